@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
 #include "TTree.h"
@@ -25,6 +26,8 @@ double MonoEnergy;
 int gNEvents = -999;
 bool IsMonoE = false;
 bool useNOvAWeights = false;
+int gNWorkers = 1;
+bool gIncremental = false;
 
 void PrintOptions();
 void ParseOptions(int argc, char *argv[]);
@@ -33,6 +36,8 @@ void RunGENIEPrepareMono(std::string input, std::string target,
 void RunGENIEPrepare(std::string input, std::string flux, std::string target,
                      std::string output);
 bool CheckConfig(std::string filename);
+void FillModeHistograms(std::string const &input, TH1D const *xsechist,
+                        int &nleft, PrepareUtils::HistSet &hists);
 
 int main(int argc, char *argv[]) {
   ParseOptions(argc, argv);
@@ -563,11 +568,6 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
     NUIS_LOG(FIT, "Found " << nevt << " input entries in " << input);
   }
 
-  StopTalking();
-  NtpMCEventRecord *genientpl = NULL;
-  tn->SetBranchAddress("gmcrec", &genientpl);
-  StartTalking();
-
   // Make Event and xsec Hist
   TH1D *eventhist = (TH1D *)fluxhist->Clone();
   eventhist->SetDirectory(NULL);
@@ -575,84 +575,66 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
   TH1D *xsechist = (TH1D *)eventhist->Clone();
   xsechist->SetDirectory(NULL);
 
-  // Create maps
+  // A limited number of events has to be read in input order, and isn't
+  // worth caching
+  int nworkers = gNWorkers;
+  std::string cachefile = "";
+  if (gIncremental) {
+    cachefile = PrepareUtils::GetCacheFile(
+        gOutputFile.length() ? gOutputFile : first_file);
+  }
+  if (gNEvents != -999 && (nworkers > 1 || cachefile.length())) {
+    NUIS_ERR(WRN, "-n is set, reading inputs serially without a cache.");
+    nworkers = 1;
+    cachefile = "";
+  }
+
+  std::vector<std::string> inputfiles;
+  TObjArray *chainfiles = tn->GetListOfFiles();
+  for (int i = 0; i < chainfiles->GetEntries(); ++i) {
+    inputfiles.push_back(chainfiles->At(i)->GetTitle());
+  }
+
+  // Each input is filled separately, then summed in input order
+  int nleft = gNEvents;
+  PrepareUtils::HistSet modehists;
+  PrepareUtils::FillFromInputs(
+      inputfiles,
+      [xsechist, &nleft](std::string const &input,
+                         PrepareUtils::HistSet &filled) {
+        FillModeHistograms(input, xsechist, nleft, filled);
+      },
+      modehists, nworkers, cachefile, PrepareUtils::GetBinningKey(xsechist));
+  NUIS_LOG(FIT, "Processed all events");
+
+  // Create maps, modes and targets are in the order they were first seen
   std::map<std::string, TH1D *> modexsec;
   std::map<std::string, TH1D *> modecount;
   std::vector<std::string> genieids;
   std::vector<std::string> targetids;
-  std::vector<std::string> interids;
 
-  // Loop over all events
-  for (int i = 0; i < nevt; i++) {
-    tn->GetEntry(i);
-
-    // Hussssch GENIE
-    StopTalking();
-    // Get the event
-    EventRecord &event = *(genientpl->event);
-    // Get the neutrino
-    GHepParticle *neu = event.Probe();
-    StartTalking();
-
-    // Get XSec From Spline
-    // Get the GHepRecord
-    GHepRecord genie_record = static_cast<GHepRecord>(event);
-    double xsec = (genie_record.XSec() / (1E-38 * genie::units::cm2));
+  std::string const xsecsuffix = "_summed_xsec";
+  for (size_t i = 0; i < modehists.GetNames().size(); ++i) {
+    std::string name = modehists.GetNames()[i];
+    if (name.size() <= xsecsuffix.size() ||
+        name.compare(name.size() - xsecsuffix.size(), xsecsuffix.size(),
+                     xsecsuffix)) {
+      continue;
+    }
+    std::string mode = name.substr(0, name.size() - xsecsuffix.size());
+    genieids.push_back(mode);
+    modexsec[mode] = (TH1D *)modehists.Get(mode + "_summed_xsec")->Clone();
+    modecount[mode] = (TH1D *)modehists.Get(mode + "_summed_evt")->Clone();
+    modexsec[mode]->SetDirectory(NULL);
+    modecount[mode]->SetDirectory(NULL);
 
-    // Parse Interaction String
-    std::string mode = genie_record.Summary()->AsString();
     std::vector<std::string> modevec = GeneralUtils::ParseToStr(mode, ";");
     std::string targ = (modevec[0] + ";" + modevec[1]);
-    std::string inter = mode;
-
-    // Get target nucleus
-    // Alternative ways of getting the summaries
-    // GHepParticle *target = genie_record.TargetNucleus();
-    // int pdg = target->Pdg();
-
-    // Fill lists of Unique IDS (neutrino and target)
     if (std::find(targetids.begin(), targetids.end(), targ) ==
         targetids.end()) {
       targetids.push_back(targ);
     }
-
-    // The full interaction list
-    if (std::find(interids.begin(), interids.end(), inter) == interids.end()) {
-      interids.push_back(inter);
-    }
-
-    // Create entries Mode Maps
-    if (modexsec.find(mode) == modexsec.end()) {
-      genieids.push_back(mode);
-
-      modexsec[mode] = (TH1D *)xsechist->Clone();
-      modecount[mode] = (TH1D *)xsechist->Clone();
-
-      modexsec[mode]->SetDirectory(NULL);
-      modecount[mode]->SetDirectory(NULL);
-
-      modexsec[mode]->GetYaxis()->SetTitle(
-          "d#sigma/dE_{#nu} #times 10^{-38} (events weighted by #sigma)");
-      modecount[mode]->GetYaxis()->SetTitle("Number of events in file");
-    }
-
-    // Fill XSec Histograms
-    modexsec[mode]->Fill(neu->E(), xsec);
-    modecount[mode]->Fill(neu->E());
-
-    // Fill total event hist
-    eventhist->Fill(neu->E());
-
-    if (i % (nevt / 20) == 0) {
-      NUIS_LOG(FIT, "Processed "
-          << i << "/" << nevt << " GENIE events (E: " << neu->E()
-          << " GeV, xsec: " << xsec << " E-38 cm^2/nucleon)");
-    }
-
-    // Clear Event
-    genientpl->Clear();
   }
-  NUIS_LOG(FIT, "Processed all events");
 
   // Check if we need to correct MEC events before possibly deleting the TChain below
   bool MECcorrect = CheckConfig(std::string(tn->GetFile()->GetName()));
@@ -913,6 +895,73 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
   return;
 };
 
+//*******************************
+void FillModeHistograms(std::string const &input, TH1D const *xsechist,
+                        int &nleft, PrepareUtils::HistSet &hists) {
+  //*******************************
+
+  TChain tn("gtree");
+  tn.AddFile(input.c_str());
+
+  int nevt = tn.GetEntries();
+  if (nleft != -999) {
+    nevt = std::min(nevt, nleft);
+    nleft -= nevt;
+  }
+
+  StopTalking();
+  NtpMCEventRecord *genientpl = NULL;
+  tn.SetBranchAddress("gmcrec", &genientpl);
+  StartTalking();
+
+  int countwidth = nevt / 20;
+  countwidth = countwidth ? countwidth : 1;
+
+  // Loop over all events
+  for (int i = 0; i < nevt; i++) {
+    tn.GetEntry(i);
+
+    // Hussssch GENIE
+    StopTalking();
+    // Get the event
+    EventRecord &event = *(genientpl->event);
+    // Get the neutrino
+    GHepParticle *neu = event.Probe();
+    StartTalking();
+
+    // Get XSec From Spline
+    // Get the GHepRecord
+    GHepRecord genie_record = static_cast<GHepRecord>(event);
+    double xsec = (genie_record.XSec() / (1E-38 * genie::units::cm2));
+
+    // Parse Interaction String
+    std::string mode = genie_record.Summary()->AsString();
+
+    // Create entries Mode Maps
+    std::string xsecname = mode + "_summed_xsec";
+    std::string countname = mode + "_summed_evt";
+    if (!hists.Has(xsecname)) {
+      hists.Get(xsecname, xsechist)->GetYaxis()->SetTitle(
+          "d#sigma/dE_{#nu} #times 10^{-38} (events weighted by #sigma)");
+      hists.Get(countname, xsechist)->GetYaxis()->SetTitle(
+          "Number of events in file");
+    }
+
+    // Fill XSec Histograms
+    hists.Get(xsecname)->Fill(neu->E(), xsec);
+    hists.Get(countname)->Fill(neu->E());
+
+    if (i % countwidth == 0) {
+      NUIS_LOG(FIT, "Processed "
+          << i << "/" << nevt << " GENIE events in " << input << " (E: "
+          << neu->E() << " GeV, xsec: " << xsec << " E-38 cm^2/nucleon)");
+    }
+
+    // Clear Event
+    genientpl->Clear();
+  }
+}
+
 void PrintOptions() {
   std::cout << "PrepareGENIE events NUISANCE app. " << std::endl
     << "Takes GHep Outputs and prepares events for NUISANCE."
@@ -955,6 +1004,13 @@ void PrintOptions() {
   std::cout << " [ -n number_of_evt ] : Run with a reduced number of events "
     "for debugging purposes"
     << std::endl;
+  std::cout << " [ -j nworkers ] : Read the input files in nworkers parallel "
+    "processes. The output does not depend on nworkers."
+    << std::endl;
+  std::cout << " [ -U ] : Keep the histograms filled from each input file in "
+    "<output>.prepcache.root and only read files that are new or have "
+    "changed when re-preparing."
+    << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -976,6 +1032,9 @@ void ParseOptions(int argc, char *argv[]) {
     if (!std::strcmp(argv[i], "-h")) {
       flagopt = true;
       break;
+    } else if (!std::strcmp(argv[i], "-U")) {
+      gIncremental = true;
+      continue;
     }
     if (i + 1 != argc) {
       // Cardfile
@@ -997,6 +1056,9 @@ void ParseOptions(int argc, char *argv[]) {
       } else if (!std::strcmp(argv[i], "-n")) {
         gNEvents = GeneralUtils::StrToInt(argv[i + 1]);
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        gNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
       } else if (!std::strcmp(argv[i], "-m")) {
         MonoEnergy = GeneralUtils::StrToDbl(argv[i + 1]);
         IsMonoE = true;
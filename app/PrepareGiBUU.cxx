@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "StatUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
@@ -10,12 +11,16 @@
 std::string fInputFiles = "";
 std::string fOutputFile = "";
 std::string fFluxFile   = "";
+int fNWorkers = 1;
+bool fIncremental = false;
 
 void PrintOptions();
 void ParseOptions(int argc, char *argv[]);
 void CreateRateHistogram(std::string inputList, std::string flux,
                          std::string output);
 TH1D* MakeFluxHistFromDatFile(std::string inputDatFile);
+void FillRateHistograms(std::string const &input, TH1D const *fluxHist,
+                        PrepareUtils::HistSet &hists);
 
 int main(int argc, char *argv[]) {
 
@@ -84,9 +89,6 @@ void CreateRateHistogram(std::string inputList, std::string flux,
                          std::string output) {
 
   TChain *tn = new TChain("RootTuple");
-  double E, xsec;
-  tn->SetBranchAddress("lepIn_E", &E);
-  tn->SetBranchAddress("weight", &xsec);
 
   std::vector<std::string> inputs = GeneralUtils::ParseToStr(inputList, ",");
   for (std::vector<std::string>::iterator it = inputs.begin();
@@ -119,24 +121,22 @@ void CreateRateHistogram(std::string inputList, std::string flux,
     NUIS_ABORT("NO FLUX SPECIFIED");
   }
 
-  // Make Event Hist
-  TH1D *xsecHist = (TH1D *)fluxHist->Clone();
-  xsecHist->Reset();
-
-  // Make a total cross section hist for shits and giggles
-  TH1D *entryHist = (TH1D *)xsecHist->Clone();
-
-  for (int i = 0; i < nevts; ++i) {
-    tn->GetEntry(i);
-    xsecHist->Fill(E, xsec);
-    entryHist->Fill(E);
-
-    if (i % (nevts / 10) == 0) {
-      NUIS_LOG(FIT, "Processed " << i << "/" << nevts << " GiBUU events."
-                             << "(Enu = " << E << ", xsec = " << xsec << ") ");
-    }
-  }
+  // Each input is filled separately, then summed in input order
+  PrepareUtils::HistSet hists;
+  PrepareUtils::FillFromInputs(
+      inputs,
+      [fluxHist](std::string const &input, PrepareUtils::HistSet &filled) {
+        FillRateHistograms(input, fluxHist, filled);
+      },
+      hists, fNWorkers,
+      fIncremental ? PrepareUtils::GetCacheFile(output.empty() ? inputs[0]
+                                                               : output)
+                   : "",
+      PrepareUtils::GetBinningKey(fluxHist));
   NUIS_LOG(FIT, "Processed all events");
+
+  // Make Event Hist
+  TH1D *xsecHist = (TH1D *)hists.Get("xsec")->Clone();
   
   // Somewhat annoyingly, have to include the flux width!
   double flux_range = (xsecHist->GetXaxis()->GetBinUpEdge(xsecHist->GetNbinsX()+1) - \
@@ -211,6 +211,37 @@ void CreateRateHistogram(std::string inputList, std::string flux,
   return;
 }
 
+void FillRateHistograms(std::string const &input, TH1D const *fluxHist,
+                        PrepareUtils::HistSet &hists) {
+
+  TChain tn("RootTuple");
+  double E, xsec;
+  tn.SetBranchAddress("lepIn_E", &E);
+  tn.SetBranchAddress("weight", &xsec);
+  tn.AddFile(input.c_str());
+
+  TH1D *xsecHist = hists.Get("xsec", fluxHist);
+
+  // Make a total cross section hist for shits and giggles
+  TH1D *entryHist = hists.Get("entry", fluxHist);
+
+  int nevts = tn.GetEntries();
+  int countwidth = nevts / 10;
+  countwidth = countwidth ? countwidth : 1;
+
+  for (int i = 0; i < nevts; ++i) {
+    tn.GetEntry(i);
+    xsecHist->Fill(E, xsec);
+    entryHist->Fill(E);
+
+    if (i % countwidth == 0) {
+      NUIS_LOG(FIT, "Processed " << i << "/" << nevts << " GiBUU events in "
+                                 << input << " (Enu = " << E
+                                 << ", xsec = " << xsec << ") ");
+    }
+  }
+}
+
 void PrintOptions() {
   std::cout << "PrepareGiBUU NUISANCE app. " << std::endl
             << "Produces or recalculates evtrt and flux histograms necessary "
@@ -234,6 +265,15 @@ void PrintOptions() {
   std::cout << "          If more than one input file is given, an output file "
                "must be given"
             << std::endl;
+  std::cout << "    [-j nworkers]" << std::endl;
+  std::cout << "          Read the input files in nworkers parallel processes. "
+               "The output does not depend on nworkers."
+            << std::endl;
+  std::cout << "    [-U]" << std::endl;
+  std::cout << "          Keep the histograms filled from each input file in "
+               "<output>.prepcache.root and only read files that are new or "
+               "have changed when re-preparing."
+            << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -244,6 +284,9 @@ void ParseOptions(int argc, char *argv[]) {
     if (!std::strcmp(argv[i], "-h")) {
       flagopt = true;
       break;
+    } else if (!std::strcmp(argv[i], "-U")) {
+      fIncremental = true;
+      continue;
     }
     if (i + 1 != argc) {
       // Cardfile
@@ -259,6 +302,9 @@ void ParseOptions(int argc, char *argv[]) {
       } else if (!std::strcmp(argv[i], "-f")) {
         fFluxFile = argv[i + 1];
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        fNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
       } else {
         NUIS_ERR(FTL, "ERROR: unknown command line option given! - '"
                         << argv[i] << " " << argv[i + 1] << "'");
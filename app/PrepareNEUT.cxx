@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "StatUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
@@ -18,6 +19,8 @@ bool fFluxInGeV = false;
 bool fIsMonoEFlux = false;
 double fMonoEEnergy = 0xdeadbeef;
 double fXSecOverride = 0;
+int fNWorkers = 1;
+bool fIncremental = false;
 
 void PrintOptions();
 void ParseOptions(int argc, char *argv[]);
@@ -25,6 +28,8 @@ void AddMonoRateHistogram(std::string inputList, double MonoE,
                           std::string output);
 void CreateRateHistogram(std::string inputList, std::string flux,
                          std::string output);
+void FillRateHistograms(std::string const &input, TH1D const *fluxHist,
+                        PrepareUtils::HistSet &hists);
 
 //*******************************
 int main(int argc, char *argv[]) {
@@ -200,9 +205,6 @@ void CreateRateHistogram(std::string inputList, std::string flux,
     NUIS_ABORT("Either the input file is not from NEUT, or it's empty...");
   }
 
-  NeutVect *fNeutVect = NULL;
-  tn->SetBranchAddress("vectorbranch", &fNeutVect);
-
   // Get Flux Hist
   std::vector<std::string> fluxvect = GeneralUtils::ParseToStr(flux, ",");
   TH1D *fluxHist = NULL;
@@ -221,32 +223,26 @@ void CreateRateHistogram(std::string inputList, std::string flux,
     NUIS_LOG(FIT, "Assuming flux histogram is in MeV");
   }
 
+  // Each input is filled separately, then summed in input order
+  PrepareUtils::HistSet hists;
+  PrepareUtils::FillFromInputs(
+      inputs,
+      [fluxHist](std::string const &input, PrepareUtils::HistSet &filled) {
+        FillRateHistograms(input, fluxHist, filled);
+      },
+      hists, fNWorkers,
+      fIncremental ? PrepareUtils::GetCacheFile(output.empty() ? inputs[0]
+                                                               : output)
+                   : "",
+      PrepareUtils::GetBinningKey(fluxHist) +
+          (fFluxInGeV ? ":GeV" : ":MeV"));
+  NUIS_LOG(FIT, "Processed all events");
+
   // Make Event Hist
-  TH1D *xsecHist = (TH1D *)fluxHist->Clone();
-  xsecHist->Reset();
+  TH1D *xsecHist = (TH1D *)hists.Get("xsec")->Clone();
 
   // Make a total cross section hist for shits and giggles
-  TH1D *entryHist = (TH1D *)xsecHist->Clone();
-
-  for (int i = 0; i < nevts; ++i) {
-    tn->GetEntry(i);
-    NeutPart *part = fNeutVect->PartInfo(0);
-    double E = part->fP.E();
-    double xsec = fNeutVect->Totcrs;
-
-    // Unit conversion
-    if (fFluxInGeV)
-      E *= 1E-3;
-
-    xsecHist->Fill(E, xsec);
-    entryHist->Fill(E);
-
-    if (i % (nevts / 20) == 0) {
-      NUIS_LOG(FIT, "Processed " << i << "/" << nevts << " NEUT events."
-                             << "(Enu = " << E << ", xsec = " << xsec << ") ");
-    }
-  }
-  NUIS_LOG(FIT, "Processed all events");
+  TH1D *entryHist = (TH1D *)hists.Get("entry")->Clone();
 
   xsecHist->Divide(entryHist);
 
@@ -330,6 +326,45 @@ void CreateRateHistogram(std::string inputList, std::string flux,
   return;
 }
 
+//*******************************
+void FillRateHistograms(std::string const &input, TH1D const *fluxHist,
+                        PrepareUtils::HistSet &hists) {
+  //*******************************
+
+  TChain tn("neuttree");
+  tn.AddFile(input.c_str());
+
+  NeutVect *fNeutVect = NULL;
+  tn.SetBranchAddress("vectorbranch", &fNeutVect);
+
+  TH1D *xsecHist = hists.Get("xsec", fluxHist);
+  TH1D *entryHist = hists.Get("entry", fluxHist);
+
+  int nevts = tn.GetEntries();
+  int countwidth = nevts / 20;
+  countwidth = countwidth ? countwidth : 1;
+
+  for (int i = 0; i < nevts; ++i) {
+    tn.GetEntry(i);
+    NeutPart *part = fNeutVect->PartInfo(0);
+    double E = part->fP.E();
+    double xsec = fNeutVect->Totcrs;
+
+    // Unit conversion
+    if (fFluxInGeV)
+      E *= 1E-3;
+
+    xsecHist->Fill(E, xsec);
+    entryHist->Fill(E);
+
+    if (i % countwidth == 0) {
+      NUIS_LOG(FIT, "Processed " << i << "/" << nevts << " NEUT events in "
+                                 << input << " (Enu = " << E
+                                 << ", xsec = " << xsec << ") ");
+    }
+  }
+}
+
 void PrintOptions() {
   std::cout << "PrepareNEUT NUISANCE app. " << std::endl
             << "Produces or recalculates evtrt and flux histograms necessary "
@@ -361,6 +396,15 @@ void PrintOptions() {
   std::cout << "          Used to add dummy flux and evt rate histograms to "
                "mono-energetic vectors. Adheres to the -G flag."
             << std::endl;
+  std::cout << "    [-j nworkers]" << std::endl;
+  std::cout << "          Read the input files in nworkers parallel processes. "
+               "The output does not depend on nworkers."
+            << std::endl;
+  std::cout << "    [-U]" << std::endl;
+  std::cout << "          Keep the histograms filled from each input file in "
+               "<output>.prepcache.root and only read files that are new or "
+               "have changed when re-preparing."
+            << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -374,6 +418,9 @@ void ParseOptions(int argc, char *argv[]) {
     } else if (!std::strcmp(argv[i], "-G")) {
       fFluxInGeV = true;
       continue;
+    } else if (!std::strcmp(argv[i], "-U")) {
+      fIncremental = true;
+      continue;
     }
     if (i + 1 != argc) {
       // Cardfile
@@ -393,6 +440,9 @@ void ParseOptions(int argc, char *argv[]) {
         fIsMonoEFlux = true;
         fMonoEEnergy = GeneralUtils::StrToDbl(argv[i + 1]);
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        fNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
       } else if (!std::strcmp(argv[i],"-X")){
         fXSecOverride = GeneralUtils::StrToDbl(argv[i + 1]);
 	++i;
@@ -6,6 +6,7 @@
 // #include "params.h"
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
 #include "TTree.h"
@@ -13,20 +14,33 @@
 void printInputCommands(char *argv[]) {
   std::cout << "[USAGE]: " << argv[0]
             << " [-h] [-f] [-F <FluxRootFile>,<FluxHistName>[,PDG[,speciesFraction]] [-o output.root] "
-               "inputfile.root [file2.root ...]"
+               "[-j nworkers] [-U] inputfile.root [file2.root ...]"
             << std::endl
             << "\t-h : Print this message." << std::endl
             << "\t-f : Pass -f argument to '$ hadd' invocation." << std::endl
             << "\t-F : Read input flux from input descriptor." << std::endl
             << "\t-o : Write full output to a new file." << std::endl
+            << "\t-j : Read the input files in nworkers parallel processes."
+            << std::endl
+            << "\t-U : Keep the histograms filled from each input file in "
+               "<output>.prepcache.root and only read files that are new or "
+               "have changed when re-preparing."
+            << std::endl
             << std::endl;
 };
-void CreateRateHistograms(std::string inputs, bool force_out);
+void CreateRateHistograms(std::string inputs,
+                          std::vector<std::string> const &sourcefiles,
+                          bool force_out);
+void FillEventHistograms(std::string const &input,
+                         std::map<int, TH1D *> const &eventlist,
+                         PrepareUtils::HistSet &hists);
 void HaddNuwroFiles(std::vector<std::string> &inputs, bool force_out);
 
 bool outputNewFile = false;
 std::string ofile = "";
 bool haveFluxInputs = false;
+int nWorkers = 1;
+bool incremental = false;
 
 struct FluxInputBlob {
   FluxInputBlob(std::string _File, std::string _Hist, int _PDG,
@@ -124,6 +138,10 @@ int main(int argc, char *argv[]) {
     } else if (!std::strcmp(argv[i], "-o")) {
       outputNewFile = true;
       ofile = argv[++i];
+    } else if (!std::strcmp(argv[i], "-j")) {
+      nWorkers = GeneralUtils::StrToInt(argv[++i]);
+    } else if (!std::strcmp(argv[i], "-U")) {
+      incremental = true;
     } else if (!std::strcmp(argv[i], "-F")) {
       std::string inpLine = argv[++i];
       std::vector<std::string> fluxInputDescriptor =
@@ -158,6 +176,10 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  // Events are read from the files as given, the hadded file only provides
+  // the output tree
+  std::vector<std::string> sourcefiles = inputfiles;
+
   // If one input file just create flux histograms
   if (inputfiles.size() > (UInt_t)1) {
     HaddNuwroFiles(inputfiles, force_output);
@@ -165,13 +187,15 @@ int main(int argc, char *argv[]) {
     printInputCommands(argv);
   }
 
-  CreateRateHistograms(inputfiles[0], force_output);
+  CreateRateHistograms(inputfiles[0], sourcefiles, force_output);
 
   NUIS_LOG(FIT, "Finished NUWRO Prep.");
 };
 
 //*******************************
-void CreateRateHistograms(std::string inputs, bool force_out) {
+void CreateRateHistograms(std::string inputs,
+                          std::vector<std::string> const &sourcefiles,
+                          bool force_out) {
   //*******************************
 
   // Open root file
@@ -398,43 +422,35 @@ void CreateRateHistograms(std::string inputs, bool force_out) {
     }
   }
 
-  // Start main event loop to fill plots
-  int nevents = nuwrotree->GetEntries();
-  double Enu = 0.0;
-  double TotXSec = 0.0;
-  // double totaleventmode = 0.0;
-  // double totalevents = 0.0;
-  int pdg = 0;
-  int countwidth = nevents / 50.0;
-  countwidth = countwidth ? countwidth : 1;
-
-  for (int i = 0; i < nevents; i++) {
-    nuwrotree->GetEntry(i);
-
-    // Get Variables
-    Enu = evt->in[0].t / 1000.0;
-    TotXSec = evt->weight;
-    pdg = evt->in[0].pdg;
-    
-    if (std::find(allpdg.begin(), allpdg.end(), pdg) == allpdg.end()) {
-      NUIS_ABORT("Not set up to handle PDG: " << pdg << " check your inputs");
-    }
-
-    eventlist[0]->Fill(Enu);
-    eventlist[pdg]->Fill(Enu);
-
-    nevtlist[0] += 1;
-    nevtlist[pdg] += 1;
-
-    intxseclist[0] += TotXSec;
-    intxseclist[pdg] += TotXSec;
+  // Each input is filled separately, then summed in input order
+  std::string fillkey = "";
+  for (uint i = 0; i < allpdg.size(); i++) {
+    fillkey += Form("%i:", allpdg[i]) +
+               PrepareUtils::GetBinningKey(eventlist[allpdg[i]]) + ";";
+  }
+  PrepareUtils::HistSet hists;
+  PrepareUtils::FillFromInputs(
+      sourcefiles,
+      [&eventlist](std::string const &input, PrepareUtils::HistSet &filled) {
+        FillEventHistograms(input, eventlist, filled);
+      },
+      hists, nWorkers,
+      incremental ? PrepareUtils::GetCacheFile(outputNewFile ? ofile : inputs)
+                  : "",
+      fillkey);
+  NUIS_LOG(FIT, "Processed all events");
 
-    if (i % countwidth == 0) {
-      NUIS_LOG(FIT, "Processed " << i << " events "
-                                 << " (" << int(i * 100.0 / nevents) << "%)"
-                                 << " : E, W, PDG = " << Enu << ", " << TotXSec
-                                 << ", " << pdg)
+  for (uint i = 0; i < allpdg.size(); i++) {
+    int pdg = allpdg[i];
+    TH1D *filledevt = hists.Get(Form("evt_%i", pdg));
+    TH1D *filledxsec = hists.Get(Form("xsec_%i", pdg));
+    if (!filledevt || !filledxsec) {
+      continue;
     }
+    int nbins = filledevt->GetNbinsX();
+    eventlist[pdg]->Add(filledevt);
+    nevtlist[pdg] = int(filledevt->Integral(0, nbins + 1));
+    intxseclist[pdg] = filledxsec->Integral(0, nbins + 1);
   }
 
   TH1D *zeroevents = (TH1D *)eventlist[0]->Clone();
@@ -476,6 +492,62 @@ void CreateRateHistograms(std::string inputs, bool force_out) {
   return;
 }
 
+//*******************************
+void FillEventHistograms(std::string const &input,
+                         std::map<int, TH1D *> const &eventlist,
+                         PrepareUtils::HistSet &hists) {
+  //*******************************
+
+  TFile inpFile(input.c_str(), "READ");
+  TTree *nuwrotree =
+      inpFile.IsOpen() ? dynamic_cast<TTree *>(inpFile.Get("treeout")) : NULL;
+  if (!nuwrotree) {
+    NUIS_ABORT("Cannot find TTree \"treeout\" in input root file: "
+               << input.c_str());
+  }
+
+  event *evt = new event();
+  nuwrotree->SetBranchAddress("e", &evt);
+
+  int nevents = nuwrotree->GetEntries();
+  double Enu = 0.0;
+  double TotXSec = 0.0;
+  int pdg = 0;
+  int countwidth = nevents / 50.0;
+  countwidth = countwidth ? countwidth : 1;
+
+  for (int i = 0; i < nevents; i++) {
+    nuwrotree->GetEntry(i);
+
+    // Get Variables
+    Enu = evt->in[0].t / 1000.0;
+    TotXSec = evt->weight;
+    pdg = evt->in[0].pdg;
+
+    std::map<int, TH1D *>::const_iterator templ = eventlist.find(pdg);
+    if (templ == eventlist.end()) {
+      NUIS_ABORT("Not set up to handle PDG: " << pdg << " check your inputs");
+    }
+
+    // Entry 0 is the total over all species
+    hists.Get("evt_0", eventlist.at(0))->Fill(Enu);
+    hists.Get(Form("evt_%i", pdg), templ->second)->Fill(Enu);
+    hists.Get("xsec_0", eventlist.at(0))->Fill(Enu, TotXSec);
+    hists.Get(Form("xsec_%i", pdg), templ->second)->Fill(Enu, TotXSec);
+
+    if (i % countwidth == 0) {
+      NUIS_LOG(FIT, "Processed " << i << " events in " << input << " ("
+                                 << int(i * 100.0 / nevents) << "%)"
+                                 << " : E, W, PDG = " << Enu << ", " << TotXSec
+                                 << ", " << pdg)
+    }
+  }
+
+  nuwrotree->ResetBranchAddresses();
+  delete evt;
+  inpFile.Close();
+}
+
 //*******************************
 void HaddNuwroFiles(std::vector<std::string> &inputs, bool force_out) {
   //*******************************
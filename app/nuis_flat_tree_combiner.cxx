@@ -4,6 +4,8 @@
 
 #include "TChain.h"
 #include "TFile.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
 #include "TTree.h"
 
 std::vector<std::string> inputdescriptors;
@@ -11,6 +13,7 @@ std::string outputfilename;
 std::string treename;
 std::string branchname;
 bool isdouble = true;
+bool fastmerge = false;
 
 void SayUsage(char const *argv[]) {
   std::cout
@@ -22,6 +25,16 @@ void SayUsage(char const *argv[]) {
          "branch name\n"
       << "\t-f                                              : xsec weighting "
          "branch is float\n"
+      << "\t-F                                              : fast merge, "
+         "copy the\n"
+      << "\t                                                  compressed "
+         "baskets and move\n"
+      << "\t                                                  the rescaled "
+         "weighting branch,\n"
+      << "\t                                                  under the same "
+         "name, to a friend\n"
+      << "\t                                                  tree "
+         "<treename>_combined\n"
       << std::endl;
 }
 
@@ -44,6 +57,8 @@ void handleOpts(int argc, char const *argv[]) {
       branchname = argv[++opt];
     } else if (std::string(argv[opt]) == "-f") {
       isdouble = false;
+    } else if (std::string(argv[opt]) == "-F") {
+      fastmerge = true;
     } else {
       std::cout << "[ERROR]: Unknown option: " << argv[opt] << std::endl;
       SayUsage(argv);
@@ -53,6 +68,80 @@ void handleOpts(int argc, char const *argv[]) {
   }
 }
 
+// Branch names and leaf types of a tree, baskets can only be copied between
+// trees that agree on these.
+std::vector<std::string> GetSchema(TTree *tree) {
+  std::vector<std::string> schema;
+  TObjArray *leaves = tree->GetListOfLeaves();
+  for (int i = 0; i < leaves->GetEntries(); ++i) {
+    TLeaf *leaf = static_cast<TLeaf *>(leaves->At(i));
+    schema.push_back(std::string(leaf->GetBranch()->GetName()) + ":" +
+                     leaf->GetTitle() + ":" + leaf->GetTypeName());
+  }
+  return schema;
+}
+
+bool SchemasMatch(TChain &ch) {
+  std::vector<std::string> first;
+  TObjArray *files = ch.GetListOfFiles();
+  for (int i = 0; i < files->GetEntries(); ++i) {
+    std::string fname = files->At(i)->GetTitle();
+    TFile f(fname.c_str(), "READ");
+    TTree *tree = f.IsZombie() ? NULL : (TTree *)f.Get(treename.c_str());
+    if (!tree) {
+      std::cout << "[WARN]: Could not read " << treename << " from " << fname
+                << std::endl;
+      return false;
+    }
+    std::vector<std::string> schema = GetSchema(tree);
+    if (!i) {
+      first = schema;
+    } else if (schema != first) {
+      std::cout << "[WARN]: " << fname
+                << " has different branches to the first input." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy every input tree basket by basket, except for the weighting branch.
+// The rescaled weighting branch is stored under the same name in a friend
+// tree, so it is the only copy seen through the merged tree.
+template <typename T> void FastMerge(TChain &ch, TFile *outfile) {
+  size_t nents = ch.GetEntries();
+  double ntrees = ch.GetNtrees();
+
+  ch.SetBranchStatus(branchname.c_str(), false);
+  TTree *outtree = ch.CloneTree(-1, "fast");
+  outtree->SetDirectory(outfile);
+  std::cout << "Copied " << nents << " entries from " << ntrees
+            << " input trees." << std::endl;
+
+  std::string friendname = treename + "_combined";
+  TTree *friendtree = new TTree(friendname.c_str(), friendname.c_str());
+  friendtree->SetDirectory(outfile);
+
+  T fScaleFactor;
+  T fScaleFactor_combined;
+  friendtree->Branch(branchname.c_str(), &fScaleFactor_combined);
+
+  // Only the weighting branch needs decompressing
+  ch.SetBranchStatus("*", false);
+  ch.SetBranchStatus(branchname.c_str(), true);
+  ch.SetBranchAddress(branchname.c_str(), &fScaleFactor);
+  std::cout << "recalculating " << branchname << " into " << friendname << "."
+            << branchname << " for " << ntrees << " input trees." << std::endl;
+
+  for (size_t ent_it = 0; ent_it < nents; ++ent_it) {
+    ch.GetEntry(ent_it);
+    fScaleFactor_combined = fScaleFactor / ntrees;
+    friendtree->Fill();
+  }
+
+  outtree->AddFriend(friendtree);
+}
+
 int main(int argc, char const *argv[]) {
   handleOpts(argc, argv);
 
@@ -63,6 +152,25 @@ int main(int argc, char const *argv[]) {
               << std::endl;
   }
 
+  if (fastmerge && !SchemasMatch(ch)) {
+    std::cout << "[WARN]: Falling back to the entry by entry merge."
+              << std::endl;
+    fastmerge = false;
+  }
+
+  if (fastmerge) {
+    TFile *outfile = new TFile(outputfilename.c_str(), "RECREATE");
+    std::cout << "Fast merging to " << outputfilename << std::endl;
+    if (isdouble) {
+      FastMerge<double>(ch, outfile);
+    } else {
+      FastMerge<float>(ch, outfile);
+    }
+    outfile->Write();
+    outfile->Close();
+    return 0;
+  }
+
   TFile *outfile = new TFile(outputfilename.c_str(), "RECREATE");
   std::cout << "Writing to " << outputfilename << std::endl;
   TTree *outtree = ch.CloneTree(0, "");
@@ -28,7 +28,22 @@
 //*******************************
 void printInputCommands(){
 //*******************************
-  
+
+  std::cout << "nuisbayes -c cardFile -o outFile [-f strategy] [-t nthrows] "
+               "[-n maxevents] [-q config_name=config_val] [--resume] \n";
+  std::cout << std::endl;
+  std::cout << "Arguments:" << std::endl;
+  std::cout << "     -c cardFile:   Path to card file that defines the "
+               "samples and parameters \n";
+  std::cout << "     -o outFile:    Path to root file that will be created to "
+               "save output file.\n";
+  std::cout << "     -t nthrows:    Number of throws to run (default 250)\n";
+  std::cout << "     --resume:      Carry on from the checkpoint left by a job "
+               "that was stopped. Checkpoints\n";
+  std::cout << "                    are written every 'config "
+               "checkpoint_interval' seconds.\n"
+            << std::endl;
+
   exit(-1);
 
 };
@@ -22,6 +22,19 @@
 #include "InputUtils.h"
 #include "MeasurementBase.h"
 #include "Smearceptance_Tester.h"
+#include "ThrowUtils.h"
+
+#include "TClass.h"
+#include "TKey.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
 
 // Global Arguments
 std::string gOptInputFile = "";
@@ -31,6 +44,8 @@ std::string gOptType = "DEFAULT";
 std::string gOptNumberEvents = "NULL";
 std::string gOptCardInput = "";
 std::string gOptOptions = "";
+int gOptNWorkers = 1;
+bool gOptUnordered = false;
 
 // Input Dial Vals
 std::vector<std::string> fParams;              ///< Vector of dial names.
@@ -42,13 +57,15 @@ std::map<std::string, double> fFakeVals; ///< Map of fake data settings.
 
 void SetupComparisonsFromXML();
 void SetupRWEngine();
+MeasurementBase *CreateFlatTreeCreator();
+void RunFlatTreeWorkers(TFile *f);
 
 //*******************************
 void PrintSyntax() {
   //*******************************
 
   std::cout << "nuisflat -i input [-f format]  [-o outfile] [-n nevents] [-t "
-               "options] [-q con=val] \n";
+               "options] [-q con=val] [-j nworkers [-u]] \n";
   std::cout
       << "\n Arguments : "
       << "\n\t -i input   : Path to input vector of events to flatten"
@@ -76,7 +93,15 @@ void PrintSyntax() {
       << "\n\t[-t options]: Pass OPTION to the FlatTree sample. "
       << "\n\t              Similar to type field in comparison xml configs."
       << "\n\t"
-      << "\n\t[-q con=val]: Configuration overrides." << std::endl;
+      << "\n\t[-q con=val]: Configuration overrides."
+      << "\n\t"
+      << "\n\t[-j nworkers]: Split the input between nworkers processes, each"
+      << "\n\t              reading its own contiguous block of events. The"
+      << "\n\t              output is merged in input event order."
+      << "\n\t"
+      << "\n\t[-u]        : With -j, merge each block as soon as its worker"
+      << "\n\t              finishes instead of in input event order."
+      << std::endl;
 
   exit(-1);
 };
@@ -145,6 +170,18 @@ void GetCommandLineArgs(int argc, char **argv) {
   if (gOptOptions != "") {
     NUIS_LOG(FIT, "Read options: \"" << gOptOptions << "\'");
   }
+
+  ParserUtils::ParseArgument(args, "-j", gOptNWorkers, false);
+  if (gOptNWorkers < 1) {
+    NUIS_ABORT("Need at least one worker for -j, got: " << gOptNWorkers);
+  }
+
+  ParserUtils::ParseFlag(args, "-u", gOptUnordered);
+  if (gOptNWorkers > 1) {
+    NUIS_LOG(FIT, "Flattening with " << gOptNWorkers << " worker processes, "
+                                     << (gOptUnordered ? "not " : "")
+                                     << "preserving input event order.");
+  }
   return;
 }
 
@@ -173,37 +210,19 @@ int main(int argc, char *argv[]) {
   f->cd();
   FitPar::Config().out = f;
 
-  // Create a new measurementbase class depending on the Format
-  MeasurementBase *flattreecreator = NULL;
-
   SetupComparisonsFromXML();
   SetupRWEngine();
   // SetupFCN();
 
-  // Make a new sample key for the format of interest.
-  nuiskey samplekey = Config::CreateKey("sample");
-  if (!gOptFormat.compare("GenericFlux")) {
-    samplekey.Set("name", "FlatTree");
-    samplekey.Set("input", gOptInputFile);
-    samplekey.Set("type", gOptType);
-    flattreecreator = new GenericFlux_Tester("FlatTree", gOptInputFile,
-                                             FitBase::GetRW(), gOptType, "");
-
-  } else if (!gOptFormat.compare("GenericVectors")) {
-    samplekey.Set("name", "FlatTree");
-    samplekey.Set("input", gOptInputFile);
-    samplekey.Set("type", gOptType);
-    flattreecreator = new GenericFlux_Vectors("FlatTree", gOptInputFile,
-                                              FitBase::GetRW(), gOptType, "");
-
+  if (gOptNWorkers > 1) {
+    RunFlatTreeWorkers(f);
   } else {
-    NUIS_ERR(FTL, "Unknown FlatTree format!");
+    // Make the FlatTree reconfigure
+    MeasurementBase *flattreecreator = CreateFlatTreeCreator();
+    flattreecreator->Reconfigure();
+    f->cd();
+    flattreecreator->Write();
   }
-
-  // Make the FlatTree reconfigure
-  flattreecreator->Reconfigure();
-  f->cd();
-  flattreecreator->Write();
   f->Close();
 
   // Show Final Status
@@ -399,3 +418,213 @@ void SetupRWEngine() {
   FitBase::GetRW()->Reconfigure();
   return;
 }
+
+//*************************************
+MeasurementBase *CreateFlatTreeCreator() {
+  //*************************************
+
+  // Create a new measurementbase class depending on the Format
+  MeasurementBase *flattreecreator = NULL;
+
+  // Make a new sample key for the format of interest.
+  nuiskey samplekey = Config::CreateKey("sample");
+  if (!gOptFormat.compare("GenericFlux")) {
+    samplekey.Set("name", "FlatTree");
+    samplekey.Set("input", gOptInputFile);
+    samplekey.Set("type", gOptType);
+    flattreecreator = new GenericFlux_Tester("FlatTree", gOptInputFile,
+                                             FitBase::GetRW(), gOptType, "");
+
+  } else if (!gOptFormat.compare("GenericVectors")) {
+    samplekey.Set("name", "FlatTree");
+    samplekey.Set("input", gOptInputFile);
+    samplekey.Set("type", gOptType);
+    flattreecreator = new GenericFlux_Vectors("FlatTree", gOptInputFile,
+                                              FitBase::GetRW(), gOptType, "");
+
+  } else {
+    NUIS_ERR(FTL, "Unknown FlatTree format!");
+  }
+
+  return flattreecreator;
+}
+
+//*************************************
+std::string GetFlatTreeWorkerFile(int worker) {
+  //*************************************
+  return ThrowUtils::GetWorkerFile(gOptOutputFile, worker);
+}
+
+//*************************************
+void RunFlatTreeWorker(int worker) {
+  //*************************************
+
+  TFile *workerfile =
+      new TFile(GetFlatTreeWorkerFile(worker).c_str(), "RECREATE");
+  if (workerfile->IsZombie()) {
+    NUIS_ABORT("Cannot create worker output file "
+               << GetFlatTreeWorkerFile(worker));
+  }
+  workerfile->cd();
+  FitPar::Config().out = workerfile;
+
+  // Every worker opens the input itself so no file handles or read offsets
+  // are shared, and sees the full input so the normalisation is unchanged.
+  MeasurementBase *flattreecreator = CreateFlatTreeCreator();
+  InputHandlerBase *input = flattreecreator->GetInput();
+
+  int nevents = input->GetNEvents();
+  int maxevents = Config::GetParI("MAXEVENTS");
+  if (maxevents != -1 && maxevents + 1 < nevents) {
+    nevents = maxevents + 1;
+  }
+
+  std::vector<std::pair<int, int> > ranges =
+      ThrowUtils::SplitThrows(0, nevents - 1, gOptNWorkers);
+  if (size_t(worker) >= ranges.size()) {
+    // More workers than events, nothing left for this one
+    workerfile->Close();
+    gSystem->Unlink(GetFlatTreeWorkerFile(worker).c_str());
+    return;
+  }
+
+  NUIS_LOG(FIT, "Worker " << worker << " flattening events "
+                          << ranges[worker].first << "-"
+                          << ranges[worker].second);
+  input->SetEventRange(ranges[worker].first, ranges[worker].second);
+  flattreecreator->Reconfigure();
+  workerfile->cd();
+  flattreecreator->Write();
+  workerfile->Close();
+}
+
+//*************************************
+void MergeFlatTreeWorker(TFile *f, int worker, TTree *&outtree) {
+  //*************************************
+
+  std::string workername = GetFlatTreeWorkerFile(worker);
+  if (gSystem->AccessPathName(workername.c_str())) {
+    // Worker had no events to process
+    return;
+  }
+
+  TFile *workerfile = new TFile(workername.c_str(), "READ");
+  if (workerfile->IsZombie()) {
+    NUIS_ABORT("Cannot read worker output file " << workername);
+  }
+
+  NUIS_LOG(FIT, "Merging flattree output of worker " << worker);
+  bool first = (outtree == NULL);
+  TIter next(workerfile->GetListOfKeys());
+  TKey *key;
+  while ((key = (TKey *)next())) {
+    TClass *cl = gROOT->GetClass(key->GetClassName());
+    if (!cl) {
+      continue;
+    }
+
+    if (cl->InheritsFrom("TTree")) {
+      TTree *tree = (TTree *)workerfile->Get(key->GetName());
+      f->cd();
+      if (!outtree) {
+        outtree = tree->CloneTree(0);
+        outtree->SetDirectory(f);
+      }
+      outtree->CopyEntries(tree, -1, "fast");
+
+    } else if (first) {
+      // Flux and event histograms are identical in every worker
+      TObject *obj = workerfile->Get(key->GetName());
+      f->cd();
+      obj->Write(key->GetName());
+      delete obj;
+    }
+  }
+
+  workerfile->Close();
+  delete workerfile;
+  gSystem->Unlink(workername.c_str());
+  f->cd();
+}
+
+//*************************************
+void RunFlatTreeWorkers(TFile *f) {
+  //*************************************
+
+  // Anything buffered here would otherwise be flushed once per worker
+  std::cout << std::flush;
+  std::cerr << std::flush;
+  std::fflush(stdout);
+  std::fflush(stderr);
+
+  std::vector<pid_t> pids(gOptNWorkers, -1);
+  for (int i = 0; i < gOptNWorkers; i++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      NUIS_ABORT("Failed to fork flattree worker " << i);
+    }
+
+    if (pid == 0) {
+      int status = 0;
+      try {
+        RunFlatTreeWorker(i);
+      } catch (...) {
+        status = 1;
+      }
+      std::cout << std::flush;
+      std::cerr << std::flush;
+      std::fflush(stdout);
+      std::fflush(stderr);
+      // Skip the parent's atexit/static teardown, it owns those resources
+      _exit(status);
+    }
+    pids[i] = pid;
+  }
+
+  // Merge blocks while the remaining workers are still running. In ordered
+  // mode a finished block waits until all blocks before it are merged.
+  std::vector<bool> done(gOptNWorkers, false);
+  int nextmerge = 0;
+  int nrunning = gOptNWorkers;
+  TTree *outtree = NULL;
+  while (nrunning > 0) {
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      break;
+    }
+
+    int worker = std::find(pids.begin(), pids.end(), pid) - pids.begin();
+    if (worker >= gOptNWorkers) {
+      continue;
+    }
+    nrunning--;
+
+    if (!WIFEXITED(status) or WEXITSTATUS(status) != 0) {
+      // A missing block would silently bias the flattree, so give up
+      for (int i = 0; i < gOptNWorkers; i++) {
+        if (i != worker && !done[i]) {
+          kill(pids[i], SIGTERM);
+          waitpid(pids[i], NULL, 0);
+        }
+        gSystem->Unlink(GetFlatTreeWorkerFile(i).c_str());
+      }
+      NUIS_ABORT("Flattree worker " << worker << " failed.");
+    }
+    done[worker] = true;
+
+    if (gOptUnordered) {
+      MergeFlatTreeWorker(f, worker, outtree);
+      continue;
+    }
+    while (nextmerge < gOptNWorkers && done[nextmerge]) {
+      MergeFlatTreeWorker(f, nextmerge, outtree);
+      nextmerge++;
+    }
+  }
+
+  f->cd();
+  if (outtree) {
+    outtree->Write();
+  }
+}
@@ -34,7 +34,8 @@ void printInputCommands() {
 
   std::cout
       << "nuismin -c cardFile -o outFile [-f fitStategy] [-d "
-         "fakeDataFile] [-i inputFile] [-q config_name=config_val] \n";
+         "fakeDataFile] [-i inputFile] [-q config_name=config_val] "
+         "[--resume] \n";
   std::cout << std::endl;
   std::cout << "Arguments:" << std::endl;
   std::cout << "     -c cardFile:   Path to card file that defines fit "
@@ -83,6 +84,10 @@ void printInputCommands() {
                "those given in the default, or cardFile. \n";
   std::cout << "                                 example: -q verbosity=6 -q "
                "maxevents=10000 \n";
+  std::cout << "     --resume:      Carry on from the checkpoint left by a job "
+               "that was stopped. Checkpoints\n";
+  std::cout << "                    are written every 'config "
+               "checkpoint_interval' seconds.\n";
 
   exit(-1);
 };
@@ -26,6 +26,7 @@ std::string gOptInputFile = "";
 std::string gOptOutputFile = "";
 std::string gOptType = "DEFAULT";
 std::string gOptNumberEvents = "NULL";
+std::string gOptNumberThreads = "NULL";
 std::string gOptCardInput = "";
 std::string gOptOptions = "";
 
@@ -33,8 +34,8 @@ std::string gOptOptions = "";
 void PrintSyntax() {
   //*******************************
 
-  std::cout << "nuisflat -i input [-o outfile] [-n nevents] [-t "
-               "options] [-q con=val] \n";
+  std::cout << "nuisflat -i input [-o outfile] [-n nevents] [-j nthreads] "
+               "[-t options] [-q con=val] \n";
   std::cout
       << "\n Arguments : "
       << "\n\t -i input   : Path to input vector of events to flatten"
@@ -53,6 +54,10 @@ void PrintSyntax() {
       << "\n\t[-n nevents]: Optional choice of Nevents to run over. Default is "
          "all."
       << "\n\t"
+      << "\n\t[-j nthreads]: Number of threads to smear on, the output does "
+         "not depend"
+      << "\n\t              on it. Set smear.seed to change the throws."
+      << "\n\t"
       << "\n\t[-t options]: Pass OPTION to the smearception sample. "
       << "\n\t              Similar to type field in comparison xml configs."
       << "\n\t"
@@ -101,6 +106,11 @@ void GetCommandLineArgs(int argc, char **argv) {
     configuration.OverrideConfig("MAXEVENTS=" + gOptNumberEvents);
   }
 
+  ParserUtils::ParseArgument(args, "-j", gOptNumberThreads, false);
+  if (gOptNumberThreads.compare("NULL")) {
+    configuration.OverrideConfig("smear.threads=" + gOptNumberThreads);
+  }
+
   std::vector<std::string> configargs;
   ParserUtils::ParseArgument(args, "-q", configargs);
   for (size_t i = 0; i < configargs.size(); i++) {
@@ -30,14 +30,19 @@ void printInputCommands() {
   //*******************************
 
   std::cout << "nuissyst.exe -c cardFile -o outFile [-f fitStategy] [-d "
-               "fakeDataFile] [-i inputFile] [-q config_name=config_val] \n";
+               "fakeDataFile] [-i inputFile] [-q config_name=config_val] "
+               "[--resume] \n";
   std::cout << std::endl;
   std::cout << "Arguments:" << std::endl;
   std::cout << "     -c cardFile:   Path to card file that defines fit "
                "samples, free parameters, and config overrides \n";
   std::cout << "     -o outFile:    Path to root file that will be created to "
                "save output file.\n";
-  std::cout << "     -f Strategy:   ErrorBands (default) or PlotLimits\n"
+  std::cout << "     -f Strategy:   ErrorBands (default) or PlotLimits\n";
+  std::cout << "     --resume:      Carry on with the throws of a job that was "
+               "stopped, from the checkpoint\n";
+  std::cout << "                    written every 'config checkpoint_interval' "
+               "seconds.\n"
             << std::endl;
 
   exit(-1);
@@ -0,0 +1,199 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+#include "ANL_CCQE_Evt_1DQ2_nu.h"
+#include "ANL_CCQE_XSec_1DEnu_nu.h"
+
+// ANL CC1ppip
+#include "ANL_CC1ppip_Evt_1DQ2_nu.h"
+#include "ANL_CC1ppip_Evt_1DWNmu_nu.h"
+#include "ANL_CC1ppip_Evt_1DWNpi_nu.h"
+#include "ANL_CC1ppip_Evt_1DWmupi_nu.h"
+#include "ANL_CC1ppip_Evt_1DcosmuStar_nu.h"
+#include "ANL_CC1ppip_Evt_1DcosthAdler_nu.h"
+#include "ANL_CC1ppip_Evt_1Dphi_nu.h"
+#include "ANL_CC1ppip_Evt_1Dppi_nu.h"
+#include "ANL_CC1ppip_Evt_1Dthpr_nu.h"
+#include "ANL_CC1ppip_XSec_1DEnu_nu.h"
+#include "ANL_CC1ppip_XSec_1DQ2_nu.h"
+// ANL CC1npip
+#include "ANL_CC1npip_Evt_1DQ2_nu.h"
+#include "ANL_CC1npip_Evt_1DWNmu_nu.h"
+#include "ANL_CC1npip_Evt_1DWNpi_nu.h"
+#include "ANL_CC1npip_Evt_1DWmupi_nu.h"
+#include "ANL_CC1npip_Evt_1DcosmuStar_nu.h"
+#include "ANL_CC1npip_Evt_1Dppi_nu.h"
+#include "ANL_CC1npip_XSec_1DEnu_nu.h"
+// ANL CC1pi0
+#include "ANL_CC1pi0_Evt_1DQ2_nu.h"
+#include "ANL_CC1pi0_Evt_1DWNmu_nu.h"
+#include "ANL_CC1pi0_Evt_1DWNpi_nu.h"
+#include "ANL_CC1pi0_Evt_1DWmupi_nu.h"
+#include "ANL_CC1pi0_Evt_1DcosmuStar_nu.h"
+#include "ANL_CC1pi0_XSec_1DEnu_nu.h"
+// ANL NC1npip (mm, exotic!)
+#include "ANL_NC1npip_Evt_1Dppi_nu.h"
+// ANL NC1ppim (mm, exotic!)
+#include "ANL_NC1ppim_Evt_1DcosmuStar_nu.h"
+#include "ANL_NC1ppim_XSec_1DEnu_nu.h"
+// ANL CC2pi 1pim1pip (mm, even more exotic!)
+#include "ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu.h"
+#include "ANL_CC2pi_1pim1pip_Evt_1Dppim_nu.h"
+#include "ANL_CC2pi_1pim1pip_Evt_1Dppip_nu.h"
+#include "ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu.h"
+#include "ANL_CC2pi_1pim1pip_XSec_1DEnu_nu.h"
+// ANL CC2pi 1pip1pip (mm, even more exotic!)
+#include "ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu.h"
+#include "ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu.h"
+#include "ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu.h"
+#include "ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu.h"
+#include "ANL_CC2pi_1pip1pip_XSec_1DEnu_nu.h"
+// ANL CC2pi 1pip1pi0 (mm, even more exotic!)
+#include "ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu.h"
+#include "ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu.h"
+#include "ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu.h"
+#include "ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu.h"
+#include "ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu.h"
+
+void SampleUtils::RegisterANLSamples(SampleFactoryMap &factories) {
+  RegisterSample<ANL_CCQE_XSec_1DEnu_nu>(factories, "ANL_CCQE_XSec_1DEnu_nu");
+  RegisterSample<ANL_CCQE_XSec_1DEnu_nu>(factories,
+                                         "ANL_CCQE_XSec_1DEnu_nu_PRD26");
+  RegisterSample<ANL_CCQE_XSec_1DEnu_nu>(factories,
+                                         "ANL_CCQE_XSec_1DEnu_nu_PRL31");
+  RegisterSample<ANL_CCQE_XSec_1DEnu_nu>(factories,
+                                         "ANL_CCQE_XSec_1DEnu_nu_PRD16");
+  RegisterSample<ANL_CCQE_Evt_1DQ2_nu>(factories, "ANL_CCQE_Evt_1DQ2_nu");
+  RegisterSample<ANL_CCQE_Evt_1DQ2_nu>(factories, "ANL_CCQE_Evt_1DQ2_nu_PRL31");
+  RegisterSample<ANL_CCQE_Evt_1DQ2_nu>(factories, "ANL_CCQE_Evt_1DQ2_nu_PRD26");
+  RegisterSample<ANL_CCQE_Evt_1DQ2_nu>(factories, "ANL_CCQE_Evt_1DQ2_nu_PRD16");
+  RegisterSample<ANL_CC1ppip_XSec_1DEnu_nu>(factories,
+                                            "ANL_CC1ppip_XSec_1DEnu_nu");
+  RegisterSample<ANL_CC1ppip_XSec_1DEnu_nu>(factories,
+                                            "ANL_CC1ppip_XSec_1DEnu_nu_W14Cut");
+  RegisterSample<ANL_CC1ppip_XSec_1DEnu_nu>(factories,
+                                            "ANL_CC1ppip_XSec_1DEnu_nu_Uncorr");
+  RegisterSample<ANL_CC1ppip_XSec_1DEnu_nu>(
+      factories, "ANL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr");
+  RegisterSample<ANL_CC1ppip_XSec_1DEnu_nu>(
+      factories, "ANL_CC1ppip_XSec_1DEnu_nu_W16Cut_Uncorr");
+  RegisterSample<ANL_CC1ppip_XSec_1DQ2_nu>(factories,
+                                           "ANL_CC1ppip_XSec_1DQ2_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1DQ2_nu>(factories, "ANL_CC1ppip_Evt_1DQ2_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1DQ2_nu>(factories,
+                                          "ANL_CC1ppip_Evt_1DQ2_nu_W14Cut");
+  RegisterSample<ANL_CC1ppip_Evt_1Dppi_nu>(factories,
+                                           "ANL_CC1ppip_Evt_1Dppi_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1Dthpr_nu>(factories,
+                                            "ANL_CC1ppip_Evt_1Dthpr_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1DcosmuStar_nu>(
+      factories, "ANL_CC1ppip_Evt_1DcosmuStar_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1DcosthAdler_nu>(
+      factories, "ANL_CC1ppip_Evt_1DcosthAdler_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1Dphi_nu>(factories,
+                                           "ANL_CC1ppip_Evt_1Dphi_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1DWNpi_nu>(factories,
+                                            "ANL_CC1ppip_Evt_1DWNpi_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1DWNmu_nu>(factories,
+                                            "ANL_CC1ppip_Evt_1DWNmu_nu");
+  RegisterSample<ANL_CC1ppip_Evt_1DWmupi_nu>(factories,
+                                             "ANL_CC1ppip_Evt_1DWmupi_nu");
+  RegisterSample<ANL_CC1npip_XSec_1DEnu_nu>(factories,
+                                            "ANL_CC1npip_XSec_1DEnu_nu");
+  RegisterSample<ANL_CC1npip_XSec_1DEnu_nu>(factories,
+                                            "ANL_CC1npip_XSec_1DEnu_nu_W14Cut");
+  RegisterSample<ANL_CC1npip_XSec_1DEnu_nu>(factories,
+                                            "ANL_CC1npip_XSec_1DEnu_nu_Uncorr");
+  RegisterSample<ANL_CC1npip_XSec_1DEnu_nu>(
+      factories, "ANL_CC1npip_XSec_1DEnu_nu_W14Cut_Uncorr");
+  RegisterSample<ANL_CC1npip_XSec_1DEnu_nu>(
+      factories, "ANL_CC1npip_XSec_1DEnu_nu_W16Cut_Uncorr");
+  RegisterSample<ANL_CC1npip_Evt_1DQ2_nu>(factories, "ANL_CC1npip_Evt_1DQ2_nu");
+  RegisterSample<ANL_CC1npip_Evt_1DQ2_nu>(factories,
+                                          "ANL_CC1npip_Evt_1DQ2_nu_W14Cut");
+  RegisterSample<ANL_CC1npip_Evt_1Dppi_nu>(factories,
+                                           "ANL_CC1npip_Evt_1Dppi_nu");
+  RegisterSample<ANL_CC1npip_Evt_1DcosmuStar_nu>(
+      factories, "ANL_CC1npip_Evt_1DcosmuStar_nu");
+  RegisterSample<ANL_CC1npip_Evt_1DWNpi_nu>(factories,
+                                            "ANL_CC1npip_Evt_1DWNpi_nu");
+  RegisterSample<ANL_CC1npip_Evt_1DWNmu_nu>(factories,
+                                            "ANL_CC1npip_Evt_1DWNmu_nu");
+  RegisterSample<ANL_CC1npip_Evt_1DWmupi_nu>(factories,
+                                             "ANL_CC1npip_Evt_1DWmupi_nu");
+  RegisterSample<ANL_CC1pi0_XSec_1DEnu_nu>(factories,
+                                           "ANL_CC1pi0_XSec_1DEnu_nu");
+  RegisterSample<ANL_CC1pi0_XSec_1DEnu_nu>(factories,
+                                           "ANL_CC1pi0_XSec_1DEnu_nu_W14Cut");
+  RegisterSample<ANL_CC1pi0_XSec_1DEnu_nu>(factories,
+                                           "ANL_CC1pi0_XSec_1DEnu_nu_Uncorr");
+  RegisterSample<ANL_CC1pi0_XSec_1DEnu_nu>(
+      factories, "ANL_CC1pi0_XSec_1DEnu_nu_W14Cut_Uncorr");
+  RegisterSample<ANL_CC1pi0_XSec_1DEnu_nu>(
+      factories, "ANL_CC1pi0_XSec_1DEnu_nu_W16Cut_Uncorr");
+  RegisterSample<ANL_CC1pi0_Evt_1DQ2_nu>(factories, "ANL_CC1pi0_Evt_1DQ2_nu");
+  RegisterSample<ANL_CC1pi0_Evt_1DQ2_nu>(factories,
+                                         "ANL_CC1pi0_Evt_1DQ2_nu_W14Cut");
+  RegisterSample<ANL_CC1pi0_Evt_1DcosmuStar_nu>(
+      factories, "ANL_CC1pi0_Evt_1DcosmuStar_nu");
+  RegisterSample<ANL_CC1pi0_Evt_1DWNpi_nu>(factories,
+                                           "ANL_CC1pi0_Evt_1DWNpi_nu");
+  RegisterSample<ANL_CC1pi0_Evt_1DWNmu_nu>(factories,
+                                           "ANL_CC1pi0_Evt_1DWNmu_nu");
+  RegisterSample<ANL_CC1pi0_Evt_1DWmupi_nu>(factories,
+                                            "ANL_CC1pi0_Evt_1DWmupi_nu");
+  RegisterSample<ANL_NC1npip_Evt_1Dppi_nu>(factories,
+                                           "ANL_NC1npip_Evt_1Dppi_nu");
+  RegisterSample<ANL_NC1ppim_XSec_1DEnu_nu>(factories,
+                                            "ANL_NC1ppim_XSec_1DEnu_nu");
+  RegisterSample<ANL_NC1ppim_Evt_1DcosmuStar_nu>(
+      factories, "ANL_NC1ppim_Evt_1DcosmuStar_nu");
+  RegisterSample<ANL_CC2pi_1pim1pip_XSec_1DEnu_nu>(
+      factories, "ANL_CC2pi_1pim1pip_XSec_1DEnu_nu");
+  RegisterSample<ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu>(
+      factories, "ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu");
+  RegisterSample<ANL_CC2pi_1pim1pip_Evt_1Dppip_nu>(
+      factories, "ANL_CC2pi_1pim1pip_Evt_1Dppip_nu");
+  RegisterSample<ANL_CC2pi_1pim1pip_Evt_1Dppim_nu>(
+      factories, "ANL_CC2pi_1pim1pip_Evt_1Dppim_nu");
+  RegisterSample<ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu>(
+      factories, "ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu");
+  RegisterSample<ANL_CC2pi_1pip1pip_XSec_1DEnu_nu>(
+      factories, "ANL_CC2pi_1pip1pip_XSec_1DEnu_nu");
+  RegisterSample<ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu>(
+      factories, "ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu");
+  RegisterSample<ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu>(
+      factories, "ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu");
+  RegisterSample<ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu>(
+      factories, "ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu");
+  RegisterSample<ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu>(
+      factories, "ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu");
+  RegisterSample<ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu>(
+      factories, "ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu");
+  RegisterSample<ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu>(
+      factories, "ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu");
+  RegisterSample<ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu>(
+      factories, "ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu");
+  RegisterSample<ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu>(
+      factories, "ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu");
+  RegisterSample<ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu>(
+      factories, "ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu");
+}
@@ -0,0 +1,62 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// ArgoNeuT CC1Pi
+#include "ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu.h"
+#include "ArgoNeuT_CC1Pi_XSec_1Dpmu_nu.h"
+#include "ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu.h"
+#include "ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu.h"
+#include "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu.h"
+#include "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu.h"
+#include "ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu.h"
+#include "ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu.h"
+// ArgoNeuT CC-inclusive
+#include "ArgoNeuT_CCInc_XSec_1Dpmu_antinu.h"
+#include "ArgoNeuT_CCInc_XSec_1Dpmu_nu.h"
+#include "ArgoNeuT_CCInc_XSec_1Dthetamu_antinu.h"
+#include "ArgoNeuT_CCInc_XSec_1Dthetamu_nu.h"
+
+void SampleUtils::RegisterArgoNeuTSamples(SampleFactoryMap &factories) {
+  RegisterSample<ArgoNeuT_CCInc_XSec_1Dpmu_antinu>(
+      factories, "ArgoNeuT_CCInc_XSec_1Dpmu_antinu");
+  RegisterSample<ArgoNeuT_CCInc_XSec_1Dpmu_nu>(factories,
+                                               "ArgoNeuT_CCInc_XSec_1Dpmu_nu");
+  RegisterSample<ArgoNeuT_CCInc_XSec_1Dthetamu_antinu>(
+      factories, "ArgoNeuT_CCInc_XSec_1Dthetamu_antinu");
+  RegisterSample<ArgoNeuT_CCInc_XSec_1Dthetamu_nu>(
+      factories, "ArgoNeuT_CCInc_XSec_1Dthetamu_nu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dpmu_nu>(factories,
+                                               "ArgoNeuT_CC1Pi_XSec_1Dpmu_nu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu>(
+      factories, "ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu>(
+      factories, "ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu>(
+      factories, "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu>(
+      factories, "ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu>(
+      factories, "ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu>(
+      factories, "ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu");
+  RegisterSample<ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu>(
+      factories, "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu");
+}
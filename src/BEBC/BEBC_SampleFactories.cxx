@@ -0,0 +1,62 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// BEBC CCQE
+#include "BEBC_CCQE_XSec_1DQ2_nu.h"
+// BEBC CC1ppip
+#include "BEBC_CC1ppip_XSec_1DEnu_nu.h"
+#include "BEBC_CC1ppip_XSec_1DQ2_nu.h"
+// BEBC CC1npip
+#include "BEBC_CC1npip_XSec_1DEnu_nu.h"
+#include "BEBC_CC1npip_XSec_1DQ2_nu.h"
+// BEBC CC1pi0
+#include "BEBC_CC1pi0_XSec_1DEnu_nu.h"
+#include "BEBC_CC1pi0_XSec_1DQ2_nu.h"
+// BEBC CC1npim
+#include "BEBC_CC1npim_XSec_1DEnu_antinu.h"
+#include "BEBC_CC1npim_XSec_1DQ2_antinu.h"
+// BEBC CC1ppim
+#include "BEBC_CC1ppim_XSec_1DEnu_antinu.h"
+#include "BEBC_CC1ppim_XSec_1DQ2_antinu.h"
+
+void SampleUtils::RegisterBEBCSamples(SampleFactoryMap &factories) {
+  RegisterSample<BEBC_CCQE_XSec_1DQ2_nu>(factories, "BEBC_CCQE_XSec_1DQ2_nu");
+  RegisterSample<BEBC_CC1ppip_XSec_1DEnu_nu>(factories,
+                                             "BEBC_CC1ppip_XSec_1DEnu_nu");
+  RegisterSample<BEBC_CC1ppip_XSec_1DQ2_nu>(factories,
+                                            "BEBC_CC1ppip_XSec_1DQ2_nu");
+  RegisterSample<BEBC_CC1npip_XSec_1DEnu_nu>(factories,
+                                             "BEBC_CC1npip_XSec_1DEnu_nu");
+  RegisterSample<BEBC_CC1npip_XSec_1DQ2_nu>(factories,
+                                            "BEBC_CC1npip_XSec_1DQ2_nu");
+  RegisterSample<BEBC_CC1pi0_XSec_1DEnu_nu>(factories,
+                                            "BEBC_CC1pi0_XSec_1DEnu_nu");
+  RegisterSample<BEBC_CC1pi0_XSec_1DQ2_nu>(factories,
+                                           "BEBC_CC1pi0_XSec_1DQ2_nu");
+  RegisterSample<BEBC_CC1npim_XSec_1DEnu_antinu>(
+      factories, "BEBC_CC1npim_XSec_1DEnu_antinu");
+  RegisterSample<BEBC_CC1npim_XSec_1DQ2_antinu>(
+      factories, "BEBC_CC1npim_XSec_1DQ2_antinu");
+  RegisterSample<BEBC_CC1ppim_XSec_1DEnu_antinu>(
+      factories, "BEBC_CC1ppim_XSec_1DEnu_antinu");
+  RegisterSample<BEBC_CC1ppim_XSec_1DQ2_antinu>(
+      factories, "BEBC_CC1ppim_XSec_1DQ2_antinu");
+}
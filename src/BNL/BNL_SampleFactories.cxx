@@ -0,0 +1,106 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// BNL CCQE
+#include "BNL_CCQE_Evt_1DQ2_nu.h"
+#include "BNL_CCQE_XSec_1DEnu_nu.h"
+// BNL CC1ppip
+#include "BNL_CC1ppip_Evt_1DQ2_nu.h"
+#include "BNL_CC1ppip_Evt_1DWNmu_nu.h"
+#include "BNL_CC1ppip_Evt_1DWNpi_nu.h"
+#include "BNL_CC1ppip_Evt_1DWmupi_nu.h"
+#include "BNL_CC1ppip_Evt_1DcosthAdler_nu.h"
+#include "BNL_CC1ppip_Evt_1Dphi_nu.h"
+#include "BNL_CC1ppip_XSec_1DEnu_nu.h"
+// BNL CC1npip
+#include "BNL_CC1npip_Evt_1DQ2_nu.h"
+#include "BNL_CC1npip_Evt_1DWNmu_nu.h"
+#include "BNL_CC1npip_Evt_1DWNpi_nu.h"
+#include "BNL_CC1npip_Evt_1DWmupi_nu.h"
+#include "BNL_CC1npip_XSec_1DEnu_nu.h"
+// BNL CC1pi0
+#include "BNL_CC1pi0_Evt_1DQ2_nu.h"
+#include "BNL_CC1pi0_Evt_1DWNmu_nu.h"
+#include "BNL_CC1pi0_Evt_1DWNpi_nu.h"
+#include "BNL_CC1pi0_Evt_1DWmupi_nu.h"
+#include "BNL_CC1pi0_XSec_1DEnu_nu.h"
+// BNL multipi
+#include "BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu.h"
+#include "BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu.h"
+#include "BNL_CC2pi_1pim1pip_XSec_1DEnu_nu.h"
+#include "BNL_CC3pi_1pim2pip_XSec_1DEnu_nu.h"
+#include "BNL_CC4pi_2pim2pip_XSec_1DEnu_nu.h"
+
+void SampleUtils::RegisterBNLSamples(SampleFactoryMap &factories) {
+  RegisterSample<BNL_CCQE_XSec_1DEnu_nu>(factories, "BNL_CCQE_XSec_1DEnu_nu");
+  RegisterSample<BNL_CCQE_Evt_1DQ2_nu>(factories, "BNL_CCQE_Evt_1DQ2_nu");
+  RegisterSample<BNL_CC1ppip_XSec_1DEnu_nu>(factories,
+                                            "BNL_CC1ppip_XSec_1DEnu_nu");
+  RegisterSample<BNL_CC1ppip_XSec_1DEnu_nu>(factories,
+                                            "BNL_CC1ppip_XSec_1DEnu_nu_Uncorr");
+  RegisterSample<BNL_CC1ppip_XSec_1DEnu_nu>(factories,
+                                            "BNL_CC1ppip_XSec_1DEnu_nu_W14Cut");
+  RegisterSample<BNL_CC1ppip_XSec_1DEnu_nu>(
+      factories, "BNL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr");
+  RegisterSample<BNL_CC1ppip_Evt_1DQ2_nu>(factories, "BNL_CC1ppip_Evt_1DQ2_nu");
+  RegisterSample<BNL_CC1ppip_Evt_1DQ2_nu>(factories,
+                                          "BNL_CC1ppip_Evt_1DQ2_nu_W14Cut");
+  RegisterSample<BNL_CC1ppip_Evt_1DcosthAdler_nu>(
+      factories, "BNL_CC1ppip_Evt_1DcosthAdler_nu");
+  RegisterSample<BNL_CC1ppip_Evt_1Dphi_nu>(factories,
+                                           "BNL_CC1ppip_Evt_1Dphi_nu");
+  RegisterSample<BNL_CC1ppip_Evt_1DWNpi_nu>(factories,
+                                            "BNL_CC1ppip_Evt_1DWNpi_nu");
+  RegisterSample<BNL_CC1ppip_Evt_1DWNmu_nu>(factories,
+                                            "BNL_CC1ppip_Evt_1DWNmu_nu");
+  RegisterSample<BNL_CC1ppip_Evt_1DWmupi_nu>(factories,
+                                             "BNL_CC1ppip_Evt_1DWmupi_nu");
+  RegisterSample<BNL_CC1npip_XSec_1DEnu_nu>(factories,
+                                            "BNL_CC1npip_XSec_1DEnu_nu");
+  RegisterSample<BNL_CC1npip_XSec_1DEnu_nu>(factories,
+                                            "BNL_CC1npip_XSec_1DEnu_nu_Uncorr");
+  RegisterSample<BNL_CC1npip_Evt_1DQ2_nu>(factories, "BNL_CC1npip_Evt_1DQ2_nu");
+  RegisterSample<BNL_CC1npip_Evt_1DWNpi_nu>(factories,
+                                            "BNL_CC1npip_Evt_1DWNpi_nu");
+  RegisterSample<BNL_CC1npip_Evt_1DWNmu_nu>(factories,
+                                            "BNL_CC1npip_Evt_1DWNmu_nu");
+  RegisterSample<BNL_CC1npip_Evt_1DWmupi_nu>(factories,
+                                             "BNL_CC1npip_Evt_1DWmupi_nu");
+  RegisterSample<BNL_CC1pi0_XSec_1DEnu_nu>(factories,
+                                           "BNL_CC1pi0_XSec_1DEnu_nu");
+  RegisterSample<BNL_CC1pi0_Evt_1DQ2_nu>(factories, "BNL_CC1pi0_Evt_1DQ2_nu");
+  RegisterSample<BNL_CC1pi0_Evt_1DWNpi_nu>(factories,
+                                           "BNL_CC1pi0_Evt_1DWNpi_nu");
+  RegisterSample<BNL_CC1pi0_Evt_1DWNmu_nu>(factories,
+                                           "BNL_CC1pi0_Evt_1DWNmu_nu");
+  RegisterSample<BNL_CC1pi0_Evt_1DWmupi_nu>(factories,
+                                            "BNL_CC1pi0_Evt_1DWmupi_nu");
+  RegisterSample<BNL_CC2pi_1pim1pip_XSec_1DEnu_nu>(
+      factories, "BNL_CC2pi_1pim1pip_XSec_1DEnu_nu");
+  RegisterSample<BNL_CC3pi_1pim2pip_XSec_1DEnu_nu>(
+      factories, "BNL_CC3pi_1pim2pip_XSec_1DEnu_nu");
+  RegisterSample<BNL_CC4pi_2pim2pip_XSec_1DEnu_nu>(
+      factories, "BNL_CC4pi_2pim2pip_XSec_1DEnu_nu");
+  RegisterSample<BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu>(
+      factories, "BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu");
+  RegisterSample<BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu>(
+      factories, "BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu");
+}
@@ -103,6 +103,7 @@ public:
   void SpecifcSetup(nuiskey &nk) {
     rand.~TRandom3();
     new (&rand) TRandom3();
+    SetRandom(&rand);
 
     InstanceName = nk.GetS("name");
     DefaultAccRatio = nk.GetD("DefaultAccRatio");
@@ -167,7 +168,7 @@ public:
   }
 
   RecoInfo *Smearcept(FitEvent *fe) {
-    RecoInfo *ri = new RecoInfo();
+    RecoInfo *ri = GetRecoInfoBuffer();
 
     for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
       FitParticle *fp = fe->GetParticle(p_it);
@@ -203,7 +204,7 @@ public:
 
       double acc_ratio = eff.GetAccRatio(p, cost, phi, DefaultAccRatio);
 
-      bool accepted = (rand.Uniform() < acc_ratio);
+      bool accepted = (GetRandom()->Uniform() < acc_ratio);
       if (accepted) {
 #ifdef DEBUG_CLASACCEPT
         std::cout << "(" << p << ", " << cost << ", " << phi << ")."
@@ -0,0 +1,254 @@
+#include "IterationWriter.h"
+
+#include "FitLogger.h"
+
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <set>
+
+namespace {
+std::mutex gWritersMutex;
+std::set<IterationWriter *> gWriters;
+std::once_flag gAtForkOnce;
+std::atomic<int> gSpillCount(0);
+} // namespace
+
+//***************************************************
+IterationWriter::IterationWriter(std::string const &name,
+                                 std::vector<std::string> const &columns,
+                                 size_t capacity)
+    : fName(name), fNCols(columns.size()), fCapacity(capacity ? capacity : 1),
+      fOwner(getpid()), fRing(fCapacity * (fNCols + 1)), fHead(0), fTail(0),
+      fStop(false), fFile(NULL), fTree(NULL), fIteration(0), fRow(fNCols) {
+  //***************************************************
+
+  // The tree is filled on another thread
+  ROOT::EnableThreadSafety();
+  std::call_once(gAtForkOnce, []() {
+    pthread_atfork(&IterationWriter::PrepareFork, &IterationWriter::AfterFork,
+                   &IterationWriter::AfterFork);
+  });
+
+  fSpillFile = Form("%s/nuisiterations_%i_%i.root", gSystem->TempDirectory(),
+                    int(fOwner), int(gSpillCount++));
+
+  TDirectory::TContext context(NULL);
+  fFile = new TFile(fSpillFile.c_str(), "RECREATE");
+  if (!fFile || fFile->IsZombie()) {
+    NUIS_ERR(WRN, "Couldn't open " << fSpillFile << " for the " << fName
+                                   << " rows, keeping them in memory.");
+    delete fFile;
+    fFile = NULL;
+    return;
+  }
+
+  fTree = new TTree(fName.c_str(), fName.c_str());
+  fTree->SetDirectory(fFile);
+  fTree->Branch("iteration", &fIteration, "Iteration/I");
+  for (size_t i = 0; i < fNCols; i++) {
+    fTree->Branch(columns[i].c_str(), &fRow[i], (columns[i] + "/D").c_str());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(gWritersMutex);
+    gWriters.insert(this);
+  }
+  fThread = std::thread(&IterationWriter::Run, this);
+}
+
+//***************************************************
+IterationWriter::~IterationWriter() {
+  //***************************************************
+
+  if (!fTree) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(gWritersMutex);
+    gWriters.erase(this);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(fWakeMutex);
+    fStop = true;
+  }
+  fWake.notify_one();
+  fThread.join();
+
+  fFile->Close();
+  delete fFile;
+  gSystem->Unlink(fSpillFile.c_str());
+}
+
+//***************************************************
+bool IterationWriter::IsOwner() const {
+  //***************************************************
+  return getpid() == fOwner;
+}
+
+//***************************************************
+void IterationWriter::Push(int iteration, std::vector<double> const &vals) {
+  //***************************************************
+
+  if (!fTree || !IsOwner()) {
+    return;
+  }
+
+  // Only this thread moves the head, so it can't change under us
+  size_t head = fHead.load(std::memory_order_relaxed);
+  if (head - fTail.load(std::memory_order_acquire) >= fCapacity) {
+    std::unique_lock<std::mutex> lock(fWakeMutex);
+    fSpace.wait(lock, [&]() {
+      return head - fTail.load(std::memory_order_acquire) < fCapacity;
+    });
+  }
+
+  double *row = &fRing[(head % fCapacity) * (fNCols + 1)];
+  row[0] = iteration;
+  std::copy(vals.begin(), vals.begin() + std::min(vals.size(), fNCols),
+            row + 1);
+
+  {
+    std::lock_guard<std::mutex> lock(fWakeMutex);
+    fHead.store(head + 1, std::memory_order_release);
+  }
+  fWake.notify_one();
+}
+
+//***************************************************
+void IterationWriter::Drain() {
+  //***************************************************
+
+  if (!fTree || !IsOwner()) {
+    return;
+  }
+
+  size_t head = fHead.load(std::memory_order_relaxed);
+  std::unique_lock<std::mutex> lock(fWakeMutex);
+  fSpace.wait(lock, [&]() {
+    return fTail.load(std::memory_order_acquire) == head;
+  });
+}
+
+//***************************************************
+void IterationWriter::ReadAll(std::vector<int> &counts,
+                              std::vector<std::vector<double> > &vals) {
+  //***************************************************
+
+  counts.clear();
+  vals.clear();
+  if (!fTree || !IsOwner()) {
+    return;
+  }
+
+  Drain();
+  std::lock_guard<std::mutex> lock(fTreeMutex);
+  Long64_t nentries = fTree->GetEntries();
+  counts.reserve(nentries);
+  vals.reserve(nentries);
+  for (Long64_t i = 0; i < nentries; i++) {
+    fTree->GetEntry(i);
+    counts.push_back(fIteration);
+    vals.push_back(fRow);
+  }
+}
+
+//***************************************************
+void IterationWriter::Reset() {
+  //***************************************************
+
+  if (!fTree || !IsOwner()) {
+    return;
+  }
+
+  Drain();
+  std::lock_guard<std::mutex> lock(fTreeMutex);
+  fTree->Reset();
+}
+
+//***************************************************
+void IterationWriter::Write(TDirectory *dir) {
+  //***************************************************
+
+  if (!fTree || !IsOwner()) {
+    return;
+  }
+
+  Drain();
+  std::lock_guard<std::mutex> lock(fTreeMutex);
+  fTree->FlushBaskets();
+
+  // Copies the spilled baskets without unpacking them
+  TDirectory::TContext context(dir);
+  TTree *itree = fTree->CloneTree(-1, "fast");
+  itree->Write();
+  delete itree;
+}
+
+//***************************************************
+void IterationWriter::Run() {
+  //***************************************************
+
+  TDirectory::TContext context(NULL);
+  while (true) {
+    size_t tail = fTail.load(std::memory_order_relaxed);
+    size_t head = fHead.load(std::memory_order_acquire);
+
+    if (tail == head) {
+      if (fStop) {
+        break;
+      }
+      std::unique_lock<std::mutex> wait(fWakeMutex);
+      fWake.wait(wait, [&]() {
+        return fStop || fHead.load(std::memory_order_acquire) != tail;
+      });
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(fTreeMutex);
+      for (; tail != head; tail++) {
+        double const *row = &fRing[(tail % fCapacity) * (fNCols + 1)];
+        fIteration = int(row[0]);
+        std::copy(row + 1, row + 1 + fNCols, fRow.begin());
+        fTree->Fill();
+      }
+    }
+
+    // Free the whole batch at once, Push and Drain wait on this
+    {
+      std::lock_guard<std::mutex> wait(fWakeMutex);
+      fTail.store(tail, std::memory_order_release);
+    }
+    fSpace.notify_all();
+  }
+}
+
+//***************************************************
+void IterationWriter::PrepareFork() {
+  //***************************************************
+
+  // Don't let a fork land while a writer thread is inside ROOT
+  gWritersMutex.lock();
+  for (std::set<IterationWriter *>::iterator it = gWriters.begin();
+       it != gWriters.end(); ++it) {
+    (*it)->fTreeMutex.lock();
+  }
+}
+
+//***************************************************
+void IterationWriter::AfterFork() {
+  //***************************************************
+
+  for (std::set<IterationWriter *>::iterator it = gWriters.begin();
+       it != gWriters.end(); ++it) {
+    (*it)->fTreeMutex.unlock();
+  }
+  gWritersMutex.unlock();
+}
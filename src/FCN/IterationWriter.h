@@ -0,0 +1,103 @@
+#ifndef _ITERATION_WRITER_H_
+#define _ITERATION_WRITER_H_
+
+/*!
+ *  \addtogroup FCN
+ *  @{
+ */
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TTree.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+
+//! Writes iteration tree rows from a background thread so DoEval only has to
+//! copy its values into a fixed size ring buffer. Rows are spilled to a
+//! temporary file as they are filled, so memory use doesn't grow with the
+//! length of the fit, and are copied into the output by Write.
+//!
+//! Only made when iteration_tree_buffer > 0, since it turns on ROOT's thread
+//! safety for the whole process.
+//!
+//! Push is only valid from the thread that created the writer. Rows pushed
+//! from a forked child are dropped, the routines that fork return their rows
+//! to the parent themselves.
+class IterationWriter {
+public:
+  //! name: tree name, columns: branch names after "iteration",
+  //! capacity: number of rows the ring buffer holds
+  IterationWriter(std::string const &name,
+                  std::vector<std::string> const &columns, size_t capacity);
+  ~IterationWriter();
+
+  //! False if the spill file couldn't be opened
+  bool IsValid() const { return fTree; }
+  //! False in a process forked after the writer was made
+  bool IsOwner() const;
+
+  //! Queue a row, blocks until the writer frees a slot if the ring is full
+  void Push(int iteration, std::vector<double> const &vals);
+
+  //! Wait until every queued row is in the tree
+  void Drain();
+
+  //! Every row so far, for checkpoints
+  void ReadAll(std::vector<int> &counts,
+               std::vector<std::vector<double> > &vals);
+
+  //! Remove every row
+  void Reset();
+
+  //! Copy the tree into dir
+  void Write(TDirectory *dir);
+
+private:
+  IterationWriter(IterationWriter const &);
+  IterationWriter &operator=(IterationWriter const &);
+
+  void Run();
+
+  //! pthread_atfork handlers for every live writer
+  static void PrepareFork();
+  static void AfterFork();
+
+  std::string fName;
+  std::string fSpillFile;
+  size_t fNCols;
+  size_t fCapacity;
+  pid_t fOwner;
+
+  //! capacity rows of (iteration, values...)
+  std::vector<double> fRing;
+  //! Rows pushed and rows filled, only ever increase
+  std::atomic<size_t> fHead;
+  std::atomic<size_t> fTail;
+  std::atomic<bool> fStop;
+
+  //! Guards changes to fHead, fTail and fStop for the waits below
+  std::mutex fWakeMutex;
+  //! Wakes the writer thread when a row is pushed or on stop
+  std::condition_variable fWake;
+  //! Wakes Push and Drain when the writer has freed rows
+  std::condition_variable fSpace;
+
+  //! Held while the tree is used, so it is never mid-fill at a fork
+  std::mutex fTreeMutex;
+  TFile *fFile;
+  TTree *fTree;
+  int fIteration;
+  std::vector<double> fRow;
+
+  std::thread fThread;
+};
+
+/*! @} */
+#endif
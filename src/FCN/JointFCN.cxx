@@ -1,6 +1,27 @@
 #include "JointFCN.h"
 #include "FitUtils.h"
+#include "ForkUtils.h"
+#include "IterationWriter.h"
+#include "SampleFactoryRegistry.h"
+
+#include "TDirectory.h"
+#include "TROOT.h"
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
 #include <stdio.h>
+#include <thread>
+
+namespace {
+/// Shared memory layout for sharded evaluation: fit mode, then the dial
+/// values, then a likelihood and NDOF per sample.
+const size_t kShardHeader = 1;
+} // namespace
 
 //***************************************************
 JointFCN::JointFCN(TFile *outfile) {
@@ -20,10 +41,20 @@ JointFCN::JointFCN(TFile *outfile) {
   fMCFilled = false;
 
   fIterationTree = false;
+  fIterationWriter = NULL;
   fDialVals = NULL;
   fNDials = 0;
 
   fUsingEventManager = FitPar::Config().GetParB("EventManager");
+  fCacheEngineWeights = false;
+  fEngineWeightsFilled = false;
+
+  fNShards = FitPar::Config().GetParI("FCNShards");
+  fFitMode = false;
+  fShardStale = false;
+  fShardOwner = 0;
+  fShardMem = NULL;
+  fShardMemSize = 0;
   fOutputDir->cd();
 }
 
@@ -43,10 +74,20 @@ JointFCN::JointFCN(std::vector<nuiskey> samplekeys, TFile *outfile) {
   fOutputDir->cd();
 
   fIterationTree = false;
+  fIterationWriter = NULL;
   fDialVals = NULL;
   fNDials = 0;
 
   fUsingEventManager = FitPar::Config().GetParB("EventManager");
+  fCacheEngineWeights = false;
+  fEngineWeightsFilled = false;
+
+  fNShards = FitPar::Config().GetParI("FCNShards");
+  fFitMode = false;
+  fShardStale = false;
+  fShardOwner = 0;
+  fShardMem = NULL;
+  fShardMemSize = 0;
   fOutputDir->cd();
 }
 
@@ -54,6 +95,8 @@ JointFCN::JointFCN(std::vector<nuiskey> samplekeys, TFile *outfile) {
 JointFCN::~JointFCN() {
   //***************************************************
 
+  StopShards();
+
   // Delete Samples
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
@@ -133,14 +176,83 @@ void JointFCN::CreateIterationTree(std::string name, FitWeight *rw) {
   fNDials = dials.size();
   fDialVals = new double[fNDials];
 
+  // Optionally send rows to a background writer so that long fits don't hold
+  // every iteration in memory
+  int buffer = FitPar::Config().GetParI("iteration_tree_buffer");
+  if (buffer > 0) {
+    fIterationWriter = new IterationWriter(name, fNameValues, buffer);
+    if (!fIterationWriter->IsValid()) {
+      delete fIterationWriter;
+      fIterationWriter = NULL;
+    }
+  }
+
   // Set IterationTree Flag
   fIterationTree = true;
 }
 
+//***************************************************
+void JointFCN::AppendIteration(std::vector<double> const &vals) {
+  //***************************************************
+  if (fIterationWriter) {
+    fIterationWriter->Push(fCurIter++, vals);
+    return;
+  }
+  fIterationCount.push_back(fCurIter++);
+  fIterationValues.push_back(vals);
+}
+
+//***************************************************
+void JointFCN::RestoreIterations(std::vector<int> const &counts,
+                                 std::vector<std::vector<double> > const &vals) {
+  //***************************************************
+  if (fIterationWriter) {
+    fIterationWriter->Reset();
+    for (size_t i = 0; i < counts.size(); i++) {
+      fIterationWriter->Push(counts[i], vals[i]);
+    }
+  } else {
+    fIterationCount = counts;
+    fIterationValues = vals;
+  }
+  if (!counts.empty() && UInt_t(counts.back() + 1) > fCurIter)
+    fCurIter = counts.back() + 1;
+}
+
+//***************************************************
+std::vector<int> const &JointFCN::GetIterationCounts() {
+  //***************************************************
+  if (fIterationWriter)
+    fIterationWriter->ReadAll(fIterationCount, fIterationValues);
+  return fIterationCount;
+}
+
+//***************************************************
+std::vector<std::vector<double> > const &JointFCN::GetIterationValues() {
+  //***************************************************
+  if (fIterationWriter)
+    fIterationWriter->ReadAll(fIterationCount, fIterationValues);
+  return fIterationValues;
+}
+
+//***************************************************
+void JointFCN::SetCacheEngineWeights(bool cache) {
+  //***************************************************
+  fCacheEngineWeights = cache;
+  fEngineWeightsFilled = false;
+  if (!cache)
+    std::vector<double>().swap(fEngineWeights);
+}
+
 //***************************************************
 void JointFCN::DestroyIterationTree() {
   //***************************************************
 
+  // A forked child can't stop its parent's writer thread, it just drops it
+  if (fIterationWriter && fIterationWriter->IsOwner())
+    delete fIterationWriter;
+  fIterationWriter = NULL;
+
   fIterationCount.clear();
   fCurrentValues.clear();
   fNameValues.clear();
@@ -152,6 +264,11 @@ void JointFCN::WriteIterationTree() {
   //***************************************************
   NUIS_LOG(FIT, "Writing iteration tree");
 
+  if (fIterationWriter) {
+    fIterationWriter->Write(gDirectory);
+    return;
+  }
+
   // Make a new TTree
   TTree *itree =
       new TTree(fIterationTreeName.c_str(), fIterationTreeName.c_str());
@@ -205,6 +322,17 @@ void JointFCN::FillIterationTree(FitWeight *rw) {
     fCurrentValues[count++] = double(fDialVals[i]);
   }
 
+  if (fIterationWriter) {
+    fIterationWriter->Push(fCurIter, fCurrentValues);
+
+    // Drop any copy made for a checkpoint
+    if (!fIterationValues.empty()) {
+      std::vector<int>().swap(fIterationCount);
+      std::vector<std::vector<double> >().swap(fIterationValues);
+    }
+    return;
+  }
+
   // Push Back Into Container
   fIterationCount.push_back(fCurIter);
   fIterationValues.push_back(fCurrentValues);
@@ -238,6 +366,38 @@ double JointFCN::DoEval(const double *x) {
     }
   }
 
+  // A forked copy of this FCN (e.g. a scan worker) can't share the shard
+  // workers with its parent, so it evaluates in process.
+  if (fShardWorkers.size() && fShardOwner != getpid()) {
+    StopShards();
+    fNShards = 1;
+  }
+
+  // SHARDED EVALUATION
+  if (fNShards > 1 && (fShardWorkers.size() || StartShards()) &&
+      EvaluateShards(par_vals)) {
+    // Pulls and the iteration tree read the dials from here
+    FitBase::GetRW()->UpdateWeightEngine(par_vals);
+    for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end();
+         iter++) {
+      (*iter)->Reconfigure();
+    }
+    fMCFilled = true;
+    fCurIter++;
+
+    fLikelihood = GetLikelihood();
+    fNDOF = GetNDOF();
+
+    NUIS_LOG(FIT,
+             "Current Stat (iter. " << this->fCurIter << ") = " << fLikelihood);
+
+    if (fIterationTree)
+      FillIterationTree(FitBase::GetRW());
+
+    delete[] par_vals;
+    return fLikelihood;
+  }
+
   // WEIGHT ENGINE
   fDialChanged = FitBase::GetRW()->HasRWDialChanged(par_vals);
   FitBase::GetRW()->UpdateWeightEngine(par_vals);
@@ -280,7 +440,7 @@ int JointFCN::GetNDOF() {
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
     MeasurementBase *exp = *iter;
-    int dof = exp->GetNDOF();
+    int dof = fShardStale ? fShardNDOF[count] : exp->GetNDOF();
 
     // Save Separate DOF
     if (fIterationTree) {
@@ -328,8 +488,15 @@ double JointFCN::GetLikelihood() {
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
     MeasurementBase *exp = *iter;
-    double newlike = exp->GetLikelihood();
-    int ndof = exp->GetNDOF();
+    double newlike;
+    if (fShardStale) {
+      newlike = fShardLikes[count];
+    } else {
+      ProfileUtils::ScopedTimer timer(
+          exp->GetProfileStage(MeasurementBase::kProfLikelihood));
+      newlike = exp->GetLikelihood();
+    }
+    int ndof = fShardStale ? fShardNDOF[count] : exp->GetNDOF();
     // Save separate likelihoods
     if (fIterationTree) {
       fSampleLikes[count] = newlike;
@@ -372,6 +539,13 @@ double JointFCN::GetLikelihood() {
 
 void JointFCN::LoadSamples(std::vector<nuiskey> samplekeys) {
   NUIS_LOG(MIN, "Loading Samples : " << samplekeys.size());
+
+  int nthreads = FitPar::Config().GetParI("SampleLoadThreads");
+  if (nthreads > 1 && samplekeys.size() > 1) {
+    LoadSamplesParallel(samplekeys, nthreads);
+    return;
+  }
+
   for (size_t i = 0; i < samplekeys.size(); i++) {
     nuiskey key = samplekeys[i];
 
@@ -396,6 +570,70 @@ void JointFCN::LoadSamples(std::vector<nuiskey> samplekeys) {
   }
 }
 
+//***************************************************
+void JointFCN::LoadSamplesParallel(std::vector<nuiskey> samplekeys,
+                                   int nthreads) {
+  //***************************************************
+
+  // Make any lazily built singletons before workers can race to build them.
+  ROOT::EnableThreadSafety();
+  DynamicSampleFactory::Get();
+  SampleUtils::GetSampleFactories();
+  FitBase::GetRW();
+
+  std::vector<MeasurementBase *> loaded(samplekeys.size(), NULL);
+  std::vector<size_t> parallelsamples;
+
+  // Samples that edit the global config, or come from plugins, are built
+  // here on the main thread before any worker starts.
+  for (size_t i = 0; i < samplekeys.size(); i++) {
+    if (SampleUtils::CanCreateInParallel(samplekeys[i])) {
+      parallelsamples.push_back(i);
+      continue;
+    }
+    NUIS_LOG(MIN, "Loading Sample : " << samplekeys[i].GetS("name"));
+    fOutputDir->cd();
+    loaded[i] = SampleUtils::CreateSample(samplekeys[i]);
+  }
+
+  nthreads = std::min(nthreads, int(parallelsamples.size()));
+  NUIS_LOG(MIN, "Loading " << parallelsamples.size() << " samples on "
+                           << nthreads << " threads.");
+
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nthreads; ++t) {
+    workers.push_back(std::thread([&]() {
+      // gDirectory is thread local once thread safety is enabled. Leave it
+      // unset so that sample histograms are not appended to a directory that
+      // other threads are also appending to. Samples write their own output.
+      // Generator input handlers are still built one at a time, see
+      // InputUtils::CreateInputHandler.
+      TDirectory::TContext context(NULL);
+      for (size_t j = next++; j < parallelsamples.size(); j = next++) {
+        nuiskey key = samplekeys[parallelsamples[j]];
+        NUIS_LOG(MIN, "Loading Sample : " << key.GetS("name"));
+        loaded[parallelsamples[j]] = SampleUtils::CreateSample(key);
+      }
+    }));
+  }
+  for (size_t t = 0; t < workers.size(); ++t) {
+    workers[t].join();
+  }
+  fOutputDir->cd();
+
+  // Keep the card order regardless of which thread finished first
+  for (size_t i = 0; i < samplekeys.size(); i++) {
+    if (!loaded[i]) {
+      NUIS_ERR(FTL, "Could not load sample provided: "
+                        << samplekeys[i].GetS("name"));
+      NUIS_ERR(FTL, "Check spelling with that in src/FCN/SampleList.cxx");
+      throw;
+    }
+    fSamples.push_back(loaded[i]);
+  }
+}
+
 //***************************************************
 void JointFCN::LoadPulls(std::vector<nuiskey> pullkeys) {
   //***************************************************
@@ -416,8 +654,18 @@ void JointFCN::ReconfigureSamples(bool fullconfig) {
   //***************************************************
 
   int starttime = time(NULL);
+  ProfileUtils::ScopedTimer timer(
+      ProfileUtils::GetStage("fcn/ReconfigureSamples"));
   NUIS_LOG(REC, "------------");
   NUIS_LOG(REC, "Starting Reconfigure iter. " << this->fCurIter);
+
+  // Sharded evaluations only updated the workers' copies of the samples
+  if (fShardStale) {
+    fShardStale = false;
+    FitBase::GetRW()->Reconfigure();
+    FitBase::EvtManager().ResetWeightFlags();
+    fullconfig = true;
+  }
   // std::cout << fUsingEventManager << " " << fullconfig << " " << fMCFilled
   // << std::endl; Event Manager Reconf
   if (fUsingEventManager) {
@@ -519,6 +767,9 @@ void JointFCN::ReconfigureUsingManager() {
 
   // 'Slow' Event Manager Reconfigure
   NUIS_LOG(REC, "Event Manager Reconfigure");
+
+  // Signal events may change, so cached engine weights are stale
+  fEngineWeightsFilled = false;
   // int timestart = time(NULL);
 
   // Reset all samples
@@ -572,9 +823,10 @@ void JointFCN::ReconfigureUsingManager() {
   for (; inp_iter != fInputList.end(); inp_iter++) {
     InputHandlerBase *curinput = (*inp_iter);
 
+    // Set up the cache before any read-ahead thread starts reading
+    curinput->CreateCache();
     // Get event information
     FitEvent *curevent = curinput->FirstNuisanceEvent();
-    curinput->CreateCache();
 
     int i = 0;
     int nevents = curinput->GetNEvents();
@@ -636,7 +888,14 @@ void JointFCN::ReconfigureUsingManager() {
         // Fill events for matching inputs.
         MeasurementVariableBox *box = curmeas->FillVariableBox(curevent);
 
-        bool signal = curmeas->isSignal(curevent);
+        ProfileUtils::Stage *signalstage =
+            curmeas->GetProfileStage(MeasurementBase::kProfSignal);
+        bool signal;
+        {
+          ProfileUtils::ScopedTimer timer(signalstage);
+          signal = curmeas->isSignal(curevent);
+        }
+        ProfileUtils::CountSignal(signalstage, signal);
         curmeas->SetSignal(signal);
         curmeas->FillHistograms(curevent->Weight);
 
@@ -719,6 +978,8 @@ void JointFCN::ReconfigureUsingManager() {
   iterSam = fSamples.begin();
   for (; iterSam != fSamples.end(); iterSam++) {
     MeasurementBase *exp = (*iterSam);
+    ProfileUtils::ScopedTimer timer(
+        exp->GetProfileStage(MeasurementBase::kProfConvertEventRates));
     exp->ConvertEventRates();
   }
 
@@ -819,6 +1080,18 @@ void JointFCN::ReconfigureFastUsingManager() {
     }
   }
 
+  // Per engine weights of each signal event from the last fast reconfigure,
+  // so engines whose dials haven't moved since then aren't recalculated.
+  size_t nengines = FitBase::GetRW()->GetNEngines();
+  bool enginecachevalid = false;
+  if (fCacheEngineWeights) {
+    size_t cachesize = fSignalEventBoxes.size() * nengines;
+    enginecachevalid = fEngineWeightsFilled and
+                       (fEngineWeights.size() == cachesize);
+    if (fEngineWeights.size() != cachesize)
+      fEngineWeights.resize(cachesize);
+  }
+
   // Loop over all possible spline inputs
   double *coreeventweights = new double[fSignalEventBoxes.size()];
   splinecount = 0;
@@ -847,7 +1120,7 @@ void JointFCN::ReconfigureFastUsingManager() {
         // Get Event Info
         if (!fIsAllSplines) {
           if (fFillNuisanceEvent) {
-            curevent = curinput->GetNuisanceEvent(i);
+            curevent = curinput->ReadNuisanceEvent(i);
           } else {
             curevent = curinput->GetBaseEvent(i);
           }
@@ -855,7 +1128,13 @@ void JointFCN::ReconfigureFastUsingManager() {
           curevent->fSplineCoeff = &fSignalEventSplines[splinecount][0];
         }
 
-        curevent->RWWeight = FitBase::GetRW()->CalcWeight(curevent);
+        if (fCacheEngineWeights) {
+          curevent->RWWeight = FitBase::GetRW()->CalcWeightCached(
+              curevent, &fEngineWeights[splinecount * nengines],
+              enginecachevalid);
+        } else {
+          curevent->RWWeight = FitBase::GetRW()->CalcWeight(curevent);
+        }
         curevent->Weight =
             curevent->RWWeight * curevent->InputWeight * curevent->CustomWeight;
         rwweight = curevent->Weight;
@@ -878,6 +1157,11 @@ void JointFCN::ReconfigureFastUsingManager() {
 
   NUIS_LOG(SAM, "Processed event weights.");
 
+  if (fCacheEngineWeights) {
+    FitBase::GetRW()->ClearChangedEngines();
+    fEngineWeightsFilled = true;
+  }
+
   // #pragma omp barrier
 
   // Reset Iterators
@@ -935,6 +1219,8 @@ void JointFCN::ReconfigureFastUsingManager() {
   iterSam = fSamples.begin();
   for (; iterSam != fSamples.end(); iterSam++) {
     MeasurementBase *exp = (*iterSam);
+    ProfileUtils::ScopedTimer timer(
+        exp->GetProfileStage(MeasurementBase::kProfConvertEventRates));
     exp->ConvertEventRates();
   }
 
@@ -945,10 +1231,60 @@ void JointFCN::ReconfigureFastUsingManager() {
   NUIS_LOG(REC, "Filled " << fillcount << " signal events.");
 }
 
+//***************************************************
+void JointFCN::SetFitMode(bool fitmode) {
+  //***************************************************
+
+  fFitMode = fitmode;
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++) {
+    (*iter)->SetFitMode(fitmode);
+  }
+}
+
+//***************************************************
+bool JointFCN::HasStaleOutputs() {
+  //***************************************************
+
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++) {
+    if ((*iter)->HasStaleOutputs())
+      return true;
+  }
+  return false;
+}
+
 //***************************************************
 void JointFCN::Write() {
   //***************************************************
 
+  RefreshShardedSamples();
+
+  // Fit mode skipped the fine, mode and extra histograms. Do one full pass at
+  // the current dial values so the output matches a normal reconfigure.
+  if (HasStaleOutputs()) {
+    NUIS_LOG(MIN, "Regenerating output histograms skipped in fit mode...");
+    std::vector<bool> fitmodes;
+    for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+         iter++) {
+      fitmodes.push_back((*iter)->IsFitMode());
+      (*iter)->SetFitMode(false);
+    }
+
+    // Not a fit iteration, keep the iteration count as it was
+    int curiter = fCurIter;
+    TDirectory *curdir = gDirectory;
+    ReconfigureAllEvents();
+    curdir->cd();
+    fCurIter = curiter;
+
+    size_t i = 0;
+    for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+         iter++) {
+      (*iter)->SetFitMode(fitmodes[i++]);
+    }
+  }
+
   // Save a likelihood/ndof plot
   NUIS_LOG(MIN, "Writing likelihood plot...");
   std::vector<double> likes;
@@ -1021,6 +1357,10 @@ void JointFCN::Write() {
 void JointFCN::SetFakeData(std::string fakeinput) {
   //***************************************************
 
+  // Workers hold their own copy of the data, restart them after the change
+  RefreshShardedSamples();
+  StopShards();
+
   NUIS_LOG(MIN, "Setting fake data from " << fakeinput);
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
@@ -1035,6 +1375,10 @@ void JointFCN::SetFakeData(std::string fakeinput) {
 void JointFCN::ThrowDataToy() {
   //***************************************************
 
+  // Workers hold their own copy of the data, restart them after the change
+  RefreshShardedSamples();
+  StopShards();
+
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
     MeasurementBase *exp = *iter;
@@ -1078,6 +1422,8 @@ std::vector<std::string> JointFCN::GetAllNames() {
 std::vector<double> JointFCN::GetAllLikelihoods() {
   //***************************************************
 
+  RefreshShardedSamples();
+
   // Vect of all likelihoods and total
   std::vector<double> likevect;
   double total_likelihood = 0.0;
@@ -1122,6 +1468,8 @@ std::vector<double> JointFCN::GetAllLikelihoods() {
 std::vector<int> JointFCN::GetAllNDOF() {
   //***************************************************
 
+  RefreshShardedSamples();
+
   // Vect of all ndof and total
   std::vector<int> ndofvect;
   int total_ndof = 0;
@@ -1152,3 +1500,292 @@ std::vector<int> JointFCN::GetAllNDOF() {
 
   return ndofvect;
 }
+
+//***************************************************
+bool JointFCN::StartShards() {
+  //***************************************************
+
+  std::vector<MeasurementBase *> samples(fSamples.begin(), fSamples.end());
+  if (samples.size() < 2 || fNPars < 1) {
+    NUIS_ERR(WRN, "FCNShards=" << fNShards << " needs at least two samples, "
+                               << "evaluating in process.");
+    fNShards = 1;
+    return false;
+  }
+
+  // Samples reading the same input go to the same shard, so with the event
+  // manager each input is only looped over once. Groups are then balanced by
+  // event count.
+  std::vector<InputHandlerBase *> groupinputs;
+  std::vector<std::vector<size_t> > groups;
+  std::vector<double> groupcost;
+  for (size_t i = 0; i < samples.size(); i++) {
+    std::vector<MeasurementBase *> subsamples = samples[i]->GetSubSamples();
+    InputHandlerBase *input = NULL;
+    double cost = 0;
+    for (size_t j = 0; j < subsamples.size(); j++) {
+      InputHandlerBase *inp = subsamples[j]->GetInput();
+      if (!inp)
+        continue;
+      if (!input)
+        input = inp;
+      cost += inp->GetNEvents();
+    }
+
+    size_t g = std::find(groupinputs.begin(), groupinputs.end(), input) -
+               groupinputs.begin();
+    if (!input || g == groupinputs.size()) {
+      g = groups.size();
+      groupinputs.push_back(input);
+      groups.push_back(std::vector<size_t>());
+      groupcost.push_back(0);
+    }
+    groups[g].push_back(i);
+    groupcost[g] += cost;
+  }
+
+  int nshards = std::min(fNShards, int(groups.size()));
+  if (nshards < 2) {
+    NUIS_ERR(WRN, "All samples share one input, evaluating in process.");
+    fNShards = 1;
+    return false;
+  }
+
+  std::vector<size_t> order(groups.size());
+  for (size_t g = 0; g < order.size(); g++)
+    order[g] = g;
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return groupcost[a] > groupcost[b];
+  });
+
+  std::vector<ShardWorker> shards(nshards);
+  std::vector<double> shardcost(nshards, 0);
+  for (size_t o = 0; o < order.size(); o++) {
+    size_t s = std::min_element(shardcost.begin(), shardcost.end()) -
+               shardcost.begin();
+    shards[s].samples.insert(shards[s].samples.end(),
+                             groups[order[o]].begin(), groups[order[o]].end());
+    shardcost[s] += groupcost[order[o]];
+  }
+
+  fShardMemSize =
+      (kShardHeader + fNPars + 2 * samples.size()) * sizeof(double);
+  void *mem = mmap(NULL, fShardMemSize, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED) {
+    NUIS_ERR(WRN, "Could not map shared memory for FCN shards, evaluating "
+                  "in process.");
+    fNShards = 1;
+    return false;
+  }
+  fShardMem = (double *)mem;
+  fShardLikes.assign(samples.size(), 0.0);
+  fShardNDOF.assign(samples.size(), 0);
+
+  std::cout << std::flush;
+  std::cerr << std::flush;
+  fflush(stdout);
+  fflush(stderr);
+
+  // Workers reopen the inputs so they don't share file offsets
+  std::vector<ForkUtils::InputFile> inputfiles =
+      ForkUtils::SnapshotInputFiles();
+
+  fShardOwner = getpid();
+  for (int s = 0; s < nshards; s++) {
+    std::sort(shards[s].samples.begin(), shards[s].samples.end());
+
+    int socks[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socks) != 0) {
+      NUIS_ERR(WRN, "Could not create socket for FCN shard " << s);
+      StopShards();
+      fNShards = 1;
+      return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      NUIS_ERR(WRN, "Failed to fork FCN shard " << s);
+      close(socks[0]);
+      close(socks[1]);
+      StopShards();
+      fNShards = 1;
+      return false;
+    }
+
+    if (pid == 0) {
+      ForkUtils::ReopenInputFiles(inputfiles);
+      close(socks[0]);
+      // Only the coordinator may talk to the other shards
+      for (size_t o = 0; o < fShardWorkers.size(); o++) {
+        close(fShardWorkers[o].sock);
+      }
+      RunShardWorker(shards[s].samples, socks[1]);
+    }
+
+    close(socks[1]);
+    shards[s].pid = pid;
+    shards[s].sock = socks[0];
+    fShardWorkers.push_back(shards[s]);
+
+    std::ostringstream names;
+    for (size_t i = 0; i < shards[s].samples.size(); i++) {
+      names << (i ? ", " : "") << samples[shards[s].samples[i]]->GetName();
+    }
+    NUIS_LOG(FIT, "Started FCN shard " << s << " (pid " << pid
+                                       << ") with samples: " << names.str());
+  }
+
+  return true;
+}
+
+//***************************************************
+void JointFCN::RunShardWorker(std::vector<size_t> const &mine, int sock) {
+  //***************************************************
+
+  std::vector<MeasurementBase *> samples(fSamples.begin(), fSamples.end());
+  fShardWorkers.clear();
+
+  // Keep only this shard's samples, so the event manager loops over each of
+  // the shard's inputs once for all of the samples reading it. Any saved
+  // signal events belong to the full sample list.
+  fSamples.clear();
+  for (size_t i = 0; i < mine.size(); i++) {
+    fSamples.push_back(samples[mine[i]]);
+  }
+  fInputList.clear();
+  fSubSampleList.clear();
+  fSignalEventBoxes.clear();
+  fSignalEventFlags.clear();
+  fSampleSignalFlags.clear();
+  fSignalEventSplines.clear();
+
+  double *dials = fShardMem + kShardHeader;
+  double *results = dials + fNPars;
+
+  char cmd;
+  // A closed socket means the coordinator has gone away
+  while (read(sock, &cmd, 1) == 1 && cmd == 'e') {
+    char reply = 'd';
+    try {
+      bool fitmode = fShardMem[0];
+      if (fitmode != fFitMode)
+        SetFitMode(fitmode);
+
+      FitBase::GetRW()->UpdateWeightEngine(dials);
+      FitBase::GetRW()->Reconfigure();
+      FitBase::EvtManager().ResetWeightFlags();
+
+      if (fUsingEventManager) {
+        if (fMCFilled)
+          ReconfigureFastUsingManager();
+        else
+          ReconfigureUsingManager();
+      }
+
+      for (size_t i = 0; i < mine.size(); i++) {
+        MeasurementBase *exp = samples[mine[i]];
+        if (!fUsingEventManager) {
+          if (fMCFilled)
+            exp->ReconfigureFast();
+          else
+            exp->Reconfigure();
+        }
+
+        results[2 * mine[i]] = exp->GetLikelihood();
+        results[2 * mine[i] + 1] = exp->GetNDOF();
+      }
+      fMCFilled = true;
+    } catch (...) {
+      reply = 'x';
+    }
+
+    std::cout << std::flush;
+    std::cerr << std::flush;
+    if (send(sock, &reply, 1, MSG_NOSIGNAL) != 1)
+      break;
+  }
+
+  close(sock);
+  // Skip the coordinator's atexit/static teardown, it owns those resources
+  _exit(0);
+}
+
+//***************************************************
+bool JointFCN::EvaluateShards(const double *x) {
+  //***************************************************
+
+  fShardMem[0] = fFitMode;
+  std::copy(x, x + fNPars, fShardMem + kShardHeader);
+
+  bool failed = false;
+  char cmd = 'e';
+  for (size_t s = 0; s < fShardWorkers.size(); s++) {
+    if (send(fShardWorkers[s].sock, &cmd, 1, MSG_NOSIGNAL) != 1)
+      failed = true;
+  }
+  for (size_t s = 0; s < fShardWorkers.size(); s++) {
+    char reply = 0;
+    if (read(fShardWorkers[s].sock, &reply, 1) != 1 || reply != 'd') {
+      NUIS_ERR(WRN, "FCN shard " << s << " (pid " << fShardWorkers[s].pid
+                                 << ") failed.");
+      failed = true;
+    }
+  }
+
+  if (failed) {
+    NUIS_ERR(WRN, "Stopping FCN shards, evaluating in process from now on.");
+    StopShards();
+    fNShards = 1;
+    return false;
+  }
+
+  const double *results = fShardMem + kShardHeader + fNPars;
+  for (size_t i = 0; i < fShardLikes.size(); i++) {
+    fShardLikes[i] = results[2 * i];
+    fShardNDOF[i] = int(results[2 * i + 1]);
+  }
+  fShardStale = true;
+  return true;
+}
+
+//***************************************************
+void JointFCN::StopShards() {
+  //***************************************************
+
+  bool owner = (fShardOwner == getpid());
+  char cmd = 'q';
+  for (size_t s = 0; s < fShardWorkers.size(); s++) {
+    if (owner)
+      send(fShardWorkers[s].sock, &cmd, 1, MSG_NOSIGNAL);
+    close(fShardWorkers[s].sock);
+  }
+  if (owner) {
+    for (size_t s = 0; s < fShardWorkers.size(); s++) {
+      int status = 0;
+      waitpid(fShardWorkers[s].pid, &status, 0);
+    }
+  }
+  fShardWorkers.clear();
+
+  if (fShardMem) {
+    munmap(fShardMem, fShardMemSize);
+    fShardMem = NULL;
+    fShardMemSize = 0;
+  }
+}
+
+//***************************************************
+void JointFCN::RefreshShardedSamples() {
+  //***************************************************
+
+  if (!fShardStale)
+    return;
+
+  // Not a fit iteration, keep the iteration count as it was
+  int curiter = fCurIter;
+  TDirectory *curdir = gDirectory;
+  ReconfigureSamples(true);
+  curdir->cd();
+  fCurIter = curiter;
+}
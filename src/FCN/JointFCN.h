@@ -10,6 +10,8 @@
 #include <fstream>
 #include <list>
 
+#include <sys/types.h>
+
 // ROOT headers
 #include "TTree.h"
 #include "TH1D.h"
@@ -35,6 +37,8 @@
 #include "MeasurementVariableBox.h"
 #include "MeasurementVariableBox1D.h"
 
+class IterationWriter;
+
 using namespace FitUtils;
 using namespace FitBase;
 //! Main FCN Class which ROOT's joint function needs to evaulate the chi2 at each stage of the fit.
@@ -51,6 +55,8 @@ public:
 
   //! Create sample list from cardfile
   void LoadSamples(std::vector<nuiskey> samplekeys);
+  /// Build the samples on nthreads worker threads, see SampleLoadThreads.
+  void LoadSamplesParallel(std::vector<nuiskey> samplekeys, int nthreads);
   void LoadPulls(std::vector<nuiskey> pullkeys);
 
   //! Main Likelihood evaluation FCN
@@ -79,6 +85,28 @@ public:
   //! Deletes TTree
   void DestroyIterationTree();
 
+  //! Values filled into the iteration tree by the last DoEval
+  inline std::vector<double> const &GetCurrentIterationValues() {
+    return fCurrentValues;
+  };
+
+  //! Add an iteration evaluated elsewhere, e.g. by a forked scan worker
+  void AppendIteration(std::vector<double> const &vals);
+
+  //! Iterations kept for the iteration tree, for checkpoints
+  std::vector<int> const &GetIterationCounts();
+  std::vector<std::vector<double> > const &GetIterationValues();
+
+  //! Replace the kept iterations, e.g. from a checkpoint, and carry on
+  //! counting after the last of them
+  void RestoreIterations(std::vector<int> const &counts,
+                         std::vector<std::vector<double> > const &vals);
+
+  //! Keep each signal event's weight per RW engine between fast reconfigures
+  //! and only recalculate engines whose dials changed. Useful for scans where
+  //! one dial moves at a time.
+  void SetCacheEngineWeights(bool cache);
+
   //! Get Degrees of Freedom for samples (NBins)
   int GetNDOF();
 
@@ -108,6 +136,13 @@ public:
   //! Write all samples to output DIR
   void Write();
 
+  //! Only fill the histograms needed for the likelihood during reconfigures.
+  //! Output-only histograms are regenerated by a full pass inside Write.
+  void SetFitMode(bool fitmode);
+
+  //! True if any sample skipped output histograms on its last reconfigure
+  bool HasStaleOutputs();
+
   //! Set Fake data from file/MC
   void SetFakeData(std::string fakeinput);
 
@@ -139,8 +174,25 @@ public:
     fNPars = npar;
   }
 
+  //! Stop any sharded worker processes, see FCNShards. The next DoEval
+  //! starts them again from the current state of the samples.
+  void StopShards();
+
 private:
 
+  //! Fork the shard workers, each owning a subset of the samples
+  bool StartShards();
+
+  //! Broadcast the dials to the shard workers and collect their sample
+  //! likelihoods. Returns false if any worker failed.
+  bool EvaluateShards(const double *x);
+
+  //! Shard worker main loop over the given samples, never returns
+  void RunShardWorker(std::vector<size_t> const &samples, int sock);
+
+  //! Reconfigure the samples in this process after sharded evaluations
+  void RefreshShardedSamples();
+
   //! Append the experiments to include in the fit to this list
   std::list<MeasurementBase*> fSamples;
 
@@ -165,6 +217,10 @@ private:
 
   bool fUsingEventManager; //!< Flag for doing joint comparisons
 
+  bool fCacheEngineWeights;  //!< See SetCacheEngineWeights
+  bool fEngineWeightsFilled; //!< fEngineWeights match the current signal
+  std::vector<double> fEngineWeights; //!< NSignal x NEngines cached weights
+
   std::vector< std::vector<float> > fSignalEventSplines;
   std::vector< std::vector<MeasurementVariableBox*> > fSignalEventBoxes;
   std::vector< bool > fSignalEventFlags;
@@ -181,6 +237,9 @@ private:
   std::vector< std::vector<double> > fIterationValues;
   int fSampleN;
   std::string fIterationTreeName;
+  //! Background writer for the iteration tree, see iteration_tree_buffer.
+  //! If NULL the rows are kept in fIterationCount and fIterationValues.
+  IterationWriter *fIterationWriter;
 
 
   struct mirror_param {
@@ -190,6 +249,23 @@ private:
   std::map<int, mirror_param> fMirroredParams;
   //the number of pars added to the minimizer, should be the same as fNDials
   int fNPars;
+
+  //! A forked worker process owning some of the samples
+  struct ShardWorker {
+    pid_t pid;
+    int sock;
+    std::vector<size_t> samples;
+  };
+
+  int fNShards;        //!< Requested number of shards, from FCNShards
+  bool fFitMode;       //!< Last SetFitMode, passed on to shard workers
+  bool fShardStale;    //!< Samples here are behind the last sharded DoEval
+  pid_t fShardOwner;   //!< Process that started the shard workers
+  double *fShardMem;   //!< Shared fit mode, dial values and results
+  size_t fShardMemSize;
+  std::vector<ShardWorker> fShardWorkers;
+  std::vector<double> fShardLikes; //!< Per sample likelihoods from workers
+  std::vector<int> fShardNDOF;     //!< Per sample NDOF from workers
 };
 
 /*! @} */
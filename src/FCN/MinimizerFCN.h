@@ -5,6 +5,7 @@
 *  @{  
 */
 
+#include <functional>
 #include <iostream>
 #include <vector>
 #include "FitLogger.h"
@@ -57,7 +58,15 @@ class MinimizerFCN{
       NUIS_ABORT("Exiting!");
     }
     
-    return fFCN->DoEval(x);
+    double like = fFCN->DoEval(x);
+    if (fEvalHook) fEvalHook(x, like);
+    return like;
+  };
+
+  // Called after every evaluation with the point and its likelihood
+  inline void SetEvalHook(std::function<void(const double *, double)> hook)
+  {
+    fEvalHook = hook;
   };
 
   // Func Operator for vectors
@@ -76,6 +85,7 @@ class MinimizerFCN{
  private:
   
   JointFCN* fFCN;
+  std::function<void(const double *, double)> fEvalHook;
 };
 /*! @} */
 #endif // _MINIMIZER_FCN_H_
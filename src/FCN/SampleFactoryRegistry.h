@@ -0,0 +1,62 @@
+#ifndef _SAMPLE_FACTORY_REGISTRY_H_
+#define _SAMPLE_FACTORY_REGISTRY_H_
+
+/*!
+ *  \addtogroup FCN
+ *  @{
+ */
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+class nuiskey;
+class MeasurementBase;
+
+namespace SampleUtils {
+
+/// Builds one sample class from its sample key.
+struct SampleFactory {
+  MeasurementBase *(*Create)(nuiskey &);
+  /// False for samples that edit the global config while being built (e.g.
+  /// joint samples creating sub-sample keys). These are never built off the
+  /// main thread.
+  bool ParallelSafe;
+};
+
+typedef std::unordered_map<std::string, SampleFactory> SampleFactoryMap;
+
+template <typename T> MeasurementBase *ConstructSample(nuiskey &samplekey) {
+  return new T(samplekey);
+}
+
+/// Register sample class T under name. The first registration of a name wins.
+template <typename T>
+void RegisterSample(SampleFactoryMap &factories, char const *name,
+                    bool parallelsafe = true) {
+  SampleFactory factory = {&ConstructSample<T>, parallelsafe};
+  factories.insert(std::make_pair(std::string(name), factory));
+}
+
+/// Each experiment directory registers its samples in <EXP>_SampleFactories.cxx
+void RegisterANLSamples(SampleFactoryMap &factories);
+void RegisterArgoNeuTSamples(SampleFactoryMap &factories);
+void RegisterBNLSamples(SampleFactoryMap &factories);
+void RegisterFNALSamples(SampleFactoryMap &factories);
+void RegisterBEBCSamples(SampleFactoryMap &factories);
+void RegisterGGMSamples(SampleFactoryMap &factories);
+void RegisterMiniBooNESamples(SampleFactoryMap &factories);
+void RegisterMicroBooNESamples(SampleFactoryMap &factories);
+void RegisterMINERvASamples(SampleFactoryMap &factories);
+void RegisterT2KSamples(SampleFactoryMap &factories);
+void RegisterSciBooNESamples(SampleFactoryMap &factories);
+void RegisterK2KSamples(SampleFactoryMap &factories);
+
+/// All samples registered by the enabled experiments, built on first use.
+SampleFactoryMap const &GetSampleFactories();
+
+/// Returns NULL if name is not a registered sample.
+SampleFactory const *FindSampleFactory(std::string const &name);
+} // namespace SampleUtils
+
+/*! @} */
+#endif
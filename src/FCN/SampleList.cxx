@@ -1,367 +1,5 @@
 #include "SampleList.h"
-
-#ifdef ANL_ENABLED
-#include "ANL_CCQE_Evt_1DQ2_nu.h"
-#include "ANL_CCQE_XSec_1DEnu_nu.h"
-
-// ANL CC1ppip
-#include "ANL_CC1ppip_Evt_1DQ2_nu.h"
-#include "ANL_CC1ppip_Evt_1DWNmu_nu.h"
-#include "ANL_CC1ppip_Evt_1DWNpi_nu.h"
-#include "ANL_CC1ppip_Evt_1DWmupi_nu.h"
-#include "ANL_CC1ppip_Evt_1DcosmuStar_nu.h"
-#include "ANL_CC1ppip_Evt_1DcosthAdler_nu.h"
-#include "ANL_CC1ppip_Evt_1Dphi_nu.h"
-#include "ANL_CC1ppip_Evt_1Dppi_nu.h"
-#include "ANL_CC1ppip_Evt_1Dthpr_nu.h"
-#include "ANL_CC1ppip_XSec_1DEnu_nu.h"
-#include "ANL_CC1ppip_XSec_1DQ2_nu.h"
-// ANL CC1npip
-#include "ANL_CC1npip_Evt_1DQ2_nu.h"
-#include "ANL_CC1npip_Evt_1DWNmu_nu.h"
-#include "ANL_CC1npip_Evt_1DWNpi_nu.h"
-#include "ANL_CC1npip_Evt_1DWmupi_nu.h"
-#include "ANL_CC1npip_Evt_1DcosmuStar_nu.h"
-#include "ANL_CC1npip_Evt_1Dppi_nu.h"
-#include "ANL_CC1npip_XSec_1DEnu_nu.h"
-// ANL CC1pi0
-#include "ANL_CC1pi0_Evt_1DQ2_nu.h"
-#include "ANL_CC1pi0_Evt_1DWNmu_nu.h"
-#include "ANL_CC1pi0_Evt_1DWNpi_nu.h"
-#include "ANL_CC1pi0_Evt_1DWmupi_nu.h"
-#include "ANL_CC1pi0_Evt_1DcosmuStar_nu.h"
-#include "ANL_CC1pi0_XSec_1DEnu_nu.h"
-// ANL NC1npip (mm, exotic!)
-#include "ANL_NC1npip_Evt_1Dppi_nu.h"
-// ANL NC1ppim (mm, exotic!)
-#include "ANL_NC1ppim_Evt_1DcosmuStar_nu.h"
-#include "ANL_NC1ppim_XSec_1DEnu_nu.h"
-// ANL CC2pi 1pim1pip (mm, even more exotic!)
-#include "ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu.h"
-#include "ANL_CC2pi_1pim1pip_Evt_1Dppim_nu.h"
-#include "ANL_CC2pi_1pim1pip_Evt_1Dppip_nu.h"
-#include "ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu.h"
-#include "ANL_CC2pi_1pim1pip_XSec_1DEnu_nu.h"
-// ANL CC2pi 1pip1pip (mm, even more exotic!)
-#include "ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu.h"
-#include "ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu.h"
-#include "ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu.h"
-#include "ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu.h"
-#include "ANL_CC2pi_1pip1pip_XSec_1DEnu_nu.h"
-// ANL CC2pi 1pip1pi0 (mm, even more exotic!)
-#include "ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu.h"
-#include "ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu.h"
-#include "ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu.h"
-#include "ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu.h"
-#include "ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu.h"
-#endif
-
-#ifdef ArgoNeuT_ENABLED
-// ArgoNeuT CC1Pi
-#include "ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu.h"
-#include "ArgoNeuT_CC1Pi_XSec_1Dpmu_nu.h"
-#include "ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu.h"
-#include "ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu.h"
-#include "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu.h"
-#include "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu.h"
-#include "ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu.h"
-#include "ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu.h"
-// ArgoNeuT CC-inclusive
-#include "ArgoNeuT_CCInc_XSec_1Dpmu_antinu.h"
-#include "ArgoNeuT_CCInc_XSec_1Dpmu_nu.h"
-#include "ArgoNeuT_CCInc_XSec_1Dthetamu_antinu.h"
-#include "ArgoNeuT_CCInc_XSec_1Dthetamu_nu.h"
-#endif
-
-#ifdef BNL_ENABLED
-// BNL CCQE
-#include "BNL_CCQE_Evt_1DQ2_nu.h"
-#include "BNL_CCQE_XSec_1DEnu_nu.h"
-// BNL CC1ppip
-#include "BNL_CC1ppip_Evt_1DQ2_nu.h"
-#include "BNL_CC1ppip_Evt_1DWNmu_nu.h"
-#include "BNL_CC1ppip_Evt_1DWNpi_nu.h"
-#include "BNL_CC1ppip_Evt_1DWmupi_nu.h"
-#include "BNL_CC1ppip_Evt_1DcosthAdler_nu.h"
-#include "BNL_CC1ppip_Evt_1Dphi_nu.h"
-#include "BNL_CC1ppip_XSec_1DEnu_nu.h"
-// BNL CC1npip
-#include "BNL_CC1npip_Evt_1DQ2_nu.h"
-#include "BNL_CC1npip_Evt_1DWNmu_nu.h"
-#include "BNL_CC1npip_Evt_1DWNpi_nu.h"
-#include "BNL_CC1npip_Evt_1DWmupi_nu.h"
-#include "BNL_CC1npip_XSec_1DEnu_nu.h"
-// BNL CC1pi0
-#include "BNL_CC1pi0_Evt_1DQ2_nu.h"
-#include "BNL_CC1pi0_Evt_1DWNmu_nu.h"
-#include "BNL_CC1pi0_Evt_1DWNpi_nu.h"
-#include "BNL_CC1pi0_Evt_1DWmupi_nu.h"
-#include "BNL_CC1pi0_XSec_1DEnu_nu.h"
-// BNL multipi
-#include "BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu.cxx"
-#include "BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu.cxx"
-#include "BNL_CC2pi_1pim1pip_XSec_1DEnu_nu.cxx"
-#include "BNL_CC3pi_1pim2pip_XSec_1DEnu_nu.cxx"
-#include "BNL_CC4pi_2pim2pip_XSec_1DEnu_nu.cxx"
-#endif
-
-#ifdef FNAL_ENABLED
-// FNAL CCQE
-#include "FNAL_CCQE_Evt_1DQ2_nu.h"
-// FNAL CC1ppip
-#include "FNAL_CC1ppip_Evt_1DQ2_nu.h"
-#include "FNAL_CC1ppip_XSec_1DEnu_nu.h"
-#include "FNAL_CC1ppip_XSec_1DQ2_nu.h"
-// FNAL CC1ppim
-#include "FNAL_CC1ppim_XSec_1DEnu_antinu.h"
-#endif
-
-#ifdef BEBC_ENABLED
-// BEBC CCQE
-#include "BEBC_CCQE_XSec_1DQ2_nu.h"
-// BEBC CC1ppip
-#include "BEBC_CC1ppip_XSec_1DEnu_nu.h"
-#include "BEBC_CC1ppip_XSec_1DQ2_nu.h"
-// BEBC CC1npip
-#include "BEBC_CC1npip_XSec_1DEnu_nu.h"
-#include "BEBC_CC1npip_XSec_1DQ2_nu.h"
-// BEBC CC1pi0
-#include "BEBC_CC1pi0_XSec_1DEnu_nu.h"
-#include "BEBC_CC1pi0_XSec_1DQ2_nu.h"
-// BEBC CC1npim
-#include "BEBC_CC1npim_XSec_1DEnu_antinu.h"
-#include "BEBC_CC1npim_XSec_1DQ2_antinu.h"
-// BEBC CC1ppim
-#include "BEBC_CC1ppim_XSec_1DEnu_antinu.h"
-#include "BEBC_CC1ppim_XSec_1DQ2_antinu.h"
-#endif
-
-#ifdef GGM_ENABLED
-// GGM CC1ppip
-#include "GGM_CC1ppip_Evt_1DQ2_nu.h"
-#include "GGM_CC1ppip_XSec_1DEnu_nu.h"
-#endif
-
-#ifdef MiniBooNE_ENABLED
-// MiniBooNE CCQE
-#include "MiniBooNE_CCQE_XSec_1DEnu_nu.h"
-#include "MiniBooNE_CCQE_XSec_1DQ2_antinu.h"
-#include "MiniBooNE_CCQE_XSec_1DQ2_nu.h"
-#include "MiniBooNE_CCQE_XSec_2DTcos_antinu.h"
-#include "MiniBooNE_CCQE_XSec_2DTcos_nu.h"
-
-// MiniBooNE CC1pi+ 1D
-#include "MiniBooNE_CC1pip_XSec_1DEnu_nu.h"
-#include "MiniBooNE_CC1pip_XSec_1DQ2_nu.h"
-#include "MiniBooNE_CC1pip_XSec_1DTpi_nu.h"
-#include "MiniBooNE_CC1pip_XSec_1DTu_nu.h"
-// MiniBooNE CC1pi+ 2D
-#include "MiniBooNE_CC1pip_XSec_2DQ2Enu_nu.h"
-#include "MiniBooNE_CC1pip_XSec_2DTpiCospi_nu.h"
-#include "MiniBooNE_CC1pip_XSec_2DTpiEnu_nu.h"
-#include "MiniBooNE_CC1pip_XSec_2DTuCosmu_nu.h"
-#include "MiniBooNE_CC1pip_XSec_2DTuEnu_nu.h"
-
-// MiniBooNE CC1pi0
-#include "MiniBooNE_CC1pi0_XSec_1DEnu_nu.h"
-#include "MiniBooNE_CC1pi0_XSec_1DQ2_nu.h"
-#include "MiniBooNE_CC1pi0_XSec_1DTu_nu.h"
-#include "MiniBooNE_CC1pi0_XSec_1Dcosmu_nu.h"
-#include "MiniBooNE_CC1pi0_XSec_1Dcospi0_nu.h"
-#include "MiniBooNE_CC1pi0_XSec_1Dppi0_nu.h"
-#include "MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu.h"
-#include "MiniBooNE_NC1pi0_XSec_1Dcospi0_nu.h"
-#include "MiniBooNE_NC1pi0_XSec_1Dppi0_antinu.h"
-#include "MiniBooNE_NC1pi0_XSec_1Dppi0_nu.h"
-
-// MiniBooNE NCEL
-#include "MiniBooNE_NCEL_XSec_Treco_nu.h"
-#endif
-
-#ifdef MicroBooNE_ENABLED
-#include "MicroBooNE_CC1Mu1p_XSec_1D_nu.h"
-#include "MicroBooNE_CC1Mu2p_XSec_1D_nu.h"
-#include "MicroBooNE_CC1MuNp_XSec_1D_nu.h"
-#include "MicroBooNE_CCInc_XSec_2DPcos_nu.h"
-#include "MicroBooNE_CC1Mu0pNp_XSec_nu.h"
-#include "MicroBooNE_CC1Mu3DInc_XSec_nu.h"
-#include "MicroBooNE_NCpi0_XSec_nu.h"
-#endif
-
-#ifdef MINERvA_ENABLED
-// MINERvA CCQE
-#include "MINERvA_CCQE_XSec_1DQ2_antinu.h"
-#include "MINERvA_CCQE_XSec_1DQ2_joint.h"
-#include "MINERvA_CCQE_XSec_1DQ2_nu.h"
-
-// MINERvA CC0pi
-#include "MINERvA_CC0pi_XSec_1DEe_nue.h"
-#include "MINERvA_CC0pi_XSec_1DQ2_nu_proton.h"
-#include "MINERvA_CC0pi_XSec_1DQ2_nue.h"
-#include "MINERvA_CC0pi_XSec_1DThetae_nue.h"
-
-// 2018 MINERvA CC0pi STV
-#include "MINERvA_CC0pinp_STV_XSec_1D_nu.h"
-
-// 2018 MINERvA CC0pi 2D
-#include "MINERvA_CC0pi_XSec_1D_2018_nu.h"
-#include "MINERvA_CC0pi_XSec_2D_nu.h"
-// #include "MINERvA_CC0pi_XSec_3DptpzTp_nu.h"
-#include "MINERvA_CC0pi_XSec_3DptpzTp_1DVersion_nu.h"
-#include "MINERvA_CC0pi_XSec_3Dq0qeemuTp_1DVersion_nu.h"
-
-// 2018 MINERvA CC0pi 2D antinu
-#include "MINERvA_CC0pi_XSec_2D_antinu.h"
-
-// MINERvA CC1pi+
-#include "MINERvA_CC1pip_XSec_1DTpi_20deg_nu.h"
-#include "MINERvA_CC1pip_XSec_1DTpi_nu.h"
-#include "MINERvA_CC1pip_XSec_1Dth_20deg_nu.h"
-#include "MINERvA_CC1pip_XSec_1Dth_nu.h"
-// 2017 data update
-#include "MINERvA_CC1pip_XSec_1D_2017Update.h"
-
-// MINERvA CC1pi-
-#include "MINERvA_CC1pim_XSec_1DEnu_antinu.h"
-#include "MINERvA_CC1pim_XSec_1DQ2_antinu.h"
-#include "MINERvA_CC1pim_XSec_1DTpi_antinu.h"
-#include "MINERvA_CC1pim_XSec_1Dpmu_antinu.h"
-#include "MINERvA_CC1pim_XSec_1Dth_antinu.h"
-#include "MINERvA_CC1pim_XSec_1Dthmu_antinu.h"
-
-// MINERvA CCNpi+
-#include "MINERvA_CCNpip_XSec_1DEnu_nu.h"
-#include "MINERvA_CCNpip_XSec_1DQ2_nu.h"
-#include "MINERvA_CCNpip_XSec_1DTpi_nu.h"
-#include "MINERvA_CCNpip_XSec_1Dpmu_nu.h"
-#include "MINERvA_CCNpip_XSec_1Dth_nu.h"
-#include "MINERvA_CCNpip_XSec_1Dthmu_nu.h"
-
-// MINERvA CC1pi0
-#include "MINERvA_CC1pi0_XSec_1DEnu_antinu.h"
-#include "MINERvA_CC1pi0_XSec_1DQ2_antinu.h"
-#include "MINERvA_CC1pi0_XSec_1DTpi0_antinu.h"
-#include "MINERvA_CC1pi0_XSec_1Dpmu_antinu.h"
-#include "MINERvA_CC1pi0_XSec_1Dppi0_antinu.h"
-#include "MINERvA_CC1pi0_XSec_1Dth_antinu.h"
-#include "MINERvA_CC1pi0_XSec_1Dthmu_antinu.h"
-
-// MINERvA CC1pi0 neutrino
-#include "MINERvA_CC1pi0_XSec_1D_nu.h"
-
-// MINERvA CCINC
-#include "MINERvA_CCinc_XSec_1DEnu_ratio.h"
-#include "MINERvA_CCinc_XSec_1Dx_ratio.h"
-#include "MINERvA_CCinc_XSec_2DEavq3_nu.h"
-
-// MINERvA CCDIS
-#include "MINERvA_CCDIS_XSec_1DEnu_ratio.h"
-#include "MINERvA_CCDIS_XSec_1Dx_ratio.h"
-
-// MINERvA CCCOH pion
-#include "MINERvA_CCCOHPI_XSec_1DEnu_antinu.h"
-#include "MINERvA_CCCOHPI_XSec_1DEpi_antinu.h"
-#include "MINERvA_CCCOHPI_XSec_1DQ2_antinu.h"
-
-#include "MINERvA_CCCOHPI_XSec_1DEpi_nu.h"
-#include "MINERvA_CCCOHPI_XSec_1DQ2_nu.h"
-#include "MINERvA_CCCOHPI_XSec_1Dth_nu.h"
-
-#include "MINERvA_CCCOHPI_XSec_joint.h"
-
-#include "MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu.h"
-#include "MINERvA_CC0pi_XSec_1DQ2_Tgt_nu.h"
-
-// MINERvA Nuke CC0pi muon 2d
-#include "MINERvA_NukeCC0pi_XSec_2D_nu.h"
-#endif
-
-#ifdef T2K_ENABLED
-// T2K CC0pi 2016
-#include "T2K_CC0pi_XSec_2DPcos_nu_I.h"
-#include "T2K_CC0pi_XSec_2DPcos_nu_II.h"
-
-// T2K CC0pi 2020 arXiv:1908.10249
-#include "T2K_CC0pi_XSec_H2O_2DPcos_anu.h"
-
-// T2K CC0pi 2020 arXiv:2004.05434
-#include "T2K_NuMu_CC0pi_OC_XSec_2DPcos.h"
-#include "T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint.h"
-
-// T2K CC0pi 2020 arXiv:2002.09323
-#include "T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos.h"
-#include "T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint.h"
-
-// T2K CC-inclusive with full acceptance 2018
-#include "T2K_CCinc_XSec_2DPcos_nu_nonuniform.h"
-
-// T2K nue CC-inclusive 2019
-#include "T2K_nueCCinc_XSec_1Dpe.h"
-#include "T2K_nueCCinc_XSec_1Dpe_joint.h"
-#include "T2K_nueCCinc_XSec_1Dthe.h"
-#include "T2K_nueCCinc_XSec_1Dthe_joint.h"
-#include "T2K_nueCCinc_XSec_joint.h"
-
-// T2K STV CC0pi 2018
-#include "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np.h"
-#include "T2K_CC0pinp_STV_XSec_1Ddat_nu.h"
-#include "T2K_CC0pinp_STV_XSec_1Ddphit_nu.h"
-#include "T2K_CC0pinp_STV_XSec_1Ddpt_nu.h"
-#include "T2K_CC0pinp_ifk_XSec_3Dinfa_nu.h"
-#include "T2K_CC0pinp_ifk_XSec_3Dinfip_nu.h"
-#include "T2K_CC0pinp_ifk_XSec_3Dinfp_nu.h"
-
-// T2K CC1pi+ on CH
-#include "T2K_CC1pip_CH_XSec_1DAdlerPhi_nu.h"
-#include "T2K_CC1pip_CH_XSec_1DCosThAdler_nu.h"
-#include "T2K_CC1pip_CH_XSec_1DQ2_nu.h"
-#include "T2K_CC1pip_CH_XSec_1Dppi_nu.h"
-#include "T2K_CC1pip_CH_XSec_1Dthmupi_nu.h"
-#include "T2K_CC1pip_CH_XSec_1Dthpi_nu.h"
-#include "T2K_CC1pip_CH_XSec_2Dpmucosmu_nu.h"
-
-// T2K CCCOH (single bin)
-#include "T2K_CCCOH_C12_XSec_1DEnu_nu.h"
-
-// T2K CC1pi+ on H2O
-#include "T2K_CC1pip_H2O_XSec_1DEnuDelta_nu.h"
-#include "T2K_CC1pip_H2O_XSec_1DEnuMB_nu.h"
-#include "T2K_CC1pip_H2O_XSec_1Dcosmu_nu.h"
-#include "T2K_CC1pip_H2O_XSec_1Dcosmupi_nu.h"
-#include "T2K_CC1pip_H2O_XSec_1Dcospi_nu.h"
-#include "T2K_CC1pip_H2O_XSec_1Dpmu_nu.h"
-#include "T2K_CC1pip_H2O_XSec_1Dppi_nu.h"
-
-// add header here
-
-#endif
-
-#ifdef SciBooNE_ENABLED
-
-// SciBooNE COH studies
-#include "SciBooNE_CCCOH_1TRK_1DQ2_nu.h"
-#include "SciBooNE_CCCOH_1TRK_1Dpmu_nu.h"
-#include "SciBooNE_CCCOH_1TRK_1Dthetamu_nu.h"
-#include "SciBooNE_CCCOH_MuPiNoVA_1DQ2_nu.h"
-#include "SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu.h"
-#include "SciBooNE_CCCOH_MuPiNoVA_1Dthetamu_nu.h"
-#include "SciBooNE_CCCOH_MuPiNoVA_1Dthetapi_nu.h"
-#include "SciBooNE_CCCOH_MuPiNoVA_1Dthetapr_nu.h"
-#include "SciBooNE_CCCOH_MuPiVA_1DQ2_nu.h"
-#include "SciBooNE_CCCOH_MuPiVA_1Dpmu_nu.h"
-#include "SciBooNE_CCCOH_MuPiVA_1Dthetamu_nu.h"
-#include "SciBooNE_CCCOH_MuPr_1DQ2_nu.h"
-#include "SciBooNE_CCCOH_MuPr_1Dpmu_nu.h"
-#include "SciBooNE_CCCOH_MuPr_1Dthetamu_nu.h"
-#include "SciBooNE_CCCOH_STOPFINAL_1DQ2_nu.h"
-#include "SciBooNE_CCCOH_STOP_NTrks_nu.h"
-#include "SciBooNE_CCInc_XSec_1DEnu_nu.h"
-#endif
-
-#ifdef K2K_ENABLED
-// K2K NC1pi0
-#include "K2K_NC1pi0_Evt_1Dppi0_nu.h"
-#endif
+#include "SampleFactoryRegistry.h"
 
 // MC Studies
 #include "ExpMultDist_CCQE_XSec_1DVar_FakeStudy.h"
@@ -638,6 +276,62 @@ DynamicSampleFactory::~DynamicSampleFactory() { Manifests.clear(); }
 //! Functions to make it easier for samples to be created and handled.
 namespace SampleUtils {
 
+namespace {
+SampleFactoryMap BuildSampleFactories() {
+  SampleFactoryMap factories;
+#ifdef ANL_ENABLED
+  RegisterANLSamples(factories);
+#endif
+#ifdef ArgoNeuT_ENABLED
+  RegisterArgoNeuTSamples(factories);
+#endif
+#ifdef BNL_ENABLED
+  RegisterBNLSamples(factories);
+#endif
+#ifdef FNAL_ENABLED
+  RegisterFNALSamples(factories);
+#endif
+#ifdef BEBC_ENABLED
+  RegisterBEBCSamples(factories);
+#endif
+#ifdef GGM_ENABLED
+  RegisterGGMSamples(factories);
+#endif
+#ifdef MiniBooNE_ENABLED
+  RegisterMiniBooNESamples(factories);
+#endif
+#ifdef MicroBooNE_ENABLED
+  RegisterMicroBooNESamples(factories);
+#endif
+#ifdef MINERvA_ENABLED
+  RegisterMINERvASamples(factories);
+#endif
+#ifdef T2K_ENABLED
+  RegisterT2KSamples(factories);
+#endif
+#ifdef SciBooNE_ENABLED
+  RegisterSciBooNESamples(factories);
+#endif
+#ifdef K2K_ENABLED
+  RegisterK2KSamples(factories);
+#endif
+  return factories;
+}
+} // namespace
+
+SampleFactoryMap const &GetSampleFactories() {
+  // Function-local static so that the first caller builds the registry, even
+  // if that happens on a sample loading thread.
+  static SampleFactoryMap const factories = BuildSampleFactories();
+  return factories;
+}
+
+SampleFactory const *FindSampleFactory(std::string const &name) {
+  SampleFactoryMap const &factories = GetSampleFactories();
+  SampleFactoryMap::const_iterator it = factories.find(name);
+  return (it == factories.end()) ? NULL : &it->second;
+}
+
 //! Create a given sample given its name, file, type, fakdata(fkdt) file and the
 //! current rw engine and push it back into the list fChain.
 MeasurementBase *CreateSample(std::string name, std::string file,
@@ -670,1030 +364,67 @@ MeasurementBase *CreateSample(nuiskey samplekey) {
   std::string type = samplekey.GetS("type");
   std::string fkdt = "";
 
+  // Experimental samples are all registered by exact name
+  SampleFactory const *factory = FindSampleFactory(name);
+  if (factory) {
+    return factory->Create(samplekey);
+  }
+
   /*
-     ANL CCQE Samples
+    MC Studies, some of these are matched on name patterns
   */
-
-#ifdef ANL_ENABLED
-  if (!name.compare("ANL_CCQE_XSec_1DEnu_nu") ||
-      !name.compare("ANL_CCQE_XSec_1DEnu_nu_PRD26") ||
-      !name.compare("ANL_CCQE_XSec_1DEnu_nu_PRL31") ||
-      !name.compare("ANL_CCQE_XSec_1DEnu_nu_PRD16")) {
-    return (new ANL_CCQE_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CCQE_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CCQE_Evt_1DQ2_nu_PRL31") ||
-             !name.compare("ANL_CCQE_Evt_1DQ2_nu_PRD26") ||
-             !name.compare("ANL_CCQE_Evt_1DQ2_nu_PRD16")) {
-    return (new ANL_CCQE_Evt_1DQ2_nu(samplekey));
-    /*
-      ANL CC1ppip samples
-    */
-  } else if (!name.compare("ANL_CC1ppip_XSec_1DEnu_nu") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_W16Cut_Uncorr")) {
-    return (new ANL_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_XSec_1DQ2_nu")) {
-    return (new ANL_CC1ppip_XSec_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CC1ppip_Evt_1DQ2_nu_W14Cut")) {
-    return (new ANL_CC1ppip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1Dppi_nu")) {
-    return (new ANL_CC1ppip_Evt_1Dppi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1Dthpr_nu")) {
-    return (new ANL_CC1ppip_Evt_1Dthpr_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DcosmuStar_nu")) {
-    return (new ANL_CC1ppip_Evt_1DcosmuStar_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DcosthAdler_nu")) {
-    return (new ANL_CC1ppip_Evt_1DcosthAdler_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1Dphi_nu")) {
-    return (new ANL_CC1ppip_Evt_1Dphi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DWNpi_nu")) {
-    return (new ANL_CC1ppip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DWNmu_nu")) {
-    return (new ANL_CC1ppip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DWmupi_nu")) {
-    return (new ANL_CC1ppip_Evt_1DWmupi_nu(samplekey));
-    /*
-      ANL CC1npip sample
-    */
-  } else if (!name.compare("ANL_CC1npip_XSec_1DEnu_nu") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_W14Cut_Uncorr") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_W16Cut_Uncorr")) {
-    return (new ANL_CC1npip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CC1npip_Evt_1DQ2_nu_W14Cut")) {
-    return (new ANL_CC1npip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1Dppi_nu")) {
-    return (new ANL_CC1npip_Evt_1Dppi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DcosmuStar_nu")) {
-    return (new ANL_CC1npip_Evt_1DcosmuStar_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DWNpi_nu")) {
-    return (new ANL_CC1npip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DWNmu_nu")) {
-    return (new ANL_CC1npip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DWmupi_nu")) {
-    return (new ANL_CC1npip_Evt_1DWmupi_nu(samplekey));
-    /*
-      ANL CC1pi0 sample
-    */
-  } else if (!name.compare("ANL_CC1pi0_XSec_1DEnu_nu") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_W14Cut_Uncorr") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_W16Cut_Uncorr")) {
-    return (new ANL_CC1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CC1pi0_Evt_1DQ2_nu_W14Cut")) {
-    return (new ANL_CC1pi0_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DcosmuStar_nu")) {
-    return (new ANL_CC1pi0_Evt_1DcosmuStar_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DWNpi_nu")) {
-    return (new ANL_CC1pi0_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DWNmu_nu")) {
-    return (new ANL_CC1pi0_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DWmupi_nu")) {
-    return (new ANL_CC1pi0_Evt_1DWmupi_nu(samplekey));
-    /*
-      ANL NC1npip sample
-    */
-  } else if (!name.compare("ANL_NC1npip_Evt_1Dppi_nu")) {
-    return (new ANL_NC1npip_Evt_1Dppi_nu(samplekey));
-    /*
-      ANL NC1ppim sample
-    */
-  } else if (!name.compare("ANL_NC1ppim_XSec_1DEnu_nu")) {
-    return (new ANL_NC1ppim_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_NC1ppim_Evt_1DcosmuStar_nu")) {
-    return (new ANL_NC1ppim_Evt_1DcosmuStar_nu(samplekey));
-    /*
-      ANL CC2pi sample
-    */
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_XSec_1DEnu_nu")) {
-    return (new ANL_CC2pi_1pim1pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dppip_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dppip_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dppim_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dppim_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu(samplekey));
-
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_XSec_1DEnu_nu")) {
-    return (new ANL_CC2pi_1pip1pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu(samplekey));
-
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu(samplekey));
-
-    /*
-      ArgoNeut Samples
-    */
-  } else
-#endif
-#ifdef ArgoNeuT_ENABLED
-      if (!name.compare("ArgoNeuT_CCInc_XSec_1Dpmu_antinu")) {
-    return (new ArgoNeuT_CCInc_XSec_1Dpmu_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CCInc_XSec_1Dpmu_nu")) {
-    return (new ArgoNeuT_CCInc_XSec_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CCInc_XSec_1Dthetamu_antinu")) {
-    return (new ArgoNeuT_CCInc_XSec_1Dthetamu_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CCInc_XSec_1Dthetamu_nu")) {
-    return (new ArgoNeuT_CCInc_XSec_1Dthetamu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dpmu_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu(samplekey));
-
-    /*
-      BNL Samples
-    */
-  } else
-#endif
-#ifdef BNL_ENABLED
-      if (!name.compare("BNL_CCQE_XSec_1DEnu_nu")) {
-    return (new BNL_CCQE_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CCQE_Evt_1DQ2_nu")) {
-    return (new BNL_CCQE_Evt_1DQ2_nu(samplekey));
-
-    /*
-      BNL CC1ppip samples
-    */
-  } else if (!name.compare("BNL_CC1ppip_XSec_1DEnu_nu") ||
-             !name.compare("BNL_CC1ppip_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("BNL_CC1ppip_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("BNL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr")) {
-    return (new BNL_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DQ2_nu") ||
-             !name.compare("BNL_CC1ppip_Evt_1DQ2_nu_W14Cut")) {
-    return (new BNL_CC1ppip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DcosthAdler_nu")) {
-    return (new BNL_CC1ppip_Evt_1DcosthAdler_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1Dphi_nu")) {
-    return (new BNL_CC1ppip_Evt_1Dphi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DWNpi_nu")) {
-    return (new BNL_CC1ppip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DWNmu_nu")) {
-    return (new BNL_CC1ppip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DWmupi_nu")) {
-    return (new BNL_CC1ppip_Evt_1DWmupi_nu(samplekey));
-
-    /*
-      BNL CC1npip samples
-    */
-  } else if (!name.compare("BNL_CC1npip_XSec_1DEnu_nu") ||
-             !name.compare("BNL_CC1npip_XSec_1DEnu_nu_Uncorr")) {
-    return (new BNL_CC1npip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DQ2_nu")) {
-    return (new BNL_CC1npip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DWNpi_nu")) {
-    return (new BNL_CC1npip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DWNmu_nu")) {
-    return (new BNL_CC1npip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DWmupi_nu")) {
-    return (new BNL_CC1npip_Evt_1DWmupi_nu(samplekey));
-    /*
-      BNL CC1pi0 samples
-    */
-  } else if (!name.compare("BNL_CC1pi0_XSec_1DEnu_nu")) {
-    return (new BNL_CC1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DQ2_nu")) {
-    return (new BNL_CC1pi0_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DWNpi_nu")) {
-    return (new BNL_CC1pi0_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DWNmu_nu")) {
-    return (new BNL_CC1pi0_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DWmupi_nu")) {
-    return (new BNL_CC1pi0_Evt_1DWmupi_nu(samplekey));
-    /*
-      BNL multi-pi
-    */
-  } else if (!name.compare("BNL_CC2pi_1pim1pip_XSec_1DEnu_nu")) {
-    return (new BNL_CC2pi_1pim1pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC3pi_1pim2pip_XSec_1DEnu_nu")) {
-    return (new BNL_CC3pi_1pim2pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC4pi_2pim2pip_XSec_1DEnu_nu")) {
-    return (new BNL_CC4pi_2pim2pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu")) {
-    return (new BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu(samplekey));
-  } else if (!name.compare("BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu")) {
-    return (new BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu(samplekey));
-    /*
-      FNAL Samples
-    */
-  } else
-#endif
-#ifdef FNAL_ENABLED
-      if (!name.compare("FNAL_CCQE_Evt_1DQ2_nu")) {
-    return (new FNAL_CCQE_Evt_1DQ2_nu(samplekey));
-    /*
-      FNAL CC1ppip
-    */
-  } else if (!name.compare("FNAL_CC1ppip_XSec_1DEnu_nu")) {
-    return (new FNAL_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("FNAL_CC1ppip_XSec_1DQ2_nu")) {
-    return (new FNAL_CC1ppip_XSec_1DQ2_nu(samplekey));
-  } else if (!name.compare("FNAL_CC1ppip_Evt_1DQ2_nu")) {
-    return (new FNAL_CC1ppip_Evt_1DQ2_nu(samplekey));
-    /*
-      FNAL CC1ppim
-    */
-  } else if (!name.compare("FNAL_CC1ppim_XSec_1DEnu_antinu")) {
-    return (new FNAL_CC1ppim_XSec_1DEnu_antinu(samplekey));
-
-    /*
-      BEBC Samples
-    */
-  } else
-#endif
-#ifdef BEBC_ENABLED
-      if (!name.compare("BEBC_CCQE_XSec_1DQ2_nu")) {
-    return (new BEBC_CCQE_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1ppip samples
-    */
-  } else if (!name.compare("BEBC_CC1ppip_XSec_1DEnu_nu")) {
-    return (new BEBC_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BEBC_CC1ppip_XSec_1DQ2_nu")) {
-    return (new BEBC_CC1ppip_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1npip samples
-    */
-  } else if (!name.compare("BEBC_CC1npip_XSec_1DEnu_nu")) {
-    return (new BEBC_CC1npip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BEBC_CC1npip_XSec_1DQ2_nu")) {
-    return (new BEBC_CC1npip_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1pi0 samples
-    */
-  } else if (!name.compare("BEBC_CC1pi0_XSec_1DEnu_nu")) {
-    return (new BEBC_CC1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BEBC_CC1pi0_XSec_1DQ2_nu")) {
-    return (new BEBC_CC1pi0_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1npim samples
-    */
-  } else if (!name.compare("BEBC_CC1npim_XSec_1DEnu_antinu")) {
-    return (new BEBC_CC1npim_XSec_1DEnu_antinu(samplekey));
-  } else if (!name.compare("BEBC_CC1npim_XSec_1DQ2_antinu")) {
-    return (new BEBC_CC1npim_XSec_1DQ2_antinu(samplekey));
-    /*
-      BEBC CC1ppim samples
-    */
-  } else if (!name.compare("BEBC_CC1ppim_XSec_1DEnu_antinu")) {
-    return (new BEBC_CC1ppim_XSec_1DEnu_antinu(samplekey));
-  } else if (!name.compare("BEBC_CC1ppim_XSec_1DQ2_antinu")) {
-    return (new BEBC_CC1ppim_XSec_1DQ2_antinu(samplekey));
-
-    /*
-      GGM CC1ppip samples
-    */
-  } else
-#endif
-#ifdef GGM_ENABLED
-      if (!name.compare("GGM_CC1ppip_XSec_1DEnu_nu")) {
-    return (new GGM_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("GGM_CC1ppip_Evt_1DQ2_nu")) {
-    return (new GGM_CC1ppip_Evt_1DQ2_nu(samplekey));
-
-    /*
-      MiniBooNE Samples
-    */
-    /*
-      CCQE
-    */
-  } else
-#endif
-#ifdef MiniBooNE_ENABLED
-      if (!name.compare("MiniBooNE_CCQE_XSec_1DQ2_nu") ||
-          !name.compare("MiniBooNE_CCQELike_XSec_1DQ2_nu")) {
-    return (new MiniBooNE_CCQE_XSec_1DQ2_nu(samplekey));
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_1DEnu_nu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_1DEnu_nu")) {
-    return (new MiniBooNE_CCQE_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_1DQ2_antinu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_1DQ2_antinu") ||
-             !name.compare("MiniBooNE_CCQE_CTarg_XSec_1DQ2_antinu")) {
-    return (new MiniBooNE_CCQE_XSec_1DQ2_antinu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_2DTcos_nu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_2DTcos_nu")) {
-    return (new MiniBooNE_CCQE_XSec_2DTcos_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_2DTcos_antinu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_2DTcos_antinu")) {
-    return (new MiniBooNE_CCQE_XSec_2DTcos_antinu(samplekey));
-
-    /*
-      MiniBooNE CC1pi+
-    */
-    // 1D
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DEnu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DEnu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DQ2_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DQ2_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DTpi_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DTpi_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DTu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DTu_nu(samplekey));
-
-    // 2D
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DQ2Enu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DQ2Enu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTpiCospi_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTpiCospi_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTpiEnu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTpiEnu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTuCosmu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTuCosmu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTuEnu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTuEnu_nu(samplekey));
-
-    /*
-      MiniBooNE CC1pi0
-    */
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1DEnu_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1DEnu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1DQ2_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1DQ2_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1DTu_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1DTu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1Dcosmu_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1Dcosmu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1Dcospi0_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1Dcospi0_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1Dppi0_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1Dppi0_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_rhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_nu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_fhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dcospi0_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_antinu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_rhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dppi0_antinu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_nu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_fhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dppi0_nu(samplekey));
-
-    /*
-      MiniBooNE NCEL
-    */
-  } else if (!name.compare("MiniBooNE_NCEL_XSec_Treco_nu")) {
-    return (new MiniBooNE_NCEL_XSec_Treco_nu(samplekey));
-  } else
-#endif
-
-#ifdef MicroBooNE_ENABLED
-    /*
-    MicroBooNE Samples
-    */
-    if (!name.compare("MicroBooNE_CCInc_XSec_2DPcos_nu")) {
-      return (new MicroBooNE_CCInc_XSec_2DPcos_nu(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1MuNp_XSec_1DPmu_nu") ||
-               !name.compare("MicroBooNE_CC1MuNp_XSec_1Dcosmu_nu") ||
-               !name.compare("MicroBooNE_CC1MuNp_XSec_1DPp_nu") ||
-               !name.compare("MicroBooNE_CC1MuNp_XSec_1Dcosp_nu") ||
-               !name.compare("MicroBooNE_CC1MuNp_XSec_1Dthetamup_nu")) {
-      return (new MicroBooNE_CC1MuNp_XSec_1D_nu(samplekey));
-    } else if (!name.compare(
-                   "MicroBooNE_CC1Mu2p_XSec_1DOpening_Angle_Protons_Lab_nu") ||
-               !name.compare(
-                   "MicroBooNE_CC1Mu2p_XSec_1DOpening_Angle_Mu_Both_nu") ||
-               !name.compare("MicroBooNE_CC1Mu2p_XSec_1DDeltaPT_nu")) {
-      return (new MicroBooNE_CC1Mu2p_XSec_1D_nu(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu1p_XSec_1DDeltaPT_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DDeltaAlphaT_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DDeltaPhiT_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DMuonCosTheta_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DProtonCosTheta_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DMuonMomentum_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DProtonMomentum_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DDeltaPn_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DDeltaPtx_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DDeltaPty_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DECal_nu") ||
-               !name.compare("MicroBooNE_CC1Mu1p_XSec_1DEQE_nu")) {
-      return (new MicroBooNE_CC1Mu1p_XSec_1D_nu(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_EMu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpEMu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_CosThetaMu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpCosThetaMu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_ENu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpEnu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_TransferEnergy_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpTransferEnergy>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_AvailEnergy_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpAvailEnergy>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_ProtonKE_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCProtonKE>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_ProtonCosTheta_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCProtonCosTheta>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_ProtonMult_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCProtonMult>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_EMuCosThetaMu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpEMuCosThetaMu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_ProtonKECosTheta_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCNpProtonKECosTheta>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_XpEMu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpEMu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_XpCosThetaMu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpCosThetaMu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_XpEMuCosThetaMu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpEMuCosThetaMu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_XpAvailEnergyCosThetaMuEMu_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpAvailEnergyCosThetaMuEMu>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu0pNp_XSec_All_nu")) {
-      return (new MicroBooNE_CC1Mu0pNp_XSec_nu<kAllCC>(samplekey));
-    } else if (!name.compare("MicroBooNE_CC1Mu3DInc_XSec_nu")) {
-      return (new MicroBooNE_CC1Mu3DInc_XSec_nu(samplekey));
-
-    } else if (!name.compare("MicroBooNE_NCpi0_XSec_0pNpPpi0_nu")) {
-      return (new MicroBooNE_NCpi0_XSec_nu<kNC0pNpPpi0>(samplekey));
-    } else if (!name.compare("MicroBooNE_NCpi0_XSec_XpPpi0_nu")) {
-      return (new MicroBooNE_NCpi0_XSec_nu<kNCXpPpi0>(samplekey));
-    } else if (!name.compare("MicroBooNE_NCpi0_XSec_0pNpCosThetaPi0_nu")) {
-      return (new MicroBooNE_NCpi0_XSec_nu<kNC0pNpCosThetaPi0>(samplekey));
-    } else if (!name.compare("MicroBooNE_NCpi0_XSec_XpCosThetaPi0_nu")) {
-      return (new MicroBooNE_NCpi0_XSec_nu<kNCXpCosThetaPi0>(samplekey));
-    } else if (!name.compare("MicroBooNE_NCpi0_XSec_XpPpi0CosThetaPi0_nu")) {
-      return (new MicroBooNE_NCpi0_XSec_nu<kNCXpPpi0CosThetaPi0>(samplekey));
-    } else if (!name.compare("MicroBooNE_NCpi0_XSec_AllNCpi0_nu")) {
-      return (new MicroBooNE_NCpi0_XSec_nu<kAllNCpi0>(samplekey));
-    } else
-
-#endif
-#ifdef MINERvA_ENABLED
-      /*
-      MINERvA Samples
-      */
-      if (!name.compare("MINERvA_CCQE_XSec_1DQ2_nu") ||
-          !name.compare("MINERvA_CCQE_XSec_1DQ2_nu_20deg") ||
-          !name.compare("MINERvA_CCQE_XSec_1DQ2_nu_oldflux") ||
-          !name.compare("MINERvA_CCQE_XSec_1DQ2_nu_20deg_oldflux")) {
-        return (new MINERvA_CCQE_XSec_1DQ2_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCQE_XSec_1DQ2_antinu") ||
-                 !name.compare("MINERvA_CCQE_XSec_1DQ2_antinu_20deg") ||
-                 !name.compare("MINERvA_CCQE_XSec_1DQ2_antinu_oldflux") ||
-                 !name.compare("MINERvA_CCQE_XSec_1DQ2_antinu_20deg_oldflux")) {
-        return (new MINERvA_CCQE_XSec_1DQ2_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCQE_XSec_1DQ2_joint_oldflux") ||
-                 !name.compare("MINERvA_CCQE_XSec_1DQ2_joint_20deg_oldflux") ||
-                 !name.compare("MINERvA_CCQE_XSec_1DQ2_joint") ||
-                 !name.compare("MINERvA_CCQE_XSec_1DQ2_joint_20deg")) {
-        return (new MINERvA_CCQE_XSec_1DQ2_joint(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_1DEe_nue")) {
-        return (new MINERvA_CC0pi_XSec_1DEe_nue(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_nue")) {
-        return (new MINERvA_CC0pi_XSec_1DQ2_nue(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_1DThetae_nue")) {
-        return (new MINERvA_CC0pi_XSec_1DThetae_nue(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pinp_STV_XSec_1Dpmu_nu") ||
-                 !name.compare("MINERvA_CC0pinp_STV_XSec_1Dthmu_nu") ||
-                 !name.compare("MINERvA_CC0pinp_STV_XSec_1Dpprot_nu") ||
-                 !name.compare("MINERvA_CC0pinp_STV_XSec_1Dthprot_nu") ||
-                 !name.compare("MINERvA_CC0pinp_STV_XSec_1Dpnreco_nu") ||
-                 !name.compare("MINERvA_CC0pinp_STV_XSec_1Ddalphat_nu") ||
-                 !name.compare("MINERvA_CC0pinp_STV_XSec_1Ddpt_nu") ||
-                 !name.compare("MINERvA_CC0pinp_STV_XSec_1Ddphit_nu")) {
-        return (new MINERvA_CC0pinp_STV_XSec_1D_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_nu_proton")) {
-        return (new MINERvA_CC0pi_XSec_1DQ2_nu_proton(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtC_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtCH_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtFe_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtPb_nu")) {
-        return (new MINERvA_CC0pi_XSec_1DQ2_Tgt_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtRatioC_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtRatioFe_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtRatioPb_nu")) {
-        return (new MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu(samplekey));
-
-        // Dan Ruterbories measurements of late 2018
-      } else if (!name.compare("MINERvA_CC0pi_XSec_2Dptpz_nu")) {
-        return (new MINERvA_CC0pi_XSec_2D_nu(samplekey));
-
-        // } else if (!name.compare("MINERvA_CC0pi_XSec_3DptpzTp_nu")) {
-        // return (new MINERvA_CC0pi_XSec_3DptpzTp_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_3DptpzTp_1DVersion_nu")) {
-        return (new MINERvA_CC0pi_XSec_3DptpzTp_1DVersion_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_3Dq0qeemuTp_1DVersion_nu")) {
-        return (new MINERvA_CC0pi_XSec_3Dq0qeemuTp_1DVersion_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC0pi_XSec_1Dpt_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1Dpz_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1DQ2QE_nu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_1DEnuQE_nu")) {
-        return (new MINERvA_CC0pi_XSec_1D_2018_nu(samplekey));
-
-        // C. Patrick's early 2018 measurements
-      } else if (!name.compare("MINERvA_CC0pi_XSec_2Dptpz_antinu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_2DQ2QEEnuQE_antinu") ||
-                 !name.compare("MINERvA_CC0pi_XSec_2DQ2QEEnuTrue_antinu")) {
-        return (new MINERvA_CC0pi_XSec_2D_antinu(samplekey));
-
-        /*
-          CC1pi+
-        */
-        // DONE
-      } else if (!name.compare("MINERvA_CC1pip_XSec_1DTpi_nu") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_20deg") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_fluxcorr") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_20deg_fluxcorr")) {
-        return (new MINERvA_CC1pip_XSec_1DTpi_nu(samplekey));
-
-        // DONE
-      } else if (!name.compare("MINERvA_CC1pip_XSec_1Dth_nu") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_20deg") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_fluxcorr") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_20deg_fluxcorr")) {
-        return (new MINERvA_CC1pip_XSec_1Dth_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_2017") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_2017") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1Dpmu_nu_2017") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1Dthmu_nu_2017") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1DQ2_nu_2017") ||
-                 !name.compare("MINERvA_CC1pip_XSec_1DEnu_nu_2017")) {
-        return (new MINERvA_CC1pip_XSec_1D_2017Update(samplekey));
-        /*
-          CC1pi-
-        */
-      } else if (!name.compare("MINERvA_CC1pim_XSec_1DEnu_antinu")) {
-        return (new MINERvA_CC1pim_XSec_1DEnu_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pim_XSec_1DQ2_antinu")) {
-        return (new MINERvA_CC1pim_XSec_1DQ2_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pim_XSec_1DTpi_antinu")) {
-        return (new MINERvA_CC1pim_XSec_1DTpi_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pim_XSec_1Dpmu_antinu")) {
-        return (new MINERvA_CC1pim_XSec_1Dpmu_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pim_XSec_1Dth_antinu")) {
-        return (new MINERvA_CC1pim_XSec_1Dth_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pim_XSec_1Dthmu_antinu")) {
-        return (new MINERvA_CC1pim_XSec_1Dthmu_antinu(samplekey));
-        /*
-          CCNpi+
-        */
-      } else if (!name.compare("MINERvA_CCNpip_XSec_1Dth_nu") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2015") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2016") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2015_fluxcorr") ||
-                 !name.compare(
-                     "MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg_fluxcorr")) {
-        return (new MINERvA_CCNpip_XSec_1Dth_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCNpip_XSec_1DTpi_nu") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2015") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2016") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg") ||
-                 !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2015_fluxcorr") ||
-                 !name.compare(
-                     "MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg_fluxcorr")) {
-        return (new MINERvA_CCNpip_XSec_1DTpi_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCNpip_XSec_1Dthmu_nu")) {
-        return (new MINERvA_CCNpip_XSec_1Dthmu_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCNpip_XSec_1Dpmu_nu")) {
-        return (new MINERvA_CCNpip_XSec_1Dpmu_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCNpip_XSec_1DQ2_nu")) {
-        return (new MINERvA_CCNpip_XSec_1DQ2_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCNpip_XSec_1DEnu_nu")) {
-        return (new MINERvA_CCNpip_XSec_1DEnu_nu(samplekey));
-
-        /*
-          MINERvA CC1pi0 anti-nu
-        */
-        // Done
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_2015") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_2016") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_fluxcorr") ||
-                 !name.compare(
-                     "MINERvA_CC1pi0_XSec_1Dth_antinu_2015_fluxcorr") ||
-                 !name.compare(
-                     "MINERvA_CC1pi0_XSec_1Dth_antinu_2016_fluxcorr")) {
-        return (new MINERvA_CC1pi0_XSec_1Dth_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dppi0_antinu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1Dppi0_antinu_fluxcorr")) {
-        return (new MINERvA_CC1pi0_XSec_1Dppi0_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1DTpi0_antinu")) {
-        return (new MINERvA_CC1pi0_XSec_1DTpi0_antinu(samplekey));
-
-        // Done
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1DQ2_antinu")) {
-        return (new MINERvA_CC1pi0_XSec_1DQ2_antinu(samplekey));
-
-        // Done
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dthmu_antinu")) {
-        return (new MINERvA_CC1pi0_XSec_1Dthmu_antinu(samplekey));
-
-        // Done
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dpmu_antinu")) {
-        return (new MINERvA_CC1pi0_XSec_1Dpmu_antinu(samplekey));
-
-        // Done
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1DEnu_antinu")) {
-        return (new MINERvA_CC1pi0_XSec_1DEnu_antinu(samplekey));
-
-        // MINERvA CC1pi0 nu
-      } else if (!name.compare("MINERvA_CC1pi0_XSec_1DTpi_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1Dth_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1Dpmu_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1Dthmu_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1DQ2_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1DEnu_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1DWexp_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1DPPi0Mass_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1DPPi0MassDelta_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1DCosAdler_nu") ||
-                 !name.compare("MINERvA_CC1pi0_XSec_1DPhiAdler_nu")) {
-        return (new MINERvA_CC1pi0_XSec_1D_nu(samplekey));
-
-        /*
-          CCINC
-        */
-      } else if (!name.compare("MINERvA_CCinc_XSec_2DEavq3_nu")) {
-        return (new MINERvA_CCinc_XSec_2DEavq3_nu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCinc_XSec_1Dx_ratio_C12_CH") ||
-                 !name.compare("MINERvA_CCinc_XSec_1Dx_ratio_Fe56_CH") ||
-                 !name.compare("MINERvA_CCinc_XSec_1Dx_ratio_Pb208_CH")) {
-        return (new MINERvA_CCinc_XSec_1Dx_ratio(samplekey));
-
-      } else if (!name.compare("MINERvA_CCinc_XSec_1DEnu_ratio_C12_CH") ||
-                 !name.compare("MINERvA_CCinc_XSec_1DEnu_ratio_Fe56_CH") ||
-                 !name.compare("MINERvA_CCinc_XSec_1DEnu_ratio_Pb208_CH")) {
-        return (new MINERvA_CCinc_XSec_1DEnu_ratio(samplekey));
-        /*
-          CCDIS
-        */
-      } else if (!name.compare("MINERvA_CCDIS_XSec_1Dx_ratio_C12_CH") ||
-                 !name.compare("MINERvA_CCDIS_XSec_1Dx_ratio_Fe56_CH") ||
-                 !name.compare("MINERvA_CCDIS_XSec_1Dx_ratio_Pb208_CH")) {
-        return (new MINERvA_CCDIS_XSec_1Dx_ratio(samplekey));
-
-      } else if (!name.compare("MINERvA_CCDIS_XSec_1DEnu_ratio_C12_CH") ||
-                 !name.compare("MINERvA_CCDIS_XSec_1DEnu_ratio_Fe56_CH") ||
-                 !name.compare("MINERvA_CCDIS_XSec_1DEnu_ratio_Pb208_CH")) {
-        return (new MINERvA_CCDIS_XSec_1DEnu_ratio(samplekey));
-
-        /*
-          CC-COH
-        */
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEnu_nu")) {
-        return (new MINERvA_CCCOHPI_XSec_1DEnu_nu(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEpi_nu")) {
-        return (new MINERvA_CCCOHPI_XSec_1DEpi_nu(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1Dth_nu")) {
-        return (new MINERvA_CCCOHPI_XSec_1Dth_nu(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DQ2_nu")) {
-        return (new MINERvA_CCCOHPI_XSec_1DQ2_nu(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEnu_antinu")) {
-        return (new MINERvA_CCCOHPI_XSec_1DEnu_antinu(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEpi_antinu")) {
-        return (new MINERvA_CCCOHPI_XSec_1DEpi_antinu(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1Dth_antinu")) {
-        return (new MINERvA_CCCOHPI_XSec_1Dth_antinu(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DQ2_antinu")) {
-        return (new MINERvA_CCCOHPI_XSec_1DQ2_antinu(samplekey));
-
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEnu_joint")) {
-        return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEpi_joint")) {
-        return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1Dth_joint")) {
-        return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-      } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DQ2_joint")) {
-        return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_CH_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_CH_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_C_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_C_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_H2O_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_H2O_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_Fe_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_Fe_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_Pb_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_Pb_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_CH_C_Flux_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_CH_C_Flux_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_CH_H2O_Flux_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_CH_H2O_Flux_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_CH_Fe_Flux_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_CH_Fe_Flux_XSec_2D_nu(samplekey));
-      } else if (!name.compare("MINERvA_NukeCC0pi_CH_Pb_Flux_XSec_2D_nu")) {
-        return (new MINERvA_NukeCC0pi_CH_Pb_Flux_XSec_2D_nu(samplekey));
-
-        /*
-        T2K Samples
-        */
-
-      } else
-#endif
-#ifdef T2K_ENABLED
-          if (!name.compare("T2K_CC0pi_XSec_2DPcos_nu_I")) {
-        return (new T2K_CC0pi_XSec_2DPcos_nu_I(samplekey));
-
-      } else if (!name.compare("T2K_CC0pi_XSec_2DPcos_nu_II")) {
-        return (new T2K_CC0pi_XSec_2DPcos_nu_II(samplekey));
-
-      } else if (!name.compare("T2K_CCinc_XSec_2DPcos_nu_nonuniform")) {
-        return (new T2K_CCinc_XSec_2DPcos_nu_nonuniform(samplekey));
-
-      } else if (!name.compare("T2K_CC0pi_XSec_H2O_2DPcos_anu")) {
-        return (new T2K_CC0pi_XSec_H2O_2DPcos_anu(samplekey));
-
-      } else if (!name.compare("T2K_NuMu_CC0pi_O_XSec_2DPcos") ||
-                 !name.compare("T2K_NuMu_CC0pi_C_XSec_2DPcos")) {
-        return (new T2K_NuMu_CC0pi_OC_XSec_2DPcos(samplekey));
-
-      } else if (!name.compare("T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint")) {
-        return (new T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint(samplekey));
-
-      } else if (!name.compare("T2K_NuMu_CC0pi_CH_XSec_2DPcos") ||
-                 !name.compare("T2K_AntiNuMu_CC0pi_CH_XSec_2DPcos")) {
-        return (new T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos(samplekey));
-
-      } else if (!name.compare("T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint")) {
-        return (new T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint(samplekey));
-
-      } else if (!name.compare("T2K_nueCCinc_XSec_1Dpe_FHC") ||
-                 !name.compare("T2K_nueCCinc_XSec_1Dpe_RHC") ||
-                 !name.compare("T2K_nuebarCCinc_XSec_1Dpe_RHC")) {
-        return (new T2K_nueCCinc_XSec_1Dpe(samplekey));
-
-      } else if (!name.compare("T2K_nueCCinc_XSec_1Dthe_FHC") ||
-                 !name.compare("T2K_nueCCinc_XSec_1Dthe_RHC") ||
-                 !name.compare("T2K_nuebarCCinc_XSec_1Dthe_RHC")) {
-        return (new T2K_nueCCinc_XSec_1Dthe(samplekey));
-
-      } else if (!name.compare("T2K_nueCCinc_XSec_1Dpe_joint")) {
-        return (new T2K_nueCCinc_XSec_1Dpe_joint(samplekey));
-      } else if (!name.compare("T2K_nueCCinc_XSec_1Dthe_joint")) {
-        return (new T2K_nueCCinc_XSec_1Dthe_joint(samplekey));
-      } else if (!name.compare("T2K_nueCCinc_XSec_joint")) {
-        return (new T2K_nueCCinc_XSec_joint(samplekey));
-
-        /*
-          T2K CC1pi+ CH samples
-        */
-        // Comment these out for now because we don't have the proper data
-
-      } else if (!name.compare("T2K_CC1pip_CH_XSec_2Dpmucosmu_nu")) {
-        return (new T2K_CC1pip_CH_XSec_2Dpmucosmu_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_CH_XSec_1Dppi_nu")) {
-        return (new T2K_CC1pip_CH_XSec_1Dppi_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_CH_XSec_1Dthpi_nu")) {
-        return (new T2K_CC1pip_CH_XSec_1Dthpi_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_CH_XSec_1Dthmupi_nu")) {
-        return (new T2K_CC1pip_CH_XSec_1Dthmupi_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_CH_XSec_1DQ2_nu")) {
-        return (new T2K_CC1pip_CH_XSec_1DQ2_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_CH_XSec_1DAdlerPhi_nu")) {
-        return (new T2K_CC1pip_CH_XSec_1DAdlerPhi_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_CH_XSec_1DCosThAdler_nu")) {
-        return (new T2K_CC1pip_CH_XSec_1DCosThAdler_nu(samplekey));
-
-      } else if (!name.compare("T2K_CCCOH_C12_XSec_1DEnu_nu")) {
-        return (new T2K_CCCOH_C12_XSec_1DEnu_nu(samplekey));
-
-        /*
-          T2K CC1pi+ H2O samples
-        */
-      } else if (!name.compare("T2K_CC1pip_H2O_XSec_1DEnuDelta_nu")) {
-        return (new T2K_CC1pip_H2O_XSec_1DEnuDelta_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_H2O_XSec_1DEnuMB_nu")) {
-        return (new T2K_CC1pip_H2O_XSec_1DEnuMB_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dcosmu_nu")) {
-        return (new T2K_CC1pip_H2O_XSec_1Dcosmu_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dcosmupi_nu")) {
-        return (new T2K_CC1pip_H2O_XSec_1Dcosmupi_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dcospi_nu")) {
-        return (new T2K_CC1pip_H2O_XSec_1Dcospi_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dpmu_nu")) {
-        return (new T2K_CC1pip_H2O_XSec_1Dpmu_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dppi_nu")) {
-        return (new T2K_CC1pip_H2O_XSec_1Dppi_nu(samplekey));
-
-        /*
-          T2K CC0pi + np CH samples
-        */
-      } else if (!name.compare("T2K_CC0pinp_STV_XSec_1Ddpt_nu")) {
-        return (new T2K_CC0pinp_STV_XSec_1Ddpt_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC0pinp_STV_XSec_1Ddphit_nu")) {
-        return (new T2K_CC0pinp_STV_XSec_1Ddphit_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC0pinp_STV_XSec_1Ddat_nu")) {
-        return (new T2K_CC0pinp_STV_XSec_1Ddat_nu(samplekey));
-
-      } else if (!name.compare(
-                     "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np") ||
-                 !name.compare(
-                     "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p") ||
-                 !name.compare("T2K_CC0piWithProtons_XSec_2018_multidif_0p") ||
-                 !name.compare("T2K_CC0piWithProtons_XSec_2018_multidif_1p")) {
-        return (
-            new T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np(samplekey));
-
-      } else if (!name.compare("T2K_CC0pinp_ifk_XSec_3Dinfp_nu")) {
-        return (new T2K_CC0pinp_ifk_XSec_3Dinfp_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC0pinp_ifk_XSec_3Dinfa_nu")) {
-        return (new T2K_CC0pinp_ifk_XSec_3Dinfa_nu(samplekey));
-
-      } else if (!name.compare("T2K_CC0pinp_ifk_XSec_3Dinfip_nu")) {
-        return (new T2K_CC0pinp_ifk_XSec_3Dinfip_nu(samplekey));
-
-        // SciBooNE COH studies
-      } else
-#endif
-#ifdef SciBooNE_ENABLED
-          if (!name.compare("SciBooNE_CCCOH_STOP_NTrks_nu")) {
-        return (new SciBooNE_CCCOH_STOP_NTrks_nu(samplekey));
-
-      } else if (!name.compare("SciBooNE_CCCOH_1TRK_1DQ2_nu")) {
-        return (new SciBooNE_CCCOH_1TRK_1DQ2_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_1TRK_1Dpmu_nu")) {
-        return (new SciBooNE_CCCOH_1TRK_1Dpmu_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_1TRK_1Dthetamu_nu")) {
-        return (new SciBooNE_CCCOH_1TRK_1Dthetamu_nu(samplekey));
-
-      } else if (!name.compare("SciBooNE_CCCOH_MuPr_1DQ2_nu")) {
-        return (new SciBooNE_CCCOH_MuPr_1DQ2_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPr_1Dpmu_nu")) {
-        return (new SciBooNE_CCCOH_MuPr_1Dpmu_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPr_1Dthetamu_nu")) {
-        return (new SciBooNE_CCCOH_MuPr_1Dthetamu_nu(samplekey));
-
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiVA_1DQ2_nu")) {
-        return (new SciBooNE_CCCOH_MuPiVA_1DQ2_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiVA_1Dpmu_nu")) {
-        return (new SciBooNE_CCCOH_MuPiVA_1Dpmu_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiVA_1Dthetamu_nu")) {
-        return (new SciBooNE_CCCOH_MuPiVA_1Dthetamu_nu(samplekey));
-
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1DQ2_nu")) {
-        return (new SciBooNE_CCCOH_MuPiNoVA_1DQ2_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dthetapr_nu")) {
-        return (new SciBooNE_CCCOH_MuPiNoVA_1Dthetapr_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dthetapi_nu")) {
-        return (new SciBooNE_CCCOH_MuPiNoVA_1Dthetapi_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dthetamu_nu")) {
-        return (new SciBooNE_CCCOH_MuPiNoVA_1Dthetamu_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu")) {
-        return (new SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu(samplekey));
-
-      } else if (!name.compare("SciBooNE_CCCOH_STOPFINAL_1DQ2_nu")) {
-        return (new SciBooNE_CCCOH_STOPFINAL_1DQ2_nu(samplekey));
-      } else if (!name.compare("SciBooNE_CCInc_XSec_1DEnu_nu") ||
-                 !name.compare("SciBooNE_CCInc_XSec_1DEnu_nu_NEUT") ||
-                 !name.compare("SciBooNE_CCInc_XSec_1DEnu_nu_NUANCE")) {
-        return (new SciBooNE_CCInc_XSec_1DEnu_nu(samplekey));
-
-        /*
-        K2K Samples
-        */
-        /*
-          NC1pi0
-        */
-      } else
-#endif
-#ifdef K2K_ENABLED
-          if (!name.compare("K2K_NC1pi0_Evt_1Dppi0_nu")) {
-        return (new K2K_NC1pi0_Evt_1Dppi0_nu(samplekey));
-
-        /*
-        Fake Studies
-        */
-      } else
-#endif
-          if (name.find("ExpMultDist_CCQE_XSec_1D") != std::string::npos &&
-              name.find("_FakeStudy") != std::string::npos) {
-        return (new ExpMultDist_CCQE_XSec_1DVar_FakeStudy(name, file, rw, type,
-                                                          fkdt));
-      } else if (name.find("ExpMultDist_CCQE_XSec_2D") != std::string::npos &&
-                 name.find("_FakeStudy") != std::string::npos) {
-        return (new ExpMultDist_CCQE_XSec_2DVar_FakeStudy(name, file, rw, type,
-                                                          fkdt));
-      } else if (name.find("GenericFlux") != std::string::npos) {
-        return (new GenericFlux_Tester(name, file, rw, type, fkdt));
-      } else if (name.find("GenericVectors") != std::string::npos) {
-        return (new GenericFlux_Vectors(name, file, rw, type, fkdt));
-      } else if (!name.compare("T2K2017_FakeData")) {
-        return (new T2K2017_FakeData(samplekey));
-      } else if (!name.compare("MCStudy_CCQE")) {
-        return (new MCStudy_CCQEHistograms(name, file, rw, type, fkdt));
-      } else if (!name.compare("ElectronFlux_FlatTree")) {
-        return (new ElectronFlux_FlatTree(name, file, rw, type, fkdt));
-      }
+  if (name.find("ExpMultDist_CCQE_XSec_1D") != std::string::npos &&
+      name.find("_FakeStudy") != std::string::npos) {
+    return (new ExpMultDist_CCQE_XSec_1DVar_FakeStudy(name, file, rw, type,
+                                                      fkdt));
+  } else if (name.find("ExpMultDist_CCQE_XSec_2D") != std::string::npos &&
+             name.find("_FakeStudy") != std::string::npos) {
+    return (new ExpMultDist_CCQE_XSec_2DVar_FakeStudy(name, file, rw, type,
+                                                      fkdt));
+  } else if (name.find("GenericFlux") != std::string::npos) {
+    return (new GenericFlux_Tester(name, file, rw, type, fkdt));
+  } else if (name.find("GenericVectors") != std::string::npos) {
+    return (new GenericFlux_Vectors(name, file, rw, type, fkdt));
+  } else if (!name.compare("T2K2017_FakeData")) {
+    return (new T2K2017_FakeData(samplekey));
+  } else if (!name.compare("MCStudy_CCQE")) {
+    return (new MCStudy_CCQEHistograms(name, file, rw, type, fkdt));
+  } else if (!name.compare("ElectronFlux_FlatTree")) {
+    return (new ElectronFlux_FlatTree(name, file, rw, type, fkdt));
+  }
 #ifdef Electron_ENABLED
-      else if (name.find("ElectronData_") != std::string::npos) {
-        return new ElectronScattering_DurhamData(samplekey);
-      }
+  else if (name.find("ElectronData_") != std::string::npos) {
+    return new ElectronScattering_DurhamData(samplekey);
+  }
 #endif
-      else if (name.find("MuonValidation_") != std::string::npos) {
-        return (new MCStudy_MuonValidation(name, file, rw, type, fkdt));
-      } else if (!name.compare("NIWGOfficialPlots")) {
-        return (new OfficialNIWGPlots(samplekey));
-      } else if ((name.find("SigmaEnuHists") != std::string::npos) ||
-                 (name.find("SigmaEnuPerEHists") != std::string::npos)) {
-        return (new SigmaEnuHists(samplekey));
-      }
+  else if (name.find("MuonValidation_") != std::string::npos) {
+    return (new MCStudy_MuonValidation(name, file, rw, type, fkdt));
+  } else if (!name.compare("NIWGOfficialPlots")) {
+    return (new OfficialNIWGPlots(samplekey));
+  } else if ((name.find("SigmaEnuHists") != std::string::npos) ||
+             (name.find("SigmaEnuPerEHists") != std::string::npos)) {
+    return (new SigmaEnuHists(samplekey));
+  }
 #ifdef Prob3plusplus_ENABLED
-      else if (!name.compare("Simple_Osc")) {
-        return (new Simple_Osc(samplekey));
-      } else if (!name.compare("Smear_SVDUnfold_Propagation_Osc")) {
-        return (new Smear_SVDUnfold_Propagation_Osc(samplekey));
-      }
+  else if (!name.compare("Simple_Osc")) {
+    return (new Simple_Osc(samplekey));
+  } else if (!name.compare("Smear_SVDUnfold_Propagation_Osc")) {
+    return (new Smear_SVDUnfold_Propagation_Osc(samplekey));
+  }
 #endif
-      else {
-        NUIS_ABORT("Error: No such sample: " << name << std::endl);
-      }
+  else {
+    NUIS_ABORT("Error: No such sample: " << name << std::endl);
+  }
 
   // Return NULL if no sample loaded.
   return NULL;
-} // namespace SampleUtils
+}
+
+bool CanCreateInParallel(nuiskey &samplekey) {
+  if (DynamicSampleFactory::Get().HasSample(samplekey)) {
+    return false;
+  }
+  SampleFactory const *factory = FindSampleFactory(samplekey.GetS("name"));
+  return factory && factory->ParallelSafe;
+}
 } // namespace SampleUtils
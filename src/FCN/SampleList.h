@@ -76,6 +76,10 @@ MeasurementBase* CreateSample(std::string name, std::string file,
                               std::string type, std::string fkdt,
                               FitWeight* rw);
 MeasurementBase* CreateSample(nuiskey samplekey);
+
+//! True if the sample can be built concurrently with other samples, i.e. it
+//! is a registered sample that does not touch the global config while built.
+bool CanCreateInParallel(nuiskey& samplekey);
 }
 
 /*! @} */
@@ -0,0 +1,41 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// FNAL CCQE
+#include "FNAL_CCQE_Evt_1DQ2_nu.h"
+// FNAL CC1ppip
+#include "FNAL_CC1ppip_Evt_1DQ2_nu.h"
+#include "FNAL_CC1ppip_XSec_1DEnu_nu.h"
+#include "FNAL_CC1ppip_XSec_1DQ2_nu.h"
+// FNAL CC1ppim
+#include "FNAL_CC1ppim_XSec_1DEnu_antinu.h"
+
+void SampleUtils::RegisterFNALSamples(SampleFactoryMap &factories) {
+  RegisterSample<FNAL_CCQE_Evt_1DQ2_nu>(factories, "FNAL_CCQE_Evt_1DQ2_nu");
+  RegisterSample<FNAL_CC1ppip_XSec_1DEnu_nu>(factories,
+                                             "FNAL_CC1ppip_XSec_1DEnu_nu");
+  RegisterSample<FNAL_CC1ppip_XSec_1DQ2_nu>(factories,
+                                            "FNAL_CC1ppip_XSec_1DQ2_nu");
+  RegisterSample<FNAL_CC1ppip_Evt_1DQ2_nu>(factories,
+                                           "FNAL_CC1ppip_Evt_1DQ2_nu");
+  RegisterSample<FNAL_CC1ppim_XSec_1DEnu_antinu>(
+      factories, "FNAL_CC1ppim_XSec_1DEnu_antinu");
+}
@@ -84,16 +84,30 @@ InputHandlerBase* EventManager::AddInput(std::string handle, std::string infile)
   InputUtils::InputType inpType =
       InputUtils::ParseInputType(file_descriptor[0]);
 
+  // Samples may be built concurrently (SampleLoadThreads), the first caller
+  // for a given file builds its handler while any others wait for it.
+  std::unique_lock<std::mutex> lock(fInputMutex);
   int id = GetInputID(file_descriptor[1]);
   if ((uint)id != fid.size()) {
+    while (!finputs[id]) {
+      fInputReady.wait(lock);
+    }
     NUIS_LOG(SAM,"Event manager already contains " << file_descriptor[1]);
     return finputs[id];
   } 
 
   fid[file_descriptor[1]] = id;
-  finputs[id] = InputUtils::CreateInputHandler(handle, inpType, file_descriptor[1]);
+  finputs[id] = NULL;
+  lock.unlock();
+
+  InputHandlerBase *input =
+      InputUtils::CreateInputHandler(handle, inpType, file_descriptor[1]);
+
+  lock.lock();
+  finputs[id] = input;
   frwneeded[id] = std::vector<bool>(finputs[id]->GetNEvents(), true);
   calc_rw[id] = std::vector<double>(finputs[id]->GetNEvents(), 0.0);
+  fInputReady.notify_all();
   
   NUIS_LOG(SAM,"Registered " << handle << " with EventManager.");
 
@@ -24,6 +24,10 @@
 #include "FitWeight.h"
 #include "InputUtils.h"
 #include "InputFactory.h"
+
+#include <condition_variable>
+#include <mutex>
+
 // This class is meant to manage one input file for many distributions
 class EventManager {
  public:
@@ -53,6 +57,9 @@ class EventManager {
   std::map< int, std::vector< bool > > frwneeded;
   std::map< int, std::vector< double > > calc_rw;
 
+  std::mutex fInputMutex;              ///< Guards fid and finputs
+  std::condition_variable fInputReady; ///< Signalled when an input is built
+
 };
 
 
@@ -664,6 +664,16 @@ void JointMeas1D::FinaliseMeasurement() {
   // Comment out until scaling is used consistently...
   StatUtils::SetDataErrorFromCov(fDataHist, fFullCovar, 1E-38);
 
+  // Joint covariances are often block diagonal across the sub-samples, only
+  // the blocks are visited by the chi2 and throws
+  fCovarBlocks = StatUtils::GetCovarBlocks(covar);
+  fFullCovarBlocks = StatUtils::GetCovarBlocks(fFullCovar);
+  if (fFullCovarBlocks.size() > 1) {
+    NUIS_LOG(SAM, "Covariance for " << fName << " has "
+                                    << fFullCovarBlocks.size()
+                                    << " diagonal blocks");
+  }
+
   // Setup fMCHist from data
   fMCHist = (TH1D *)fDataHist->Clone();
   fMCHist->SetNameTitle((fSettings.GetName() + "_MC").c_str(),
@@ -1074,7 +1084,8 @@ double JointMeas1D::GetLikelihood() {
     } else if (fIsDiag) {
       stat = StatUtils::GetChi2FromDiag(fDataHist, fMCHist, fMaskHist);
     } else if (!fIsDiag and !fIsRawEvents) {
-      stat = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fMaskHist);
+      stat = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fCovarBlocks,
+                                       fMaskHist);
     }
   }
 
@@ -1168,6 +1179,9 @@ void JointMeas1D::SetFakeDataValues(std::string fakeOption) {
     delete fDecomp;
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
+  fCovarBlocks = StatUtils::GetCovarBlocks(covar);
+  fFullCovarBlocks = StatUtils::GetCovarBlocks(fFullCovar);
+
   delete tempdata;
 
   return;
@@ -1208,7 +1222,8 @@ void JointMeas1D::ThrowCovariance() {
 
   if (fDataHist)
     delete fDataHist;
-  fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fDataHist =
+      StatUtils::ThrowHistogram(fDataTrue, fFullCovar, fFullCovarBlocks);
 
   return;
 };
@@ -1220,7 +1235,8 @@ void JointMeas1D::ThrowDataToy() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fMCHist)
     delete fMCHist;
-  fMCHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fMCHist =
+      StatUtils::ThrowHistogram(fDataTrue, fFullCovar, fFullCovarBlocks);
 }
 
 /*
@@ -1605,10 +1621,26 @@ void JointMeas1D::Reconfigure() {
   return;
 }
 
+//********************************************************************
+void JointMeas1D::SetFitMode(bool fitmode) {
+  //********************************************************************
+
+  fFitMode = fitmode;
+  for (std::vector<MeasurementBase *>::const_iterator expIter =
+           fSubChain.begin();
+       expIter != fSubChain.end(); expIter++) {
+    (*expIter)->SetFitMode(fitmode);
+  }
+}
+
 //********************************************************************
 void JointMeas1D::ConvertEventRates() {
   //********************************************************************
 
+  // The fine histograms are stitched from sub samples that skip them in fit
+  // mode
+  fStaleOutputs = fFitMode;
+
   // Apply Event Scaling
   for (std::vector<MeasurementBase *>::const_iterator expIter =
            fSubChain.begin();
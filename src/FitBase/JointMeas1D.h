@@ -548,6 +548,10 @@ public:
   virtual std::vector<MeasurementBase *> GetSubSamples();
   virtual void ConvertEventRates();
 
+  /// Fit mode is passed on to every sub sample, the joint fMCHist is only
+  /// built from their fMCHist
+  virtual void SetFitMode(bool fitmode);
+
   /*
     Access Functions
   */
@@ -594,6 +598,9 @@ protected:
   TMatrixDSym *fCorrel;     ///< Correlation Matrix
   TMatrixDSym *fShapeCovar; ///< Shape-only covariance
 
+  StatUtils::CovarBlocks fCovarBlocks;     ///< Diagonal blocks of covar
+  StatUtils::CovarBlocks fFullCovarBlocks; ///< Diagonal blocks of fFullCovar
+
   TMatrixDSym *fCovar;  ///< New FullCovar
   TMatrixDSym *fInvert; ///< New covar
 
@@ -653,6 +653,15 @@ void Measurement1D::FinaliseMeasurement() {
 
   // ***** end NS covar modifications *****
 
+  // Multi-target and multi-sample covariances are often block diagonal, only
+  // the blocks are visited by the chi2 and throws
+  fCovarBlocks = StatUtils::GetCovarBlocks(covar);
+  fFullCovarBlocks = StatUtils::GetCovarBlocks(fFullCovar);
+  if (fFullCovarBlocks.size() > 1) {
+    NUIS_LOG(SAM, "Covariance for " << fName << " has "
+                                    << fFullCovarBlocks.size()
+                                    << " diagonal blocks");
+  }
 
   // Setup fMCHist from data
   fMCHist = (TH1D *)fDataHist->Clone();
@@ -951,6 +960,12 @@ void Measurement1D::FillHistograms() {
 
     NUIS_LOG(DEB, "Fill MCHist: " << fXVar << ", " << Weight);
 
+    // Only the likelihood histogram is needed in fit mode
+    if (fFitMode) {
+      fMCHist->Fill(fIsSingleBin ? fMCHist->GetBinCenter(1) : fXVar, Weight);
+      return;
+    }
+
     // If it's single bin, whatever the limits on the plot are don't apply
     if (fIsSingleBin){
       fMCHist->Fill(fMCHist->GetBinCenter(1), Weight);
@@ -982,6 +997,9 @@ void Measurement1D::ScaleEvents() {
   //   fMCWeighted->SetBinError(i + 1,   fMCHist->GetBinError(i + 1));
   // }
 
+  // Fine and mode histograms are not filled in fit mode, so leave them be
+  bool scaleoutputs = !fFitMode;
+
   // Setup Stat ratios for MC and MC Fine
   double *statratio = new double[fMCHist->GetNbinsX()];
   for (int i = 0; i < fMCHist->GetNbinsX(); i++) {
@@ -994,7 +1012,7 @@ void Measurement1D::ScaleEvents() {
   }
 
   double *statratiofine = new double[fMCFine->GetNbinsX()];
-  for (int i = 0; i < fMCFine->GetNbinsX(); i++) {
+  for (int i = 0; scaleoutputs && i < fMCFine->GetNbinsX(); i++) {
     if (fMCFine->GetBinContent(i + 1) != 0) {
       statratiofine[i] =
           fMCFine->GetBinError(i + 1) / fMCFine->GetBinContent(i + 1);
@@ -1008,23 +1026,28 @@ void Measurement1D::ScaleEvents() {
     double datamcratio = fDataHist->Integral() / fMCHist->Integral();
 
     fMCHist->Scale(datamcratio);
-    fMCFine->Scale(datamcratio);
+    if (scaleoutputs) {
+      fMCFine->Scale(datamcratio);
 
-    if (fMCHist_Modes)
-      fMCHist_Modes->Scale(datamcratio);
+      if (fMCHist_Modes)
+        fMCHist_Modes->Scale(datamcratio);
 
-    if (fMCFine_Modes)
-      fMCFine_Modes->Scale(datamcratio);
+      if (fMCFine_Modes)
+        fMCFine_Modes->Scale(datamcratio);
+    }
 
     // Scaling for XSec as function of Enu
   } else if (fIsEnu1D) {
 
     PlotUtils::FluxUnfoldedScaling(fMCHist, GetFluxHistogram(),
                                    GetEventHistogram(), fScaleFactor, fNEvents);
-    PlotUtils::FluxUnfoldedScaling(fMCFine, GetFluxHistogram(),
-                                   GetEventHistogram(), fScaleFactor, fNEvents);
+    if (scaleoutputs) {
+      PlotUtils::FluxUnfoldedScaling(fMCFine, GetFluxHistogram(),
+                                     GetEventHistogram(), fScaleFactor,
+                                     fNEvents);
+    }
 
-    if (fMCHist_Modes) {
+    if (scaleoutputs && fMCHist_Modes) {
       // Loop over the modes
       fMCHist_Modes->FluxUnfold(GetFluxHistogram(), GetEventHistogram(),
                                 fScaleFactor, fNEvents);
@@ -1034,36 +1057,42 @@ void Measurement1D::ScaleEvents() {
 
   } else if (fIsNoWidth) {
     fMCHist->Scale(fScaleFactor);
-    fMCFine->Scale(fScaleFactor);
-    if (fMCHist_Modes)
-      fMCHist_Modes->Scale(fScaleFactor);
-    if (fMCFine_Modes)
-      fMCFine_Modes->Scale(fScaleFactor);
+    if (scaleoutputs) {
+      fMCFine->Scale(fScaleFactor);
+      if (fMCHist_Modes)
+        fMCHist_Modes->Scale(fScaleFactor);
+      if (fMCFine_Modes)
+        fMCFine_Modes->Scale(fScaleFactor);
+    }
   } else if (fIsSingleBin) {
     fMCHist->Scale(fScaleFactor);
-    fMCFine->Scale(fScaleFactor, "width");
-    if (fMCHist_Modes)
-      fMCHist_Modes->Scale(fScaleFactor);
-    if (fMCFine_Modes)
-      fMCFine_Modes->Scale(fScaleFactor, "width");
+    if (scaleoutputs) {
+      fMCFine->Scale(fScaleFactor, "width");
+      if (fMCHist_Modes)
+        fMCHist_Modes->Scale(fScaleFactor);
+      if (fMCFine_Modes)
+        fMCFine_Modes->Scale(fScaleFactor, "width");
+    }
 
     // Any other differential scaling
   } else {
     fMCHist->Scale(fScaleFactor, "width");
-    fMCFine->Scale(fScaleFactor, "width");
+    if (scaleoutputs) {
+      fMCFine->Scale(fScaleFactor, "width");
 
-    if (fMCHist_Modes)
-      fMCHist_Modes->Scale(fScaleFactor, "width");
-    if (fMCFine_Modes)
-      fMCFine_Modes->Scale(fScaleFactor, "width");
+      if (fMCHist_Modes)
+        fMCHist_Modes->Scale(fScaleFactor, "width");
+      if (fMCFine_Modes)
+        fMCFine_Modes->Scale(fScaleFactor, "width");
+    }
   }
 
   // Proper error scaling - ROOT Freaks out with xsec weights sometimes
-  for (int i = 0; i < fMCStat->GetNbinsX(); i++) {
+  for (int i = 0; i < fMCHist->GetNbinsX(); i++) {
     fMCHist->SetBinError(i + 1, fMCHist->GetBinContent(i + 1) * statratio[i]);
   }
 
-  for (int i = 0; i < fMCFine->GetNbinsX(); i++) {
+  for (int i = 0; scaleoutputs && i < fMCFine->GetNbinsX(); i++) {
     fMCFine->SetBinError(i + 1,
                          fMCFine->GetBinContent(i + 1) * statratiofine[i]);
   }
@@ -1160,8 +1189,9 @@ double Measurement1D::GetLikelihood() {
     } else if (fIsDiag) {
       stat = StatUtils::GetChi2FromDiag(fDataHist, fMCHist, fMaskHist);
     } else if (!fIsDiag and !fIsRawEvents) {
-      stat = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fMaskHist, 1,
-                                       1E76, fIsWriting ? fResidualHist : NULL);
+      stat = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fCovarBlocks,
+                                       fMaskHist, 1, 1E76,
+                                       fIsWriting ? fResidualHist : NULL);
       if (fChi2LessBinHist && fIsWriting) {
         for (int xi = 0; xi < fDataHist->GetNbinsX(); ++xi) {
           TH1I *binmask = fMaskHist
@@ -1299,6 +1329,9 @@ void Measurement1D::SetFakeDataValues(std::string fakeOption) {
     delete fDecomp;
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
+  fCovarBlocks = StatUtils::GetCovarBlocks(covar);
+  fFullCovarBlocks = StatUtils::GetCovarBlocks(fFullCovar);
+
   delete tempdata;
 
   return;
@@ -1341,7 +1374,8 @@ void Measurement1D::ThrowCovariance() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fDataHist)
     delete fDataHist;
-  fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fDataHist =
+      StatUtils::ThrowHistogram(fDataTrue, fFullCovar, fFullCovarBlocks);
 
   return;
 };
@@ -1353,7 +1387,8 @@ void Measurement1D::ThrowDataToy() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fMCHist)
     delete fMCHist;
-  fMCHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fMCHist =
+      StatUtils::ThrowHistogram(fDataTrue, fFullCovar, fFullCovarBlocks);
 }
 
 /*
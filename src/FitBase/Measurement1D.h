@@ -609,6 +609,9 @@ protected:
   TMatrixDSym* fShapeDecomp; ///< Decomposed shape-only covariance
   TMatrixDSym* fShapeInvert; ///< Inverted shape-only covariance
 
+  StatUtils::CovarBlocks fCovarBlocks;     ///< Diagonal blocks of covar
+  StatUtils::CovarBlocks fFullCovarBlocks; ///< Diagonal blocks of fFullCovar
+
   TMatrixDSym* fCovar;    ///< New FullCovar
   TMatrixDSym* fInvert;   ///< New covar
 
@@ -47,6 +47,8 @@ Measurement2D::Measurement2D(void) {
   fResidualHist = NULL;
   fChi2LessBinHist = NULL;
 
+  fFlatInvCovar = NULL;
+
   fDefaultTypes = "FIX/FULL/CHI2";
   fAllowedTypes =
       "FIX,FREE,SHAPE/FULL,DIAG/CHI2/NORM/ENUCORR/Q2CORR/ENU1D/FITPROJX/"
@@ -142,6 +144,7 @@ Measurement2D::~Measurement2D(void) {
 
   delete fResidualHist;
   delete fChi2LessBinHist;
+  delete fFlatInvCovar;
 }
 
 //********************************************************************
@@ -525,6 +528,8 @@ void Measurement2D::ScaleCovar(double scale) {
   (*fFullCovar) *= scale;
   (*covar) *= 1.0 / scale;
   (*fDecomp) *= sqrt(scale);
+
+  InvalidateFlatBins();
 }
 
 //********************************************************************
@@ -569,6 +574,7 @@ void Measurement2D::SetBinMask(std::string maskfile) {
 
   // Apply masking by setting masked data bins to zero
   PlotUtils::MaskBins(fDataHist, fMaskHist);
+  InvalidateFlatBins();
 
   return;
 }
@@ -668,7 +674,10 @@ void Measurement2D::FinaliseMeasurement() {
 
 
   // ***** end NS covar modifications *****
- 
+
+  // Any flat inverse was built from an earlier covar or mask
+  InvalidateFlatBins();
+
   // Setup fMCHist from data
   fMCHist = (TH2D *)fDataHist->Clone();
   fMCHist->SetNameTitle((fSettings.GetName() + "_MC").c_str(),
@@ -707,6 +716,7 @@ void Measurement2D::FinaliseMeasurement() {
     fMaskHist = PlotUtils::GetTH2FromRootFile<TH2I>(fSettings.GetS("maskfile"),
                                                     fSettings.GetS("maskhist"));
     fIsMask = bool(fMaskHist);
+    InvalidateFlatBins();
     NUIS_LOG(SAM, "Loaded mask histogram: " << fSettings.GetS("maskhist")
                                             << " from "
                                             << fSettings.GetS("maskfile"));
@@ -925,6 +935,11 @@ void Measurement2D::FillHistograms() {
 
   if (Signal) {
     fMCHist->Fill(fXVar, fYVar, Weight);
+
+    // Only the likelihood histogram is needed in fit mode
+    if (fFitMode)
+      return;
+
     fMCFine->Fill(fXVar, fYVar, Weight);
     fMCStat->Fill(fXVar, fYVar, 1.0);
 
@@ -945,6 +960,9 @@ void Measurement2D::ScaleEvents() {
   // fMCWeighted->SetBinError(i + 1,   fMCHist->GetBinError(i + 1));
   // }
 
+  // Fine and mode histograms are not filled in fit mode, so leave them be
+  bool scaleoutputs = !fFitMode;
+
   // Setup Stat ratios for MC and MC Fine
   double *statratio = new double[fMCHist->GetNbinsX()];
   for (int i = 0; i < fMCHist->GetNbinsX(); i++) {
@@ -957,7 +975,7 @@ void Measurement2D::ScaleEvents() {
   }
 
   double *statratiofine = new double[fMCFine->GetNbinsX()];
-  for (int i = 0; i < fMCFine->GetNbinsX(); i++) {
+  for (int i = 0; scaleoutputs && i < fMCFine->GetNbinsX(); i++) {
     if (fMCFine->GetBinContent(i + 1) != 0) {
       statratiofine[i] =
           fMCFine->GetBinError(i + 1) / fMCFine->GetBinContent(i + 1);
@@ -971,10 +989,12 @@ void Measurement2D::ScaleEvents() {
     double datamcratio = fDataHist->Integral() / fMCHist->Integral();
 
     fMCHist->Scale(datamcratio);
-    fMCFine->Scale(datamcratio);
+    if (scaleoutputs) {
+      fMCFine->Scale(datamcratio);
 
-    if (fMCHist_Modes)
-      fMCHist_Modes->Scale(datamcratio);
+      if (fMCHist_Modes)
+        fMCHist_Modes->Scale(datamcratio);
+    }
 
     // Scaling for XSec as function of Enu
   } else if (fIsEnu1D) {
@@ -982,8 +1002,10 @@ void Measurement2D::ScaleEvents() {
     PlotUtils::FluxUnfoldedScaling(fMCHist, GetFluxHistogram(),
                                    GetEventHistogram(), fScaleFactor);
 
-    PlotUtils::FluxUnfoldedScaling(fMCFine, GetFluxHistogram(),
-                                   GetEventHistogram(), fScaleFactor);
+    if (scaleoutputs) {
+      PlotUtils::FluxUnfoldedScaling(fMCFine, GetFluxHistogram(),
+                                     GetEventHistogram(), fScaleFactor);
+    }
 
     // if (fMCHist_Modes) {
     // PlotUtils::FluxUnfoldedScaling(fMCHist_Modes, GetFluxHistogram(),
@@ -994,7 +1016,8 @@ void Measurement2D::ScaleEvents() {
     // Any other differential scaling
   } else {
     fMCHist->Scale(fScaleFactor, "width");
-    fMCFine->Scale(fScaleFactor, "width");
+    if (scaleoutputs)
+      fMCFine->Scale(fScaleFactor, "width");
 
     // if (fMCHist_Modes) fMCHist_Modes->Scale(fScaleFactor, "width");
   }
@@ -1004,7 +1027,7 @@ void Measurement2D::ScaleEvents() {
     fMCHist->SetBinError(i + 1, fMCHist->GetBinContent(i + 1) * statratio[i]);
   }
 
-  for (int i = 0; i < fMCFine->GetNbinsX(); i++) {
+  for (int i = 0; scaleoutputs && i < fMCFine->GetNbinsX(); i++) {
     fMCFine->SetBinError(i + 1,
                          fMCFine->GetBinContent(i + 1) * statratiofine[i]);
   }
@@ -1080,6 +1103,7 @@ double Measurement2D::GetLikelihood() {
   if (!fIsMask) {
     if (fMaskHist) {
       fMaskHist = NULL;
+      InvalidateFlatBins();
     }
   } else {
     if (fMaskHist) {
@@ -1130,7 +1154,8 @@ double Measurement2D::GetLikelihood() {
     } else if (fIsDiag) {
       chi2 =
           StatUtils::GetChi2FromDiag(fDataHist, fMCHist, fMapHist, fMaskHist);
-    } else {
+    } else if (FitPar::Config().GetParB("statutils.addmcerror")) {
+      // MC errors change the matrix on every call
       chi2 = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fMapHist,
                                        fMaskHist,
                                        fIsWriting ? fResidualHist : NULL);
@@ -1155,6 +1180,14 @@ double Measurement2D::GetLikelihood() {
           }
         }
       }
+    } else {
+      if (!fFlatInvCovar) {
+        SetupFlatBins();
+      }
+      chi2 = GetFlatChi2(fIsWriting ? fResidualHist : NULL);
+      if (fChi2LessBinHist && fIsWriting) {
+        FillFlatChi2LessBin(chi2);
+      }
     }
   }
 
@@ -1207,6 +1240,192 @@ double Measurement2D::GetLikelihood() {
   return chi2;
 }
 
+//********************************************************************
+void Measurement2D::SetupFlatBins() {
+  //********************************************************************
+
+  if (!fMapHist) {
+    fMapHist = StatUtils::GenerateMap(fDataHist);
+  }
+
+  int nx = fDataHist->GetNbinsX();
+  int ny = fDataHist->GetNbinsY();
+
+  // Covariance rows follow the map, masked bins are dropped the same way
+  // StatUtils::ApplyMatrixMasking drops them
+  std::vector<int> mapped(covar->GetNrows(), -1);
+  std::vector<bool> masked(covar->GetNrows(), false);
+  int nmapped = 0;
+  for (int xi = 0; xi < nx; ++xi) {
+    for (int yi = 0; yi < ny; ++yi) {
+      int index = fMapHist->GetBinContent(xi + 1, yi + 1);
+      if (index <= 0) {
+        continue;
+      }
+      nmapped++;
+      if (index > int(mapped.size())) {
+        continue;
+      }
+      mapped[index - 1] = fDataHist->GetBin(xi + 1, yi + 1);
+      masked[index - 1] =
+          fMaskHist && fMaskHist->GetBinContent(xi + 1, yi + 1);
+    }
+  }
+
+  if (nmapped != covar->GetNrows()) {
+    NUIS_ERR(WRN, "Inconsistent matrix and data histogram in " << fName);
+    NUIS_ABORT("data_hist has " << nmapped << " mapped bins, matrix has "
+                                << covar->GetNrows() << " bins");
+  }
+
+  fFlatBins.clear();
+  fFlatIndex.assign(fDataHist->GetNcells(), -1);
+  for (size_t i = 0; i < mapped.size(); ++i) {
+    if (masked[i]) {
+      continue;
+    }
+    if (mapped[i] >= 0) {
+      fFlatIndex[mapped[i]] = fFlatBins.size();
+    }
+    fFlatBins.push_back(mapped[i]);
+  }
+
+  delete fFlatInvCovar;
+  if (fMaskHist) {
+    TH1I *mask_1D = StatUtils::MapToMask(fMaskHist, fMapHist);
+    fFlatInvCovar = StatUtils::ApplyInvertedMatrixMasking(covar, mask_1D);
+    delete mask_1D;
+  } else {
+    fFlatInvCovar = new TMatrixDSym(*covar);
+  }
+
+  size_t nflat = fFlatBins.size();
+  fFlatDiff.assign(nflat, 0);
+  fFlatWeight.assign(nflat, 0);
+  fFlatRowSum.assign(nflat, 0);
+  fFlatColSum.assign(nflat, 0);
+}
+
+//********************************************************************
+void Measurement2D::InvalidateFlatBins() {
+  //********************************************************************
+  delete fFlatInvCovar;
+  fFlatInvCovar = NULL;
+}
+
+//********************************************************************
+double Measurement2D::GetFlatChi2(TH2D *residuals) {
+  //********************************************************************
+
+  static bool first = true;
+  static bool UseSVDDecomp = false;
+  if (first) {
+    UseSVDDecomp = FitPar::Config().GetParB("UseSVDInverse");
+    first = false;
+  }
+
+  // Same terms, scaling and order as StatUtils::GetChi2FromCov
+  double const covar_scale = 1E76;
+  int nflat = fFlatBins.size();
+  for (int i = 0; i < nflat; ++i) {
+    double data_i = 0;
+    double mc_i = 0;
+    if (fFlatBins[i] >= 0) {
+      data_i = fDataHist->GetBinContent(fFlatBins[i]);
+      mc_i = fMCHist->GetBinContent(fFlatBins[i]);
+    }
+    fFlatDiff[i] = data_i - mc_i;
+    fFlatWeight[i] = (data_i != 0 && mc_i != 0) ? fFlatDiff[i] : 0;
+  }
+
+  if (residuals) {
+    residuals->Reset();
+  }
+
+  const double *el = fFlatInvCovar->GetMatrixArray();
+  double chi2 = 0;
+  for (int i = 0; i < nflat; ++i) {
+    if (fFlatWeight[i] == 0) {
+      continue;
+    }
+
+    double ibin_contrib = 0;
+    for (int j = 0; j < nflat; ++j) {
+      double cov_ij = el[i * nflat + j] * covar_scale;
+      if (cov_ij == 0) {
+        continue;
+      }
+
+      double bin_cont = fFlatDiff[i] * cov_ij * fFlatDiff[j];
+      if (!UseSVDDecomp && (i == j) && (cov_ij < 0)) {
+        NUIS_ABORT("Found negative diagonal covariance element: Covar("
+                   << i << ", " << j << ") = " << cov_ij
+                   << " would contribute: " << bin_cont << " on top of: "
+                   << chi2);
+      }
+
+      chi2 += bin_cont;
+      ibin_contrib += bin_cont;
+    }
+
+    if (residuals && fFlatBins[i] >= 0) {
+      residuals->SetBinContent(fFlatBins[i], ibin_contrib);
+    }
+  }
+
+  return chi2;
+}
+
+//********************************************************************
+void Measurement2D::FillFlatChi2LessBin(double chi2) {
+  //********************************************************************
+
+  NUIS_LOG(SAM, "Building n-1 chi2 contribution plot for " << GetName());
+
+  // Removing bin k from the covariance changes its inverse A by the rank-one
+  // Schur complement A - A[:,k] A[k,:] / A[k][k], so with w the diff of bins
+  // with data and MC, d the diff of all bins, q = A d and p = w A:
+  //   chi2_k = chi2 - w_k q_k - p_k d_k + w_k A_kk d_k
+  //                 - (p_k - w_k A_kk) (q_k - A_kk d_k) / A_kk
+  double const covar_scale = 1E76;
+  int nflat = fFlatBins.size();
+  const double *el = fFlatInvCovar->GetMatrixArray();
+
+  fFlatRowSum.assign(nflat, 0);
+  fFlatColSum.assign(nflat, 0);
+  for (int i = 0; i < nflat; ++i) {
+    for (int j = 0; j < nflat; ++j) {
+      double cov_ij = el[i * nflat + j] * covar_scale;
+      fFlatRowSum[i] += cov_ij * fFlatDiff[j];
+      fFlatColSum[j] += fFlatWeight[i] * cov_ij;
+    }
+  }
+
+  // Bins outside the chi2 don't change it when removed
+  fChi2LessBinHist->Reset();
+  for (int xi = 0; xi < fDataHist->GetNbinsX(); ++xi) {
+    for (int yi = 0; yi < fDataHist->GetNbinsY(); ++yi) {
+      int k = fFlatIndex[fDataHist->GetBin(xi + 1, yi + 1)];
+      if (k < 0) {
+        fChi2LessBinHist->SetBinContent(xi + 1, yi + 1, chi2);
+        continue;
+      }
+
+      double a_kk = el[k * nflat + k] * covar_scale;
+      double w_k = fFlatWeight[k];
+      double d_k = fFlatDiff[k];
+      double q_k = fFlatRowSum[k];
+      double p_k = fFlatColSum[k];
+
+      double chi2_k = chi2 - w_k * q_k - p_k * d_k + w_k * a_kk * d_k;
+      if (a_kk != 0) {
+        chi2_k -= (p_k - w_k * a_kk) * (q_k - a_kk * d_k) / a_kk;
+      }
+      fChi2LessBinHist->SetBinContent(xi + 1, yi + 1, chi2_k);
+    }
+  }
+}
+
 /*
   Fake Data Functions
 */
@@ -1284,6 +1503,8 @@ void Measurement2D::SetFakeDataValues(std::string fakeOption) {
     delete fDecomp;
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
+  InvalidateFlatBins();
+
   delete tempdata;
 
   return;
@@ -34,6 +34,7 @@
 #include <sstream>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 // ROOT includes
 #include <TArrayF.h>
@@ -387,6 +388,23 @@ public:
   /// Diferent likelihoods definitions are used depending on the FitOptions.
   virtual double GetLikelihood(void);
 
+  //! Build the flat bin map and the inverse covariance over it, with masked
+  //! bins removed, used by GetFlatChi2
+  void SetupFlatBins();
+
+  //! Drop the flat inverse covariance so the next likelihood rebuilds it.
+  //! Must be called whenever covar or fMaskHist change after
+  //! FinaliseMeasurement.
+  void InvalidateFlatBins();
+
+  //! Covariance chi2 over the flat bins without mapping to 1D histograms.
+  //! Per bin contributions are filled into residuals if given.
+  double GetFlatChi2(TH2D *residuals);
+
+  //! Fill fChi2LessBinHist with the chi2 without each bin, from rank-one
+  //! updates of the flat inverse covariance. chi2 is from GetFlatChi2.
+  void FillFlatChi2LessBin(double chi2);
+
   /*
     Fake Data
   */
@@ -569,6 +587,14 @@ protected:
   TH2D *fResidualHist;
   TH2D *fChi2LessBinHist;
 
+  std::vector<int> fFlatBins;  //!< Global 2D bin of each flat bin in the chi2
+  std::vector<int> fFlatIndex; //!< Flat bin of each global 2D bin, or -1
+  TMatrixDSym *fFlatInvCovar;  //!< covar over fFlatBins, masked bins removed
+  std::vector<double> fFlatDiff;   //!< Scratch, data - MC
+  std::vector<double> fFlatWeight; //!< Scratch, fFlatDiff if data and MC != 0
+  std::vector<double> fFlatRowSum; //!< Scratch, fFlatInvCovar * fFlatDiff
+  std::vector<double> fFlatColSum; //!< Scratch, fFlatWeight * fFlatInvCovar
+
   bool fIsFakeData;         //!< is current data actually fake
   std::string fakeDataFile; //!< MC fake data input file
 
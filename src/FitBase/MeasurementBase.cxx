@@ -31,6 +31,8 @@ MeasurementBase::MeasurementBase(void) {
   fScaleFactor = 1.0;
   fMCFilled = false;
   fNoData = false;
+  fFitMode = false;
+  fStaleOutputs = false;
   fInput = NULL;
   NSignal = 0;
 
@@ -42,6 +44,9 @@ MeasurementBase::MeasurementBase(void) {
   fMeasurementSpeciesType = kSingleSpeciesMeasurement;
   fEventVariables = NULL;
   fIsJoint = false;
+  for (int i = 0; i < kNProfileStages; i++) {
+    fProfileStages[i] = NULL;
+  }
 
   fNPOT = 0xdeadbeef;
   fFluxIntegralOverride = 0xdeadbeef;
@@ -210,8 +215,11 @@ void MeasurementBase::Reconfigure() {
 
   NUIS_LOG(REC, " Reconfiguring sample " << fName);
 
-  // Reset Histograms
-  ResetExtraHistograms();
+  // Reset Histograms. Auto-processed histograms are kept up to date in fit
+  // mode, as some samples build fMCHist from them.
+  if (!fFitMode) {
+    ResetExtraHistograms();
+  }
   AutoResetExtraTH1();
   this->ResetAll();
 
@@ -237,8 +245,15 @@ void MeasurementBase::Reconfigure() {
     Mode = cust_event->Mode;
 
     // Extract Measurement Variables
-    this->FillEventVariables(cust_event);
-    Signal = this->isSignal(cust_event);
+    {
+      ProfileUtils::ScopedTimer timer(GetProfileStage(kProfEventVariables));
+      this->FillEventVariables(cust_event);
+    }
+    {
+      ProfileUtils::ScopedTimer timer(GetProfileStage(kProfSignal));
+      Signal = this->isSignal(cust_event);
+    }
+    ProfileUtils::CountSignal(GetProfileStage(kProfSignal), Signal);
     if (Signal)
       npassed++;
 
@@ -283,11 +298,13 @@ void MeasurementBase::Reconfigure() {
 
   // Finalise Histograms
   fMCFilled = true;
+  ProfileUtils::ScopedTimer timer(GetProfileStage(kProfConvertEventRates));
   this->ConvertEventRates();
 }
 
 void MeasurementBase::FillHistogramsFromBox(MeasurementVariableBox *var,
                                             double weight) {
+  ProfileUtils::ScopedTimer timer(GetProfileStage(kProfFillHistograms));
   fXVar = var->GetX();
   fYVar = var->GetY();
   fZVar = var->GetZ();
@@ -295,13 +312,16 @@ void MeasurementBase::FillHistogramsFromBox(MeasurementVariableBox *var,
   fEventVariables = var;
 
   FillHistograms();
-  FillExtraHistograms(var, weight);
+  if (!fFitMode)
+    FillExtraHistograms(var, weight);
 }
 
 void MeasurementBase::FillHistograms(double weight) {
+  ProfileUtils::ScopedTimer timer(GetProfileStage(kProfFillHistograms));
   Weight = weight * GetBox()->GetSampleWeight();
   FillHistograms();
-  FillExtraHistograms(GetBox(), Weight);
+  if (!fFitMode)
+    FillExtraHistograms(GetBox(), Weight);
 }
 
 MeasurementVariableBox *MeasurementBase::FillVariableBox(FitEvent *event) {
@@ -309,7 +329,10 @@ MeasurementVariableBox *MeasurementBase::FillVariableBox(FitEvent *event) {
   Mode = event->Mode;
   Weight = 1.0; // event->Weight;
 
-  this->FillEventVariables(event);
+  {
+    ProfileUtils::ScopedTimer timer(GetProfileStage(kProfEventVariables));
+    this->FillEventVariables(event);
+  }
   Signal = this->isSignal(event);
 
   GetBox()->FillBoxFromEvent(event);
@@ -324,6 +347,20 @@ MeasurementVariableBox *MeasurementBase::FillVariableBox(FitEvent *event) {
   return GetBox();
 }
 
+ProfileUtils::Stage *MeasurementBase::GetProfileStage(ProfileStage stage) {
+  if (!ProfileUtils::IsEnabled())
+    return NULL;
+
+  if (!fProfileStages[stage]) {
+    static char const *names[kNProfileStages] = {
+        "FillEventVariables", "isSignal", "FillHistograms",
+        "ConvertEventRates", "GetLikelihood"};
+    fProfileStages[stage] =
+        ProfileUtils::GetStage("sample/" + fName + "/" + names[stage]);
+  }
+  return fProfileStages[stage];
+}
+
 MeasurementVariableBox *MeasurementBase::GetBox() {
   if (!fEventVariables)
     fEventVariables = CreateBox();
@@ -340,8 +377,12 @@ void MeasurementBase::ReconfigureFast() {
 void MeasurementBase::ConvertEventRates() {
   //***********************************************
 
+  // Extra histograms are output only, they are skipped entirely in fit mode
+  fStaleOutputs = fFitMode;
   AutoScaleExtraTH1();
-  ScaleExtraHistograms(GetBox());
+  if (!fFitMode) {
+    ScaleExtraHistograms(GetBox());
+  }
   this->ScaleEvents();
 
   double normval = fRW->GetSampleNorm(this->fName);
@@ -354,7 +395,9 @@ void MeasurementBase::ConvertEventRates() {
     normval = 1.0;
   }
   AutoNormExtraTH1(normval);
-  NormExtraHistograms(GetBox(), normval);
+  if (!fFitMode) {
+    NormExtraHistograms(GetBox(), normval);
+  }
   this->ApplyNormScale(normval);
 }
 
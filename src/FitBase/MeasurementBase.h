@@ -74,6 +74,7 @@
 #include "InputHandler.h"
 #include "NuisConfig.h"
 #include "NuisKey.h"
+#include "ProfileUtils.h"
 #include "SampleSettings.h"
 #include "StackBase.h"
 #include "StandardStacks.h"
@@ -214,6 +215,17 @@ public:
   virtual MeasurementVariableBox* GetBox();
 
   void FillHistogramsFromBox(MeasurementVariableBox* var, double weight);
+
+  ///! In fit mode only the histograms used by GetLikelihood are filled, fine,
+  /// mode and extra histograms are left stale until a full reconfigure.
+  /// Auto-processed (SetAutoProcessTH1) histograms are still reset, scaled and
+  /// normalised, as samples may build fMCHist from them.
+  virtual void SetFitMode(bool fitmode) { fFitMode = fitmode; };
+  bool IsFitMode() const { return fFitMode; };
+
+  ///! True if the last reconfigure ran in fit mode, so the output-only
+  /// histograms need a full reconfigure before Write.
+  bool HasStaleOutputs() const { return fStaleOutputs; };
   /*
     Histogram Access Functions
   */
@@ -241,6 +253,18 @@ public:
   std::string GetName(void) { return fName; };
   double GetScaleFactor(void) { return fScaleFactor; };
 
+  ///! Event loop stages of this sample timed by ProfileUtils
+  enum ProfileStage {
+    kProfEventVariables = 0,
+    kProfSignal,
+    kProfFillHistograms,
+    kProfConvertEventRates,
+    kProfLikelihood,
+    kNProfileStages
+  };
+  ///! ProfileUtils stage for this sample, NULL if profiling is disabled.
+  ProfileUtils::Stage* GetProfileStage(ProfileStage stage);
+
   double GetXVar(void) { return fXVar; };
   double GetYVar(void) { return fYVar; };
   double GetZVar(void) { return fZVar; };
@@ -322,6 +346,8 @@ protected:
   //! ApplyNormalisation)
   bool fNoData;      //!< flag whether data plots do not exist (for ratios)
   bool fIsNoWidth;    ///< Flag : Don't scale by bin width
+  bool fFitMode;      ///< Flag : Only fill likelihood histograms
+  bool fStaleOutputs; ///< Flag : Output-only histograms skipped by fit mode
 
   // TEMP OBJECTS TO HANDLE MERGE
   double fXVar, fYVar, fZVar, Mode, Weight;
@@ -339,6 +365,7 @@ protected:
   SampleSettings fSettings;
 
   MeasurementVariableBox* fEventVariables;
+  ProfileUtils::Stage* fProfileStages[kNProfileStages];
 
   std::map<StackBase*, std::vector<int> > fExtraTH1s;
   int NSignal;
@@ -235,6 +235,7 @@ double BaseFitEvt::GetWeight() {
 void BaseFitEvt::SetNeutVect(NeutVect *v) {
   fType = kNEUT;
   fNeutVect = v;
+  fInvariants.Reset();
 }
 #endif
 
@@ -242,6 +243,7 @@ void BaseFitEvt::SetNeutVect(NeutVect *v) {
 void BaseFitEvt::SetGenieEvent(NtpMCEventRecord *ntpl) {
   fType = kGENIE;
   genie_event = ntpl;
+  fInvariants.Reset();
 }
 #endif
 
@@ -249,6 +251,7 @@ void BaseFitEvt::SetGenieEvent(NtpMCEventRecord *ntpl) {
 void BaseFitEvt::SetNuanceEvent(NuanceEvent *e) {
   fType = kNUANCE;
   nuance_event = e;
+  fInvariants.Reset();
 }
 #endif
 
@@ -54,6 +54,7 @@ class GENIEInputHandler;
 #include "SplineReader.h"
 #include "InputTypes.h"
 #include "GeneratorInfoBase.h"
+#include "EventInvariants.h"
 
 /// Base Event Class used to store just the generator event pointers
 class BaseFitEvt {
@@ -99,6 +100,9 @@ class BaseFitEvt {
   GeneratorInfoBase* fGenInfo; ///< Generator Variable Box
   UInt_t fType; ///< Generator Event Type
 
+  // Shared Kinematics
+  EventInvariants fInvariants; ///< Reset whenever a new event is loaded
+
 #ifdef NEUT_ENABLED
   /// Setup Event Reading from NEUT Event
   void SetNeutVect(NeutVect* v);
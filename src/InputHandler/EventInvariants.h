@@ -0,0 +1,77 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef EVENTINVARIANTS_H_SEEN
+#define EVENTINVARIANTS_H_SEEN
+/*!
+ *  \addtogroup InputHandler
+ *  @{
+ */
+
+/// Kinematic invariants shared by the reweight calculators. Filled by
+/// FitEvent::GetInvariants() the first time they are asked for after an
+/// event is loaded, so the stack is only scanned once per event rather than
+/// once per calculator. Energies are in GeV, missing values are -999.
+struct EventInvariants {
+
+  /// Initial nucleon pair of a 2p2h event
+  enum PairClass {
+    kPairUnknown = -1,
+    kPairSame = 1, ///< pp or nn
+    kPairNP = 2    ///< np
+  };
+
+  EventInvariants() { Reset(); };
+
+  /// Mark as not filled
+  inline void Reset() {
+    filled = false;
+#ifdef GENIE_ENABLED
+    genie = false;
+#endif
+  };
+
+  bool filled;
+
+  // From the NUISANCE particle stack
+  int probe;     ///< Stack index of the incoming neutrino, -1 if missing
+  int lepton;    ///< Stack index of the outgoing lepton, -1 if missing
+  double q0;     ///< |Energy transfer|
+  double q3;     ///< |Three-momentum transfer|
+  double Q2;     ///< Four-momentum transfer squared
+  double W;      ///< Hadronic invariant mass for a proton at rest
+  int targetA;
+  int targetZ;
+  int pairclass; ///< PairClass of abs(Mode) == 2 events
+
+#ifdef GENIE_ENABLED
+  // From the GHepRecord, only set for GENIE events
+  bool genie;
+  int genie_probe;     ///< GHep index of the probe, -1 if missing
+  int genie_lepton;    ///< GHep index of the primary lepton, -1 if missing
+  int genie_probepdg;
+  int genie_targetpdg; ///< 0 without a target nucleus
+  double genie_q0;
+  double genie_q3;
+  double genie_Q2;     ///< |Four-momentum transfer squared|
+  double genie_W;      ///< Hadronic invariant mass for a proton at rest
+#endif
+};
+
+/*! @} */
+#endif
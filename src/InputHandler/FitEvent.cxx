@@ -20,6 +20,14 @@
 #include "TObjArray.h"
 #include <iostream>
 
+#ifdef GENIE_ENABLED
+#ifdef GENIE3_API_ENABLED
+#include "Framework/GHEP/GHepParticle.h"
+#else
+#include "GHEP/GHepParticle.h"
+#endif
+#endif
+
 FitEvent::FitEvent() {
   fGenInfo = NULL;
   kRemoveFSIParticles = true;
@@ -130,6 +138,7 @@ void FitEvent::ResetEvent() {
   fTargetH = -1;
   fBound = false;
   fNParticles = 0;
+  fInvariants.Reset();
 
   if (fGenInfo)
     fGenInfo->Reset();
@@ -159,6 +168,53 @@ void FitEvent::ResetEvent() {
   }
 }
 
+void FitEvent::CopyEventFrom(FitEvent const &other) {
+  ResetEvent();
+
+  if (kMaxParticles < other.kMaxParticles) {
+    ExpandParticleStack(other.kMaxParticles);
+  }
+
+  Mode = other.Mode;
+  probe_E = other.probe_E;
+  probe_pdg = other.probe_pdg;
+
+  Weight = other.Weight;
+  InputWeight = other.InputWeight;
+  RWWeight = other.RWWeight;
+  CustomWeight = other.CustomWeight;
+  SavedRWWeight = other.SavedRWWeight;
+  for (int i = 0; i < 6; ++i) {
+    CustomWeightArray[i] = other.CustomWeightArray[i];
+  }
+  fType = other.fType;
+
+  fEventNo = other.fEventNo;
+  fTotCrs = other.fTotCrs;
+  fTargetA = other.fTargetA;
+  fTargetZ = other.fTargetZ;
+  fTargetH = other.fTargetH;
+  fBound = other.fBound;
+  fDistance = other.fDistance;
+  fTargetPDG = other.fTargetPDG;
+  fResCode = other.fResCode;
+  fInvariants = other.fInvariants;
+
+  fNParticles = other.fNParticles;
+  for (int i = 0; i < fNParticles; i++) {
+    fParticlePDG[i] = other.fParticlePDG[i];
+    fParticleState[i] = other.fParticleState[i];
+    fPrimaryVertex[i] = other.fPrimaryVertex[i];
+    fOrigParticlePDG[i] = other.fOrigParticlePDG[i];
+    fOrigParticleState[i] = other.fOrigParticleState[i];
+    fOrigPrimaryVertex[i] = other.fOrigPrimaryVertex[i];
+    for (int j = 0; j < 4; j++) {
+      fParticleMom[i][j] = other.fParticleMom[i][j];
+      fOrigParticleMom[i][j] = other.fOrigParticleMom[i][j];
+    }
+  }
+}
+
 void FitEvent::OrderStack() {
   // Copy current stack
   int npart = fNParticles;
@@ -537,4 +593,84 @@ double FitEvent::GetQ2() {
     (lepton->P4() - neutrino->P4()) / 1.E6;
   return Q2;
 }
+
+//********************************************************************
+// Fills the kinematic invariants shared by the reweight calculators
+void FitEvent::FillInvariants() {
+  EventInvariants &inv = fInvariants;
+
+  inv.probe = GetBeamNeutrinoIndex();
+  inv.lepton = (inv.probe == -1) ? -1 : GetLeptonIndex();
+  inv.targetA = fTargetA;
+  inv.targetZ = fTargetZ;
+  inv.q0 = inv.q3 = inv.Q2 = inv.W = -999;
+
+  if (inv.probe != -1 && inv.lepton != -1) {
+    double const *k1 = fParticleMom[inv.probe];
+    double const *k2 = fParticleMom[inv.lepton];
+    TLorentzVector q(k1[0] - k2[0], k1[1] - k2[1], k1[2] - k2[2],
+                     k1[3] - k2[3]);
+    q *= 1.E-3;
+
+    inv.q0 = fabs(q.E());
+    inv.q3 = q.Vect().Mag();
+    inv.Q2 = -q.Mag2();
+
+    const double m_p = PhysConst::mass_proton;
+    double W2 = m_p * m_p + 2 * m_p * q.E() - inv.Q2;
+    if (W2 >= 0) inv.W = sqrt(W2);
+  }
+
+  // Initial nucleon pair for 2p2h
+  inv.pairclass = EventInvariants::kPairUnknown;
+  if (abs(Mode) == 2) {
+    int npr = 0;
+    int nne = 0;
+    for (int i = 0; i < fNParticles; i++) {
+      if (fParticleState[i] == kFinalState) continue;
+      if (fParticlePDG[i] == 2212) npr++;
+      else if (fParticlePDG[i] == 2112) nne++;
+    }
+
+    if (npr == 1 && nne == 1) {
+      inv.pairclass = EventInvariants::kPairNP;
+    } else if ((npr == 0 && nne == 2) || (npr == 2 && nne == 0)) {
+      inv.pairclass = EventInvariants::kPairSame;
+    }
+  }
+
+#ifdef GENIE_ENABLED
+  // Same again from the GENIE record, which lightweight reads still have
+  inv.genie = false;
+  if (fType == kGENIE && genie_event && genie_event->event) {
+    GHepRecord *ghep = static_cast<GHepRecord *>(genie_event->event);
+    inv.genie = true;
+
+    inv.genie_probe = ghep->ProbePosition();
+    inv.genie_lepton = ghep->FinalStatePrimaryLeptonPosition();
+    int tgtpos = ghep->TargetNucleusPosition();
+    GHepParticle *neutrino =
+        (inv.genie_probe == -1) ? NULL : ghep->Particle(inv.genie_probe);
+    GHepParticle *fsl =
+        (inv.genie_lepton == -1) ? NULL : ghep->Particle(inv.genie_lepton);
+
+    inv.genie_probepdg = neutrino ? neutrino->Pdg() : 0;
+    inv.genie_targetpdg = (tgtpos == -1) ? 0 : ghep->Particle(tgtpos)->Pdg();
+    inv.genie_q0 = inv.genie_q3 = inv.genie_Q2 = inv.genie_W = -999;
+
+    if (neutrino && fsl) {
+      TLorentzVector q = *(neutrino->P4()) - *(fsl->P4());
+      inv.genie_q0 = fabs(q.E());
+      inv.genie_q3 = fabs(q.Vect().Mag());
+      inv.genie_Q2 = fabs(q.Mag2());
+
+      const double m_p = PhysConst::mass_proton;
+      double W2 = m_p * m_p + 2 * m_p * q.E() + q.Mag2();
+      if (W2 >= 0) inv.genie_W = sqrt(W2);
+    }
+  }
+#endif
+
+  inv.filled = true;
+}
 //********************************************************************
@@ -59,6 +59,9 @@ public:
   void AllocateParticleStack(int stacksize);
   void ExpandParticleStack(int stacksize);
   void AddGeneratorInfo(GeneratorInfoBase* gen);
+  /// Copy the event information, weights and particle stack from another
+  /// event. Generator record pointers are not copied.
+  void CopyEventFrom(FitEvent const& other);
 
 
   // ---- HELPER/ACCESS FUNCTIONS ---- //
@@ -686,6 +689,14 @@ public:
 
   double GetQ2();
 
+  /// Kinematic invariants for the reweight calculators, filled on the first
+  /// call after the event is loaded
+  inline EventInvariants const &GetInvariants() {
+    if (!fInvariants.filled) FillInvariants();
+    return fInvariants;
+  };
+  void FillInvariants();
+
 
   // Event Information
   UInt_t fEventNo;
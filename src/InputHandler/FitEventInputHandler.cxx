@@ -80,20 +80,21 @@ FitEventInputHandler::FitEventInputHandler(std::string const &handle,
 }
 
 FitEventInputHandler::~FitEventInputHandler() {
+  StopReadAhead();
   if (fFitEventTree)
     delete fFitEventTree;
 }
 
 void FitEventInputHandler::CreateCache() {
-  //    fFitEventTree->SetCacheEntryRange(0, fNEvents);
-  //    fFitEventTree->AddBranchToCache("*", 1);
-  //    fFitEventTree->SetCacheSize(fCacheSize);
+  if (fCacheSize > 0) {
+    fFitEventTree->SetCacheSize(fCacheSize);
+    fFitEventTree->AddBranchToCache("*", 1);
+  }
 }
 
 void FitEventInputHandler::RemoveCache() {
-  // fFitEventTree->SetCacheEntryRange(0, fNEvents);
-  //    fFitEventTree->AddBranchToCache("*", 0);
-  //    fFitEventTree->SetCacheSize(0);
+  StopReadAhead();
+  fFitEventTree->SetCacheSize(0);
 }
 
 FitEvent *FitEventInputHandler::GetNuisanceEvent(const UInt_t entry,
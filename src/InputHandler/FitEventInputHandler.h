@@ -40,6 +40,9 @@ public:
 	/// Remove TTree Cache to save memory
 	void RemoveCache();
 
+	/// Events are fully described by the tree, so can be read ahead
+	bool SupportsReadAhead() { return true; };
+
 	/// Returns NUISANCE FitEvent from the TTree. If lightweight does nothing.
 	FitEvent* GetNuisanceEvent(const UInt_t entry, const bool lightweight=false);
 
@@ -324,31 +324,6 @@ FitEvent *GENIEInputHandler::GetNuisanceEvent(const UInt_t ent,
   return fNUISANCEEvent;
 }
 
-#ifdef nusystematics_ENABLED
-systtools::event_unit_response_w_cv_t *
-GENIEInputHandler::nusystematics_GetCachedResponse(Long64_t itree_ent) {
-  // ev index 5
-  // response_cache[5] is the 6th event. So have cached if response_cache.size()
-  // > 5
-  if (Long64_t(response_has_cached.size()) <= itree_ent) {
-    return nullptr;
-  }
-  return response_has_cached[itree_ent] ? &response_cache[itree_ent] : nullptr;
-}
-void GENIEInputHandler::nusystematics_CacheResponse(
-    Long64_t itree_ent, systtools::event_unit_response_w_cv_t &&er) {
-  // ev index 5
-  // response_cache[5] is the 6th event. So need more space if
-  // response_cache.size()
-  // <= 5
-  if (Long64_t(response_cache.size()) <= itree_ent) {
-    response_cache.resize(itree_ent+1);
-    response_has_cached.resize(itree_ent+1);
-  }
-  response_cache[itree_ent] = std::move(er);
-  response_has_cached[itree_ent] = true;
-}
-#endif
 
 int GENIEInputHandler::GetGENIEParticleStatus(genie::GHepParticle *p,
                                               int mode) {
@@ -38,7 +38,9 @@
 #endif
 
 #ifdef nusystematics_ENABLED
-#include "systematicstools/interface/EventResponse_product.hh"
+#include <memory>
+
+class nusystematicsResponseTable;
 #endif
 
 using namespace genie;
@@ -113,12 +115,9 @@ public:
   bool IsPrimary(GHepParticle *p);
 
 #ifdef nusystematics_ENABLED
-  std::vector<systtools::event_unit_response_w_cv_t> response_cache;
-  std::vector<bool> response_has_cached;
-  systtools::event_unit_response_w_cv_t *
-  nusystematics_GetCachedResponse(Long64_t itree_ent);
-  void nusystematics_CacheResponse(Long64_t itree_ent,
-                                   systtools::event_unit_response_w_cv_t &&);
+  /// nusystematicsResponseTable for the events read by this handler, owned
+  /// here so it lives as long as the entries it indexes
+  std::shared_ptr<nusystematicsResponseTable> nusystematics_ResponseTable;
 #endif
 };
 /*! @} */
@@ -19,6 +19,8 @@
 #include "GenericVectorsInputHandler.h"
 #include "InputUtils.h"
 
+#include <algorithm>
+
 GenericVectorsInputHandler::GenericVectorsInputHandler(std::string const &handle,
                                            std::string const &rawinputs) {
   NUIS_LOG(SAM, "Creating GenericVectorsInputHandler : " << handle);
@@ -28,6 +30,9 @@ GenericVectorsInputHandler::GenericVectorsInputHandler(std::string const &handle
   fFitEventTree = new TChain("FlatTree_VARS");
   fCacheSize = FitPar::Config().GetParI("CacheSize");
 
+  // Largest particle multiplicities in any input
+  int maxfsp = 0, maxinitp = 0, maxvertp = 0;
+
   std::vector<std::string> inputs = InputUtils::ParseInputFileList(rawinputs);
   for (size_t inp_it = 0; inp_it < inputs.size(); ++inp_it) {
     // Open File for histogram access
@@ -50,6 +55,16 @@ GenericVectorsInputHandler::GenericVectorsInputHandler(std::string const &handle
     }
     int nevents = eventtree->GetEntries();
 
+    if (eventtree->GetBranch("nfsp")) {
+      maxfsp = std::max(maxfsp, int(eventtree->GetMaximum("nfsp")));
+    }
+    if (eventtree->GetBranch("ninitp")) {
+      maxinitp = std::max(maxinitp, int(eventtree->GetMaximum("ninitp")));
+    }
+    if (eventtree->GetBranch("nvertp")) {
+      maxvertp = std::max(maxvertp, int(eventtree->GetMaximum("nvertp")));
+    }
+
     // Register input to form flux/event rate hists
     RegisterJointInput(inputs[inp_it], nevents, fluxhist, eventhist);
 
@@ -67,36 +82,43 @@ GenericVectorsInputHandler::GenericVectorsInputHandler(std::string const &handle
   fNUISANCEEvent = new FitEvent();
   fNUISANCEEvent->HardReset();
 
+  char const *required[] = {"Mode", "tgt",    "nfsp",        "px",
+                            "py",   "pz",     "E",           "pdg",
+                            "Weight", "RWWeight", "InputWeight"};
+  for (size_t i = 0; i < sizeof(required) / sizeof(required[0]); ++i) {
+    if (!fFitEventTree->GetBranch(required[i])) {
+      NUIS_ABORT("Flat tree input " << rawinputs << " has no \""
+                                    << required[i]
+                                    << "\" branch, was it dropped with "
+                                       "nuisflat_DropBranches?");
+    }
+  }
+
+  if ((maxfsp + maxinitp + maxvertp) > int(fNUISANCEEvent->kMaxParticles)) {
+    fNUISANCEEvent->ExpandParticleStack(maxfsp + maxinitp + maxvertp);
+  }
+
+  FlatTreeTargetA = FlatTreeTargetZ = 0;
   fFitEventTree->SetBranchAddress("Mode", &FlatTreeMode);
-  fFitEventTree->SetBranchAddress("tgta", &FlatTreeTargetA);
-  fFitEventTree->SetBranchAddress("tgtz", &FlatTreeTargetZ);
+  if (fFitEventTree->GetBranch("tgta")) {
+    fFitEventTree->SetBranchAddress("tgta", &FlatTreeTargetA);
+  }
+  if (fFitEventTree->GetBranch("tgtz")) {
+    fFitEventTree->SetBranchAddress("tgtz", &FlatTreeTargetZ);
+  }
   fFitEventTree->SetBranchAddress("tgt", &FlatTreeTargetPDG);
 
-
   // Save outgoing particle vectors
-  fFitEventTree->SetBranchAddress("nfsp", &nfsp);
-  fFitEventTree->SetBranchAddress("px", px_fsp);
-  fFitEventTree->SetBranchAddress("py", py_fsp);
-  fFitEventTree->SetBranchAddress("pz", pz_fsp);
-  fFitEventTree->SetBranchAddress("E", E_fsp);
-  fFitEventTree->SetBranchAddress("pdg", pdg_fsp);
-  // fFitEventTree->SetBranchAddress("pdg_rank", pdg_fsp);
+  SetParticleBranches("nfsp", nfsp, maxfsp, "", px_fsp, py_fsp, pz_fsp, E_fsp,
+                      pdg_fsp);
 
   // Save init particle vectors
-  fFitEventTree->SetBranchAddress("ninitp", &ninitp);
-  fFitEventTree->SetBranchAddress("px_init", px_init);
-  fFitEventTree->SetBranchAddress("py_init", py_init);
-  fFitEventTree->SetBranchAddress("pz_init", pz_init);
-  fFitEventTree->SetBranchAddress("E_init", E_init);
-  fFitEventTree->SetBranchAddress("pdg_init", pdg_init);
+  SetParticleBranches("ninitp", ninitp, maxinitp, "_init", px_init, py_init,
+                      pz_init, E_init, pdg_init);
 
   // Save pre-FSI vectors
-  fFitEventTree->SetBranchAddress("nvertp", &nvertp);
-  fFitEventTree->SetBranchAddress("px_vert", px_vert);
-  fFitEventTree->SetBranchAddress("py_vert", py_vert);
-  fFitEventTree->SetBranchAddress("pz_vert", pz_vert);
-  fFitEventTree->SetBranchAddress("E_vert", E_vert);
-  fFitEventTree->SetBranchAddress("pdg_vert", pdg_vert);
+  SetParticleBranches("nvertp", nvertp, maxvertp, "_vert", px_vert, py_vert,
+                      pz_vert, E_vert, pdg_vert);
 
   fFitEventTree->SetBranchAddress("InputWeight", &FlatTreeInputWeight);
   fFitEventTree->SetBranchAddress("RWWeight", &FlatTreeRWWeight);
@@ -109,21 +131,56 @@ GenericVectorsInputHandler::GenericVectorsInputHandler(std::string const &handle
   // std::cout << "Event Info " << fNUISANCEEvent->PartInfo(0)->fPID << std::endl;
 }
 
+void GenericVectorsInputHandler::SetParticleBranches(
+    std::string const &counter, int &n, int maxn, std::string const &suffix,
+    std::vector<float> &px, std::vector<float> &py, std::vector<float> &pz,
+    std::vector<float> &E, std::vector<int> &pdg) {
+  n = 0;
+  char const *columns[] = {"px", "py", "pz", "E", "pdg"};
+  if (!fFitEventTree->GetBranch(counter.c_str())) {
+    return;
+  }
+  for (size_t i = 0; i < 5; ++i) {
+    if (!fFitEventTree->GetBranch((columns[i] + suffix).c_str())) {
+      NUIS_ERR(WRN, "Flat tree has no " << columns[i] + suffix
+                                        << " branch, not reading the "
+                                        << counter << " particles.");
+      return;
+    }
+  }
+
+  // Never leave a column empty, its address has to be valid
+  size_t size = std::max(maxn, 1);
+  px.resize(size);
+  py.resize(size);
+  pz.resize(size);
+  E.resize(size);
+  pdg.resize(size);
+
+  fFitEventTree->SetBranchAddress(counter.c_str(), &n);
+  fFitEventTree->SetBranchAddress(("px" + suffix).c_str(), &px[0]);
+  fFitEventTree->SetBranchAddress(("py" + suffix).c_str(), &py[0]);
+  fFitEventTree->SetBranchAddress(("pz" + suffix).c_str(), &pz[0]);
+  fFitEventTree->SetBranchAddress(("E" + suffix).c_str(), &E[0]);
+  fFitEventTree->SetBranchAddress(("pdg" + suffix).c_str(), &pdg[0]);
+}
+
 GenericVectorsInputHandler::~GenericVectorsInputHandler() {
+  StopReadAhead();
   if (fFitEventTree)
     delete fFitEventTree;
 }
 
 void GenericVectorsInputHandler::CreateCache() {
-  //    fFitEventTree->SetCacheEntryRange(0, fNEvents);
-  //    fFitEventTree->AddBranchToCache("*", 1);
-  //    fFitEventTree->SetCacheSize(fCacheSize);
+  if (fCacheSize > 0) {
+    fFitEventTree->SetCacheSize(fCacheSize);
+    fFitEventTree->AddBranchToCache("*", 1);
+  }
 }
 
 void GenericVectorsInputHandler::RemoveCache() {
-  // fFitEventTree->SetCacheEntryRange(0, fNEvents);
-  //    fFitEventTree->AddBranchToCache("*", 0);
-  //    fFitEventTree->SetCacheSize(0);
+  StopReadAhead();
+  fFitEventTree->SetCacheSize(0);
 }
 
 FitEvent *GenericVectorsInputHandler::GetNuisanceEvent(const UInt_t entry,
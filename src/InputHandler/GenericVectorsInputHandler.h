@@ -40,6 +40,9 @@ public:
 	/// Remove TTree Cache to save memory
 	void RemoveCache();
 
+	/// Events are fully described by the tree, so can be read ahead
+	bool SupportsReadAhead() { return true; };
+
 	/// Returns NUISANCE FitEvent from the TTree. If lightweight does nothing.
 	FitEvent* GetNuisanceEvent(const UInt_t entry, const bool lightweight=false);
 
@@ -49,6 +52,16 @@ public:
 	/// Print out event information
 	void Print();
 
+private:
+	/// Size the columns of one particle list to maxn and point the branches
+	/// at them. Lists that were dropped from the flat tree are left empty.
+	void SetParticleBranches(std::string const &counter, int &n, int maxn,
+	                         std::string const &suffix, std::vector<float> &px,
+	                         std::vector<float> &py, std::vector<float> &pz,
+	                         std::vector<float> &E, std::vector<int> &pdg);
+
+public:
+
 	TChain* fFitEventTree; ///< TTree from FitEvent file.
 
 	// int fReadNParticles;
@@ -57,30 +70,30 @@ public:
 	// int fReadParticlePDG[400];
 
 
-	// Save outgoing particle vectors
+	// Save outgoing particle vectors, sized to the largest multiplicity in the
+	// inputs
   int nfsp;
-  static const int kMAX = 200;
-  float px_fsp[kMAX];
-  float py_fsp[kMAX];
-  float pz_fsp[kMAX];
-  float E_fsp[kMAX];
-  int pdg_fsp[kMAX];
+  std::vector<float> px_fsp;
+  std::vector<float> py_fsp;
+  std::vector<float> pz_fsp;
+  std::vector<float> E_fsp;
+  std::vector<int> pdg_fsp;
 
   // Save incoming particle info
   int ninitp;
-  float px_init[kMAX];
-  float py_init[kMAX];
-  float pz_init[kMAX];
-  float E_init[kMAX];
-  int pdg_init[kMAX];
+  std::vector<float> px_init;
+  std::vector<float> py_init;
+  std::vector<float> pz_init;
+  std::vector<float> E_init;
+  std::vector<int> pdg_init;
 
   // Save pre-FSI particle info
   int nvertp;
-  float px_vert[kMAX];
-  float py_vert[kMAX];
-  float pz_vert[kMAX];
-  float E_vert[kMAX];
-  int pdg_vert[kMAX];
+  std::vector<float> px_vert;
+  std::vector<float> py_vert;
+  std::vector<float> pz_vert;
+  std::vector<float> E_vert;
+  std::vector<int> pdg_vert;
 
   // Basic event info
   float FlatTreeWeight;
@@ -48,6 +48,29 @@
 
 #include "TFile.h"
 
+#include <mutex>
+
+namespace {
+/// Generator input handlers set up global generator state (class
+/// dictionaries, NEUT common blocks, GENIE/NuWro singletons) while they are
+/// built, so only one can be constructed at a time when samples are loaded in
+/// parallel. FitEvent, histogram and flat-tree inputs don't need this.
+bool NeedsSerialConstruction(InputUtils::InputType inpType) {
+  switch (inpType) {
+  case (InputUtils::kNEUT_Input):
+  case (InputUtils::kGENIE_Input):
+  case (InputUtils::kNuWro_Input):
+  case (InputUtils::kGiBUU_Input):
+  case (InputUtils::kNUANCE_Input):
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::mutex GeneratorInputMutex;
+} // namespace
+
 namespace InputUtils {
 
 InputHandlerBase *CreateInputHandler(std::string const &handle,
@@ -56,6 +79,11 @@ InputHandlerBase *CreateInputHandler(std::string const &handle,
   InputHandlerBase *input = NULL;
   std::string newinputs = InputUtils::ExpandInputDirectories(inputs);
 
+  std::unique_lock<std::mutex> lock(GeneratorInputMutex, std::defer_lock);
+  if (NeedsSerialConstruction(inpType)) {
+    lock.lock();
+  }
+
   switch (inpType) {
   case (kNEUT_Input):
 #ifdef NEUT_ENABLED
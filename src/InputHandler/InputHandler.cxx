@@ -17,8 +17,11 @@
  *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
  *******************************************************************************/
 #include "InputHandler.h"
+#include "InputReadAhead.h"
 #include "InputUtils.h"
 
+#include "TFile.h"
+
 InputHandlerBase::InputHandlerBase() {
   fName = "";
   fFluxHist = NULL;
@@ -35,9 +38,17 @@ InputHandlerBase::InputHandlerBase() {
   if (FitPar::Config().HasConfig("NSKIPEVENTS")) {
     fSkip = FitPar::Config().GetParI("NSKIPEVENTS");
   }
+  fReadAheadDepth = FitPar::Config().GetParI("InputReadAheadDepth");
+  fReadAheadThreads = FitPar::Config().GetParI("InputReadAheadThreads");
+  fReadAhead = NULL;
+  fReadStage = NULL;
+  fFirstEntry = 0;
+  fLastEntry = -1;
 };
 
 InputHandlerBase::~InputHandlerBase() {
+  if (fReadAhead)
+    delete fReadAhead;
   if (fFluxHist)
     delete fFluxHist;
   if (fEventHist)
@@ -166,22 +177,86 @@ std::vector<TH1 *> InputHandlerBase::GetXSecList(void) {
   return std::vector<TH1 *>(1, GetXSecHistogram());
 };
 
+void InputHandlerBase::StopReadAhead() {
+  if (fReadAhead)
+    fReadAhead->Stop();
+}
+
+void InputHandlerBase::SetEventRange(int first, int last) {
+  StopReadAhead();
+  fFirstEntry = std::max(first, 0);
+  fLastEntry = last;
+}
+
+int InputHandlerBase::GetLastEntry() {
+  if (fLastEntry == -1) {
+    return fMaxEvents;
+  }
+  if (fMaxEvents == -1) {
+    return fLastEntry;
+  }
+  return std::min(fLastEntry, fMaxEvents);
+}
+
 FitEvent *InputHandlerBase::FirstNuisanceEvent() {
-  fCurrentIndex = 0;
-  return GetNuisanceEvent(fCurrentIndex);
+  fCurrentIndex = fFirstEntry;
+  StopReadAhead();
+
+  int last = GetLastEntry();
+  if ((last != -1) && (fCurrentIndex > last)) {
+    return NULL;
+  }
+
+  if (fReadAheadDepth > 0 && SupportsReadAhead()) {
+    if (!fReadAhead) {
+      fReadAhead =
+          new InputReadAhead(this, fReadAheadDepth, fReadAheadThreads);
+    }
+    fReadAhead->Start(fCurrentIndex, last);
+    return fReadAhead->Next();
+  }
+
+  return ReadNuisanceEvent(fCurrentIndex);
 };
 
 FitEvent *InputHandlerBase::NextNuisanceEvent() {
   fCurrentIndex++;
-  if ((fMaxEvents != -1) && (fCurrentIndex > fMaxEvents)) {
+
+  // Producer already applies the MAXEVENTS and event range limits
+  if (fReadAhead && fReadAhead->IsRunning()) {
+    return fReadAhead->Next();
+  }
+
+  int last = GetLastEntry();
+  if ((last != -1) && (fCurrentIndex > last)) {
     return NULL;
   }
 
-  return GetNuisanceEvent(fCurrentIndex);
+  return ReadNuisanceEvent(fCurrentIndex);
 };
 
+FitEvent *InputHandlerBase::ReadNuisanceEvent(const UInt_t entry) {
+  if (!fReadStage && ProfileUtils::IsEnabled()) {
+    fReadStage = ProfileUtils::GetStage("input/" + fName + "/GetNuisanceEvent");
+  }
+  if (!fReadStage) {
+    return GetNuisanceEvent(entry);
+  }
+
+  // Process-wide count, so includes reads by other inputs' threads
+  Long64_t bytes = TFile::GetFileBytesRead();
+  FitEvent *evt;
+  {
+    ProfileUtils::ScopedTimer timer(fReadStage);
+    evt = GetNuisanceEvent(entry);
+  }
+  ProfileUtils::CountBytes(fReadStage, TFile::GetFileBytesRead() - bytes);
+  return evt;
+}
+
 BaseFitEvt *InputHandlerBase::FirstBaseEvent() {
   fCurrentIndex = 0;
+  StopReadAhead();
   return GetBaseEvent(fCurrentIndex);
 };
 
@@ -276,6 +351,7 @@ void InputHandlerBase::SetupJointInputs() {
 }
 
 BaseFitEvt *InputHandlerBase::GetBaseEvent(const UInt_t entry) {
+  StopReadAhead();
   // Do some light processing: don't calculate the kinematics
   return static_cast<BaseFitEvt *>(GetNuisanceEvent(entry, true));
 }
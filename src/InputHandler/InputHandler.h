@@ -24,9 +24,22 @@
  */
 #include "BaseFitEvt.h"
 #include "FitEvent.h"
+#include "ProfileUtils.h"
 #include "TH1D.h"
 #include "TTreePerfStats.h"
 
+class InputReadAhead;
+
+/// Independent sequential reader over a [first, last) entry range of an
+/// input. It must not touch the state of the handler that created it, so
+/// that it can decode events on another thread.
+class InputRangeReader {
+public:
+  virtual ~InputRangeReader(){};
+  /// Returns the next event in the range, or NULL once the range is exhausted.
+  virtual FitEvent *Next() = 0;
+};
+
 /// Base InputHandler class defining how events are requested and setup.
 class InputHandlerBase {
 public:
@@ -41,6 +54,9 @@ public:
   /// option to be given where only RW information is needed.
   virtual FitEvent *GetNuisanceEvent(const UInt_t entry,
                                      const bool lightweight = false) = 0;
+  /// Calls GetNuisanceEvent(entry), counting the time and bytes read in the
+  /// input's ProfileUtils stage.
+  FitEvent *ReadNuisanceEvent(const UInt_t entry);
   /// Calls GetNuisanceEvent(entry, TRUE);
   virtual BaseFitEvt *GetBaseEvent(const UInt_t entry);
 
@@ -73,10 +89,36 @@ public:
   /// Placeholder to remove optional cache to free up memory
   inline virtual void RemoveCache(){};
 
-  /// Return starting NUISANCE event pointer (entry=0)
+  /// Whether the FitEvent returned by GetNuisanceEvent is self contained, so
+  /// it can be decoded ahead of time on another thread. Handlers whose
+  /// reweighting relies on generator record pointers must return false.
+  inline virtual bool SupportsReadAhead() { return false; };
+  /// Create a reader over the entries [first, last), clamped to the input.
+  /// Used by the read-ahead so the producer does not share the handler's
+  /// reader. NULL if the handler cannot open independent readers.
+  inline virtual InputRangeReader *CreateRangeReader(UInt_t first,
+                                                     UInt_t last) {
+    return NULL;
+  };
+  /// Whether CreateRangeReader can start at any entry without reading the
+  /// ones before it, so several readers can decode interleaved blocks.
+  inline virtual bool SupportsParallelReadAhead() { return false; };
+  /// Stop any background read-ahead. Must be called before random access
+  /// through GetNuisanceEvent and in the destructor of handlers that
+  /// support read-ahead.
+  void StopReadAhead();
+
+  /// Return starting NUISANCE event pointer (entry=0, or the first entry of
+  /// SetEventRange). If InputReadAheadDepth is set, starts decoding
+  /// subsequent events on a background thread.
   FitEvent *FirstNuisanceEvent();
-  /// Iterate to next NUISANCE event. Returns NULL when entry > fNEvents.
+  /// Iterate to next NUISANCE event. Returns NULL when entry > fNEvents, or
+  /// past the last entry of SetEventRange.
   FitEvent *NextNuisanceEvent();
+  /// Restrict First/NextNuisanceEvent to the inclusive entries [first, last]
+  /// so one input can be split between worker processes. last = -1 reads to
+  /// the end. MAXEVENTS still applies.
+  void SetEventRange(int first, int last);
   /// Returns starting Base Event Pointer (entry=0)
   BaseFitEvt *FirstBaseEvent();
   /// Iterate to next NUISANCE Base Event. Returns NULL when entry > fNEvents.
@@ -130,6 +172,16 @@ public:
   bool kRemoveNuclearParticles;
   TTreePerfStats *fTTreePerformance;
   int fSkip;
+  int fReadAheadDepth;
+  int fReadAheadThreads;
+  InputReadAhead *fReadAhead;
+  ProfileUtils::Stage *fReadStage;
+  int fFirstEntry;
+  int fLastEntry;
+
+private:
+  /// Last entry First/NextNuisanceEvent may return, or -1 for no limit.
+  int GetLastEntry();
 };
 /*! @} */
 #endif
@@ -0,0 +1,207 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#include "InputReadAhead.h"
+#include "InputHandler.h"
+
+#include "TROOT.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+// Each parallel block opens a new reader, keep them long enough to amortise it
+const size_t kMinParallelBlock = 64;
+} // namespace
+
+InputReadAhead::InputReadAhead(InputHandlerBase *input, int depth,
+                               int nthreads)
+    : fInput(input), fNThreads(nthreads), fBlock(0), fFirst(0),
+      fMaxEntry(-1), fRead(0), fEnd(0), fActive(0), fHeld(false),
+      fAbort(false), fRunning(false) {
+  if (depth < 1) {
+    depth = 1;
+  }
+  if (fNThreads < 1) {
+    fNThreads = 1;
+  }
+  if (fNThreads > 1 && !fInput->SupportsParallelReadAhead()) {
+    NUIS_LOG(SAM, "|-> Input " << fInput->GetName()
+                               << " can only be read ahead on one thread");
+    fNThreads = 1;
+  }
+
+  // Parallel producers decode interleaved blocks, the ring has to hold one
+  // block from each of them.
+  size_t nslots = depth + 1;
+  if (fNThreads > 1) {
+    fBlock = std::max(nslots / fNThreads, kMinParallelBlock);
+    nslots = std::max(nslots, fBlock * fNThreads);
+  }
+
+  // The producer threads open files and read trees while the main thread
+  // keeps filling histograms.
+  ROOT::EnableThreadSafety();
+  for (size_t i = 0; i < nslots; i++) {
+    FitEvent *evt = new FitEvent();
+    evt->HardReset();
+    fRing.push_back(evt);
+  }
+  fReady.resize(nslots, 0);
+  NUIS_LOG(SAM, "|-> Read ahead depth : " << nslots - 1 << " events on "
+                                          << fNThreads << " thread(s)");
+}
+
+InputReadAhead::~InputReadAhead() {
+  Stop();
+  for (size_t i = 0; i < fRing.size(); i++) {
+    delete fRing[i];
+  }
+  fRing.clear();
+}
+
+void InputReadAhead::Start(int first, int maxentry) {
+  Stop();
+
+  fFirst = first;
+  fMaxEntry = maxentry;
+  fRead = 0;
+  fEnd = size_t(-1);
+  fActive = fNThreads;
+  fHeld = false;
+  fAbort = false;
+  fRunning = true;
+  std::fill(fReady.begin(), fReady.end(), 0);
+
+  for (int i = 0; i < fNThreads; i++) {
+    fThreads.push_back(std::thread(&InputReadAhead::Produce, this, i));
+  }
+}
+
+void InputReadAhead::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fAbort = true;
+  }
+  fCanWrite.notify_all();
+
+  for (size_t i = 0; i < fThreads.size(); i++) {
+    fThreads[i].join();
+  }
+  fThreads.clear();
+  fRunning = false;
+}
+
+FitEvent *InputReadAhead::Next() {
+  std::unique_lock<std::mutex> lock(fMutex);
+
+  // Hand the previous event back to the producers
+  if (fHeld) {
+    fReady[fRead % fRing.size()] = 0;
+    fRead++;
+    fHeld = false;
+    fCanWrite.notify_all();
+  }
+
+  fCanRead.wait(lock, [this] {
+    return fReady[fRead % fRing.size()] || (fRead >= fEnd) || !fActive;
+  });
+  if ((fRead >= fEnd) || !fReady[fRead % fRing.size()]) {
+    return NULL;
+  }
+
+  fHeld = true;
+  return fRing[fRead % fRing.size()];
+}
+
+void InputReadAhead::Produce(int thread) {
+  ProfileUtils::Stage *stage =
+      ProfileUtils::GetStage("input/" + fInput->GetName() + "/GetNuisanceEvent");
+
+  long end = (fMaxEntry == -1) ? std::numeric_limits<int>::max()
+                               : long(fMaxEntry) + 1;
+  // A single producer reads the whole range in one block
+  long block = fBlock ? long(fBlock) : end - fFirst;
+
+  bool done = false;
+  for (long begin = fFirst + thread * block; !done && (begin < end);
+       begin += fNThreads * block) {
+    long stop = std::min(begin + block, end);
+
+    // Prefer an independent reader so the handler's own reader is left alone
+    InputRangeReader *reader =
+        fInput->CreateRangeReader(UInt_t(begin), UInt_t(stop));
+    if (!reader && (fNThreads > 1)) {
+      NUIS_ABORT("Input " << fInput->GetName()
+                          << " did not provide a range reader for parallel "
+                             "read-ahead.");
+    }
+
+    for (long entry = begin; entry < stop; entry++) {
+      size_t index = entry - fFirst;
+      FitEvent *slot = NULL;
+      {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fCanWrite.wait(lock, [this, index] {
+          return fAbort || (index >= fEnd) || (index < fRead + fRing.size());
+        });
+        if (fAbort || (index >= fEnd)) {
+          done = true;
+          break;
+        }
+        slot = fRing[index % fRing.size()];
+      }
+
+      // The slot is not visible to the consumer until it is marked ready, so
+      // decoding and copying can happen without the lock held.
+      FitEvent *evt = NULL;
+      if (reader) {
+        ProfileUtils::ScopedTimer timer(stage);
+        evt = reader->Next();
+      } else {
+        evt = fInput->ReadNuisanceEvent(entry);
+      }
+      if (evt) {
+        slot->CopyEventFrom(*evt);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (evt) {
+          fReady[index % fRing.size()] = 1;
+        } else {
+          fEnd = std::min(fEnd, index);
+          done = true;
+        }
+      }
+      fCanRead.notify_one();
+      if (done) {
+        // Wake producers waiting on entries past the end of the input
+        fCanWrite.notify_all();
+        break;
+      }
+    }
+    delete reader;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fActive--;
+  }
+  fCanRead.notify_all();
+}
@@ -0,0 +1,96 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#ifndef INPUTREADAHEAD_H
+#define INPUTREADAHEAD_H
+/*!
+ *  \addtogroup InputHandler
+ *  @{
+ */
+#include "FitEvent.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class InputHandlerBase;
+
+/// Producer/consumer read-ahead for an input handler.
+///
+/// A background thread calls GetNuisanceEvent on the handler for
+/// consecutive entries, so tree reads, basket decompression and the
+/// CalcNUISANCEKinematics conversion all happen off the calling thread. If
+/// the handler provides an InputRangeReader that is used instead, so the
+/// producer never shares the handler's own reader. Each decoded event is
+/// copied into a ring of preallocated FitEvents which the event loop
+/// consumes, in entry order, through Next().
+///
+/// Handlers that return SupportsParallelReadAhead() can be decoded by
+/// several producer threads, each taking interleaved blocks of entries
+/// with its own range reader.
+///
+/// Only the FitEvent content is copied, not any generator record pointers,
+/// so this is only used for handlers that return SupportsReadAhead().
+class InputReadAhead {
+public:
+  /// Allocates depth + 1 FitEvents (one is held by the consumer), or more if
+  /// needed to hold a block from each of nthreads producers.
+  InputReadAhead(InputHandlerBase *input, int depth, int nthreads = 1);
+  ~InputReadAhead();
+
+  /// Stop any running pass, then start decoding from entry first up to and
+  /// including maxentry (-1 for all entries).
+  void Start(int first, int maxentry);
+
+  /// Return the next decoded event, blocking until it is ready. The event
+  /// stays valid until the next call. Returns NULL at the end of the input.
+  FitEvent *Next();
+
+  /// Stop the producer threads and drop any decoded but unused events.
+  void Stop();
+
+  /// True between Start() and Stop()
+  inline bool IsRunning() const { return fRunning; };
+
+private:
+  void Produce(int thread);
+
+  InputHandlerBase *fInput;
+  std::vector<FitEvent *> fRing;
+  std::vector<char> fReady; ///< Ring slot holds a decoded, unconsumed event
+
+  int fNThreads;
+  size_t fBlock;  ///< Entries per block with parallel producers, else 0
+  int fFirst;     ///< First entry of this pass
+  int fMaxEntry;  ///< Last entry of this pass, -1 for all entries
+  size_t fRead;   ///< Events consumed, ring position is fRead % fRing.size()
+  size_t fEnd;    ///< Events in the input past fFirst, once a read failed
+  int fActive;    ///< Producers still running
+  bool fHeld;     ///< Consumer currently holds the event at fRead
+  bool fAbort;    ///< Producers asked to stop early
+  bool fRunning;
+
+  std::mutex fMutex;
+  std::condition_variable fCanRead;
+  std::condition_variable fCanWrite;
+  std::vector<std::thread> fThreads;
+};
+
+/*! @} */
+#endif
@@ -9,13 +9,50 @@
 #include "NuHepMC/HepMC3Features.hxx"
 
 #include "HepMC3/Print.h"
+#include "HepMC3/ReaderAscii.h"
 #include "HepMC3/ReaderFactory.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include <stdexcept>
 
 using namespace NuHepMC::CrossSection::Units;
 
-NuHepMCInputHandler::~NuHepMCInputHandler() {}
+namespace {
+// Bump if the layout written by SaveIndex changes
+const char kIndexMagic[8] = {'N', 'U', 'I', 'S', 'I', 'D', 'X', '1'};
+
+// Only uncompressed Asciiv3 can be seeked into with a byte offset.
+bool IsPlainAsciiv3(std::string const &filename) {
+  std::ifstream ifs(filename.c_str());
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.empty() || !line.compare(0, 14, "HepMC::Version")) {
+      continue;
+    }
+    return !line.compare(0, 34, "HepMC::Asciiv3-START_EVENT_LISTING");
+  }
+  return false;
+}
+
+bool GetFileStat(std::string const &filename, Long64_t &size,
+                 Long64_t &mtime) {
+  struct stat st;
+  if (stat(filename.c_str(), &st)) {
+    return false;
+  }
+  size = st.st_size;
+  mtime = st.st_mtime;
+  return true;
+}
+} // namespace
+
+NuHepMCInputHandler::~NuHepMCInputHandler() { StopReadAhead(); }
 
 NuHepMCInputHandler::NuHepMCInputHandler(std::string const &handle,
                                          std::string const &rawinputs)
@@ -49,70 +86,241 @@ NuHepMCInputHandler::NuHepMCInputHandler(std::string const &handle,
   fEventType = kNuHepMC;
 
   fFilename = inputs[0];
+  nextentry = 0;
+
+  // Event count, FATX, sumw and byte offsets all come from a single pass over
+  // the file, which is cached in a sidecar so later jobs can skip it.
+  bool usesidecar = FitPar::Config().GetParB("NuHepMCIndexSidecar");
+  std::string sidecar = fFilename + ".nuisidx";
+  if (!usesidecar || !LoadIndex(sidecar)) {
+    BuildIndex();
+    if (usesidecar) {
+      SaveIndex(sidecar);
+    }
+  } else {
+    NUIS_LOG(SAM, "|-> Read event index from " << sidecar);
+  }
 
+  // Units and run info are only needed from the first event
   fReader = HepMC3::deduce_reader(fFilename);
   if (!fReader) {
     NUIS_ABORT("Failed to instantiate HepMC3::Reader from " << fFilename);
   }
   HepMC3::GenEvent evt;
-  fNEvents = 0;
+  fReader->read_event(evt);
+  if (fReader->failed()) {
+    NUIS_ABORT("Failed to read first event from " << fFilename);
+  }
+  fToMeV = NuHepMC::Event::ToMeVFactor(evt);
+  frun_info = evt.run_info();
+  double to_cm2_nuc = GetRescaleFactor(
+      evt, pb_PerAtom, Unit{Scale::cm2_ten38, TargetScale::PerTargetNucleon});
+
+  std::cout << "NuHepMC NormInfo: { fatx = " << fFATX
+            << " pb/A = " << fFATX * to_cm2_nuc
+            << " cm^2/N, sumw = " << fsumevw << ", nevents = " << fNEvents
+            << ", seekable = " << IsSeekable() << " } " << std::endl;
+  // Dupe the FATX
+  fEventHist = new TH1D("eventhist", "eventhist", 10, 0.0, 10.0);
+  fEventHist->SetBinContent(5, fFATX * to_cm2_nuc);
+  fFluxHist = new TH1D("fluxhist", "fluxhist", 10, 0.0, 10.0);
+  fFluxHist->SetBinContent(5, 1);
+
+  fNUISANCEEvent = new FitEvent();
+  fNUISANCEEvent->HardReset();
+  fBaseEvent = static_cast<BaseFitEvt *>(fNUISANCEEvent);
+
+  fReader = HepMC3::deduce_reader(fFilename);
+};
+
+void NuHepMCInputHandler::BuildIndex() {
 
-  double to_cm2_nuc = 1;
+  NUIS_LOG(SAM, "|-> Building event index for " << fFilename);
+
+  // Read through our own stream for plain ascii so that the position of each
+  // event can be taken before it is read.
+  std::shared_ptr<std::ifstream> stream;
+  std::shared_ptr<HepMC3::Reader> reader;
+  if (IsPlainAsciiv3(fFilename)) {
+    stream = std::make_shared<std::ifstream>(fFilename.c_str());
+    reader = std::make_shared<HepMC3::ReaderAscii>(
+        std::static_pointer_cast<std::istream>(stream));
+  } else {
+    reader = HepMC3::deduce_reader(fFilename);
+  }
+  if (!reader) {
+    NUIS_ABORT("Failed to instantiate HepMC3::Reader from " << fFilename);
+  }
+
+  HepMC3::GenEvent evt;
+  fNEvents = 0;
+  fEventOffsets.clear();
 
   std::shared_ptr<NuHepMC::FATX::Accumulator> fatx_acc;
-  while (!fReader->failed()) {
-    fReader->read_event(evt);
-    if (fReader->failed()) {
+  while (!reader->failed()) {
+    std::streamoff pos = stream ? std::streamoff(stream->tellg()) : 0;
+    reader->read_event(evt);
+    if (reader->failed()) {
       break;
     }
 
     if (!fNEvents) {
-      fToMeV = NuHepMC::Event::ToMeVFactor(evt);
-      frun_info = evt.run_info();
-      fatx_acc = NuHepMC::FATX::MakeAccumulator(frun_info);
-      to_cm2_nuc = GetRescaleFactor(
-          evt, pb_PerAtom,
-          Unit{Scale::cm2_ten38, TargetScale::PerTargetNucleon});
+      fatx_acc = NuHepMC::FATX::MakeAccumulator(evt.run_info());
+    }
+    if (stream) {
+      fEventOffsets.push_back(pos);
     }
 
     fatx_acc->process(evt);
     fNEvents++;
   }
+
+  if (!fNEvents) {
+    NUIS_ABORT("Found no events in " << fFilename);
+  }
+
+  fFATX = fatx_acc->fatx();
   fsumevw = fatx_acc->sumweights();
+}
 
-  std::cout << "NuHepMC NormInfo: { fatx = " << fatx_acc->fatx()
-            << " pb/A = " << fatx_acc->fatx() * to_cm2_nuc
-            << " cm^2/N, sumw = " << fsumevw
-            << ", nevents = " << fatx_acc->events() << " } " << std::endl;
-  // Dupe the FATX
-  fEventHist = new TH1D("eventhist", "eventhist", 10, 0.0, 10.0);
-  fEventHist->SetBinContent(5, fatx_acc->fatx() * to_cm2_nuc);
-  fFluxHist = new TH1D("fluxhist", "fluxhist", 10, 0.0, 10.0);
-  fFluxHist->SetBinContent(5, 1);
+bool NuHepMCInputHandler::LoadIndex(std::string const &sidecar) {
 
-  fNUISANCEEvent = new FitEvent();
-  fNUISANCEEvent->HardReset();
-  fBaseEvent = static_cast<BaseFitEvt *>(fNUISANCEEvent);
+  Long64_t size, mtime;
+  if (!GetFileStat(fFilename, size, mtime)) {
+    return false;
+  }
 
-  fReader = HepMC3::deduce_reader(fFilename);
-};
+  std::ifstream ifs(sidecar.c_str(), std::ios::binary);
+  if (!ifs.good()) {
+    return false;
+  }
 
-FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
+  char magic[8];
+  Long64_t isize, imtime, nevents, noffsets;
+  double fatx, sumw;
+  ifs.read(magic, sizeof(magic));
+  ifs.read(reinterpret_cast<char *>(&isize), sizeof(isize));
+  ifs.read(reinterpret_cast<char *>(&imtime), sizeof(imtime));
+  ifs.read(reinterpret_cast<char *>(&nevents), sizeof(nevents));
+  ifs.read(reinterpret_cast<char *>(&fatx), sizeof(fatx));
+  ifs.read(reinterpret_cast<char *>(&sumw), sizeof(sumw));
+  ifs.read(reinterpret_cast<char *>(&noffsets), sizeof(noffsets));
+  if (!ifs.good() || memcmp(magic, kIndexMagic, sizeof(magic)) ||
+      (isize != size) || (imtime != mtime) || (nevents <= 0) ||
+      (noffsets && (noffsets != nevents))) {
+    NUIS_LOG(SAM, "|-> Ignoring stale event index " << sidecar);
+    return false;
+  }
+
+  std::vector<std::streamoff> offsets(noffsets);
+  for (Long64_t i = 0; i < noffsets; ++i) {
+    Long64_t off;
+    ifs.read(reinterpret_cast<char *>(&off), sizeof(off));
+    offsets[i] = off;
+  }
+  if (!ifs.good()) {
+    return false;
+  }
+
+  fNEvents = nevents;
+  fFATX = fatx;
+  fsumevw = sumw;
+  fEventOffsets.swap(offsets);
+  return true;
+}
 
-  int ntoskip = 0;
+void NuHepMCInputHandler::SaveIndex(std::string const &sidecar) const {
 
-  if (nextentry != entry) {
-    if (nextentry > entry) {
-      // start the file again
-      fReader = HepMC3::deduce_reader(fFilename);
-      ntoskip = entry;
-    } else {
-      ntoskip = entry - nextentry;
+  Long64_t size, mtime;
+  if (!GetFileStat(fFilename, size, mtime)) {
+    return;
+  }
+
+  std::stringstream tmpname;
+  tmpname << sidecar << ".tmp." << getpid();
+
+  std::ofstream ofs(tmpname.str().c_str(), std::ios::binary);
+  if (!ofs.good()) {
+    NUIS_ERR(WRN, "Cannot write event index " << sidecar
+                                              << ", will rescan next time.");
+    return;
+  }
+
+  Long64_t nevents = fNEvents;
+  Long64_t noffsets = fEventOffsets.size();
+  ofs.write(kIndexMagic, sizeof(kIndexMagic));
+  ofs.write(reinterpret_cast<char const *>(&size), sizeof(size));
+  ofs.write(reinterpret_cast<char const *>(&mtime), sizeof(mtime));
+  ofs.write(reinterpret_cast<char const *>(&nevents), sizeof(nevents));
+  ofs.write(reinterpret_cast<char const *>(&fFATX), sizeof(fFATX));
+  ofs.write(reinterpret_cast<char const *>(&fsumevw), sizeof(fsumevw));
+  ofs.write(reinterpret_cast<char const *>(&noffsets), sizeof(noffsets));
+  for (size_t i = 0; i < fEventOffsets.size(); ++i) {
+    Long64_t off = fEventOffsets[i];
+    ofs.write(reinterpret_cast<char const *>(&off), sizeof(off));
+  }
+  ofs.close();
+
+  if (ofs.fail() || std::rename(tmpname.str().c_str(), sidecar.c_str())) {
+    NUIS_ERR(WRN, "Failed to write event index " << sidecar);
+    std::remove(tmpname.str().c_str());
+  }
+}
+
+std::shared_ptr<HepMC3::Reader>
+NuHepMCInputHandler::OpenReaderAt(const UInt_t entry) const {
+
+  if (entry < fEventOffsets.size()) {
+    std::shared_ptr<std::ifstream> stream =
+        std::make_shared<std::ifstream>(fFilename.c_str());
+    stream->seekg(fEventOffsets[entry]);
+    return std::make_shared<HepMC3::ReaderAscii>(
+        std::static_pointer_cast<std::istream>(stream));
+  }
+
+  std::shared_ptr<HepMC3::Reader> reader = HepMC3::deduce_reader(fFilename);
+  if (reader && entry) {
+    reader->skip(entry);
+  }
+  return reader;
+}
+
+std::vector<std::pair<UInt_t, UInt_t> >
+NuHepMCInputHandler::GetEntryRanges(int nranges) const {
+
+  std::vector<std::pair<UInt_t, UInt_t> > ranges;
+  if (nranges < 1) {
+    nranges = 1;
+  }
+
+  UInt_t nevents = fNEvents;
+  UInt_t per_range = nevents / nranges;
+  UInt_t remainder = nevents % nranges;
+  UInt_t first = 0;
+  for (int i = 0; i < nranges; ++i) {
+    UInt_t last = first + per_range + (UInt_t(i) < remainder ? 1 : 0);
+    if (last > first) {
+      ranges.push_back(std::make_pair(first, last));
     }
+    first = last;
   }
+  return ranges;
+}
+
+InputRangeReader *NuHepMCInputHandler::CreateRangeReader(UInt_t first,
+                                                         UInt_t last) {
+  return new NuHepMCRangeReader(*this, first, last);
+}
+
+FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
 
-  if (ntoskip) {
-    fReader->skip(ntoskip);
+  if (!fReader || (nextentry != entry)) {
+    if (IsSeekable() || (nextentry > entry)) {
+      // seek directly, or start the file again if we have no index
+      fReader = OpenReaderAt(entry);
+    } else {
+      fReader->skip(entry - nextentry);
+    }
   }
 
   nextentry = entry + 1;
@@ -124,6 +332,9 @@ FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
     return NULL;
   }
 
+  // Readers opened mid-file never see the run info header
+  fHepMC3Evt.set_run_info(frun_info);
+
   // Setup Input scaling for joint inputs
   if (jointinput) {
     fNUISANCEEvent->InputWeight = GetInputWeight(entry);
@@ -142,17 +353,22 @@ FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
 }
 
 void NuHepMCInputHandler::CalcNUISANCEKinematics() {
+  FillNUISANCEEvent(fHepMC3Evt, fNUISANCEEvent, fToMeV);
+}
+
+void NuHepMCInputHandler::FillNUISANCEEvent(HepMC3::GenEvent const &evt,
+                                            FitEvent *fevt, double tomev) {
 
   // Reset all variables
-  fNUISANCEEvent->ResetEvent();
+  fevt->ResetEvent();
 
-  fNUISANCEEvent->Mode = NuHepMC::ER3::ReadProcessID(fHepMC3Evt);
+  fevt->Mode = NuHepMC::ER3::ReadProcessID(evt);
 
-  fNUISANCEEvent->fEventNo = fHepMC3Evt.event_number();
+  fevt->fEventNo = evt.event_number();
 
   // Read all particles from fHepMCEvent
-  fNUISANCEEvent->fNParticles = 0;
-  for (auto const &p : fHepMC3Evt.particles()) {
+  fevt->fNParticles = 0;
+  for (auto const &p : evt.particles()) {
 
     int status = 0;
 
@@ -167,10 +383,10 @@ void NuHepMCInputHandler::CalcNUISANCEKinematics() {
 
       status = kNuclearInitial;
 
-      fNUISANCEEvent->fTargetA = (p->pid() / 10) % 1000;
-      fNUISANCEEvent->fTargetZ = (p->pid() / 10000) % 1000;
-      fNUISANCEEvent->fTargetH = 0;
-      fNUISANCEEvent->fBound = (p->pid() == 1000010010);
+      fevt->fTargetA = (p->pid() / 10) % 1000;
+      fevt->fTargetZ = (p->pid() / 10000) % 1000;
+      fevt->fTargetH = 0;
+      fevt->fBound = (p->pid() == 1000010010);
 
     } else if (p->status() == NuHepMC::ParticleStatus::StruckNucleon) {
       status = kInitialState;
@@ -181,29 +397,29 @@ void NuHepMCInputHandler::CalcNUISANCEKinematics() {
       continue;
     }
 
-    fNUISANCEEvent->fPrimaryVertex[fNUISANCEEvent->fNParticles] =
+    fevt->fPrimaryVertex[fevt->fNParticles] =
         (p->production_vertex()->status() == NuHepMC::VertexStatus::Primary);
 
     // Mom
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][0] =
-        p->momentum().px() * fToMeV;
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][1] =
-        p->momentum().py() * fToMeV;
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][2] =
-        p->momentum().pz() * fToMeV;
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][3] =
-        p->momentum().e() * fToMeV;
+    fevt->fParticleMom[fevt->fNParticles][0] =
+        p->momentum().px() * tomev;
+    fevt->fParticleMom[fevt->fNParticles][1] =
+        p->momentum().py() * tomev;
+    fevt->fParticleMom[fevt->fNParticles][2] =
+        p->momentum().pz() * tomev;
+    fevt->fParticleMom[fevt->fNParticles][3] =
+        p->momentum().e() * tomev;
 
     // PDG
-    fNUISANCEEvent->fParticlePDG[fNUISANCEEvent->fNParticles] = p->pid();
-    fNUISANCEEvent->fParticleState[fNUISANCEEvent->fNParticles] = status;
+    fevt->fParticlePDG[fevt->fNParticles] = p->pid();
+    fevt->fParticleState[fevt->fNParticles] = status;
 
     // Add up particle count
-    fNUISANCEEvent->fNParticles++;
+    fevt->fNParticles++;
   }
 
   // Run Initial, FSI, Final, Other ordering.
-  fNUISANCEEvent->OrderStack();
+  fevt->OrderStack();
 
   return;
 }
@@ -225,7 +441,46 @@ double NuHepMCInputHandler::GetInputWeight(const UInt_t entry) {
 
 BaseFitEvt *NuHepMCInputHandler::GetBaseEvent(const UInt_t entry) {
 
+  StopReadAhead();
+
   if (entry >= (UInt_t)fNEvents)
     return NULL;
   return (BaseFitEvt *)GetNuisanceEvent(entry, true);
 }
+
+NuHepMCRangeReader::NuHepMCRangeReader(NuHepMCInputHandler const &handler,
+                                       UInt_t first, UInt_t last)
+    : fReader(handler.OpenReaderAt(first)), frun_info(handler.frun_info),
+      fEntry(first), fLast(std::min(last, UInt_t(handler.fNEvents))),
+      fToMeV(handler.fToMeV),
+      fWeightNorm(double(handler.fNEvents) / handler.fsumevw) {
+
+  if (!fReader) {
+    NUIS_ABORT("Failed to open range reader on " << handler.fFilename);
+  }
+
+  fNUISANCEEvent = new FitEvent();
+  fNUISANCEEvent->HardReset();
+}
+
+NuHepMCRangeReader::~NuHepMCRangeReader() { delete fNUISANCEEvent; }
+
+FitEvent *NuHepMCRangeReader::Next() {
+
+  if (fEntry >= fLast) {
+    return NULL;
+  }
+
+  fReader->read_event(fHepMC3Evt);
+  if (fReader->failed()) {
+    return NULL;
+  }
+  fHepMC3Evt.set_run_info(frun_info);
+  fEntry++;
+
+  NuHepMCInputHandler::FillNUISANCEEvent(fHepMC3Evt, fNUISANCEEvent, fToMeV);
+  // NuHepMC inputs are never joint, so this matches GetNuisanceEvent
+  fNUISANCEEvent->InputWeight = fHepMC3Evt.weights()[0] * fWeightNorm;
+
+  return fNUISANCEEvent;
+}
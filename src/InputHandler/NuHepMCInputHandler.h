@@ -5,8 +5,11 @@
 #include "HepMC3/Reader.h"
 #include "HepMC3/GenEvent.h"
 
+#include <iosfwd>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 /// NEUT Input Convertor to read in NeutVects and convert to FitEvents
 class NuHepMCInputHandler : public InputHandlerBase {
@@ -26,6 +29,30 @@ public:
 
 	double GetInputWeight(const UInt_t entry);
 
+  /// Events are converted fully from the HepMC3 record, so can be read ahead
+  bool SupportsReadAhead() { return true; }
+
+  /// Returns a NuHepMCRangeReader over [first, last)
+  InputRangeReader *CreateRangeReader(UInt_t first, UInt_t last);
+  /// Range readers seek in O(1) when the input is byte-offset indexed
+  bool SupportsParallelReadAhead() { return IsSeekable(); }
+
+  /// Fill a FitEvent from a HepMC3 event, does not touch handler state so can
+  /// be used by independent readers running on other threads.
+  static void FillNUISANCEEvent(HepMC3::GenEvent const &evt, FitEvent *fevt,
+                                double tomev);
+
+  /// Open a new, independent reader positioned so that the next read_event
+  /// returns entry. O(1) if the input could be byte-offset indexed.
+  std::shared_ptr<HepMC3::Reader> OpenReaderAt(const UInt_t entry) const;
+
+  /// Split [0, fNEvents) into nranges contiguous, disjoint [first, last)
+  /// entry ranges for use with NuHepMCRangeReader.
+  std::vector<std::pair<UInt_t, UInt_t> > GetEntryRanges(int nranges) const;
+
+  /// True if fEventOffsets allows O(1) seeks into the input
+  bool IsSeekable() const { return !fEventOffsets.empty(); }
+
   std::shared_ptr<HepMC3::Reader> fReader;
   std::shared_ptr<HepMC3::GenRunInfo> frun_info;
   UInt_t nextentry;
@@ -33,4 +60,44 @@ public:
   std::string fFilename;
   double fToMeV;
   double fsumevw;
+
+private:
+  /// Full pass over the input counting events, accumulating the FATX and the
+  /// sum of event weights, and recording byte offsets if the file is plain
+  /// Asciiv3.
+  void BuildIndex();
+  /// Read a previously saved index, returns false if missing or stale.
+  bool LoadIndex(std::string const &sidecar);
+  /// Save the index next to the input. Written to a temporary file and
+  /// renamed so that concurrent jobs never see a partial index.
+  void SaveIndex(std::string const &sidecar) const;
+
+  std::vector<std::streamoff> fEventOffsets; ///< Byte offset of each event
+  double fFATX;                              ///< FATX in pb/Atom
+};
+
+/// Lightweight reader over [first, last) of a NuHepMCInputHandler's input.
+/// Owns its own HepMC3 reader and FitEvent, so several range readers over
+/// disjoint ranges can be run concurrently from separate threads.
+class NuHepMCRangeReader : public InputRangeReader {
+public:
+  NuHepMCRangeReader(NuHepMCInputHandler const &handler, UInt_t first,
+                     UInt_t last);
+  ~NuHepMCRangeReader();
+
+  /// Returns the next event in the range, or NULL once the range is exhausted.
+  FitEvent *Next();
+
+  /// Entry number of the event last returned by Next.
+  UInt_t GetEntry() const { return fEntry - 1; }
+
+private:
+  std::shared_ptr<HepMC3::Reader> fReader;
+  std::shared_ptr<HepMC3::GenRunInfo> frun_info;
+  HepMC3::GenEvent fHepMC3Evt;
+  FitEvent *fNUISANCEEvent;
+  UInt_t fEntry;
+  UInt_t fLast;
+  double fToMeV;
+  double fWeightNorm;
 };
@@ -0,0 +1,28 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// K2K NC1pi0
+#include "K2K_NC1pi0_Evt_1Dppi0_nu.h"
+
+void SampleUtils::RegisterK2KSamples(SampleFactoryMap &factories) {
+  RegisterSample<K2K_NC1pi0_Evt_1Dppi0_nu>(factories,
+                                           "K2K_NC1pi0_Evt_1Dppi0_nu");
+}
@@ -27,6 +27,19 @@
 #include "T2K_SignalDef.h"
 #endif
 
+#include "TRegexp.h"
+
+#include <algorithm>
+
+namespace {
+/// Whole-name match against a shell style wildcard, e.g. "flag*"
+bool MatchesWildcard(std::string const &name, std::string const &pattern) {
+  Ssiz_t len = 0;
+  return (TRegexp(pattern.c_str(), true).Index(TString(name), &len) == 0) &&
+         (len == Ssiz_t(name.size()));
+}
+} // namespace
+
 GenericFlux_Vectors::GenericFlux_Vectors(std::string name,
                                          std::string inputfile, FitWeight *rw,
                                          std::string type,
@@ -55,6 +68,19 @@ GenericFlux_Vectors::GenericFlux_Vectors(std::string name,
   NUIS_LOG(SAM, "Running GenericFlux_Vectors saving signal flags? "
 	   << SaveSignalFlags);
 
+  // Optional comma separated lists of branch name wildcards to keep or drop
+  if (Config::HasPar("nuisflat_Branches")) {
+    KeepBranches =
+        GeneralUtils::ParseToStr(Config::GetParS("nuisflat_Branches"), ",");
+  }
+  if (Config::HasPar("nuisflat_DropBranches")) {
+    DropBranches =
+        GeneralUtils::ParseToStr(Config::GetParS("nuisflat_DropBranches"), ",");
+  }
+
+  fParticleCapacity = 0;
+  EnsureParticleCapacity(32);
+
   // Set default fitter flags
   fIsDiag = true;
   fIsShape = false;
@@ -101,6 +127,85 @@ GenericFlux_Vectors::GenericFlux_Vectors(std::string name,
   // Setup our TTrees
   this->AddEventVariablesToTree();
   if (SaveSignalFlags) this->AddSignalFlagsToTree();
+
+  // ROOT compression settings for the tree, e.g. 505 for ZSTD level 5,
+  // otherwise those of the output file are used.
+  if (Config::HasPar("nuisflat_Compression") &&
+      Config::GetParI("nuisflat_Compression") > 0) {
+    int compression = Config::GetParI("nuisflat_Compression");
+    NUIS_LOG(SAM, "Writing flat tree with compression settings "
+                      << compression);
+    TIter next(eventVariables->GetListOfBranches());
+    while (TBranch *branch = static_cast<TBranch *>(next())) {
+      branch->SetCompressionSettings(compression);
+    }
+  }
+}
+
+bool GenericFlux_Vectors::IsBranchSelected(std::string const &name) const {
+  // Needed to read the particle columns back and by nuis_flat_tree_combiner
+  if ((name == "nfsp") || (name == "ninitp") || (name == "nvertp") ||
+      (name == "fScaleFactor")) {
+    return true;
+  }
+
+  bool keep = KeepBranches.empty();
+  for (size_t i = 0; !keep && (i < KeepBranches.size()); ++i) {
+    keep = MatchesWildcard(name, KeepBranches[i]);
+  }
+  for (size_t i = 0; keep && (i < DropBranches.size()); ++i) {
+    keep = !MatchesWildcard(name, DropBranches[i]);
+  }
+  return keep;
+}
+
+void GenericFlux_Vectors::AddBranch(std::string const &name, void *address,
+                                    std::string const &leaflist) {
+  if (IsBranchSelected(name)) {
+    eventVariables->Branch(name.c_str(), address, leaflist.c_str());
+  }
+}
+
+void GenericFlux_Vectors::AddBranch(std::string const &name,
+                                    TVector3 *address) {
+  if (IsBranchSelected(name)) {
+    eventVariables->Branch(name.c_str(), address);
+  }
+}
+
+void GenericFlux_Vectors::EnsureParticleCapacity(int n) {
+  if (n <= fParticleCapacity) {
+    return;
+  }
+  // Grow geometrically so that a high multiplicity tail only moves the
+  // columns a handful of times.
+  fParticleCapacity = std::max(n, 2 * fParticleCapacity);
+
+  std::vector<float> *fcols[] = {&px,      &py,      &pz,      &E,
+                                 &px_init, &py_init, &pz_init, &E_init,
+                                 &px_vert, &py_vert, &pz_vert, &E_vert};
+  char const *fnames[] = {"px",      "py",      "pz",      "E",
+                          "px_init", "py_init", "pz_init", "E_init",
+                          "px_vert", "py_vert", "pz_vert", "E_vert"};
+  std::vector<int> *icols[] = {&pdg, &pdg_rank, &pdg_init, &pdg_vert};
+  char const *inames[] = {"pdg", "pdg_rank", "pdg_init", "pdg_vert"};
+
+  for (size_t i = 0; i < 12; ++i) {
+    fcols[i]->resize(fParticleCapacity);
+    TBranch *branch =
+        eventVariables ? eventVariables->GetBranch(fnames[i]) : NULL;
+    if (branch) {
+      branch->SetAddress(&(*fcols[i])[0]);
+    }
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    icols[i]->resize(fParticleCapacity);
+    TBranch *branch =
+        eventVariables ? eventVariables->GetBranch(inames[i]) : NULL;
+    if (branch) {
+      branch->SetAddress(&(*icols[i])[0]);
+    }
+  }
 }
 
 void GenericFlux_Vectors::AddEventVariablesToTree() {
@@ -113,83 +218,82 @@ void GenericFlux_Vectors::AddEventVariablesToTree() {
 
   NUIS_LOG(SAM, "Adding Event Variables");
 
-  eventVariables->Branch("Mode", &Mode, "Mode/I");
-  eventVariables->Branch("GENIEResCode", &GENIEResCode, "GENIEResCode/I");
-  eventVariables->Branch("cc", &cc, "cc/B");
-  eventVariables->Branch("PDGnu", &PDGnu, "PDGnu/I");
-  eventVariables->Branch("Enu_true", &Enu_true, "Enu_true/F");
-  eventVariables->Branch("tgt", &tgt, "tgt/I");
-  eventVariables->Branch("tgta", &tgta, "tgta/I");
-  eventVariables->Branch("tgtz", &tgtz, "tgtz/I");
-  eventVariables->Branch("PDGLep", &PDGLep, "PDGLep/I");
-  eventVariables->Branch("ELep", &ELep, "ELep/F");
-  eventVariables->Branch("CosLep", &CosLep, "CosLep/F");
+  AddBranch("Mode", &Mode, "Mode/I");
+  AddBranch("GENIEResCode", &GENIEResCode, "GENIEResCode/I");
+  AddBranch("cc", &cc, "cc/B");
+  AddBranch("PDGnu", &PDGnu, "PDGnu/I");
+  AddBranch("Enu_true", &Enu_true, "Enu_true/F");
+  AddBranch("tgt", &tgt, "tgt/I");
+  AddBranch("tgta", &tgta, "tgta/I");
+  AddBranch("tgtz", &tgtz, "tgtz/I");
+  AddBranch("PDGLep", &PDGLep, "PDGLep/I");
+  AddBranch("ELep", &ELep, "ELep/F");
+  AddBranch("CosLep", &CosLep, "CosLep/F");
 
   // Basic interaction kinematics
-  eventVariables->Branch("Q2", &Q2, "Q2/F");
-  eventVariables->Branch("q0", &q0, "q0/F");
-  eventVariables->Branch("q3", &q3, "q3/F");
-  eventVariables->Branch("Enu_QE", &Enu_QE, "Enu_QE/F");
-  eventVariables->Branch("Q2_QE", &Q2_QE, "Q2_QE/F");
-  eventVariables->Branch("W_nuc_rest", &W_nuc_rest, "W_nuc_rest/F");
-  eventVariables->Branch("W", &W, "W/F");
-  eventVariables->Branch("W_genie", &W_genie, "W_genie/F");
-  eventVariables->Branch("x", &x, "x/F");
-  eventVariables->Branch("y", &y, "y/F");
-  eventVariables->Branch("Erecoil_minerva", &Erecoil_minerva, "Erecoil_minerva/F");
-  eventVariables->Branch("Erecoil_charged", &Erecoil_charged, "Erecoil_charged/F");
-  eventVariables->Branch("EavAlt", &EavAlt, "EavAlt/F");
+  AddBranch("Q2", &Q2, "Q2/F");
+  AddBranch("q0", &q0, "q0/F");
+  AddBranch("q3", &q3, "q3/F");
+  AddBranch("Enu_QE", &Enu_QE, "Enu_QE/F");
+  AddBranch("Q2_QE", &Q2_QE, "Q2_QE/F");
+  AddBranch("W_nuc_rest", &W_nuc_rest, "W_nuc_rest/F");
+  AddBranch("W", &W, "W/F");
+  AddBranch("W_genie", &W_genie, "W_genie/F");
+  AddBranch("x", &x, "x/F");
+  AddBranch("y", &y, "y/F");
+  AddBranch("Erecoil_minerva", &Erecoil_minerva, "Erecoil_minerva/F");
+  AddBranch("Erecoil_charged", &Erecoil_charged, "Erecoil_charged/F");
+  AddBranch("EavAlt", &EavAlt, "EavAlt/F");
   
   // Add in EMiss and PMiss
-  eventVariables->Branch("Emiss", &Emiss, "Emiss/F");
-  eventVariables->Branch("pmiss", &pmiss);
-  eventVariables->Branch("Emiss_preFSI", &Emiss_preFSI, "Emiss_preFSI/F");
-  eventVariables->Branch("pmiss_preFSI", &pmiss_preFSI);
+  AddBranch("Emiss", &Emiss, "Emiss/F");
+  AddBranch("pmiss", &pmiss);
+  AddBranch("Emiss_preFSI", &Emiss_preFSI, "Emiss_preFSI/F");
+  AddBranch("pmiss_preFSI", &pmiss_preFSI);
 
-  eventVariables->Branch("CosThetaAdler", &CosThetaAdler, "CosThetaAdler/F");
-  eventVariables->Branch("PhiAdler", &PhiAdler, "PhiAdler/F");
+  AddBranch("CosThetaAdler", &CosThetaAdler, "CosThetaAdler/F");
+  AddBranch("PhiAdler", &PhiAdler, "PhiAdler/F");
 
-  eventVariables->Branch("dalphat", &dalphat, "dalphat/F");
-  eventVariables->Branch("dpt", &dpt, "dpt/F");
-  eventVariables->Branch("dphit", &dphit, "dphit/F");
-  eventVariables->Branch("pnreco_C", &pnreco_C, "pnreco_C/F");
+  AddBranch("dalphat", &dalphat, "dalphat/F");
+  AddBranch("dpt", &dpt, "dpt/F");
+  AddBranch("dphit", &dphit, "dphit/F");
+  AddBranch("pnreco_C", &pnreco_C, "pnreco_C/F");
 
   // Save outgoing particle vectors
-  eventVariables->Branch("nfsp", &nfsp, "nfsp/I");
-  eventVariables->Branch("px", px, "px[nfsp]/F");
-  eventVariables->Branch("py", py, "py[nfsp]/F");
-  eventVariables->Branch("pz", pz, "pz[nfsp]/F");
-  eventVariables->Branch("E", E, "E[nfsp]/F");
-  eventVariables->Branch("pdg", pdg, "pdg[nfsp]/I");
-  eventVariables->Branch("pdg_rank", pdg_rank, "pdg_rank[nfsp]/I");
+  AddBranch("nfsp", &nfsp, "nfsp/I");
+  AddBranch("px", &px[0], "px[nfsp]/F");
+  AddBranch("py", &py[0], "py[nfsp]/F");
+  AddBranch("pz", &pz[0], "pz[nfsp]/F");
+  AddBranch("E", &E[0], "E[nfsp]/F");
+  AddBranch("pdg", &pdg[0], "pdg[nfsp]/I");
+  AddBranch("pdg_rank", &pdg_rank[0], "pdg_rank[nfsp]/I");
 
   // Save init particle vectors
-  eventVariables->Branch("ninitp", &ninitp, "ninitp/I");
-  eventVariables->Branch("px_init", px_init, "px_init[ninitp]/F");
-  eventVariables->Branch("py_init", py_init, "py_init[ninitp]/F");
-  eventVariables->Branch("pz_init", pz_init, "pz_init[ninitp]/F");
-  eventVariables->Branch("E_init", E_init, "E_init[ninitp]/F");
-  eventVariables->Branch("pdg_init", pdg_init, "pdg_init[ninitp]/I");
+  AddBranch("ninitp", &ninitp, "ninitp/I");
+  AddBranch("px_init", &px_init[0], "px_init[ninitp]/F");
+  AddBranch("py_init", &py_init[0], "py_init[ninitp]/F");
+  AddBranch("pz_init", &pz_init[0], "pz_init[ninitp]/F");
+  AddBranch("E_init", &E_init[0], "E_init[ninitp]/F");
+  AddBranch("pdg_init", &pdg_init[0], "pdg_init[ninitp]/I");
 
   // Save pre-FSI vectors
-  eventVariables->Branch("nvertp", &nvertp, "nvertp/I");
-  eventVariables->Branch("px_vert", px_vert, "px_vert[nvertp]/F");
-  eventVariables->Branch("py_vert", py_vert, "py_vert[nvertp]/F");
-  eventVariables->Branch("pz_vert", pz_vert, "pz_vert[nvertp]/F");
-  eventVariables->Branch("E_vert", E_vert, "E_vert[nvertp]/F");
-  eventVariables->Branch("pdg_vert", pdg_vert, "pdg_vert[nvertp]/I");
+  AddBranch("nvertp", &nvertp, "nvertp/I");
+  AddBranch("px_vert", &px_vert[0], "px_vert[nvertp]/F");
+  AddBranch("py_vert", &py_vert[0], "py_vert[nvertp]/F");
+  AddBranch("pz_vert", &pz_vert[0], "pz_vert[nvertp]/F");
+  AddBranch("E_vert", &E_vert[0], "E_vert[nvertp]/F");
+  AddBranch("pdg_vert", &pdg_vert[0], "pdg_vert[nvertp]/I");
 
   // Event Scaling Information
-  eventVariables->Branch("Weight", &Weight, "Weight/F");
-  eventVariables->Branch("InputWeight", &InputWeight, "InputWeight/F");
-  eventVariables->Branch("RWWeight", &RWWeight, "RWWeight/F");
+  AddBranch("Weight", &Weight, "Weight/F");
+  AddBranch("InputWeight", &InputWeight, "InputWeight/F");
+  AddBranch("RWWeight", &RWWeight, "RWWeight/F");
   // Should be a double because may be 1E-39 and less
-  eventVariables->Branch("fScaleFactor", &fScaleFactor, "fScaleFactor/D");
+  AddBranch("fScaleFactor", &fScaleFactor, "fScaleFactor/D");
 
   // The customs
-  eventVariables->Branch("CustomWeight", &CustomWeight, "CustomWeight/F");
-  eventVariables->Branch("CustomWeightArray", CustomWeightArray,
-                         "CustomWeightArray[6]/F");
+  AddBranch("CustomWeight", &CustomWeight, "CustomWeight/F");
+  AddBranch("CustomWeightArray", CustomWeightArray, "CustomWeightArray[6]/F");
 
   return;
 }
@@ -289,6 +393,10 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
     }
   }
 
+  EnsureParticleCapacity(
+      std::max((int)partList.size(),
+               std::max((int)vertList.size(), (int)initList.size())));
+
   // Save outgoing particle vectors
   nfsp = (int)partList.size();
   std::map<int, std::vector<std::pair<double, int> > > pdgMap;
@@ -378,17 +486,9 @@ void GenericFlux_Vectors::ResetVariables() {
   // MINERvA-like ones
   dalphat = dpt = dphit = pnreco_C = -999.99;
 
+  // Only the first nfsp/ninitp/nvertp entries of the columns are written,
+  // and they are all set for every event.
   nfsp = ninitp = nvertp = 0;
-  for (int i = 0; i < kMAX; ++i) {
-    px[i] = py[i] = pz[i] = E[i] = -999;
-    pdg[i] = pdg_rank[i] = 0;
-
-    px_init[i] = py_init[i] = pz_init[i] = E_init[i] = -999;
-    pdg_init[i] = 0;
-
-    px_vert[i] = py_vert[i] = pz_vert[i] = E_vert[i] = -999;
-    pdg_vert[i] = 0;
-  }
 
   // Reset pmiss
   pmiss.SetXYZ(-999.,-999.,-999.);
@@ -462,30 +562,29 @@ void GenericFlux_Vectors::AddSignalFlagsToTree() {
   NUIS_LOG(SAM, "Adding signal flags");
 
   // Signal Definitions from SignalDef.cxx
-  eventVariables->Branch("flagCCINC", &flagCCINC, "flagCCINC/O");
-  eventVariables->Branch("flagNCINC", &flagNCINC, "flagNCINC/O");
-  eventVariables->Branch("flagCCQE", &flagCCQE, "flagCCQE/O");
-  eventVariables->Branch("flagCC0pi", &flagCC0pi, "flagCC0pi/O");
-  eventVariables->Branch("flagCCQELike", &flagCCQELike, "flagCCQELike/O");
-  eventVariables->Branch("flagNCEL", &flagNCEL, "flagNCEL/O");
-  eventVariables->Branch("flagNC0pi", &flagNC0pi, "flagNC0pi/O");
-  eventVariables->Branch("flagCCcoh", &flagCCcoh, "flagCCcoh/O");
-  eventVariables->Branch("flagNCcoh", &flagNCcoh, "flagNCcoh/O");
-  eventVariables->Branch("flagCC1pip", &flagCC1pip, "flagCC1pip/O");
-  eventVariables->Branch("flagNC1pip", &flagNC1pip, "flagNC1pip/O");
-  eventVariables->Branch("flagCC1pim", &flagCC1pim, "flagCC1pim/O");
-  eventVariables->Branch("flagNC1pim", &flagNC1pim, "flagNC1pim/O");
-  eventVariables->Branch("flagCC1pi0", &flagCC1pi0, "flagCC1pi0/O");
-  eventVariables->Branch("flagNC1pi0", &flagNC1pi0, "flagNC1pi0/O");
+  AddBranch("flagCCINC", &flagCCINC, "flagCCINC/O");
+  AddBranch("flagNCINC", &flagNCINC, "flagNCINC/O");
+  AddBranch("flagCCQE", &flagCCQE, "flagCCQE/O");
+  AddBranch("flagCC0pi", &flagCC0pi, "flagCC0pi/O");
+  AddBranch("flagCCQELike", &flagCCQELike, "flagCCQELike/O");
+  AddBranch("flagNCEL", &flagNCEL, "flagNCEL/O");
+  AddBranch("flagNC0pi", &flagNC0pi, "flagNC0pi/O");
+  AddBranch("flagCCcoh", &flagCCcoh, "flagCCcoh/O");
+  AddBranch("flagNCcoh", &flagNCcoh, "flagNCcoh/O");
+  AddBranch("flagCC1pip", &flagCC1pip, "flagCC1pip/O");
+  AddBranch("flagNC1pip", &flagNC1pip, "flagNC1pip/O");
+  AddBranch("flagCC1pim", &flagCC1pim, "flagCC1pim/O");
+  AddBranch("flagNC1pim", &flagNC1pim, "flagNC1pim/O");
+  AddBranch("flagCC1pi0", &flagCC1pi0, "flagCC1pi0/O");
+  AddBranch("flagNC1pi0", &flagNC1pi0, "flagNC1pi0/O");
 #ifdef MINERvA_ENABLED
-  eventVariables->Branch("flagCC0piMINERvA", &flagCC0piMINERvA,
-                         "flagCC0piMINERvA/O");
+  AddBranch("flagCC0piMINERvA", &flagCC0piMINERvA, "flagCC0piMINERvA/O");
 #endif
 #ifdef T2K_ENABLED
-  eventVariables->Branch("flagCC0Pi_T2K_AnaI", &flagCC0Pi_T2K_AnaI,
-                         "flagCC0Pi_T2K_AnaI/O");
-  eventVariables->Branch("flagCC0Pi_T2K_AnaII", &flagCC0Pi_T2K_AnaII,
-                         "flagCC0Pi_T2K_AnaII/O");
+  AddBranch("flagCC0Pi_T2K_AnaI", &flagCC0Pi_T2K_AnaI,
+            "flagCC0Pi_T2K_AnaI/O");
+  AddBranch("flagCC0Pi_T2K_AnaII", &flagCC0Pi_T2K_AnaII,
+            "flagCC0Pi_T2K_AnaII/O");
 #endif
 };
 
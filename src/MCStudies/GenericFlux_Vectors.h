@@ -63,6 +63,22 @@ public:
 
  private:
 
+  //! Whether a branch passes the nuisflat_Branches/nuisflat_DropBranches
+  //! selection
+  bool IsBranchSelected(std::string const &name) const;
+
+  //! Add a branch to eventVariables if it is selected
+  void AddBranch(std::string const &name, void *address,
+                 std::string const &leaflist);
+  void AddBranch(std::string const &name, TVector3 *address);
+
+  //! Grow the particle columns to hold n particles, repointing their branches
+  //! if the storage moved
+  void EnsureParticleCapacity(int n);
+
+  std::vector<std::string> KeepBranches;
+  std::vector<std::string> DropBranches;
+
   TTree* eventVariables;
   std::vector<FitParticle*> partList;
   std::vector<FitParticle*> initList;
@@ -109,31 +125,32 @@ public:
   float CosThetaAdler;
   float PhiAdler;
 
-  // Save outgoing particle vectors
+  // Save outgoing particle vectors. The columns are written per event with
+  // nfsp/ninitp/nvertp entries and only grow, there is no fixed maximum.
+  int fParticleCapacity;
   int nfsp;
-  static const int kMAX = 200;
-  float px[kMAX];
-  float py[kMAX];
-  float pz[kMAX];
-  float E[kMAX];
-  int pdg[kMAX];
-  int pdg_rank[kMAX];
+  std::vector<float> px;
+  std::vector<float> py;
+  std::vector<float> pz;
+  std::vector<float> E;
+  std::vector<int> pdg;
+  std::vector<int> pdg_rank;
 
   // Save incoming particle info
   int ninitp;
-  float px_init[kMAX];
-  float py_init[kMAX];
-  float pz_init[kMAX];
-  float E_init[kMAX];
-  int pdg_init[kMAX];
+  std::vector<float> px_init;
+  std::vector<float> py_init;
+  std::vector<float> pz_init;
+  std::vector<float> E_init;
+  std::vector<int> pdg_init;
 
   // Save pre-FSI particle info
   int nvertp;
-  float px_vert[kMAX];
-  float py_vert[kMAX];
-  float pz_vert[kMAX];
-  float E_vert[kMAX];
-  int pdg_vert[kMAX];
+  std::vector<float> px_vert;
+  std::vector<float> py_vert;
+  std::vector<float> pz_vert;
+  std::vector<float> E_vert;
+  std::vector<int> pdg_vert;
 
   // Basic event info
   float Weight;
@@ -134,16 +134,17 @@ void Smear_SVDUnfold_Propagation_Osc::SetupNDInputs() {
   for (size_t nd_it = 0; nd_it < NDSamples.size(); ++nd_it) {
     NDSample &nds = NDSamples[nd_it];
 
-    TMatrixD NDToSpectrumResponseMatrix_l = SmearceptanceUtils::GetMatrix(
-        SmearceptanceUtils::SVDGetInverse(nds.NDToSpectrumSmearingMatrix));
+    TMatrixD NDToSpectrumResponseMatrix_l =
+        *SmearceptanceUtils::SVDGetInverseMatrix(
+            nds.NDToSpectrumSmearingMatrix);
 
     nds.NDToSpectrumResponseMatrix.ResizeTo(NDToSpectrumResponseMatrix_l);
     nds.NDToSpectrumResponseMatrix = NDToSpectrumResponseMatrix_l;
 
     if (nds.TruncateStart != 0) {
       TMatrixD NDToSpectrumResponseMatrix_l =
-          SmearceptanceUtils::GetMatrix(SmearceptanceUtils::SVDGetInverse(
-              nds.NDToSpectrumSmearingMatrix, nds.TruncateStart));
+          *SmearceptanceUtils::SVDGetInverseMatrix(
+              nds.NDToSpectrumSmearingMatrix, nds.TruncateStart);
 
       nds.NDToSpectrumResponseMatrix.ResizeTo(NDToSpectrumResponseMatrix_l);
       nds.NDToSpectrumResponseMatrix = NDToSpectrumResponseMatrix_l;
@@ -581,8 +582,9 @@ void DumpUnfoldDebugInfo(Smear_SVDUnfold_Propagation_Osc::NDSample &nds,
   ss << "ND_Obs_" << nd_it;
   nds.NDDataHist->Write(ss.str().c_str(), TObject::kOverwrite);
 
-  TMatrixD NDToSpectrumResponseMatrix_notrunc = SmearceptanceUtils::GetMatrix(
-      SmearceptanceUtils::SVDGetInverse(nds.NDToSpectrumSmearingMatrix, 0));
+  TMatrixD NDToSpectrumResponseMatrix_notrunc =
+      *SmearceptanceUtils::SVDGetInverseMatrix(nds.NDToSpectrumSmearingMatrix,
+                                               0);
 
   nds.NDToSpectrumResponseMatrix.ResizeTo(NDToSpectrumResponseMatrix_notrunc);
   nds.NDToSpectrumResponseMatrix = NDToSpectrumResponseMatrix_notrunc;
@@ -596,8 +598,8 @@ void DumpUnfoldDebugInfo(Smear_SVDUnfold_Propagation_Osc::NDSample &nds,
   nds.ND_Unfolded_Spectrum_Hist->Write(ss.str().c_str(), TObject::kOverwrite);
 
   TMatrixD NDToSpectrumResponseMatrix_trunc =
-      SmearceptanceUtils::GetMatrix(SmearceptanceUtils::SVDGetInverse(
-          nds.NDToSpectrumSmearingMatrix, truncations));
+      *SmearceptanceUtils::SVDGetInverseMatrix(nds.NDToSpectrumSmearingMatrix,
+                                               truncations);
 
   nds.NDToSpectrumResponseMatrix.ResizeTo(NDToSpectrumResponseMatrix_trunc);
   nds.NDToSpectrumResponseMatrix = NDToSpectrumResponseMatrix_trunc;
@@ -683,8 +685,8 @@ void Smear_SVDUnfold_Propagation_Osc::UnfoldToNDETrueSpectrum(size_t nd_it) {
 
     if (HasNegValue) {
       TMatrixD NDToSpectrumResponseMatrix_l =
-          SmearceptanceUtils::GetMatrix(SmearceptanceUtils::SVDGetInverse(
-              nds.NDToSpectrumSmearingMatrix, truncations));
+          *SmearceptanceUtils::SVDGetInverseMatrix(
+              nds.NDToSpectrumSmearingMatrix, truncations);
 
       nds.NDToSpectrumResponseMatrix.ResizeTo(NDToSpectrumResponseMatrix_l);
       nds.NDToSpectrumResponseMatrix = NDToSpectrumResponseMatrix_l;
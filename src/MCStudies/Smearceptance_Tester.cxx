@@ -23,6 +23,8 @@
 
 #include "Smearcepterton.h"
 
+#include <sstream>
+
 //#define DEBUG_SMEARTESTER
 
 //********************************************************************
@@ -102,7 +104,33 @@ Smearceptance_Tester::Smearceptance_Tester(nuiskey samplekey) {
   // Setup our TTrees
   AddEventVariablesToTree();
 
-  smearceptor = &Smearcepterton::Get().GetSmearcepter(smearceptorName);
+  // Each event gets its own random stream so the output does not depend on
+  // the number of smearing threads.
+  int SmearThreads = 1;
+  if (Config::HasPar("smear.threads")) {
+    SmearThreads = Config::GetParI("smear.threads");
+  }
+  ULong64_t SmearSeed = 4357;
+  if (Config::HasPar("smear.seed")) {
+    // Read as a string, GetParI would truncate seeds above INT_MAX
+    std::string seedstr = Config::GetParS("smear.seed");
+    std::istringstream seedstream(seedstr);
+    if ((seedstr.find('-') != std::string::npos) ||
+        !(seedstream >> SmearSeed)) {
+      NUIS_ABORT("Invalid smear.seed: \"" << seedstr
+                                           << "\", expected an unsigned "
+                                              "64-bit integer.");
+    }
+  }
+  smearDriver = new SmearDriver(smearceptorName, SmearThreads, SmearSeed);
+  SmearEventIndex = 0;
+  NSmearBatched = 0;
+  if (smearDriver->GetNThreads() > 1) {
+    SmearBatch.resize(256 * smearDriver->GetNThreads());
+    for (size_t e_it = 0; e_it < SmearBatch.size(); ++e_it) {
+      SmearBatch[e_it] = new FitEvent();
+    }
+  }
 
   Int_t RecNBins = 20, TrueNBins = 20;
   double RecBinL = 0xdeadbeef, TrueBinL = 0, RecBinH = 10, TrueBinH = 10;
@@ -161,6 +189,15 @@ Smearceptance_Tester::Smearceptance_Tester(nuiskey samplekey) {
   FinaliseMeasurement();
 }
 
+//********************************************************************
+Smearceptance_Tester::~Smearceptance_Tester() {
+  //********************************************************************
+  for (size_t e_it = 0; e_it < SmearBatch.size(); ++e_it) {
+    delete SmearBatch[e_it];
+  }
+  delete smearDriver;
+}
+
 void Smearceptance_Tester::AddEventVariablesToTree() {
   if (OutputSummaryTree) {
     // Setup the TTree to save everything
@@ -337,7 +374,7 @@ void Smearceptance_Tester::AddEventVariablesToTree() {
 }
 
 template <size_t N>
-int CountNPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNPdgsSeen(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t pdg_it = 0; pdg_it < N; ++pdg_it) {
     sum +=
@@ -347,7 +384,7 @@ int CountNPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-int CountNNotPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNNotPdgsSeen(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t p_it = 0; p_it < ri.RecObjClass.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N, ri.RecObjClass[p_it])) {
@@ -358,7 +395,7 @@ int CountNNotPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-int CountNPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNPdgsContributed(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t pdg_it = 0; pdg_it < N; ++pdg_it) {
     sum += std::count(ri.TrueContribPDGs.begin(), ri.TrueContribPDGs.end(),
@@ -368,7 +405,7 @@ int CountNPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-int CountNNotPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNNotPdgsContributed(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t p_it = 0; p_it < ri.TrueContribPDGs.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N, ri.TrueContribPDGs[p_it])) {
@@ -378,7 +415,7 @@ int CountNNotPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
   return sum;
 }
 
-TLorentzVector GetHMFSRecParticles(RecoInfo ri, int pdg) {
+TLorentzVector GetHMFSRecParticles(RecoInfo const &ri, int pdg) {
   TLorentzVector mom(0, 0, 0, 0);
   for (size_t p_it = 0; p_it < ri.RecObjMom.size(); ++p_it) {
     if ((ri.RecObjClass[p_it] == pdg) &&
@@ -392,7 +429,7 @@ TLorentzVector GetHMFSRecParticles(RecoInfo ri, int pdg) {
 }
 
 template <size_t N>
-double SumKE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
+double SumKE_RecoInfo(RecoInfo const &ri, int const (&pdgs)[N], double mass) {
   double sum = 0;
   for (size_t p_it = 0; p_it < ri.RecObjMom.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N,
@@ -407,7 +444,7 @@ double SumKE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
 }
 
 template <size_t N>
-double SumTE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
+double SumTE_RecoInfo(RecoInfo const &ri, int const (&pdgs)[N], double mass) {
   double sum = 0;
   for (size_t p_it = 0; p_it < ri.RecObjMom.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N,
@@ -422,7 +459,7 @@ double SumTE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
 }
 
 template <size_t N>
-double SumVisE_RecoInfo(RecoInfo ri, int const (&pdgs)[N]) {
+double SumVisE_RecoInfo(RecoInfo const &ri, int const (&pdgs)[N]) {
   double sum = 0;
 
   for (size_t p_it = 0; p_it < ri.RecVisibleEnergy.size(); ++p_it) {
@@ -438,7 +475,7 @@ double SumVisE_RecoInfo(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-double SumVisE_RecoInfo_NotPdgs(RecoInfo ri, int const (&pdgs)[N]) {
+double SumVisE_RecoInfo_NotPdgs(RecoInfo const &ri, int const (&pdgs)[N]) {
   double sum = 0;
 
   for (size_t p_it = 0; p_it < ri.RecVisibleEnergy.size(); ++p_it) {
@@ -453,10 +490,54 @@ double SumVisE_RecoInfo_NotPdgs(RecoInfo ri, int const (&pdgs)[N]) {
   return sum;
 }
 
+//********************************************************************
+void Smearceptance_Tester::Reconfigure() {
+  //********************************************************************
+  SmearEventIndex = 0;
+  NSmearBatched = 0;
+  MeasurementBase::Reconfigure();
+  FlushSmearBatch();
+}
+
 //********************************************************************
 void Smearceptance_Tester::FillEventVariables(FitEvent *event) {
   //********************************************************************
 
+  if (!SmearBatch.size()) {
+    FillSmearedEventVariables(event,
+                              smearDriver->Smearcept(event, SmearEventIndex++));
+    return;
+  }
+
+  // Smearing is deferred until a batch of events is ready, the tree is still
+  // filled in input order.
+  SmearBatch[NSmearBatched++]->CopyEventFrom(*event);
+  if (NSmearBatched == SmearBatch.size()) {
+    FlushSmearBatch();
+  }
+}
+
+//********************************************************************
+void Smearceptance_Tester::FlushSmearBatch() {
+  //********************************************************************
+  if (!NSmearBatched) {
+    return;
+  }
+
+  smearDriver->SmearBatch(SmearBatch, NSmearBatched, SmearEventIndex);
+  for (size_t e_it = 0; e_it < NSmearBatched; ++e_it) {
+    FillSmearedEventVariables(SmearBatch[e_it],
+                              &smearDriver->GetResult(e_it));
+  }
+  SmearEventIndex += NSmearBatched;
+  NSmearBatched = 0;
+}
+
+//********************************************************************
+void Smearceptance_Tester::FillSmearedEventVariables(FitEvent *event,
+                                                     RecoInfo const *ri) {
+  //********************************************************************
+
   static int const cpipPDG[] = {211};
   static int const cpimPDG[] = {-211};
   static int const pi0PDG[] = {111};
@@ -472,8 +553,6 @@ void Smearceptance_Tester::FillEventVariables(FitEvent *event) {
                                      2212, 2112, 22,  11,  13,   15,  12,  14,
                                      16,   -11,  -13, -15, -12,  -14, -16};
 
-  RecoInfo *ri = smearceptor->Smearcept(event);
-
   //** START Pions
 
   HMFS_clep_true = TLorentzVector(0, 0, 0, 0);
@@ -23,6 +23,7 @@
 #include "Measurement1D.h"
 
 #include "ISmearcepter.h"
+#include "SmearDriver.h"
 
 #ifdef Prob3plusplus_ENABLED
 #include "OscWeightEngine.h"
@@ -34,7 +35,10 @@ class Smearceptance_Tester : public Measurement1D {
 
  public:
   Smearceptance_Tester(nuiskey samplekey);
-  virtual ~Smearceptance_Tester(){};
+  virtual ~Smearceptance_Tester();
+
+  //! Smear all events, flushing any still queued for the smearing threads
+  void Reconfigure();
 
   //! Grab info from event
   void FillEventVariables(FitEvent *event);
@@ -63,7 +67,19 @@ class Smearceptance_Tester : public Measurement1D {
   void AddEventVariablesToTree();
 
  private:
-  ISmearcepter *smearceptor;
+  //! Fill the tree and histograms from an event and its smeared info
+  void FillSmearedEventVariables(FitEvent *event, RecoInfo const *ri);
+
+  //! Smear the queued events on all threads and fill them in order
+  void FlushSmearBatch();
+
+  SmearDriver *smearDriver;
+  //! Index of the next event, keys its random stream
+  ULong64_t SmearEventIndex;
+
+  //! Copies of the events waiting to be smeared in parallel
+  std::vector<FitEvent *> SmearBatch;
+  size_t NSmearBatched;
 
   TTree *eventVariables;
 
@@ -0,0 +1,379 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// MINERvA CCQE
+#include "MINERvA_CCQE_XSec_1DQ2_antinu.h"
+#include "MINERvA_CCQE_XSec_1DQ2_joint.h"
+#include "MINERvA_CCQE_XSec_1DQ2_nu.h"
+
+// MINERvA CC0pi
+#include "MINERvA_CC0pi_XSec_1DEe_nue.h"
+#include "MINERvA_CC0pi_XSec_1DQ2_nu_proton.h"
+#include "MINERvA_CC0pi_XSec_1DQ2_nue.h"
+#include "MINERvA_CC0pi_XSec_1DThetae_nue.h"
+
+// 2018 MINERvA CC0pi STV
+#include "MINERvA_CC0pinp_STV_XSec_1D_nu.h"
+
+// 2018 MINERvA CC0pi 2D
+#include "MINERvA_CC0pi_XSec_1D_2018_nu.h"
+#include "MINERvA_CC0pi_XSec_2D_nu.h"
+// #include "MINERvA_CC0pi_XSec_3DptpzTp_nu.h"
+#include "MINERvA_CC0pi_XSec_3DptpzTp_1DVersion_nu.h"
+#include "MINERvA_CC0pi_XSec_3Dq0qeemuTp_1DVersion_nu.h"
+
+// 2018 MINERvA CC0pi 2D antinu
+#include "MINERvA_CC0pi_XSec_2D_antinu.h"
+
+// MINERvA CC1pi+
+#include "MINERvA_CC1pip_XSec_1DTpi_20deg_nu.h"
+#include "MINERvA_CC1pip_XSec_1DTpi_nu.h"
+#include "MINERvA_CC1pip_XSec_1Dth_20deg_nu.h"
+#include "MINERvA_CC1pip_XSec_1Dth_nu.h"
+// 2017 data update
+#include "MINERvA_CC1pip_XSec_1D_2017Update.h"
+
+// MINERvA CC1pi-
+#include "MINERvA_CC1pim_XSec_1DEnu_antinu.h"
+#include "MINERvA_CC1pim_XSec_1DQ2_antinu.h"
+#include "MINERvA_CC1pim_XSec_1DTpi_antinu.h"
+#include "MINERvA_CC1pim_XSec_1Dpmu_antinu.h"
+#include "MINERvA_CC1pim_XSec_1Dth_antinu.h"
+#include "MINERvA_CC1pim_XSec_1Dthmu_antinu.h"
+
+// MINERvA CCNpi+
+#include "MINERvA_CCNpip_XSec_1DEnu_nu.h"
+#include "MINERvA_CCNpip_XSec_1DQ2_nu.h"
+#include "MINERvA_CCNpip_XSec_1DTpi_nu.h"
+#include "MINERvA_CCNpip_XSec_1Dpmu_nu.h"
+#include "MINERvA_CCNpip_XSec_1Dth_nu.h"
+#include "MINERvA_CCNpip_XSec_1Dthmu_nu.h"
+
+// MINERvA CC1pi0
+#include "MINERvA_CC1pi0_XSec_1DEnu_antinu.h"
+#include "MINERvA_CC1pi0_XSec_1DQ2_antinu.h"
+#include "MINERvA_CC1pi0_XSec_1DTpi0_antinu.h"
+#include "MINERvA_CC1pi0_XSec_1Dpmu_antinu.h"
+#include "MINERvA_CC1pi0_XSec_1Dppi0_antinu.h"
+#include "MINERvA_CC1pi0_XSec_1Dth_antinu.h"
+#include "MINERvA_CC1pi0_XSec_1Dthmu_antinu.h"
+
+// MINERvA CC1pi0 neutrino
+#include "MINERvA_CC1pi0_XSec_1D_nu.h"
+
+// MINERvA CCINC
+#include "MINERvA_CCinc_XSec_1DEnu_ratio.h"
+#include "MINERvA_CCinc_XSec_1Dx_ratio.h"
+#include "MINERvA_CCinc_XSec_2DEavq3_nu.h"
+
+// MINERvA CCDIS
+#include "MINERvA_CCDIS_XSec_1DEnu_ratio.h"
+#include "MINERvA_CCDIS_XSec_1Dx_ratio.h"
+
+// MINERvA CCCOH pion
+#include "MINERvA_CCCOHPI_XSec_1DEnu_antinu.h"
+#include "MINERvA_CCCOHPI_XSec_1DEpi_antinu.h"
+#include "MINERvA_CCCOHPI_XSec_1DQ2_antinu.h"
+
+#include "MINERvA_CCCOHPI_XSec_1DEpi_nu.h"
+#include "MINERvA_CCCOHPI_XSec_1DQ2_nu.h"
+#include "MINERvA_CCCOHPI_XSec_1Dth_nu.h"
+
+#include "MINERvA_CCCOHPI_XSec_joint.h"
+
+#include "MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu.h"
+#include "MINERvA_CC0pi_XSec_1DQ2_Tgt_nu.h"
+
+// MINERvA Nuke CC0pi muon 2d
+#include "MINERvA_NukeCC0pi_XSec_2D_nu.h"
+
+void SampleUtils::RegisterMINERvASamples(SampleFactoryMap &factories) {
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_nu>(factories,
+                                            "MINERvA_CCQE_XSec_1DQ2_nu");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_nu>(factories,
+                                            "MINERvA_CCQE_XSec_1DQ2_nu_20deg");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_nu>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_nu_oldflux");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_nu>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_nu_20deg_oldflux");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_antinu>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_antinu");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_antinu>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_antinu_20deg");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_antinu>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_antinu_oldflux");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_antinu>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_antinu_20deg_oldflux");
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_joint>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_joint_oldflux", false);
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_joint>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_joint_20deg_oldflux", false);
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_joint>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_joint", false);
+  RegisterSample<MINERvA_CCQE_XSec_1DQ2_joint>(
+      factories, "MINERvA_CCQE_XSec_1DQ2_joint_20deg", false);
+  RegisterSample<MINERvA_CC0pi_XSec_1DEe_nue>(factories,
+                                              "MINERvA_CC0pi_XSec_1DEe_nue");
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_nue>(factories,
+                                              "MINERvA_CC0pi_XSec_1DQ2_nue");
+  RegisterSample<MINERvA_CC0pi_XSec_1DThetae_nue>(
+      factories, "MINERvA_CC0pi_XSec_1DThetae_nue");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Dpmu_nu");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Dthmu_nu");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Dpprot_nu");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Dthprot_nu");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Dpnreco_nu");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Ddalphat_nu");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Ddpt_nu");
+  RegisterSample<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      factories, "MINERvA_CC0pinp_STV_XSec_1Ddphit_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_nu_proton>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_nu_proton");
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_TgtC_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_TgtCH_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_TgtFe_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_TgtPb_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_TgtRatioC_nu", false);
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_TgtRatioFe_nu", false);
+  RegisterSample<MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DQ2_TgtRatioPb_nu", false);
+  RegisterSample<MINERvA_CC0pi_XSec_2D_nu>(factories,
+                                           "MINERvA_CC0pi_XSec_2Dptpz_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_3DptpzTp_1DVersion_nu>(
+      factories, "MINERvA_CC0pi_XSec_3DptpzTp_1DVersion_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_3Dq0qeemuTp_1DVersion_nu>(
+      factories, "MINERvA_CC0pi_XSec_3Dq0qeemuTp_1DVersion_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1D_2018_nu>(factories,
+                                                "MINERvA_CC0pi_XSec_1Dpt_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1D_2018_nu>(factories,
+                                                "MINERvA_CC0pi_XSec_1Dpz_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1D_2018_nu>(factories,
+                                                "MINERvA_CC0pi_XSec_1DQ2QE_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_1D_2018_nu>(
+      factories, "MINERvA_CC0pi_XSec_1DEnuQE_nu");
+  RegisterSample<MINERvA_CC0pi_XSec_2D_antinu>(
+      factories, "MINERvA_CC0pi_XSec_2Dptpz_antinu");
+  RegisterSample<MINERvA_CC0pi_XSec_2D_antinu>(
+      factories, "MINERvA_CC0pi_XSec_2DQ2QEEnuQE_antinu");
+  RegisterSample<MINERvA_CC0pi_XSec_2D_antinu>(
+      factories, "MINERvA_CC0pi_XSec_2DQ2QEEnuTrue_antinu");
+  RegisterSample<MINERvA_CC1pip_XSec_1DTpi_nu>(factories,
+                                               "MINERvA_CC1pip_XSec_1DTpi_nu");
+  RegisterSample<MINERvA_CC1pip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CC1pip_XSec_1DTpi_nu_20deg");
+  RegisterSample<MINERvA_CC1pip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CC1pip_XSec_1DTpi_nu_fluxcorr");
+  RegisterSample<MINERvA_CC1pip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CC1pip_XSec_1DTpi_nu_20deg_fluxcorr");
+  RegisterSample<MINERvA_CC1pip_XSec_1Dth_nu>(factories,
+                                              "MINERvA_CC1pip_XSec_1Dth_nu");
+  RegisterSample<MINERvA_CC1pip_XSec_1Dth_nu>(
+      factories, "MINERvA_CC1pip_XSec_1Dth_nu_20deg");
+  RegisterSample<MINERvA_CC1pip_XSec_1Dth_nu>(
+      factories, "MINERvA_CC1pip_XSec_1Dth_nu_fluxcorr");
+  RegisterSample<MINERvA_CC1pip_XSec_1Dth_nu>(
+      factories, "MINERvA_CC1pip_XSec_1Dth_nu_20deg_fluxcorr");
+  RegisterSample<MINERvA_CC1pip_XSec_1D_2017Update>(
+      factories, "MINERvA_CC1pip_XSec_1DTpi_nu_2017");
+  RegisterSample<MINERvA_CC1pip_XSec_1D_2017Update>(
+      factories, "MINERvA_CC1pip_XSec_1Dth_nu_2017");
+  RegisterSample<MINERvA_CC1pip_XSec_1D_2017Update>(
+      factories, "MINERvA_CC1pip_XSec_1Dpmu_nu_2017");
+  RegisterSample<MINERvA_CC1pip_XSec_1D_2017Update>(
+      factories, "MINERvA_CC1pip_XSec_1Dthmu_nu_2017");
+  RegisterSample<MINERvA_CC1pip_XSec_1D_2017Update>(
+      factories, "MINERvA_CC1pip_XSec_1DQ2_nu_2017");
+  RegisterSample<MINERvA_CC1pip_XSec_1D_2017Update>(
+      factories, "MINERvA_CC1pip_XSec_1DEnu_nu_2017");
+  RegisterSample<MINERvA_CC1pim_XSec_1DEnu_antinu>(
+      factories, "MINERvA_CC1pim_XSec_1DEnu_antinu");
+  RegisterSample<MINERvA_CC1pim_XSec_1DQ2_antinu>(
+      factories, "MINERvA_CC1pim_XSec_1DQ2_antinu");
+  RegisterSample<MINERvA_CC1pim_XSec_1DTpi_antinu>(
+      factories, "MINERvA_CC1pim_XSec_1DTpi_antinu");
+  RegisterSample<MINERvA_CC1pim_XSec_1Dpmu_antinu>(
+      factories, "MINERvA_CC1pim_XSec_1Dpmu_antinu");
+  RegisterSample<MINERvA_CC1pim_XSec_1Dth_antinu>(
+      factories, "MINERvA_CC1pim_XSec_1Dth_antinu");
+  RegisterSample<MINERvA_CC1pim_XSec_1Dthmu_antinu>(
+      factories, "MINERvA_CC1pim_XSec_1Dthmu_antinu");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dth_nu>(factories,
+                                              "MINERvA_CCNpip_XSec_1Dth_nu");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dth_nu>(
+      factories, "MINERvA_CCNpip_XSec_1Dth_nu_2015");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dth_nu>(
+      factories, "MINERvA_CCNpip_XSec_1Dth_nu_2016");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dth_nu>(
+      factories, "MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dth_nu>(
+      factories, "MINERvA_CCNpip_XSec_1Dth_nu_2015_fluxcorr");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dth_nu>(
+      factories, "MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg_fluxcorr");
+  RegisterSample<MINERvA_CCNpip_XSec_1DTpi_nu>(factories,
+                                               "MINERvA_CCNpip_XSec_1DTpi_nu");
+  RegisterSample<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CCNpip_XSec_1DTpi_nu_2015");
+  RegisterSample<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CCNpip_XSec_1DTpi_nu_2016");
+  RegisterSample<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg");
+  RegisterSample<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CCNpip_XSec_1DTpi_nu_2015_fluxcorr");
+  RegisterSample<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      factories, "MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg_fluxcorr");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dthmu_nu>(
+      factories, "MINERvA_CCNpip_XSec_1Dthmu_nu");
+  RegisterSample<MINERvA_CCNpip_XSec_1Dpmu_nu>(factories,
+                                               "MINERvA_CCNpip_XSec_1Dpmu_nu");
+  RegisterSample<MINERvA_CCNpip_XSec_1DQ2_nu>(factories,
+                                              "MINERvA_CCNpip_XSec_1DQ2_nu");
+  RegisterSample<MINERvA_CCNpip_XSec_1DEnu_nu>(factories,
+                                               "MINERvA_CCNpip_XSec_1DEnu_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dth_antinu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dth_antinu_2015");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dth_antinu_2016");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dth_antinu_fluxcorr");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dth_antinu_2015_fluxcorr");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dth_antinu_2016_fluxcorr");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dppi0_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dppi0_antinu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dppi0_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dppi0_antinu_fluxcorr");
+  RegisterSample<MINERvA_CC1pi0_XSec_1DTpi0_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1DTpi0_antinu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1DQ2_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1DQ2_antinu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dthmu_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dthmu_antinu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1Dpmu_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1Dpmu_antinu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1DEnu_antinu>(
+      factories, "MINERvA_CC1pi0_XSec_1DEnu_antinu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(factories,
+                                            "MINERvA_CC1pi0_XSec_1DTpi_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(factories,
+                                            "MINERvA_CC1pi0_XSec_1Dth_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(factories,
+                                            "MINERvA_CC1pi0_XSec_1Dpmu_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(factories,
+                                            "MINERvA_CC1pi0_XSec_1Dthmu_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(factories,
+                                            "MINERvA_CC1pi0_XSec_1DQ2_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(factories,
+                                            "MINERvA_CC1pi0_XSec_1DEnu_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(factories,
+                                            "MINERvA_CC1pi0_XSec_1DWexp_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(
+      factories, "MINERvA_CC1pi0_XSec_1DPPi0Mass_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(
+      factories, "MINERvA_CC1pi0_XSec_1DPPi0MassDelta_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(
+      factories, "MINERvA_CC1pi0_XSec_1DCosAdler_nu");
+  RegisterSample<MINERvA_CC1pi0_XSec_1D_nu>(
+      factories, "MINERvA_CC1pi0_XSec_1DPhiAdler_nu");
+  RegisterSample<MINERvA_CCinc_XSec_2DEavq3_nu>(
+      factories, "MINERvA_CCinc_XSec_2DEavq3_nu");
+  RegisterSample<MINERvA_CCinc_XSec_1Dx_ratio>(
+      factories, "MINERvA_CCinc_XSec_1Dx_ratio_C12_CH", false);
+  RegisterSample<MINERvA_CCinc_XSec_1Dx_ratio>(
+      factories, "MINERvA_CCinc_XSec_1Dx_ratio_Fe56_CH", false);
+  RegisterSample<MINERvA_CCinc_XSec_1Dx_ratio>(
+      factories, "MINERvA_CCinc_XSec_1Dx_ratio_Pb208_CH", false);
+  RegisterSample<MINERvA_CCinc_XSec_1DEnu_ratio>(
+      factories, "MINERvA_CCinc_XSec_1DEnu_ratio_C12_CH", false);
+  RegisterSample<MINERvA_CCinc_XSec_1DEnu_ratio>(
+      factories, "MINERvA_CCinc_XSec_1DEnu_ratio_Fe56_CH", false);
+  RegisterSample<MINERvA_CCinc_XSec_1DEnu_ratio>(
+      factories, "MINERvA_CCinc_XSec_1DEnu_ratio_Pb208_CH", false);
+  RegisterSample<MINERvA_CCDIS_XSec_1Dx_ratio>(
+      factories, "MINERvA_CCDIS_XSec_1Dx_ratio_C12_CH", false);
+  RegisterSample<MINERvA_CCDIS_XSec_1Dx_ratio>(
+      factories, "MINERvA_CCDIS_XSec_1Dx_ratio_Fe56_CH", false);
+  RegisterSample<MINERvA_CCDIS_XSec_1Dx_ratio>(
+      factories, "MINERvA_CCDIS_XSec_1Dx_ratio_Pb208_CH", false);
+  RegisterSample<MINERvA_CCDIS_XSec_1DEnu_ratio>(
+      factories, "MINERvA_CCDIS_XSec_1DEnu_ratio_C12_CH", false);
+  RegisterSample<MINERvA_CCDIS_XSec_1DEnu_ratio>(
+      factories, "MINERvA_CCDIS_XSec_1DEnu_ratio_Fe56_CH", false);
+  RegisterSample<MINERvA_CCDIS_XSec_1DEnu_ratio>(
+      factories, "MINERvA_CCDIS_XSec_1DEnu_ratio_Pb208_CH", false);
+  RegisterSample<MINERvA_CCCOHPI_XSec_1DEnu_nu>(
+      factories, "MINERvA_CCCOHPI_XSec_1DEnu_nu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_1DEpi_nu>(
+      factories, "MINERvA_CCCOHPI_XSec_1DEpi_nu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_1Dth_nu>(factories,
+                                               "MINERvA_CCCOHPI_XSec_1Dth_nu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_1DQ2_nu>(factories,
+                                               "MINERvA_CCCOHPI_XSec_1DQ2_nu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_1DEnu_antinu>(
+      factories, "MINERvA_CCCOHPI_XSec_1DEnu_antinu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_1DEpi_antinu>(
+      factories, "MINERvA_CCCOHPI_XSec_1DEpi_antinu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_1Dth_antinu>(
+      factories, "MINERvA_CCCOHPI_XSec_1Dth_antinu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_1DQ2_antinu>(
+      factories, "MINERvA_CCCOHPI_XSec_1DQ2_antinu");
+  RegisterSample<MINERvA_CCCOHPI_XSec_joint>(
+      factories, "MINERvA_CCCOHPI_XSec_1DEnu_joint", false);
+  RegisterSample<MINERvA_CCCOHPI_XSec_joint>(
+      factories, "MINERvA_CCCOHPI_XSec_1DEpi_joint", false);
+  RegisterSample<MINERvA_CCCOHPI_XSec_joint>(
+      factories, "MINERvA_CCCOHPI_XSec_1Dth_joint", false);
+  RegisterSample<MINERvA_CCCOHPI_XSec_joint>(
+      factories, "MINERvA_CCCOHPI_XSec_1DQ2_joint", false);
+  RegisterSample<MINERvA_NukeCC0pi_CH_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_CH_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_C_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_C_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_H2O_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_H2O_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_Fe_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_Fe_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_Pb_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_Pb_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_CH_C_Flux_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_CH_C_Flux_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_CH_H2O_Flux_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_CH_H2O_Flux_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_CH_Fe_Flux_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_CH_Fe_Flux_XSec_2D_nu");
+  RegisterSample<MINERvA_NukeCC0pi_CH_Pb_Flux_XSec_2D_nu>(
+      factories, "MINERvA_NukeCC0pi_CH_Pb_Flux_XSec_2D_nu");
+}
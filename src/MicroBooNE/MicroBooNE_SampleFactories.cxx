@@ -0,0 +1,117 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+#include "MicroBooNE_CC1Mu1p_XSec_1D_nu.h"
+#include "MicroBooNE_CC1Mu2p_XSec_1D_nu.h"
+#include "MicroBooNE_CC1MuNp_XSec_1D_nu.h"
+#include "MicroBooNE_CCInc_XSec_2DPcos_nu.h"
+#include "MicroBooNE_CC1Mu0pNp_XSec_nu.h"
+#include "MicroBooNE_CC1Mu3DInc_XSec_nu.h"
+#include "MicroBooNE_NCpi0_XSec_nu.h"
+
+void SampleUtils::RegisterMicroBooNESamples(SampleFactoryMap &factories) {
+  RegisterSample<MicroBooNE_CCInc_XSec_2DPcos_nu>(
+      factories, "MicroBooNE_CCInc_XSec_2DPcos_nu");
+  RegisterSample<MicroBooNE_CC1MuNp_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1MuNp_XSec_1DPmu_nu");
+  RegisterSample<MicroBooNE_CC1MuNp_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1MuNp_XSec_1Dcosmu_nu");
+  RegisterSample<MicroBooNE_CC1MuNp_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1MuNp_XSec_1DPp_nu");
+  RegisterSample<MicroBooNE_CC1MuNp_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1MuNp_XSec_1Dcosp_nu");
+  RegisterSample<MicroBooNE_CC1MuNp_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1MuNp_XSec_1Dthetamup_nu");
+  RegisterSample<MicroBooNE_CC1Mu2p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu2p_XSec_1DOpening_Angle_Protons_Lab_nu");
+  RegisterSample<MicroBooNE_CC1Mu2p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu2p_XSec_1DOpening_Angle_Mu_Both_nu");
+  RegisterSample<MicroBooNE_CC1Mu2p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu2p_XSec_1DDeltaPT_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DDeltaPT_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DDeltaAlphaT_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DDeltaPhiT_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DMuonCosTheta_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DProtonCosTheta_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DMuonMomentum_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DProtonMomentum_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DDeltaPn_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DDeltaPtx_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DDeltaPty_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DECal_nu");
+  RegisterSample<MicroBooNE_CC1Mu1p_XSec_1D_nu>(
+      factories, "MicroBooNE_CC1Mu1p_XSec_1DEQE_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpEMu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_EMu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpCosThetaMu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_CosThetaMu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpEnu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_ENu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpTransferEnergy> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_TransferEnergy_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpAvailEnergy> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_AvailEnergy_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCProtonKE> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_ProtonKE_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCProtonCosTheta> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_ProtonCosTheta_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCProtonMult> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_ProtonMult_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCC0pNpEMuCosThetaMu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_EMuCosThetaMu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCNpProtonKECosTheta> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_ProtonKECosTheta_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpEMu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_XpEMu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpCosThetaMu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_XpCosThetaMu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpEMuCosThetaMu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_XpEMuCosThetaMu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kCCXpAvailEnergyCosThetaMuEMu> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_XpAvailEnergyCosThetaMuEMu_nu");
+  RegisterSample<MicroBooNE_CC1Mu0pNp_XSec_nu<kAllCC> >(
+      factories, "MicroBooNE_CC1Mu0pNp_XSec_All_nu");
+  RegisterSample<MicroBooNE_CC1Mu3DInc_XSec_nu>(
+      factories, "MicroBooNE_CC1Mu3DInc_XSec_nu");
+  RegisterSample<MicroBooNE_NCpi0_XSec_nu<kNC0pNpPpi0> >(
+      factories, "MicroBooNE_NCpi0_XSec_0pNpPpi0_nu");
+  RegisterSample<MicroBooNE_NCpi0_XSec_nu<kNCXpPpi0> >(
+      factories, "MicroBooNE_NCpi0_XSec_XpPpi0_nu");
+  RegisterSample<MicroBooNE_NCpi0_XSec_nu<kNC0pNpCosThetaPi0> >(
+      factories, "MicroBooNE_NCpi0_XSec_0pNpCosThetaPi0_nu");
+  RegisterSample<MicroBooNE_NCpi0_XSec_nu<kNCXpCosThetaPi0> >(
+      factories, "MicroBooNE_NCpi0_XSec_XpCosThetaPi0_nu");
+  RegisterSample<MicroBooNE_NCpi0_XSec_nu<kNCXpPpi0CosThetaPi0> >(
+      factories, "MicroBooNE_NCpi0_XSec_XpPpi0CosThetaPi0_nu");
+  RegisterSample<MicroBooNE_NCpi0_XSec_nu<kAllNCpi0> >(
+      factories, "MicroBooNE_NCpi0_XSec_AllNCpi0_nu");
+}
@@ -0,0 +1,127 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// MiniBooNE CCQE
+#include "MiniBooNE_CCQE_XSec_1DEnu_nu.h"
+#include "MiniBooNE_CCQE_XSec_1DQ2_antinu.h"
+#include "MiniBooNE_CCQE_XSec_1DQ2_nu.h"
+#include "MiniBooNE_CCQE_XSec_2DTcos_antinu.h"
+#include "MiniBooNE_CCQE_XSec_2DTcos_nu.h"
+
+// MiniBooNE CC1pi+ 1D
+#include "MiniBooNE_CC1pip_XSec_1DEnu_nu.h"
+#include "MiniBooNE_CC1pip_XSec_1DQ2_nu.h"
+#include "MiniBooNE_CC1pip_XSec_1DTpi_nu.h"
+#include "MiniBooNE_CC1pip_XSec_1DTu_nu.h"
+// MiniBooNE CC1pi+ 2D
+#include "MiniBooNE_CC1pip_XSec_2DQ2Enu_nu.h"
+#include "MiniBooNE_CC1pip_XSec_2DTpiCospi_nu.h"
+#include "MiniBooNE_CC1pip_XSec_2DTpiEnu_nu.h"
+#include "MiniBooNE_CC1pip_XSec_2DTuCosmu_nu.h"
+#include "MiniBooNE_CC1pip_XSec_2DTuEnu_nu.h"
+
+// MiniBooNE CC1pi0
+#include "MiniBooNE_CC1pi0_XSec_1DEnu_nu.h"
+#include "MiniBooNE_CC1pi0_XSec_1DQ2_nu.h"
+#include "MiniBooNE_CC1pi0_XSec_1DTu_nu.h"
+#include "MiniBooNE_CC1pi0_XSec_1Dcosmu_nu.h"
+#include "MiniBooNE_CC1pi0_XSec_1Dcospi0_nu.h"
+#include "MiniBooNE_CC1pi0_XSec_1Dppi0_nu.h"
+#include "MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu.h"
+#include "MiniBooNE_NC1pi0_XSec_1Dcospi0_nu.h"
+#include "MiniBooNE_NC1pi0_XSec_1Dppi0_antinu.h"
+#include "MiniBooNE_NC1pi0_XSec_1Dppi0_nu.h"
+
+// MiniBooNE NCEL
+#include "MiniBooNE_NCEL_XSec_Treco_nu.h"
+
+void SampleUtils::RegisterMiniBooNESamples(SampleFactoryMap &factories) {
+  RegisterSample<MiniBooNE_CCQE_XSec_1DQ2_nu>(factories,
+                                              "MiniBooNE_CCQE_XSec_1DQ2_nu");
+  RegisterSample<MiniBooNE_CCQE_XSec_1DQ2_nu>(
+      factories, "MiniBooNE_CCQELike_XSec_1DQ2_nu");
+  RegisterSample<MiniBooNE_CCQE_XSec_1DEnu_nu>(factories,
+                                               "MiniBooNE_CCQE_XSec_1DEnu_nu");
+  RegisterSample<MiniBooNE_CCQE_XSec_1DEnu_nu>(
+      factories, "MiniBooNE_CCQELike_XSec_1DEnu_nu");
+  RegisterSample<MiniBooNE_CCQE_XSec_1DQ2_antinu>(
+      factories, "MiniBooNE_CCQE_XSec_1DQ2_antinu");
+  RegisterSample<MiniBooNE_CCQE_XSec_1DQ2_antinu>(
+      factories, "MiniBooNE_CCQELike_XSec_1DQ2_antinu");
+  RegisterSample<MiniBooNE_CCQE_XSec_1DQ2_antinu>(
+      factories, "MiniBooNE_CCQE_CTarg_XSec_1DQ2_antinu");
+  RegisterSample<MiniBooNE_CCQE_XSec_2DTcos_nu>(
+      factories, "MiniBooNE_CCQE_XSec_2DTcos_nu");
+  RegisterSample<MiniBooNE_CCQE_XSec_2DTcos_nu>(
+      factories, "MiniBooNE_CCQELike_XSec_2DTcos_nu");
+  RegisterSample<MiniBooNE_CCQE_XSec_2DTcos_antinu>(
+      factories, "MiniBooNE_CCQE_XSec_2DTcos_antinu");
+  RegisterSample<MiniBooNE_CCQE_XSec_2DTcos_antinu>(
+      factories, "MiniBooNE_CCQELike_XSec_2DTcos_antinu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_1DEnu_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_1DEnu_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_1DQ2_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_1DQ2_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_1DTpi_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_1DTpi_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_1DTu_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_1DTu_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_2DQ2Enu_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_2DQ2Enu_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_2DTpiCospi_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_2DTpiCospi_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_2DTpiEnu_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_2DTpiEnu_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_2DTuCosmu_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_2DTuCosmu_nu");
+  RegisterSample<MiniBooNE_CC1pip_XSec_2DTuEnu_nu>(
+      factories, "MiniBooNE_CC1pip_XSec_2DTuEnu_nu");
+  RegisterSample<MiniBooNE_CC1pi0_XSec_1DEnu_nu>(
+      factories, "MiniBooNE_CC1pi0_XSec_1DEnu_nu");
+  RegisterSample<MiniBooNE_CC1pi0_XSec_1DQ2_nu>(
+      factories, "MiniBooNE_CC1pi0_XSec_1DQ2_nu");
+  RegisterSample<MiniBooNE_CC1pi0_XSec_1DTu_nu>(
+      factories, "MiniBooNE_CC1pi0_XSec_1DTu_nu");
+  RegisterSample<MiniBooNE_CC1pi0_XSec_1Dcosmu_nu>(
+      factories, "MiniBooNE_CC1pi0_XSec_1Dcosmu_nu");
+  RegisterSample<MiniBooNE_CC1pi0_XSec_1Dcospi0_nu>(
+      factories, "MiniBooNE_CC1pi0_XSec_1Dcospi0_nu");
+  RegisterSample<MiniBooNE_CC1pi0_XSec_1Dppi0_nu>(
+      factories, "MiniBooNE_CC1pi0_XSec_1Dppi0_nu");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dcospi0_rhc");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dcospi0_nu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dcospi0_nu");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dcospi0_nu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dcospi0_fhc");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dppi0_antinu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dppi0_antinu");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dppi0_antinu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dppi0_rhc");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dppi0_nu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dppi0_nu");
+  RegisterSample<MiniBooNE_NC1pi0_XSec_1Dppi0_nu>(
+      factories, "MiniBooNE_NC1pi0_XSec_1Dppi0_fhc");
+  RegisterSample<MiniBooNE_NCEL_XSec_Treco_nu>(factories,
+                                               "MiniBooNE_NCEL_XSec_Treco_nu");
+}
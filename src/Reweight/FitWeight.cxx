@@ -227,6 +227,9 @@ void FitWeight::SetDialValue(int nuisenum, double val) {
 
   // Get RW Engine for this dial
   fAllRW[dialtype]->SetDialValue(nuisenum, val);
+  if (!fAllValues.count(nuisenum) || fAllValues[nuisenum] != val) {
+    fChangedEngines.insert(dialtype);
+  }
   fAllValues[nuisenum] = val;
 
   // Update ValueList
@@ -275,16 +278,48 @@ bool FitWeight::DialIncluded(int rwenum) {
   return (fAllValues.find(rwenum) != fAllValues.end());
 }
 
+ProfileUtils::Stage *FitWeight::GetEngineStage(size_t count, int type) {
+  if (!ProfileUtils::IsEnabled()) {
+    return NULL;
+  }
+  // Engines are keyed by type, so a new engine can shift the others
+  if (fEngineStages.size() != fAllRW.size()) {
+    fEngineStages.assign(fAllRW.size(), NULL);
+  }
+  if (!fEngineStages[count]) {
+    fEngineStages[count] = ProfileUtils::GetStage(
+        "rw/" + FitBase::ConvDialType(type) + "/CalcWeight");
+  }
+  return fEngineStages[count];
+}
+
 double FitWeight::CalcWeight(BaseFitEvt *evt) {
   double rwweight = 1.0;
+  size_t count = 0;
   for (std::map<int, WeightEngineBase *>::iterator iter = fAllRW.begin();
-       iter != fAllRW.end(); iter++) {
+       iter != fAllRW.end(); iter++, count++) {
+    ProfileUtils::ScopedTimer timer(GetEngineStage(count, (*iter).first));
     double w = (*iter).second->CalcWeight(evt);
     rwweight *= w;
   }
   return rwweight;
 }
 
+double FitWeight::CalcWeightCached(BaseFitEvt *evt, double *engweights,
+                                   bool cachevalid) {
+  double rwweight = 1.0;
+  size_t count = 0;
+  for (std::map<int, WeightEngineBase *>::iterator iter = fAllRW.begin();
+       iter != fAllRW.end(); iter++, count++) {
+    if (!cachevalid || fChangedEngines.count((*iter).first)) {
+      ProfileUtils::ScopedTimer timer(GetEngineStage(count, (*iter).first));
+      engweights[count] = (*iter).second->CalcWeight(evt);
+    }
+    rwweight *= engweights[count];
+  }
+  return rwweight;
+}
+
 void FitWeight::UpdateWeightEngine(const double *x) {
   size_t count = 0;
   for (std::vector<int>::iterator iter = fEnumList.begin();
@@ -3,10 +3,12 @@
 
 #include "WeightUtils.h"
 #include "WeightEngineBase.h"
+#include "ProfileUtils.h"
 
 #define UNDEF_DIAL_VALUE -9999.9
 
 #include <map>
+#include <set>
 #include <vector>
 
 class FitWeight {
@@ -38,6 +40,13 @@ public:
   bool DialIncluded(int rwenum);
 
   double CalcWeight(BaseFitEvt* evt);
+
+  // As CalcWeight, but engweights caches one weight per engine for this event
+  // and only engines with a dial changed since ClearChangedEngines are
+  // recalculated if cachevalid.
+  double CalcWeightCached(BaseFitEvt* evt, double* engweights, bool cachevalid);
+  void ClearChangedEngines() { fChangedEngines.clear(); };
+  inline size_t GetNEngines() { return fAllRW.size(); };
   bool HasRWDialChanged(const double* x) { return true; };
   // bool NeedsEventReWeight(const double* x);
 
@@ -62,6 +71,12 @@ public:
   std::map<int, double> fAllValues;
   std::map<int, WeightEngineBase*> fAllRW;
 
+  std::set<int> fChangedEngines;
+
+private:
+  // Per engine ProfileUtils stage, in fAllRW order. NULL when disabled.
+  ProfileUtils::Stage* GetEngineStage(size_t count, int type);
+  std::vector<ProfileUtils::Stage*> fEngineStages;
 };
 
 #endif
@@ -353,12 +353,11 @@ double RikRPA::CalcWeight(BaseFitEvt *evt) {
     return 1.0;
 
   // Extract Beam and Target PDG
-  GHepParticle *neutrino = ghep->Probe();
-  int bpdg = neutrino->Pdg();
+  EventInvariants const &inv = static_cast<FitEvent *>(evt)->GetInvariants();
+  int bpdg = inv.genie_probepdg;
 
-  GHepParticle *target = ghep->TargetNucleus();
-  assert(target);
-  int tpdg = target->Pdg();
+  assert(inv.genie_targetpdg);
+  int tpdg = inv.genie_targetpdg;
 
   // Find the enum we need
   int calcenum = GetRPACalcEnum(bpdg, tpdg);
@@ -375,12 +374,9 @@ double RikRPA::CalcWeight(BaseFitEvt *evt) {
   }
 
   // Extract Q0-Q3
-  GHepParticle *fsl = ghep->FinalStatePrimaryLepton();
-  const TLorentzVector &k1 = *(neutrino->P4());
-  const TLorentzVector &k2 = *(fsl->P4());
-  double q0 = fabs((k1 - k2).E());
-  double q3 = fabs((k1 - k2).Vect().Mag());
-  double Q2 = fabs((k1 - k2).Mag2());
+  double q0 = inv.genie_q0;
+  double q3 = inv.genie_q3;
+  double Q2 = inv.genie_Q2;
 
   // Quasielastic
   if (proc_info.IsQuasiElastic()) {
@@ -788,22 +784,8 @@ double WEnhancement::CalcWeight(BaseFitEvt* evt) {
   bool isCC1pi0AtVertex = false;
 
   // Get W
-  GHepParticle* neutrino = ghep->Probe();
-  GHepParticle* fsl = ghep->FinalStatePrimaryLepton();
-  const TLorentzVector& k1 = *(neutrino->P4());
-  const TLorentzVector& k2 = *(fsl->P4());
-
-  double E_mu = k2.E();
-  double p_mu = k2.Vect().Mag();
-  double m_mu = sqrt(E_mu * E_mu - p_mu * p_mu);
-  double th_nu_mu = k1.Vect().Angle(k2.Vect());
-
-  // The factor of 1000 is necessary for downstream functions
-  const double m_p = PhysConst::mass_proton;
-  double E_nu = k1.E();
   //    double hadMass  = kine.W (true);
-  double hadMass = sqrt(m_p * m_p + m_mu * m_mu - 2 * m_p * E_mu + \
-      2 * E_nu * (m_p - E_mu + p_mu * cos(th_nu_mu)));
+  double hadMass = static_cast<FitEvent*>(evt)->GetInvariants().genie_W;
 
 
   // Determine if event is CC1pi0 at vertex
@@ -77,21 +77,8 @@ double MINOSRPA::CalcWeight(BaseFitEvt* evt) {
   // If not on nucleus, not resonant, or NC
   if (!tgt.IsNucleus() || !proc_info.IsResonant() || proc_info.IsWeakNC()) return 1.0;
 
-  // Extract Beam and Target PDG
-  GHepParticle* neutrino = ghep->Probe();
-  //   int bpdg = neutrino->Pdg();
-
-  GHepParticle* target = ghep->Particle(1);
-  assert(target);
-  //    int tpdg = target->Pdg();
-
-  // Extract Q0-Q3
-  GHepParticle* fsl = ghep->FinalStatePrimaryLepton();
-  const TLorentzVector& k1 = *(neutrino->P4());
-  const TLorentzVector& k2 = *(fsl->P4());
-  //double q0 = fabs((k1 - k2).E());
-  //double q3 = fabs((k1 - k2).Vect().Mag());
-  double Q2 = fabs((k1 - k2).Mag2());
+  // Q2 from the probe and primary lepton
+  double Q2 = static_cast<FitEvent*>(evt)->GetInvariants().genie_Q2;
 
   w *= GetRPAWeight(Q2);
 #else
@@ -99,12 +86,11 @@ double MINOSRPA::CalcWeight(BaseFitEvt* evt) {
   FitEvent *fevt = static_cast<FitEvent*>(evt);
   // Check the event is resonant
   if (!fevt->IsResonant() || fevt->IsNC()) return 1.0;
-  int targeta = fevt->GetTargetA();
-  int targetz = fevt->GetTargetZ();
+  EventInvariants const &inv = fevt->GetInvariants();
   // Apply only to nuclear targets, ignore free protons
-  if (targeta == 1 || targetz == 1) return 1.0;
+  if (inv.targetA == 1 || inv.targetZ == 1) return 1.0;
   // Q2 in GeV2
-  double Q2 = fevt->GetQ2();
+  double Q2 = inv.Q2;
   w *= GetRPAWeight(Q2);
 #endif
 
@@ -194,33 +180,19 @@ double LagrangeRPA::CalcWeight(BaseFitEvt* evt) {
   // If not on nucleus, not resonant, or NC
   if (!tgt.IsNucleus() || !proc_info.IsResonant() || proc_info.IsWeakNC()) return 1.0;
 
-  // Extract Beam and Target PDG
-  GHepParticle* neutrino = ghep->Probe();
-  //   int bpdg = neutrino->Pdg();
-
-  GHepParticle* target = ghep->Particle(1);
-  assert(target);
-  //    int tpdg = target->Pdg();
-
-  // Extract Q0-Q3
-  GHepParticle* fsl = ghep->FinalStatePrimaryLepton();
-  const TLorentzVector& k1 = *(neutrino->P4());
-  const TLorentzVector& k2 = *(fsl->P4());
-  //double q0 = fabs((k1 - k2).E());
-  //double q3 = fabs((k1 - k2).Vect().Mag());
-  double Q2 = fabs((k1 - k2).Mag2());
+  // Q2 from the probe and primary lepton
+  double Q2 = static_cast<FitEvent*>(evt)->GetInvariants().genie_Q2;
   w *= GetRPAWeight(Q2);
 #else
   // Get the Q2 from NUISANCE if not GENIE
   FitEvent *fevt = static_cast<FitEvent*>(evt);
   // Check the event is resonant
   if (!fevt->IsResonant() || fevt->IsNC()) return 1.0;
-  int targeta = fevt->GetTargetA();
-  int targetz = fevt->GetTargetZ();
+  EventInvariants const &inv = fevt->GetInvariants();
   // Apply only to nuclear targets, ignore free protons
-  if (targeta == 1 || targetz == 1) return 1.0;
+  if (inv.targetA == 1 || inv.targetZ == 1) return 1.0;
   // Q2 in GeV2
-  double Q2 = fevt->GetQ2();
+  double Q2 = inv.Q2;
   w *= GetRPAWeight(Q2);
 #endif
 
@@ -328,7 +300,7 @@ double BeRPACalc::CalcWeight(BaseFitEvt *evt) {
   // Get final state lepton
   if (mode == 1) {
     FitEvent *fevt = static_cast<FitEvent*>(evt);
-    double Q2 = fevt->GetQ2();
+    double Q2 = fevt->GetInvariants().Q2;
     // Only CCQE events
     w *= calcRPA(Q2, fBeRPA_A, fBeRPA_B, fBeRPA_D, fBeRPA_E, fBeRPA_U);
   }
@@ -487,42 +459,20 @@ double GaussianModeCorr::CalcWeight(BaseFitEvt *evt) {
   if (!fevt->Npart()) {
     NUIS_ABORT("NO particles found in stack!");
   }
-  FitParticle *pnu = fevt->GetNeutrinoIn();
-  if (!pnu) {
+  EventInvariants const &inv = fevt->GetInvariants();
+  if (inv.probe == -1) {
     NUIS_ABORT("NO Starting particle found in stack!");
   }
 
-  FitParticle *plep = fevt->GetLeptonOut();
-  if (!plep) return 1.0;
-
-  TLorentzVector q = pnu->fP - plep->fP;
+  if (inv.lepton == -1) return 1.0;
 
   // Extra q0,q3
-  double q0 = fabs(q.E()) / 1.E3;
-  double q3 = fabs(q.Vect().Mag()) / 1.E3;
+  double q0 = inv.q0;
+  double q3 = inv.q3;
 
   int initialstate = -1; // Undef
-  if (abs(fevt->Mode) == 2) {
-    int npr = 0;
-    int nne = 0;
-
-    for (UInt_t j = 0; j < fevt->Npart(); j++) {
-      if ((fevt->PartInfo(j))->fIsAlive)
-        continue;
-
-      if (fevt->PartInfo(j)->fPID == 2212) 
-        npr++;
-      else if (fevt->PartInfo(j)->fPID == 2112) 
-        nne++;
-    }
-
-    if (fevt->Mode == 2 && npr == 1 && nne == 1) {
-      initialstate = 2;
-
-    } else if (fevt->Mode == 2 && 
-        ((npr == 0 && nne == 2) || (npr == 2 && nne == 0))) {
-      initialstate = 1;
-    }
+  if (fevt->Mode == 2) {
+    initialstate = inv.pairclass;
   }
 
   // Apply weighting
@@ -0,0 +1,229 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "nusystematicsResponseTable.h"
+
+#include "FitLogger.h"
+
+#include "TSpline.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Relative agreement needed between a compiled response and
+// GetParameterResponse before the compiled form is trusted
+const double kCompileTolerance = 1E-8;
+} // namespace
+
+int nusystematicsResponseTable::AddEntry(
+    Long64_t entry, nusyst::response_helper &helper,
+    systtools::event_unit_response_w_cv_t const &responses) {
+
+  int row = fNRows++;
+  if (Long64_t(fRows.size()) <= entry) {
+    fRows.resize(entry + 1, -1);
+  }
+  fRows[entry] = row;
+
+  for (size_t i = 0; i < fColumns.size(); i++) {
+    AddRow(fColumns[i]);
+  }
+
+  double cvweight = 1;
+  for (auto const &resp : responses) {
+    if (helper.IsWeightResponse(resp.pid)) {
+      cvweight *= resp.CV_response;
+    }
+    Column &col = GetColumn(resp.pid, helper, resp.responses);
+    SetRow(col, row, resp.CV_response, resp.responses);
+  }
+  fCVWeights.push_back(cvweight);
+
+  return row;
+}
+
+double nusystematicsResponseTable::GetResponse(systtools::paramId_t pid,
+                                               double val, int row,
+                                               nusyst::response_helper &helper) {
+  if (size_t(pid) >= fColumnIndex.size() || fColumnIndex[pid] < 0) {
+    return 1;
+  }
+
+  Column &col = fColumns[fColumnIndex[pid]];
+  if (!col.weight || !col.present[row]) {
+    return 1;
+  }
+
+  if (col.compiled) {
+    return col.cv[row] * Eval(col, val, row);
+  }
+
+  std::vector<double> responses(col.y.begin() + row * col.nknots,
+                                col.y.begin() + (row + 1) * col.nknots);
+  return col.cv[row] *
+         helper.GetParameterResponse(
+             pid, val, systtools::event_unit_response_t{{pid, responses}});
+}
+
+nusystematicsResponseTable::Column &nusystematicsResponseTable::GetColumn(
+    systtools::paramId_t pid, nusyst::response_helper &helper,
+    std::vector<double> const &firstresponses) {
+
+  if (size_t(pid) < fColumnIndex.size() && fColumnIndex[pid] >= 0) {
+    return fColumns[fColumnIndex[pid]];
+  }
+
+  if (size_t(pid) >= fColumnIndex.size()) {
+    fColumnIndex.resize(pid + 1, -1);
+  }
+  fColumnIndex[pid] = fColumns.size();
+  fColumns.push_back(Column());
+  Column &col = fColumns.back();
+
+  systtools::SystParamHeader const &hdr = helper.GetHeader(pid);
+  col.pid = pid;
+  col.weight = helper.IsWeightResponse(pid);
+  col.knots = hdr.paramVariations;
+  col.nknots = col.knots.size();
+  col.compiled = hdr.isSplineable && (col.nknots > 1) &&
+                 std::is_sorted(col.knots.begin(), col.knots.end()) &&
+                 (firstresponses.size() == col.nknots);
+  col.hasval = false;
+  col.lastval = 0;
+  col.interval = 0;
+  col.dx = 0;
+
+  for (size_t k = 0; col.compiled && k + 1 < col.nknots; k++) {
+    col.h.push_back(col.knots[k + 1] - col.knots[k]);
+    col.invh.push_back(1.0 / col.h.back());
+    if (!(col.h.back() > 0)) {
+      col.compiled = false;
+    }
+  }
+
+  // Including the row being added
+  for (int row = 0; row < fNRows; row++) {
+    AddRow(col);
+  }
+
+  // Check the compiled form against GetParameterResponse at and between the
+  // knots, and outside them, for the first event that has this parameter.
+  if (col.compiled) {
+    Column test = col;
+    test.present.clear();
+    test.cv.clear();
+    test.y.clear();
+    test.c.clear();
+    AddRow(test);
+    SetRow(test, 0, 1, firstresponses);
+
+    std::vector<double> points;
+    for (size_t k = 0; k < col.nknots; k++) {
+      points.push_back(col.knots[k]);
+      if (k + 1 < col.nknots) {
+        points.push_back(0.5 * (col.knots[k] + col.knots[k + 1]));
+      }
+    }
+    points.push_back(col.knots.front() - col.h.front());
+    points.push_back(col.knots.back() + col.h.back());
+
+    for (size_t i = 0; i < points.size(); i++) {
+      double compiled = Eval(test, points[i], 0);
+      double expected = helper.GetParameterResponse(
+          pid, points[i],
+          systtools::event_unit_response_t{{pid, firstresponses}});
+      if (std::fabs(compiled - expected) >
+          kCompileTolerance * std::max(1.0, std::fabs(expected))) {
+        NUIS_ERR(WRN, "nusystematics parameter "
+                          << hdr.prettyName
+                          << " response doesn't match a cubic spline through "
+                             "its knots, using GetParameterResponse for it.");
+        col.compiled = false;
+        break;
+      }
+    }
+  }
+
+  if (!col.compiled) {
+    col.c.clear();
+  }
+  return col;
+}
+
+void nusystematicsResponseTable::AddRow(Column &col) {
+  col.present.push_back(false);
+  col.cv.push_back(1);
+  col.y.resize(col.y.size() + col.nknots, 0);
+  if (col.compiled) {
+    col.c.resize(col.c.size() + col.nknots, 0);
+  }
+}
+
+void nusystematicsResponseTable::SetRow(Column &col, int row, double cv,
+                                        std::vector<double> const &responses) {
+  if (responses.size() != col.nknots) {
+    NUIS_ABORT("nusystematics parameter "
+               << col.pid << " has " << responses.size()
+               << " responses for an event, but " << col.nknots
+               << " knots.");
+  }
+
+  col.present[row] = true;
+  col.cv[row] = cv;
+  std::copy(responses.begin(), responses.end(),
+            col.y.begin() + row * col.nknots);
+  if (!col.compiled) {
+    return;
+  }
+
+  // Keep the knot values and the quadratic terms, which fix the rest of each
+  // cubic segment.
+  std::vector<double> x(col.knots);
+  std::vector<double> y(responses);
+  TSpline3 spline("nusyst_response", &x[0], &y[0], col.nknots);
+  for (size_t k = 0; k < col.nknots; k++) {
+    double xk, yk, bk, ck, dk;
+    spline.GetCoeff(k, xk, yk, bk, ck, dk);
+    col.c[row * col.nknots + k] = ck;
+  }
+}
+
+double nusystematicsResponseTable::Eval(Column &col, double val, int row) {
+  // Same segment TSpline3::Eval would use, the end segments extrapolate
+  if (!col.hasval || (val != col.lastval)) {
+    size_t k = std::upper_bound(col.knots.begin(), col.knots.end(), val) -
+               col.knots.begin();
+    k = (k > 0) ? k - 1 : 0;
+    col.interval = std::min(k, col.nknots - 2);
+    col.dx = val - col.knots[col.interval];
+    col.lastval = val;
+    col.hasval = true;
+  }
+
+  size_t k = col.interval;
+  double const *y = &col.y[row * col.nknots];
+  double const *c = &col.c[row * col.nknots];
+  double h = col.h[k];
+  double invh = col.invh[k];
+  double dx = col.dx;
+
+  double b = (y[k + 1] - y[k]) * invh - h * (c[k + 1] + 2 * c[k]) / 3.0;
+  double d = (c[k + 1] - c[k]) * invh / 3.0;
+  return y[k] + dx * (b + dx * (c[k] + dx * d));
+}
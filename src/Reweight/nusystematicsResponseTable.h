@@ -0,0 +1,99 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef nusystResponseTable_SEEN
+#define nusystResponseTable_SEEN
+
+#include "systematicstools/interface/types.hh"
+
+#include "nusystematics/utility/response_helper.hh"
+
+#include "Rtypes.h"
+
+#include <vector>
+
+/// nusystematics responses of every event read from an input, laid out per
+/// parameter as contiguous arrays over events.
+///
+/// Splineable parameters are stored as the knot values and second derivative
+/// terms of the same cubic spline GetParameterResponse builds, worked out once
+/// when an event is added. Evaluating a weight is then a few multiply-adds per
+/// event and parameter, with the knot interval only found again when the dial
+/// moves. Parameters that can't be compiled, or whose compiled response
+/// doesn't match GetParameterResponse for the first event that has them, keep
+/// the raw knot responses and go through GetParameterResponse.
+class nusystematicsResponseTable {
+public:
+  nusystematicsResponseTable() : fNRows(0) {}
+
+  /// Row holding an entry's responses, -1 if it hasn't been added
+  int GetRow(Long64_t entry) const {
+    return (entry >= 0 && entry < Long64_t(fRows.size())) ? fRows[entry] : -1;
+  }
+
+  /// Add an entry's responses, returns its row
+  int AddEntry(Long64_t entry, nusyst::response_helper &helper,
+               systtools::event_unit_response_w_cv_t const &responses);
+
+  /// Product of the CV responses of all weight parameters for a row
+  double GetCVWeight(int row) const { return fCVWeights[row]; }
+
+  /// CV response times the response at val of parameter pid for a row. 1 if
+  /// pid isn't a weight parameter or the event doesn't respond to it.
+  double GetResponse(systtools::paramId_t pid, double val, int row,
+                     nusyst::response_helper &helper);
+
+private:
+  struct Column {
+    systtools::paramId_t pid;
+    bool weight;   ///< IsWeightResponse
+    bool compiled; ///< y and c hold spline terms, otherwise y holds responses
+    size_t nknots;
+    std::vector<double> knots;
+    std::vector<double> h;    ///< Knot spacing, per interval
+    std::vector<double> invh; ///< 1/h, per interval
+
+    // Per row
+    std::vector<char> present;
+    std::vector<double> cv;
+    std::vector<double> y; ///< nknots per row
+    std::vector<double> c; ///< nknots per row, compiled only
+
+    // Interval of the last dial value evaluated
+    bool hasval;
+    double lastval;
+    size_t interval;
+    double dx;
+  };
+
+  Column &GetColumn(systtools::paramId_t pid,
+                    nusyst::response_helper &helper,
+                    std::vector<double> const &firstresponses);
+  void AddRow(Column &col);
+  void SetRow(Column &col, int row, double cv,
+              std::vector<double> const &responses);
+  static double Eval(Column &col, double val, int row);
+
+  std::vector<int> fRows;          ///< Row of each entry, -1 if not added
+  std::vector<double> fCVWeights;  ///< Per row
+  std::vector<Column> fColumns;
+  std::vector<int> fColumnIndex;   ///< Column of each pid, -1 if none
+  int fNRows;
+};
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "nusystematicsWeightEngine.h"
 #include "GENIEInputHandler.h"
+#include "nusystematicsResponseTable.h"
 
 #include <limits>
 #include <string>
@@ -155,43 +156,32 @@ bool nusystematicsWeightEngine::NeedsEventReWeight() {
 
 double nusystematicsWeightEngine::CalcWeight(BaseFitEvt *evt) {
 
-  systtools::event_unit_response_w_cv_t *responses;
+  if (!evt->input_handler) {
+    return 1;
+  }
 
-  if (evt->input_handler) {
-    auto cached_responses = evt->input_handler->nusystematics_GetCachedResponse(
-        evt->input_handler_itree_ent);
-    if (!cached_responses) {
-      evt->input_handler->nusystematics_CacheResponse(
-          evt->input_handler_itree_ent,
-          DUNErwt.GetEventVariationAndCVResponse(*evt->genie_event->event));
-    }
-    responses = evt->input_handler->nusystematics_GetCachedResponse(
-        evt->input_handler_itree_ent);
+  // Responses are worked out once per event and kept by its input handler
+  std::shared_ptr<nusystematicsResponseTable> &table =
+      evt->input_handler->nusystematics_ResponseTable;
+  if (!table) {
+    table = std::make_shared<nusystematicsResponseTable>();
   }
 
-  double weight = 1;
-  for (auto const &resp : *responses) {
-    if (!DUNErwt.IsWeightResponse(resp.pid)) {
-      continue;
-    }
-    if (fUseCV) {
-      weight *= resp.CV_response;
-    } else { // This is very inefficient for fitting, as it recalculates the
-             // spline every time.
-
-      // this is a completely backwards way of doing this loop, but the whole
-      // thing is broken anyway.
-      size_t index = GetParamContainerIndex(EnabledParams, resp.pid);
-      if (index != systtools::kParamUnhandled<size_t>) {
-        weight *=
-            (resp.CV_response *
-             DUNErwt.GetParameterResponse(
-                 resp.pid, EnabledParams[index].val,
-                 systtools::event_unit_response_t{{resp.pid, resp.responses}}));
-      }
-    }
+  int row = table->GetRow(evt->input_handler_itree_ent);
+  if (row < 0) {
+    row = table->AddEntry(
+        evt->input_handler_itree_ent, DUNErwt,
+        DUNErwt.GetEventVariationAndCVResponse(*evt->genie_event->event));
   }
 
+  if (fUseCV) {
+    return table->GetCVWeight(row);
+  }
+
+  double weight = 1;
+  for (auto const &param : EnabledParams) {
+    weight *= table->GetResponse(param.pid, param.val, row, DUNErwt);
+  }
   return weight;
 }
 
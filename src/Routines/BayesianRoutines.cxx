@@ -68,6 +68,8 @@ BayesianRoutines::BayesianRoutines(int argc, char *argv[]) {
   ParserUtils::ParseArgument(args, "-q", configargs);
   ParserUtils::ParseCounter(args, "e", errorcount);
   ParserUtils::ParseCounter(args, "v", verbocount);
+  bool resume = false;
+  ParserUtils::ParseFlag(args, "--resume", resume);
   ParserUtils::CheckBadArguments(args);
 
   // Add extra defaults if none given
@@ -113,6 +115,10 @@ BayesianRoutines::BayesianRoutines(int argc, char *argv[]) {
   // Finish configuration XML
   configuration.FinaliseSettings(fCompKey.GetS("outputfile") + ".xml");
 
+  if (resume) {
+    Config::SetPar("checkpoint_resume", true);
+  }
+
   // Add Error Verbo Lines
   verbocount += Config::GetParI("VERBOSITY");
   errorcount += Config::GetParI("ERROR");
@@ -420,26 +426,22 @@ void BayesianRoutines::Run() {
 void BayesianRoutines::GenerateThrows() {
   //*************************************
 
-  // Create a new output file
-  TFile *outfile =
-      new TFile((fOutputFile + ".throws.root").c_str(), "RECREATE");
+  // Create a new output file, or carry on with it when resuming
+  TFile *outfile = CheckpointUtils::OpenOutput(fOutputFile + ".throws.root");
   outfile->cd();
 
   int nthrows = fNThrows;
 
-  // Setting Seed
-  // Matteo Mazzanti's Fix
-  struct timeval mytime;
-  gettimeofday(&mytime, NULL);
-  Double_t seed = time(NULL) + int(getpid()) + (mytime.tv_sec * 1000.) +
-                  (mytime.tv_usec / 1000.);
-  gRandom->SetSeed(seed);
-  NUIS_LOG(FIT, "Using Seed : " << seed);
+  // Each throw is seeded from the master seed and its index, so any subset
+  // of throws can be regenerated exactly, on any number of workers.
+  ULong_t masterseed = ThrowUtils::GetFileMasterSeed(outfile);
   NUIS_LOG(FIT, "nthrows = " << nthrows);
 
   // Run the Initial Reconfigure
   NUIS_LOG(FIT, "Making nominal prediction ");
-  TDirectory *nominal = (TDirectory *)outfile->mkdir("nominal");
+  TDirectory *nominal = outfile->GetDirectory("nominal");
+  if (!nominal)
+    nominal = (TDirectory *)outfile->mkdir("nominal");
   nominal->cd();
   UpdateRWEngine(fStartVals);
   fSampleFCN->ReconfigureUsingManager();
@@ -448,6 +450,45 @@ void BayesianRoutines::GenerateThrows() {
   // Create an iteration tree inside SampleFCN
   fSampleFCN->CreateIterationTree("error_iterations", FitBase::GetRW());
 
+  // Throw 0 is the nominal
+  int nworkers = ThrowUtils::GetNWorkers();
+  if (nworkers < 2) {
+    RunThrowRange(1, nthrows - 1, masterseed, outfile);
+    CheckpointUtils::Remove(ThrowUtils::GetThrowCheckpoint(outfile));
+    outfile->Close();
+    return;
+  }
+
+  // Run contiguous blocks of throws on forked workers, which share the loaded
+  // events with this process, then merge their trees in throw order.
+  std::string throwsfile = fOutputFile + ".throws.root";
+  outfile->Close();
+
+  std::vector<std::pair<int, int> > ranges =
+      ThrowUtils::SplitThrows(1, nthrows - 1, nworkers);
+  std::vector<std::string> workerfiles = ThrowUtils::RunForkedThrows(
+      throwsfile, ranges, [&](int first, int last, TFile *workerfile) {
+        RunThrowRange(first, last, masterseed, workerfile);
+      });
+
+  outfile = new TFile(throwsfile.c_str(), "UPDATE");
+  std::vector<std::string> trees(1, "likelihood");
+  ThrowUtils::MergeWorkerFiles(outfile, workerfiles, trees);
+  outfile->Close();
+
+  for (size_t i = 0; i < ranges.size(); i++) {
+    CheckpointUtils::Remove(CheckpointUtils::GetCheckpointFile(
+        ThrowUtils::GetWorkerFile(throwsfile, i)));
+  }
+}
+
+//*************************************
+void BayesianRoutines::RunThrowRange(int first, int last, ULong_t masterseed,
+                                     TFile *outfile) {
+  //*************************************
+
+  outfile->cd();
+
   // Create a new iteration TTree
   TTree *LIKETREE = new TTree("likelihood", "likelihood");
   std::vector<std::string> likenames = fSampleFCN->GetAllNames();
@@ -464,6 +505,7 @@ void BayesianRoutines::GenerateThrows() {
     LIKENDOF[i] = likendof[i];
   }
 
+  size_t nlikes = likendof.size();
   likenames.clear();
   likevals.clear();
   likendof.clear();
@@ -474,15 +516,54 @@ void BayesianRoutines::GenerateThrows() {
                      (fParams[i] + "/D").c_str());
   }
 
+  // Rows of likelihoods then parameters, kept for checkpoints
+  std::vector<std::vector<double> > rows;
+  std::string checkpoint = ThrowUtils::GetThrowCheckpoint(outfile);
+  CheckpointUtils::Timer timer;
+  timer.Start();
+
+  int lastdone = first - 1;
+  if (CheckpointUtils::IsResuming()) {
+    TFile *file = CheckpointUtils::OpenRead(checkpoint);
+    lastdone = ThrowUtils::ReadThrowRange(file, first, last);
+    if (lastdone >= first &&
+        (!CheckpointUtils::ReadRows(file, "likelihood", rows) ||
+         rows.size() != size_t(lastdone - first + 1))) {
+      rows.clear();
+      lastdone = first - 1;
+    }
+    if (file) {
+      file->Close();
+      delete file;
+    }
+
+    for (size_t r = 0; r < rows.size(); r++) {
+      std::copy(rows[r].begin(), rows[r].begin() + nlikes, LIKEVALS);
+      std::copy(rows[r].begin() + nlikes, rows[r].end(), PARAMVALS);
+      LIKETREE->Fill();
+    }
+    if (lastdone >= first) {
+      NUIS_LOG(FIT, "Resuming throws " << first << "-" << last
+                                       << " after throw " << lastdone);
+    }
+  }
+
+  auto writecheckpoint = [&](int done) {
+    TFile *file = CheckpointUtils::OpenWrite(checkpoint);
+    if (file) {
+      ThrowUtils::WriteThrowRange(file, first, last, done);
+      CheckpointUtils::WriteRows(file, "likelihood", rows);
+      CheckpointUtils::Commit(file, checkpoint);
+    }
+  };
+
   // Run Throws and save
-  for (Int_t i = 0; i < nthrows; i++) {
+  for (Int_t i = lastdone + 1; i < last + 1; i++) {
 
-    // Skip the start throw
-    if (i == 0)
-      continue;
     NUIS_LOG(FIT, "Throw " << i << " ================================");
 
     // Throw Parameters
+    ThrowUtils::SeedThrow(masterseed, i);
     ThrowParameters();
     FitBase::GetRW()->Print();
 
@@ -503,16 +584,29 @@ void BayesianRoutines::GenerateThrows() {
     // Save to TTree
     LIKETREE->Fill();
 
+    rows.push_back(std::vector<double>(LIKEVALS, LIKEVALS + nlikes));
+    rows.back().insert(rows.back().end(), PARAMVALS,
+                       PARAMVALS + fParams.size());
+    if (timer.IsDue()) {
+      writecheckpoint(i);
+      timer.Reset();
+    }
+
     // Save the FCN
     // if (fSavePredictions){ SaveSamplePredictions(); }
     NUIS_LOG(FIT, "END OF THROW ================================");
   }
 
+  // Kept until the caller has finished with outfile, in case it is killed
+  // before then
+  if (timer.IsEnabled()) {
+    writecheckpoint(last);
+  }
+
   // Finish up
   outfile->cd();
   LIKETREE->Write();
-  outfile->Close();
-  delete LIKEVALS;
-  delete LIKENDOF;
-  delete PARAMVALS;
+  delete[] LIKEVALS;
+  delete[] LIKENDOF;
+  delete[] PARAMVALS;
 }
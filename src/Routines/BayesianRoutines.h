@@ -42,6 +42,8 @@
 
 #include "FitEvent.h"
 #include "JointFCN.h"
+#include "ThrowUtils.h"
+#include "CheckpointUtils.h"
 
 #include "ParserUtils.h"
 
@@ -114,8 +116,14 @@ public:
   //! If uniformly is true parameters will be thrown uniformly between their upper and lower limits.
   void ThrowParameters();
 
-  //! Run Throws   
+  //! Run Throws. Throws are seeded from "error_seed" and the throw index, and
+  //! are run on "error_throw_workers" forked processes if more than one.
   void GenerateThrows();
+
+  //! Run throws [first, last], filling a likelihood tree written to outfile.
+  //! Checkpoints every "checkpoint_interval" seconds and carries on from the
+  //! last checkpoint with --resume.
+  void RunThrowRange(int first, int last, ULong_t masterseed, TFile *outfile);
  
 protected:
 
@@ -0,0 +1,213 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#include "CheckpointUtils.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include "TSystem.h"
+#include "TVectorD.h"
+
+#include <cstdio>
+
+namespace CheckpointUtils {
+
+//*************************************
+std::string GetCheckpointFile(std::string const &output) {
+  //*************************************
+  return output + ".checkpoint.root";
+}
+
+//*************************************
+bool IsResuming() {
+  //*************************************
+  return Config::GetParB("checkpoint_resume");
+}
+
+//*************************************
+Timer::Timer() {
+  //*************************************
+  fInterval = 0;
+  fLast = time(NULL);
+}
+
+//*************************************
+void Timer::Start() {
+  //*************************************
+  fInterval = Config::GetParI("checkpoint_interval");
+  fLast = time(NULL);
+}
+
+//*************************************
+bool Timer::IsDue() const {
+  //*************************************
+  return (fInterval > 0) && (time(NULL) - fLast >= fInterval);
+}
+
+//*************************************
+void Timer::Reset() {
+  //*************************************
+  fLast = time(NULL);
+}
+
+//*************************************
+TFile *OpenWrite(std::string const &path) {
+  //*************************************
+  // Opening a file makes it gDirectory, keep the caller's
+  TDirectory::TContext context;
+  TFile *file = new TFile((path + ".tmp").c_str(), "RECREATE");
+  if (!file || file->IsZombie()) {
+    NUIS_ERR(WRN, "Could not write checkpoint " << path);
+    delete file;
+    return NULL;
+  }
+  return file;
+}
+
+//*************************************
+void Commit(TFile *file, std::string const &path) {
+  //*************************************
+  if (!file)
+    return;
+
+  TDirectory::TContext context;
+  file->Write();
+  file->Close();
+  delete file;
+
+  if (std::rename((path + ".tmp").c_str(), path.c_str()) != 0) {
+    NUIS_ERR(WRN, "Could not replace checkpoint " << path);
+    return;
+  }
+  NUIS_LOG(FIT, "Wrote checkpoint " << path);
+}
+
+//*************************************
+TFile *OpenRead(std::string const &path) {
+  //*************************************
+  if (gSystem->AccessPathName(path.c_str()))
+    return NULL;
+
+  TDirectory::TContext context;
+  TFile *file = new TFile(path.c_str(), "READ");
+  if (!file || file->IsZombie()) {
+    NUIS_ERR(WRN, "Ignoring unreadable checkpoint " << path);
+    delete file;
+    return NULL;
+  }
+  return file;
+}
+
+//*************************************
+void Remove(std::string const &path) {
+  //*************************************
+  gSystem->Unlink(path.c_str());
+  gSystem->Unlink((path + ".tmp").c_str());
+}
+
+//*************************************
+TFile *OpenOutput(std::string const &path) {
+  //*************************************
+  if (IsResuming() && !gSystem->AccessPathName(path.c_str())) {
+    TFile *file = new TFile(path.c_str(), "UPDATE");
+    if (file && !file->IsZombie()) {
+      NUIS_LOG(FIT, "Resuming output file " << path);
+      return file;
+    }
+    NUIS_ERR(WRN, "Could not reopen " << path << ", starting it again.");
+    delete file;
+  }
+  return new TFile(path.c_str(), "RECREATE");
+}
+
+//*************************************
+void WriteValue(TDirectory *dir, std::string const &name, double val) {
+  //*************************************
+  WriteVector(dir, name, std::vector<double>(1, val));
+}
+
+//*************************************
+double ReadValue(TDirectory *dir, std::string const &name, double def) {
+  //*************************************
+  std::vector<double> vals;
+  if (!ReadVector(dir, name, vals) || vals.empty())
+    return def;
+  return vals[0];
+}
+
+//*************************************
+void WriteVector(TDirectory *dir, std::string const &name,
+                 std::vector<double> const &vals) {
+  //*************************************
+  TVectorD vect(vals.size());
+  for (size_t i = 0; i < vals.size(); i++) {
+    vect[i] = vals[i];
+  }
+  dir->WriteTObject(&vect, name.c_str(), "Overwrite");
+}
+
+//*************************************
+bool ReadVector(TDirectory *dir, std::string const &name,
+                std::vector<double> &vals) {
+  //*************************************
+  TVectorD *vect = NULL;
+  dir->GetObject(name.c_str(), vect);
+  if (!vect)
+    return false;
+
+  vals.assign(vect->GetMatrixArray(),
+              vect->GetMatrixArray() + vect->GetNrows());
+  delete vect;
+  return true;
+}
+
+//*************************************
+void WriteRows(TDirectory *dir, std::string const &name,
+               std::vector<std::vector<double> > const &rows) {
+  //*************************************
+  std::vector<double> flat;
+  flat.push_back(rows.size());
+  flat.push_back(rows.empty() ? 0 : rows[0].size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    flat.insert(flat.end(), rows[i].begin(), rows[i].end());
+  }
+  WriteVector(dir, name, flat);
+}
+
+//*************************************
+bool ReadRows(TDirectory *dir, std::string const &name,
+              std::vector<std::vector<double> > &rows) {
+  //*************************************
+  std::vector<double> flat;
+  if (!ReadVector(dir, name, flat) || flat.size() < 2)
+    return false;
+
+  size_t nrows = flat[0];
+  size_t rowsize = flat[1];
+  if (flat.size() != 2 + nrows * rowsize)
+    return false;
+
+  rows.clear();
+  for (size_t i = 0; i < nrows; i++) {
+    rows.push_back(std::vector<double>(flat.begin() + 2 + i * rowsize,
+                                       flat.begin() + 2 + (i + 1) * rowsize));
+  }
+  return true;
+}
+} // namespace CheckpointUtils
@@ -0,0 +1,95 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#ifndef CHECKPOINT_UTILS_H
+#define CHECKPOINT_UTILS_H
+
+/*!
+ *  \addtogroup Minimizer
+ *  @{
+ */
+
+#include "TDirectory.h"
+#include "TFile.h"
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+//! Periodic checkpoints of long running routines so that a killed job can
+//! carry on with --resume. A checkpoint is a small ROOT file written next to
+//! the output it belongs to and replaced atomically each time.
+namespace CheckpointUtils {
+
+//! Checkpoint file belonging to an output file.
+std::string GetCheckpointFile(std::string const &output);
+
+//! True if --resume was given (config "checkpoint_resume").
+bool IsResuming();
+
+//! Keeps track of when the next checkpoint is due, every
+//! "checkpoint_interval" seconds. Never due until started, or if the
+//! interval is 0.
+class Timer {
+public:
+  Timer();
+  //! Read the interval from the config and start counting
+  void Start();
+  bool IsDue() const;
+  void Reset();
+  bool IsEnabled() const { return fInterval > 0; }
+
+private:
+  int fInterval;
+  time_t fLast;
+};
+
+//! Start writing a checkpoint. Objects go into a temporary file that only
+//! replaces path in Commit, so a kill mid-write keeps the last checkpoint.
+TFile *OpenWrite(std::string const &path);
+//! Close the temporary file and move it over path.
+void Commit(TFile *file, std::string const &path);
+//! Open an existing checkpoint, NULL if there isn't a readable one.
+TFile *OpenRead(std::string const &path);
+//! Remove a checkpoint once the routine it belongs to has finished.
+void Remove(std::string const &path);
+
+//! Open an output file, continuing it with "UPDATE" if resuming and it is
+//! readable, otherwise with "RECREATE".
+TFile *OpenOutput(std::string const &path);
+
+void WriteValue(TDirectory *dir, std::string const &name, double val);
+//! Returns def if name is missing.
+double ReadValue(TDirectory *dir, std::string const &name, double def = 0);
+
+void WriteVector(TDirectory *dir, std::string const &name,
+                 std::vector<double> const &vals);
+//! Returns false, leaving vals untouched, if name is missing.
+bool ReadVector(TDirectory *dir, std::string const &name,
+                std::vector<double> &vals);
+
+//! Store a table of equal length rows, e.g. JointFCN iterations.
+void WriteRows(TDirectory *dir, std::string const &name,
+               std::vector<std::vector<double> > const &rows);
+bool ReadRows(TDirectory *dir, std::string const &name,
+              std::vector<std::vector<double> > &rows);
+} // namespace CheckpointUtils
+
+/*! @} */
+#endif
@@ -18,6 +18,8 @@
  *******************************************************************************/
 #include "ComparisonRoutines.h"
 
+#include "ProfileUtils.h"
+
 /*
   Constructor/Destructor
 */
@@ -510,6 +512,10 @@ void ComparisonRoutines::Run() {
     }
   }
 
+  ProfileUtils::Report(fOutputRootFile,
+                       std::string(fOutputRootFile->GetName()) +
+                           ".profile.json");
+
   return;
 }
 
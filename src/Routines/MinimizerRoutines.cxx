@@ -19,8 +19,16 @@
 
 #include "MinimizerRoutines.h"
 
+#include "ForkUtils.h"
+#include "ProfileUtils.h"
 #include "Simple_MH_Sampler.h"
 
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+
 /*
   Constructor/Destructor
 */
@@ -54,6 +62,11 @@ void MinimizerRoutines::Init() {
   fMinimizerFCN = NULL;
   fCallFunctor = NULL;
 
+  fCheckpointFile = "";
+  fCheckpointOwner = 0;
+  fRoutineIndex = 0;
+  fBestLikelihood = 0;
+
   fAllowedRoutines = ("Migrad,Simplex,Combined,"
                       "Brute,Fumili,ConjugateFR,"
                       "ConjugatePR,BFGS,BFGS2,"
@@ -106,6 +119,8 @@ MinimizerRoutines::MinimizerRoutines(int argc, char *argv[]) {
   ParserUtils::ParseArgument(args, "-q", configargs);
   ParserUtils::ParseCounter(args, "e", errorcount);
   ParserUtils::ParseCounter(args, "v", verbocount);
+  bool resume = false;
+  ParserUtils::ParseFlag(args, "--resume", resume);
   ParserUtils::CheckBadArguments(args);
 
   // Add extra defaults if none given
@@ -152,6 +167,10 @@ MinimizerRoutines::MinimizerRoutines(int argc, char *argv[]) {
   // Finish configuration XML
   configuration.FinaliseSettings(fCompKey.GetS("outputfile") + ".xml");
 
+  if (resume) {
+    Config::SetPar("checkpoint_resume", true);
+  }
+
   // Sort out the printout
   verbocount += Config::GetParI("VERBOSITY");
   errorcount += Config::GetParI("ERROR");
@@ -162,9 +181,17 @@ MinimizerRoutines::MinimizerRoutines(int argc, char *argv[]) {
   SETTRACE(trace);
 
   // Minimizer Setup ========================================
-  fOutputRootFile = new TFile(fCompKey.GetS("outputfile").c_str(), "RECREATE");
+  fOutputRootFile =
+      CheckpointUtils::OpenOutput(fCompKey.GetS("outputfile"));
   SetupMinimizerFromXML();
 
+  fCheckpointTimer.Start();
+  if (fCheckpointTimer.IsEnabled() || CheckpointUtils::IsResuming()) {
+    fCheckpointFile =
+        CheckpointUtils::GetCheckpointFile(fCompKey.GetS("outputfile"));
+    fCheckpointOwner = getpid();
+  }
+
   SetupCovariance();
   SetupRWEngine();
   SetupFCN();
@@ -402,6 +429,9 @@ void MinimizerRoutines::SetupFCN() {
   SetFakeData();
 
   fMinimizerFCN = new MinimizerFCN(fSampleFCN);
+  fMinimizerFCN->SetEvalHook([this](const double *x, double like) {
+    CheckpointFCNCall(x, like);
+  });
   fCallFunctor = new ROOT::Math::Functor(*fMinimizerFCN, fParams.size());
 
   fSampleFCN->CreateIterationTree("fit_iterations", FitBase::GetRW());
@@ -463,7 +493,16 @@ void MinimizerRoutines::SetupFitter(std::string routine) {
     delete fMinimizer;
 
   if (UseMCMC) {
-    fMinimizer = new Simple_MH_Sampler();
+    Simple_MH_Sampler *sampler = new Simple_MH_Sampler();
+    // Forked chains hand their iterations back to this FCN's tree
+    sampler->SetIterationRecorder(
+        [this]() -> std::vector<double> const & {
+          return fSampleFCN->GetCurrentIterationValues();
+        },
+        [this](std::vector<double> const &row) {
+          fSampleFCN->AppendIteration(row);
+        });
+    fMinimizer = sampler;
   } else {
     fMinimizer = ROOT::Math::Factory::CreateMinimizer(fitclass, fittype);
   }
@@ -604,11 +643,17 @@ void MinimizerRoutines::Run() {
     NUIS_ABORT("Trying to run MinimizerRoutines with no routines given!");
   }
 
-  for (UInt_t i = 0; i < fRoutines.size(); i++) {
+  // Carry on from the routine that was running when the job stopped
+  size_t firstroutine = CheckpointUtils::IsResuming() ? ReadCheckpoint() : 0;
+
+  for (UInt_t i = firstroutine; i < fRoutines.size(); i++) {
     std::string routine = fRoutines.at(i);
     int fitstate = kFitUnfinished;
     NUIS_LOG(FIT, "Running Routine: " << routine);
 
+    fRoutineIndex = i;
+    fBestVals.clear();
+
     // Try Routines
     if (routine.find("LowStat") != std::string::npos)
       LowStatRoutine(routine);
@@ -630,8 +675,15 @@ void MinimizerRoutines::Run() {
     // If ending early break here
     if (fitstate == kFitFinished || fitstate == kNoChange) {
       NUIS_LOG(FIT, "Ending fit routines loop.");
+      fRoutineIndex = fRoutines.size();
+      fBestVals.clear();
+      WriteCheckpoint();
       break;
     }
+
+    fRoutineIndex = i + 1;
+    fBestVals.clear();
+    WriteCheckpoint();
   }
 
   return;
@@ -655,7 +707,9 @@ int MinimizerRoutines::RunFitRoutine(std::string routine) {
       //    !routine.compare("GSLMulti") or
       !routine.compare("GSLSimAn") or !routine.compare("MCMC")) {
     if (fMinimizer->NFree() > 0) {
+      fSampleFCN->SetFitMode(FitPar::Config().GetParB("LeanFitMode"));
       fMinimizer->Minimize();
+      fSampleFCN->SetFitMode(false);
       GetMinimizerState();
     }
   }
@@ -820,6 +874,136 @@ void MinimizerRoutines::LowStatRoutine(std::string routine) {
   return;
 }
 
+//*************************************
+std::vector<double> MinimizerRoutines::EvaluateScanPoints(
+    std::vector<std::vector<double> > const &points) {
+  //*************************************
+
+  std::vector<double> results(points.size(), 0.0);
+  if (points.empty())
+    return results;
+
+  // Only the likelihood is needed at each point, and only one or two dials
+  // move between neighbouring points.
+  fSampleFCN->SetFitMode(FitPar::Config().GetParB("LeanFitMode"));
+  fSampleFCN->SetCacheEngineWeights(true);
+
+  int nworkers = FitPar::Config().GetParI("ScanWorkers");
+  if (nworkers > int(points.size()))
+    nworkers = points.size();
+
+  if (nworkers < 2) {
+    for (size_t i = 0; i < points.size(); i++) {
+      results[i] = fSampleFCN->DoEval(&points[i][0]);
+    }
+    fSampleFCN->SetCacheEngineWeights(false);
+    fSampleFCN->SetFitMode(false);
+    return results;
+  }
+
+  // Each forked worker evaluates a contiguous block of points on its own copy
+  // of the FCN, sharing the loaded events with this process copy-on-write.
+  // Results and iteration tree rows come back through shared memory.
+  size_t rowsize = 1 + fSampleFCN->GetCurrentIterationValues().size();
+  size_t nbytes = points.size() * rowsize * sizeof(double);
+  double *shared = (double *)mmap(NULL, nbytes, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED) {
+    NUIS_ERR(WRN, "Could not allocate shared memory for scan workers, "
+                  "running the scan serially.");
+    for (size_t i = 0; i < points.size(); i++) {
+      results[i] = fSampleFCN->DoEval(&points[i][0]);
+    }
+    fSampleFCN->SetCacheEngineWeights(false);
+    fSampleFCN->SetFitMode(false);
+    return results;
+  }
+
+  std::vector<bool> done(points.size(), false);
+  std::vector<pid_t> pids;
+  std::vector<std::pair<size_t, size_t> > blocks;
+
+  // Workers read events from this process's open inputs
+  std::vector<ForkUtils::InputFile> inputs = ForkUtils::SnapshotInputFiles();
+
+  std::cout << std::flush;
+  std::cerr << std::flush;
+  size_t start = 0;
+  for (int w = 0; w < nworkers; w++) {
+    size_t count = points.size() / nworkers +
+                   (size_t(w) < (points.size() % nworkers) ? 1 : 0);
+    size_t first = start;
+    size_t last = start + count;
+    start = last;
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      NUIS_ERR(WRN, "Failed to fork scan worker " << w
+                                                  << ", evaluating its points "
+                                                     "here instead.");
+      continue;
+    }
+
+    if (pid == 0) {
+      int status = 0;
+      try {
+        ForkUtils::ReopenInputFiles(inputs);
+        for (size_t i = first; i < last; i++) {
+          double *row = &shared[i * rowsize];
+          row[0] = fSampleFCN->DoEval(&points[i][0]);
+          std::vector<double> const &iter =
+              fSampleFCN->GetCurrentIterationValues();
+          for (size_t j = 0; j < iter.size() and j + 1 < rowsize; j++) {
+            row[j + 1] = iter[j];
+          }
+        }
+      } catch (...) {
+        status = 1;
+      }
+      std::cout << std::flush;
+      std::cerr << std::flush;
+      _exit(status);
+    }
+
+    pids.push_back(pid);
+    blocks.push_back(std::make_pair(first, last));
+  }
+
+  for (size_t w = 0; w < pids.size(); w++) {
+    int status = 0;
+    waitpid(pids[w], &status, 0);
+    if (!WIFEXITED(status) or WEXITSTATUS(status) != 0) {
+      NUIS_ERR(WRN, "Scan worker " << w << " failed, evaluating its points "
+                                            "here instead.");
+      continue;
+    }
+    for (size_t i = blocks[w].first; i < blocks[w].second; i++) {
+      done[i] = true;
+    }
+  }
+
+  // Collect in point order, filling in anything a worker didn't finish
+  std::vector<double> row(rowsize - 1);
+  for (size_t i = 0; i < points.size(); i++) {
+    if (!done[i]) {
+      results[i] = fSampleFCN->DoEval(&points[i][0]);
+      continue;
+    }
+
+    results[i] = shared[i * rowsize];
+    if (rowsize > 1) {
+      std::copy(&shared[i * rowsize + 1], &shared[(i + 1) * rowsize],
+                row.begin());
+      fSampleFCN->AppendIteration(row);
+    }
+  }
+
+  munmap(shared, nbytes);
+  fSampleFCN->SetCacheEngineWeights(false);
+  fSampleFCN->SetFitMode(false);
+  return results;
+}
+
 //*************************************
 void MinimizerRoutines::Create1DScans() {
   //*************************************
@@ -837,8 +1021,6 @@ void MinimizerRoutines::Create1DScans() {
     fSampleFCN->CreateIterationTree(fParams[i] + "_scan1D_iterations",
                                     FitBase::GetRW());
 
-    double scanmiddlepoint = fCurVals[fParams[i]];
-
     // Determine N points needed
     double limlow = fMinVals[fParams[i]];
     double limhigh = fMaxVals[fParams[i]];
@@ -851,26 +1033,22 @@ void MinimizerRoutines::Create1DScans() {
                  ("Chi2Scan1D_" + fParams[i] + ";" + fParams[i]).c_str(),
                  npoints, limlow, limhigh);
 
-    // Fill bins
+    // All other dials stay at the current point
+    std::vector<double> current = GetCurrentParameterVector();
+    std::vector<std::vector<double> > points(contour->GetNbinsX(), current);
     for (int x = 0; x < contour->GetNbinsX(); x++) {
-      // Set X Val
-      fCurVals[fParams[i]] = contour->GetXaxis()->GetBinCenter(x + 1);
-
-      // Run Eval
-      double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
-      double chi2 = fSampleFCN->DoEval(vals);
-      delete vals;
+      points[x][i] = contour->GetXaxis()->GetBinCenter(x + 1);
+    }
 
-      // Fill Contour
-      contour->SetBinContent(x + 1, chi2);
+    // Fill bins
+    std::vector<double> chi2 = EvaluateScanPoints(points);
+    for (int x = 0; x < contour->GetNbinsX(); x++) {
+      contour->SetBinContent(x + 1, chi2[x]);
     }
 
     // Save contour
     contour->Write();
 
-    // Reset Parameter
-    fCurVals[fParams[i]] = scanmiddlepoint;
-
     // Save TTree
     fSampleFCN->WriteIterationTree();
   }
@@ -900,9 +1078,6 @@ void MinimizerRoutines::Chi2Scan2D() {
                                           "scan2D_iterations",
                                       FitBase::GetRW());
 
-      double scanmid_i = fCurVals[fParams[i]];
-      double scanmid_j = fCurVals[fParams[j]];
-
       double limlow_i = fMinVals[fParams[i]];
       double limhigh_i = fMaxVals[fParams[i]];
       double step_i = fStepVals[fParams[i]];
@@ -924,29 +1099,25 @@ void MinimizerRoutines::Chi2Scan2D() {
       // Begin Scan
       NUIS_LOG(FIT, "Running scan for " << fParams[i] << " " << fParams[j]);
 
-      // Fill bins
+      // Points in x-major order, so only dial j moves between most neighbours
+      std::vector<double> current = GetCurrentParameterVector();
+      std::vector<std::vector<double> > points;
+      points.reserve(contour->GetNbinsX() * contour->GetNbinsY());
       for (int x = 0; x < contour->GetNbinsX(); x++) {
-        // Set X Val
-        fCurVals[fParams[i]] = contour->GetXaxis()->GetBinCenter(x + 1);
-
-        // Loop Y
         for (int y = 0; y < contour->GetNbinsY(); y++) {
-          // Set Y Val
-          fCurVals[fParams[j]] = contour->GetYaxis()->GetBinCenter(y + 1);
-
-          // Run Eval
-          double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
-          double chi2 = fSampleFCN->DoEval(vals);
-          delete vals;
-
-          // Fill Contour
-          contour->SetBinContent(x + 1, y + 1, chi2);
-
-          fCurVals[fParams[j]] = scanmid_j;
+          points.push_back(current);
+          points.back()[i] = contour->GetXaxis()->GetBinCenter(x + 1);
+          points.back()[j] = contour->GetYaxis()->GetBinCenter(y + 1);
         }
+      }
 
-        fCurVals[fParams[i]] = scanmid_i;
-        fCurVals[fParams[j]] = scanmid_j;
+      // Fill bins
+      std::vector<double> chi2 = EvaluateScanPoints(points);
+      size_t point = 0;
+      for (int x = 0; x < contour->GetNbinsX(); x++) {
+        for (int y = 0; y < contour->GetNbinsY(); y++) {
+          contour->SetBinContent(x + 1, y + 1, chi2[point++]);
+        }
       }
 
       // Save contour
@@ -960,6 +1131,16 @@ void MinimizerRoutines::Chi2Scan2D() {
   return;
 }
 
+//*************************************
+std::vector<double> MinimizerRoutines::GetCurrentParameterVector() {
+  //*************************************
+  std::vector<double> vals(fParams.size());
+  for (size_t i = 0; i < fParams.size(); i++) {
+    vals[i] = fCurVals[fParams[i]];
+  }
+  return vals;
+}
+
 //*************************************
 void MinimizerRoutines::CreateContours() {
   //*************************************
@@ -1019,6 +1200,16 @@ void MinimizerRoutines::SaveResults() {
   }
 
   SaveCurrentState();
+
+  fOutputRootFile->cd();
+  ProfileUtils::Report(fOutputRootFile,
+                       std::string(fOutputRootFile->GetName()) +
+                           ".profile.json");
+
+  // Everything has been written, nothing left to resume
+  if (!fCheckpointFile.empty()) {
+    CheckpointUtils::Remove(fCheckpointFile);
+  }
 }
 
 //*************************************
@@ -1208,7 +1399,10 @@ void MinimizerRoutines::SaveCurrentState(std::string subdir) {
   // Setup DIRS
   TDirectory *curdir = gDirectory;
   if (!subdir.empty()) {
-    TDirectory *newdir = (TDirectory *)gDirectory->mkdir(subdir.c_str());
+    // A resumed job may already have written it
+    TDirectory *newdir = gDirectory->GetDirectory(subdir.c_str());
+    if (!newdir)
+      newdir = (TDirectory *)gDirectory->mkdir(subdir.c_str());
     newdir->cd();
   }
 
@@ -1222,6 +1416,119 @@ void MinimizerRoutines::SaveCurrentState(std::string subdir) {
   return;
 }
 
+//*************************************
+void MinimizerRoutines::WriteCheckpoint() {
+  //*************************************
+
+  if (fCheckpointFile.empty() || fCheckpointOwner != getpid())
+    return;
+
+  TFile *file = CheckpointUtils::OpenWrite(fCheckpointFile);
+  if (!file)
+    return;
+
+  std::vector<double> vals, errors, fixed;
+  for (size_t i = 0; i < fParams.size(); i++) {
+    std::string syst = fParams[i];
+    // Mid-routine, carry on from the best point found so far
+    vals.push_back(fBestVals.size() == fParams.size() ? fBestVals[i]
+                                                      : fCurVals[syst]);
+    errors.push_back(fErrorVals[syst]);
+    fixed.push_back(fFixVals[syst]);
+  }
+
+  CheckpointUtils::WriteValue(file, "routine", fRoutineIndex);
+  CheckpointUtils::WriteValue(file, "nparams", fParams.size());
+  CheckpointUtils::WriteVector(file, "values", vals);
+  CheckpointUtils::WriteVector(file, "errors", errors);
+  CheckpointUtils::WriteVector(file, "fixed", fixed);
+
+  // Iteration number in the first column
+  std::vector<int> const &counts = fSampleFCN->GetIterationCounts();
+  std::vector<std::vector<double> > const &itervals =
+      fSampleFCN->GetIterationValues();
+  std::vector<std::vector<double> > rows(itervals.size());
+  for (size_t i = 0; i < itervals.size(); i++) {
+    rows[i].push_back(counts[i]);
+    rows[i].insert(rows[i].end(), itervals[i].begin(), itervals[i].end());
+  }
+  CheckpointUtils::WriteRows(file, "iterations", rows);
+
+  CheckpointUtils::Commit(file, fCheckpointFile);
+  fCheckpointTimer.Reset();
+}
+
+//*************************************
+size_t MinimizerRoutines::ReadCheckpoint() {
+  //*************************************
+
+  TFile *file = CheckpointUtils::OpenRead(fCheckpointFile);
+  if (!file) {
+    NUIS_LOG(FIT, "No checkpoint found, starting from the first routine.");
+    return 0;
+  }
+
+  std::vector<double> vals, errors, fixed;
+  size_t routine = CheckpointUtils::ReadValue(file, "routine");
+  size_t nparams = CheckpointUtils::ReadValue(file, "nparams");
+  if (nparams != fParams.size() ||
+      !CheckpointUtils::ReadVector(file, "values", vals) ||
+      !CheckpointUtils::ReadVector(file, "errors", errors) ||
+      !CheckpointUtils::ReadVector(file, "fixed", fixed) ||
+      routine > fRoutines.size()) {
+    NUIS_ERR(WRN, "Checkpoint " << fCheckpointFile
+                                << " doesn't match this card, starting from "
+                                   "the first routine.");
+    file->Close();
+    delete file;
+    return 0;
+  }
+
+  for (size_t i = 0; i < fParams.size(); i++) {
+    std::string syst = fParams[i];
+    fCurVals[syst] = vals[i];
+    fErrorVals[syst] = errors[i];
+    fFixVals[syst] = fixed[i];
+  }
+  UpdateRWEngine(fCurVals);
+
+  std::vector<std::vector<double> > rows;
+  if (CheckpointUtils::ReadRows(file, "iterations", rows)) {
+    std::vector<int> counts(rows.size());
+    std::vector<std::vector<double> > itervals(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+      counts[i] = rows[i][0];
+      itervals[i].assign(rows[i].begin() + 1, rows[i].end());
+    }
+    fSampleFCN->RestoreIterations(counts, itervals);
+  }
+
+  file->Close();
+  delete file;
+
+  NUIS_LOG(FIT, "Resuming from checkpoint " << fCheckpointFile << " at "
+                                            << (routine < fRoutines.size()
+                                                    ? fRoutines[routine]
+                                                    : "the end"));
+  return routine;
+}
+
+//*************************************
+void MinimizerRoutines::CheckpointFCNCall(const double *x, double like) {
+  //*************************************
+
+  if (fCheckpointFile.empty())
+    return;
+
+  if (fBestVals.empty() || like < fBestLikelihood) {
+    fBestVals.assign(x, x + fParams.size());
+    fBestLikelihood = like;
+  }
+
+  if (fCheckpointTimer.IsDue())
+    WriteCheckpoint();
+}
+
 //*************************************
 void MinimizerRoutines::SaveNominal() {
   //*************************************
@@ -47,6 +47,7 @@
 #include <iostream>
 #include <sstream>
 #include <cstring>
+#include <sys/types.h>
 
 #include "FitEvent.h"
 #include "JointFCN.h"
@@ -56,6 +57,7 @@
 #include "Math/Minimizer.h"
 #include "Math/Factory.h"
 #include "Math/Functor.h"
+#include "CheckpointUtils.h"
 #include "FitLogger.h"
 #include "ParserUtils.h"
 
@@ -167,6 +169,15 @@ void SetupMinimizerFromXML();
   //! Perform a chi2 scan in 2D around the current point
   void Chi2Scan2D();
 
+  //! Evaluate the FCN at each point (dial values in fParams order). Points
+  //! are split over "ScanWorkers" forked processes if more than one, and the
+  //! results and iteration tree rows are returned in point order.
+  std::vector<double>
+  EvaluateScanPoints(std::vector<std::vector<double> > const &points);
+
+  //! Current values of fParams, in order
+  std::vector<double> GetCurrentParameterVector();
+
   //! Currently a placeholder NEEDS UPDATING
   void CreateContours();
 
@@ -211,6 +222,20 @@ void SetupMinimizerFromXML();
   /// Makes a histogram of likelihoods when throwing the data according to its statistics
   void ThrowDataToys();
 
+  /*
+    Checkpoint Functions
+  */
+
+  //! Write the routine being run, parameter state and iterations so far
+  void WriteCheckpoint();
+
+  //! Restore the state from the checkpoint when resuming. Returns the
+  //! routine to carry on from.
+  size_t ReadCheckpoint();
+
+  //! Keeps the best point of the current routine and checkpoints when due
+  void CheckpointFCNCall(const double *x, double like);
+
 protected:
 
   //! Our Custom ReWeight Object
@@ -278,6 +303,13 @@ protected:
 
     nuiskey fCompKey;
 
+  std::string fCheckpointFile;  //!< Empty if checkpoints are disabled
+  CheckpointUtils::Timer fCheckpointTimer;
+  pid_t fCheckpointOwner;       //!< Forked workers don't write checkpoints
+  size_t fRoutineIndex;         //!< Routine in fRoutines being run
+  std::vector<double> fBestVals; //!< Best point in the routine being run
+  double fBestLikelihood;
+
 };
 
 /*! @} */
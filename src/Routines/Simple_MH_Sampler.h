@@ -1,9 +1,127 @@
 #include "Math/Minimizer.h"
 
+#include "CheckpointUtils.h"
 #include "FitLogger.h"
+#include "ForkUtils.h"
+#include "ThrowUtils.h"
+
+#include "TFile.h"
+#include "TGraph.h"
+#include "TH1D.h"
+#include "TRandom3.h"
+#include "TTree.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using ROOT::Math::Minimizer;
 
+/// Writes thinned chain steps to a flat binary file in blocks from a
+/// background thread, so a chain never waits on the disk.
+class MCMC_StepWriter {
+ public:
+  /// With append, steps are added to the end of an existing file.
+  MCMC_StepWriter(std::string const &filename, size_t blocksize,
+                  bool append = false)
+      : fBlockSize(blocksize ? blocksize : 1), fDone(false), fWriting(false) {
+    fFile = fopen(filename.c_str(), append ? "ab" : "wb");
+    if (!fFile) {
+      NUIS_ABORT("Could not open MCMC step file " << filename);
+    }
+    fThread = std::thread(&MCMC_StepWriter::Run, this);
+  }
+
+  ~MCMC_StepWriter() { Close(); }
+
+  /// Add one step record, handing the block to the writer once full.
+  void Push(std::vector<double> const &record) {
+    fCurrent.insert(fCurrent.end(), record.begin(), record.end());
+    if (++fNCurrent >= fBlockSize) {
+      Flush();
+    }
+  }
+
+  /// Wait until everything pushed so far is on disk.
+  void Sync() {
+    if (!fFile) return;
+    Flush();
+    std::unique_lock<std::mutex> lock(fMutex);
+    while (!fQueue.empty() || fWriting) {
+      fIdle.wait(lock);
+    }
+    fflush(fFile);
+  }
+
+  /// Write anything outstanding and wait for the writer to finish.
+  void Close() {
+    if (!fFile) return;
+    Flush();
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fDone = true;
+    }
+    fReady.notify_one();
+    fThread.join();
+    fclose(fFile);
+    fFile = NULL;
+  }
+
+ private:
+  void Flush() {
+    if (fCurrent.empty()) return;
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fQueue.push_back(std::vector<double>());
+      fQueue.back().swap(fCurrent);
+    }
+    fNCurrent = 0;
+    fReady.notify_one();
+  }
+
+  void Run() {
+    while (true) {
+      std::vector<double> block;
+      {
+        std::unique_lock<std::mutex> lock(fMutex);
+        while (fQueue.empty() && !fDone) {
+          fReady.wait(lock);
+        }
+        if (fQueue.empty()) return;
+        block.swap(fQueue.front());
+        fQueue.pop_front();
+        fWriting = true;
+      }
+      fwrite(block.data(), sizeof(double), block.size(), fFile);
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fWriting = false;
+      }
+      fIdle.notify_all();
+    }
+  }
+
+  FILE *fFile;
+  size_t fBlockSize;
+  size_t fNCurrent = 0;
+  std::vector<double> fCurrent;
+  std::deque<std::vector<double> > fQueue;
+  std::mutex fMutex;
+  std::condition_variable fReady;
+  std::condition_variable fIdle;
+  bool fDone;
+  bool fWriting;
+  std::thread fThread;
+};
+
 class Simple_MH_Sampler : public Minimizer {
   TRandom3 RNJesus;
 
@@ -15,6 +133,37 @@ class Simple_MH_Sampler : public Minimizer {
 
   size_t discard;
 
+  /// Independent chains, each run on its own forked copy of the FCN
+  size_t nchains;
+  /// Each chain's RNG is seeded from this and the chain number
+  ULong_t masterseed;
+  /// Thinned steps per block handed to the step writer
+  size_t writebuffer;
+
+  /// With several chains every evaluation happens in a forked copy of the
+  /// FCN, so each chain saves the row IterationSource gives after each
+  /// evaluation and the parent hands them to IterationSink in chain order.
+  std::function<std::vector<double> const &()> IterationSource;
+  std::function<void(std::vector<double> const &)> IterationSink;
+  /// Open while a forked chain is recording its iteration rows
+  FILE *IterationFile;
+
+  /// Adaptive proposal: covariance of the free parameters learned during
+  /// burn-in, frozen once burn-in ends so the kept chain is Markovian.
+  bool adaptive;
+  std::vector<size_t> free_params;
+  size_t adapt_n;
+  std::vector<double> adapt_mean;
+  std::vector<double> adapt_m2;
+  std::vector<double> prop_chol;
+  bool use_chol;
+
+  double curr_chi2;
+  double propose_chi2;
+
+  int tree_step;
+  int tree_chain;
+
   struct Param {
     Param()
         : IsFixed(false),
@@ -60,9 +209,31 @@ class Simple_MH_Sampler : public Minimizer {
 
  public:
   Simple_MH_Sampler() : Minimizer(), RNJesus(), trace() {
-    thin = Config::GetParI("MCMC.thin");
+    int cthin = Config::GetParI("MCMC.thin");
+    thin = (cthin > 0) ? cthin : 1;
     thin_ctr = 0;
-    discard = Config::GetParI("MCMC.BurnInSteps");
+    int cdiscard = Config::GetParI("MCMC.BurnInSteps");
+    discard = (cdiscard > 0) ? cdiscard : 0;
+
+    int cchains = Config::GetParI("MCMC.NChains");
+    nchains = (cchains > 0) ? cchains : 1;
+    masterseed = 0;
+    int cbuffer = Config::GetParI("MCMC.WriteBuffer");
+    writebuffer = (cbuffer > 0) ? cbuffer : 1000;
+    adaptive = Config::GetParB("MCMC.AdaptiveProposal");
+    adapt_n = 0;
+    use_chol = false;
+    min_value = 0xdeadbeef;
+    StepTree = NULL;
+    IterationFile = NULL;
+  }
+
+  /// Used to fill the caller's iteration tree when chains run forked
+  void SetIterationRecorder(
+      std::function<std::vector<double> const &()> source,
+      std::function<void(std::vector<double> const &)> sink) {
+    IterationSource = source;
+    IterationSink = sink;
   }
 
   void SetFunction(ROOT::Math::IMultiGenFunction const &func) { FCN = &func; }
@@ -184,7 +355,8 @@ class Simple_MH_Sampler : public Minimizer {
     }
 
     StepTree = new TTree("MCMChain", "");
-    StepTree->Branch("Step", &step_i, "Step/I");
+    StepTree->Branch("Chain", &tree_chain, "Chain/I");
+    StepTree->Branch("Step", &tree_step, "Step/I");
     StepTree->Branch("Value", &curr_value, "Value/D");
     StepTree->Branch("Moved", &moved, "Moved/I");
 
@@ -203,7 +375,24 @@ class Simple_MH_Sampler : public Minimizer {
 
   void Fill() { StepTree->Fill(); }
 
+  bool InsideLimits(size_t p_it, double thr) {
+    if ((start_params[p_it].LowLim != 0xdeadbeef) &&
+        (thr < start_params[p_it].LowLim)) {
+      return false;
+    }
+    if ((start_params[p_it].UpLim != 0xdeadbeef) &&
+        (thr > start_params[p_it].UpLim)) {
+      return false;
+    }
+    return true;
+  }
+
   void Propose() {
+    if (use_chol) {
+      ProposeCorrelated();
+      return;
+    }
+
     for (size_t p_it = 0; p_it < start_params.size(); ++p_it) {
       double propose_param = curr_params[p_it];
 
@@ -221,14 +410,7 @@ class Simple_MH_Sampler : public Minimizer {
           double thr =
               RNJesus.Gaus(curr_params[p_it], start_params[p_it].StepWidth);
 
-          if ((start_params[p_it].LowLim != 0xdeadbeef) &&
-              (thr < start_params[p_it].LowLim)) {
-            attempts++;
-            continue;
-          }
-
-          if ((start_params[p_it].UpLim != 0xdeadbeef) &&
-              (thr > start_params[p_it].UpLim)) {
+          if (!InsideLimits(p_it, thr)) {
             attempts++;
             continue;
           }
@@ -243,9 +425,99 @@ class Simple_MH_Sampler : public Minimizer {
     }
   }
 
+  /// Multivariate Gaussian step using the adapted proposal covariance
+  void ProposeCorrelated() {
+    size_t nfree = free_params.size();
+    std::vector<double> z(nfree);
+
+    for (size_t attempts = 0; attempts <= 1000; ++attempts) {
+      for (size_t i = 0; i < nfree; ++i) {
+        z[i] = RNJesus.Gaus(0, 1);
+      }
+
+      propose_params = curr_params;
+      bool inside = true;
+      for (size_t i = 0; i < nfree && inside; ++i) {
+        double step = 0;
+        for (size_t j = 0; j <= i; ++j) {
+          step += prop_chol[i * nfree + j] * z[j];
+        }
+        size_t p_it = free_params[i];
+        propose_params[p_it] = curr_params[p_it] + step;
+        inside = InsideLimits(p_it, propose_params[p_it]);
+      }
+      if (inside) return;
+    }
+    NUIS_ABORT("After 1000 attempts, failed to throw an adapted MCMC step "
+               "inside the parameter limits.");
+  }
+
+  /// Add the current point to the burn-in covariance and periodically
+  /// rebuild the proposal from it (Haario et al. adaptive Metropolis).
+  void Adapt() {
+    size_t nfree = free_params.size();
+    if (!adaptive || !nfree || step_i >= discard) return;
+
+    adapt_n++;
+    std::vector<double> delta(nfree);
+    for (size_t i = 0; i < nfree; ++i) {
+      delta[i] = curr_params[free_params[i]] - adapt_mean[i];
+      adapt_mean[i] += delta[i] / double(adapt_n);
+    }
+    for (size_t i = 0; i < nfree; ++i) {
+      for (size_t j = 0; j < nfree; ++j) {
+        adapt_m2[i * nfree + j] +=
+            delta[i] * (curr_params[free_params[j]] - adapt_mean[j]);
+      }
+    }
+
+    if ((adapt_n < 2 * nfree + 2) || (adapt_n % (10 * nfree + 10))) return;
+
+    // Scaled sample covariance, with a small fraction of the initial step
+    // widths on the diagonal to keep it positive definite.
+    double scale = 2.38 * 2.38 / double(nfree);
+    std::vector<double> cov(nfree * nfree);
+    for (size_t i = 0; i < nfree; ++i) {
+      for (size_t j = 0; j < nfree; ++j) {
+        cov[i * nfree + j] =
+            scale * adapt_m2[i * nfree + j] / double(adapt_n - 1);
+      }
+      double width = start_params[free_params[i]].StepWidth;
+      cov[i * nfree + i] += 1E-6 * width * width;
+    }
+
+    // Cholesky, keep the previous proposal if it isn't positive definite
+    std::vector<double> chol(nfree * nfree, 0);
+    for (size_t i = 0; i < nfree; ++i) {
+      for (size_t j = 0; j <= i; ++j) {
+        double sum = cov[i * nfree + j];
+        for (size_t k = 0; k < j; ++k) {
+          sum -= chol[i * nfree + k] * chol[j * nfree + k];
+        }
+        if (i == j) {
+          if (sum <= 0) return;
+          chol[i * nfree + i] = sqrt(sum);
+        } else {
+          chol[i * nfree + j] = sum / chol[j * nfree + j];
+        }
+      }
+    }
+    prop_chol.swap(chol);
+    use_chol = true;
+  }
+
   void Evaluate() {
-    propose_value = exp(-(*FCN)(propose_params.data()) / 10000.0);
-    if (propose_value < min_value) {
+    propose_chi2 = (*FCN)(propose_params.data());
+    if (IterationFile) {
+      // Each row is [nvalues, values...]
+      std::vector<double> const &row = IterationSource();
+      double nvals = row.size();
+      fwrite(&nvals, sizeof(double), 1, IterationFile);
+      fwrite(row.data(), sizeof(double), row.size(), IterationFile);
+    }
+    propose_value = exp(-propose_chi2 / 10000.0);
+    if (propose_chi2 < min_value) {
+      min_value = propose_chi2;
       min_params = propose_params;
     }
   }
@@ -290,23 +562,193 @@ class Simple_MH_Sampler : public Minimizer {
     if (moved) {
       curr_params = propose_params;
       curr_value = propose_value;
+      curr_chi2 = propose_chi2;
     }
   }
 
-  bool Minimize() {
-    if (!start_params.size()) {
-      NUIS_ERR(FTL, "No Parameters passed to Simple_MH_Sampler.");
-      return false;
+  /// Layout of the per-chain summary shared with forked chains:
+  /// [done, best chi2, best params...]
+  size_t SummarySize() const { return 2 + start_params.size(); }
+
+  /// Each thinned step record: [step, value, moved, params...]
+  size_t RecordSize() const { return 3 + start_params.size(); }
+
+  std::string ChainFile(size_t chain) const {
+    std::string base = "MCMC";
+    if (Config::Get().out) {
+      base = Config::Get().out->GetName();
     }
+    return base + Form(".chain%i.bin", int(chain));
+  }
 
-    RestartParams();
+  std::string ChainIterationFile(size_t chain) const {
+    return ChainFile(chain) + ".iter";
+  }
 
-    AddBranches();
+  bool RecordIterations() const { return (nchains > 1) && IterationSource; }
 
-    size_t NSteps = Options().MaxIterations();
-    trace.Set(NSteps);
-    NUIS_LOG(FIT, "Running chain for " << NSteps << " steps.");
+  /// Hand a finished chain's iteration rows to IterationSink
+  void CollectIterations(size_t chain) {
+    FILE *f = fopen(ChainIterationFile(chain).c_str(), "rb");
+    if (!f) {
+      NUIS_ERR(WRN, "Could not read iterations for MCMC chain " << chain);
+      return;
+    }
+    std::vector<double> row;
+    double nvals = 0;
+    while (fread(&nvals, sizeof(double), 1, f) == 1) {
+      row.resize(size_t(nvals));
+      if (fread(row.data(), sizeof(double), row.size(), f) != row.size()) {
+        break;
+      }
+      IterationSink(row);
+    }
+    fclose(f);
+  }
+
+  std::string ChainCheckpoint(size_t chain) const {
+    return CheckpointUtils::GetCheckpointFile(ChainFile(chain));
+  }
+
+  /// Save everything needed to carry on a chain: its position, the adapted
+  /// proposal, the RNG state and how many steps are already in its file.
+  void WriteChainCheckpoint(size_t chain, double const *trace_vals,
+                            size_t nrecords) {
+    TFile *file = CheckpointUtils::OpenWrite(ChainCheckpoint(chain));
+    if (!file) return;
+
+    CheckpointUtils::WriteValue(file, "step", step_i);
+    CheckpointUtils::WriteValue(file, "nrecords", nrecords);
+    if (IterationFile) {
+      fflush(IterationFile);
+      CheckpointUtils::WriteValue(file, "iterbytes", ftell(IterationFile));
+    }
+    CheckpointUtils::WriteValue(file, "thin_ctr", thin_ctr);
+    CheckpointUtils::WriteValue(file, "curr_value", curr_value);
+    CheckpointUtils::WriteValue(file, "curr_chi2", curr_chi2);
+    CheckpointUtils::WriteValue(file, "min_value", min_value);
+    CheckpointUtils::WriteVector(file, "curr_params", curr_params);
+    CheckpointUtils::WriteVector(file, "min_params", min_params);
+    CheckpointUtils::WriteValue(file, "adapt_n", adapt_n);
+    CheckpointUtils::WriteValue(file, "use_chol", use_chol);
+    CheckpointUtils::WriteVector(file, "adapt_mean", adapt_mean);
+    CheckpointUtils::WriteVector(file, "adapt_m2", adapt_m2);
+    CheckpointUtils::WriteVector(file, "prop_chol", prop_chol);
+    CheckpointUtils::WriteVector(
+        file, "trace", std::vector<double>(trace_vals, trace_vals + step_i));
+    file->WriteTObject(&RNJesus, "rng");
+
+    CheckpointUtils::Commit(file, ChainCheckpoint(chain));
+  }
+
+  /// Restore a chain from its checkpoint. Returns the number of thinned
+  /// steps already in its file, or -1 to start the chain afresh.
+  long ReadChainCheckpoint(size_t chain, double *trace_vals, size_t NSteps) {
+    TFile *file = CheckpointUtils::OpenRead(ChainCheckpoint(chain));
+    if (!file) return -1;
+
+    long nrecords = -1;
+    std::vector<double> trace_read;
+    TRandom3 *rng = NULL;
+    file->GetObject("rng", rng);
+    size_t step = CheckpointUtils::ReadValue(file, "step");
+
+    if (rng && step <= NSteps &&
+        CheckpointUtils::ReadVector(file, "curr_params", curr_params) &&
+        CheckpointUtils::ReadVector(file, "min_params", min_params) &&
+        CheckpointUtils::ReadVector(file, "trace", trace_read) &&
+        curr_params.size() == start_params.size()) {
+      RNJesus = *rng;
+      step_i = step;
+      nrecords = CheckpointUtils::ReadValue(file, "nrecords");
+      thin_ctr = CheckpointUtils::ReadValue(file, "thin_ctr");
+      curr_value = CheckpointUtils::ReadValue(file, "curr_value");
+      curr_chi2 = CheckpointUtils::ReadValue(file, "curr_chi2");
+      min_value = CheckpointUtils::ReadValue(file, "min_value");
+      adapt_n = CheckpointUtils::ReadValue(file, "adapt_n");
+      use_chol = CheckpointUtils::ReadValue(file, "use_chol");
+      CheckpointUtils::ReadVector(file, "adapt_mean", adapt_mean);
+      CheckpointUtils::ReadVector(file, "adapt_m2", adapt_m2);
+      CheckpointUtils::ReadVector(file, "prop_chol", prop_chol);
+      std::copy(trace_read.begin(), trace_read.end(), trace_vals);
+      propose_params = curr_params;
+
+      // Drop any steps written after the checkpoint
+      if (truncate(ChainFile(chain).c_str(),
+                   nrecords * RecordSize() * sizeof(double)) != 0) {
+        nrecords = -1;
+      }
+      if (RecordIterations() &&
+          truncate(ChainIterationFile(chain).c_str(),
+                   off_t(CheckpointUtils::ReadValue(file, "iterbytes"))) !=
+              0) {
+        nrecords = -1;
+      }
+    } else {
+      NUIS_ERR(WRN, "Ignoring MCMC checkpoint " << ChainCheckpoint(chain)
+                                               << " that doesn't match.");
+    }
+
+    delete rng;
+    file->Close();
+    delete file;
+    return nrecords;
+  }
+
+  /// Run one full chain, writing thinned steps to ChainFile(chain), the
+  /// value at every step to trace_vals and the best point to summary.
+  void RunChain(size_t chain, double *summary, double *trace_vals,
+                size_t NSteps) {
+    RNJesus.SetSeed(ThrowUtils::GetThrowSeed(masterseed, chain));
+    RestartParams();
+
+    free_params.clear();
+    for (size_t p_it = 0; p_it < start_params.size(); ++p_it) {
+      if (!start_params[p_it].IsFixed) free_params.push_back(p_it);
+    }
+    adapt_n = 0;
+    adapt_mean.assign(free_params.size(), 0);
+    adapt_m2.assign(free_params.size() * free_params.size(), 0);
+    use_chol = false;
     step_i = 0;
+    thin_ctr = 0;
+
+    CheckpointUtils::Timer timer;
+    timer.Start();
+    long nrecords = -1;
+    if (CheckpointUtils::IsResuming()) {
+      nrecords = ReadChainCheckpoint(chain, trace_vals, NSteps);
+    }
+
+    if (RecordIterations()) {
+      IterationFile = fopen(ChainIterationFile(chain).c_str(),
+                            (nrecords < 0) ? "wb" : "ab");
+      if (!IterationFile) {
+        NUIS_ERR(WRN, "Could not save iterations for MCMC chain " << chain);
+      }
+    }
+
+    if (nrecords < 0) {
+      nrecords = 0;
+      RestartParams();
+      step_i = 0;
+      thin_ctr = 0;
+
+      // Start from the nominal point
+      propose_params = curr_params;
+      min_value = 0xdeadbeef;
+      Evaluate();
+      curr_value = propose_value;
+      curr_chi2 = propose_chi2;
+    } else {
+      NUIS_LOG(FIT, "Resuming chain " << chain << " at step " << step_i);
+    }
+
+    MCMC_StepWriter writer(ChainFile(chain), writebuffer, step_i > 0);
+    std::vector<double> record(RecordSize());
+
+    NUIS_LOG(FIT, "Running chain " << chain << " for " << NSteps
+                                   << " steps.");
     while (step_i < NSteps) {
       Propose();
 
@@ -314,21 +756,236 @@ class Simple_MH_Sampler : public Minimizer {
 
       Step();
 
-      trace.SetPoint(step_i, step_i, curr_value);
+      Adapt();
+
+      trace_vals[step_i] = curr_value;
 
       if (step_i >= discard) {
         thin_ctr++;
         if (thin_ctr == thin) {
-          Fill();
+          record[0] = step_i;
+          record[1] = curr_value;
+          record[2] = moved;
+          std::copy(curr_params.begin(), curr_params.end(), record.begin() + 3);
+          writer.Push(record);
+          nrecords++;
           thin_ctr = 0;
         }
       }
       step_i++;
+
+      if (timer.IsDue()) {
+        writer.Sync();
+        WriteChainCheckpoint(chain, trace_vals, nrecords);
+        timer.Reset();
+      }
+    }
+    writer.Close();
+    if (IterationFile) {
+      fclose(IterationFile);
+      IterationFile = NULL;
+    }
+
+    // A finished chain is only collected once every chain is done
+    if (timer.IsEnabled()) {
+      WriteChainCheckpoint(chain, trace_vals, nrecords);
+    }
+
+    summary[1] = min_value;
+    std::copy(min_params.begin(), min_params.end(), summary + 2);
+    summary[0] = 1;
+  }
+
+  /// Read back the thinned steps of every chain into StepTree in chain order
+  /// and write the Gelman-Rubin R-hat of each free parameter.
+  void CollectChains(double *summaries) {
+    AddBranches();
+
+    size_t npar = start_params.size();
+    std::vector<std::vector<double> > chainmean(nchains,
+                                                std::vector<double>(npar, 0));
+    std::vector<std::vector<double> > chainm2(nchains,
+                                              std::vector<double>(npar, 0));
+    std::vector<size_t> chainn(nchains, 0);
+    std::vector<double> record(RecordSize());
+
+    for (size_t c = 0; c < nchains; ++c) {
+      if (!summaries[c * SummarySize()]) {
+        NUIS_ERR(WRN, "MCMC chain " << c << " did not finish, skipping it.");
+        unlink(ChainFile(c).c_str());
+        unlink(ChainIterationFile(c).c_str());
+        CheckpointUtils::Remove(ChainCheckpoint(c));
+        continue;
+      }
+
+      FILE *f = fopen(ChainFile(c).c_str(), "rb");
+      if (!f) {
+        NUIS_ERR(WRN, "Could not read steps for MCMC chain " << c);
+        unlink(ChainIterationFile(c).c_str());
+        continue;
+      }
+      while (fread(record.data(), sizeof(double), record.size(), f) ==
+             record.size()) {
+        tree_chain = c;
+        tree_step = record[0];
+        curr_value = record[1];
+        moved = record[2];
+        std::copy(record.begin() + 3, record.end(), curr_params.begin());
+        Fill();
+
+        chainn[c]++;
+        for (size_t p_it = 0; p_it < npar; ++p_it) {
+          double delta = curr_params[p_it] - chainmean[c][p_it];
+          chainmean[c][p_it] += delta / double(chainn[c]);
+          chainm2[c][p_it] += delta * (curr_params[p_it] - chainmean[c][p_it]);
+        }
+      }
+      fclose(f);
+      unlink(ChainFile(c).c_str());
+      CheckpointUtils::Remove(ChainCheckpoint(c));
+
+      if (RecordIterations()) {
+        CollectIterations(c);
+        unlink(ChainIterationFile(c).c_str());
+      }
+
+      // Keep the best point found by any chain
+      double *summary = &summaries[c * SummarySize()];
+      if (summary[1] < min_value) {
+        min_value = summary[1];
+        min_params.assign(summary + 2, summary + 2 + npar);
+      }
+    }
+
+    // R-hat from chains with at least two kept steps
+    std::vector<size_t> good;
+    for (size_t c = 0; c < nchains; ++c) {
+      if (chainn[c] > 1) good.push_back(c);
+    }
+    if (good.size() < 2) return;
+
+    TH1D rhat("MCMC_Rhat", "Gelman-Rubin #hat{R};Parameter;#hat{R}", npar, 0,
+              npar);
+    for (size_t p_it = 0; p_it < npar; ++p_it) {
+      rhat.GetXaxis()->SetBinLabel(p_it + 1, start_params[p_it].name.c_str());
+      if (start_params[p_it].IsFixed) continue;
+
+      double n = 0, grandmean = 0, W = 0;
+      for (size_t g = 0; g < good.size(); ++g) {
+        n += chainn[good[g]];
+        grandmean += chainmean[good[g]][p_it];
+        W += chainm2[good[g]][p_it] / double(chainn[good[g]] - 1);
+      }
+      double m = good.size();
+      n /= m;
+      grandmean /= m;
+      W /= m;
+
+      double B = 0;
+      for (size_t g = 0; g < good.size(); ++g) {
+        B += pow(chainmean[good[g]][p_it] - grandmean, 2);
+      }
+      B *= n / (m - 1);
+
+      double R = (W > 0) ? sqrt(((n - 1) / n * W + B / n) / W) : 0;
+      rhat.SetBinContent(p_it + 1, R);
+      NUIS_LOG(FIT, "MCMC R-hat for " << start_params[p_it].name << " = " << R
+                                     << (R > 1.1 ? " (not converged)" : ""));
+    }
+
+    TFile *ogf = gFile;
+    if (Config::Get().out && Config::Get().out->IsOpen()) {
+      Config::Get().out->cd();
+    }
+    rhat.Write();
+    if (ogf && ogf->IsOpen()) {
+      ogf->cd();
+    }
+  }
+
+  bool Minimize() {
+    if (!start_params.size()) {
+      NUIS_ERR(FTL, "No Parameters passed to Simple_MH_Sampler.");
+      return false;
+    }
+
+    RestartParams();
+    masterseed = ThrowUtils::GetMasterSeed("MCMC.Seed");
+
+    size_t NSteps = Options().MaxIterations();
+
+    // Summaries and traces are shared with forked chains
+    size_t nshared = nchains * (SummarySize() + NSteps);
+    size_t nbytes = nshared * sizeof(double);
+    double *shared = (double *)mmap(NULL, nbytes, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+      NUIS_ABORT("Could not allocate shared memory for " << nchains
+                                                         << " MCMC chains.");
+    }
+    std::fill(shared, shared + nshared, 0);
+    double *summaries = shared;
+    double *traces = shared + nchains * SummarySize();
+
+    if (nchains == 1) {
+      RunChain(0, summaries, traces, NSteps);
+    } else {
+      NUIS_LOG(FIT, "Running " << nchains << " MCMC chains in parallel.");
+      std::cout << std::flush;
+      std::cerr << std::flush;
+
+      // Chains read events from this process's open inputs
+      std::vector<ForkUtils::InputFile> inputs =
+          ForkUtils::SnapshotInputFiles();
+
+      std::vector<pid_t> pids;
+      for (size_t c = 0; c < nchains; ++c) {
+        pid_t pid = fork();
+        if (pid < 0) {
+          NUIS_ERR(WRN, "Failed to fork MCMC chain " << c);
+          continue;
+        }
+        if (pid == 0) {
+          int status = 0;
+          try {
+            ForkUtils::ReopenInputFiles(inputs);
+            RunChain(c, &summaries[c * SummarySize()], &traces[c * NSteps],
+                     NSteps);
+          } catch (...) {
+            status = 1;
+          }
+          std::cout << std::flush;
+          std::cerr << std::flush;
+          _exit(status);
+        }
+        pids.push_back(pid);
+      }
+      for (size_t i = 0; i < pids.size(); ++i) {
+        int status = 0;
+        waitpid(pids[i], &status, 0);
+      }
     }
 
+    min_value = 0xdeadbeef;
+    CollectChains(summaries);
+
+    TFile *ogf = gFile;
+    if (Config::Get().out && Config::Get().out->IsOpen()) {
+      Config::Get().out->cd();
+    }
     StepTree->Write();
-    trace.Write("MCMCTrace");
+    for (size_t c = 0; c < nchains; ++c) {
+      trace.Set(NSteps);
+      for (size_t s_it = 0; s_it < NSteps; ++s_it) {
+        trace.SetPoint(s_it, s_it, traces[c * NSteps + s_it]);
+      }
+      trace.Write(c ? Form("MCMCTrace_chain%i", int(c)) : "MCMCTrace");
+    }
+    if (ogf && ogf->IsOpen()) {
+      ogf->cd();
+    }
 
+    munmap(shared, nbytes);
     return true;
   };
 };
@@ -75,6 +75,8 @@ SystematicRoutines::SystematicRoutines(int argc, char *argv[]) {
   ParserUtils::ParseArgument(args, "-q", configargs);
   ParserUtils::ParseCounter(args, "e", errorcount);
   ParserUtils::ParseCounter(args, "v", verbocount);
+  bool resume = false;
+  ParserUtils::ParseFlag(args, "--resume", resume);
   ParserUtils::CheckBadArguments(args);
 
   // Add extra defaults if none given
@@ -120,6 +122,10 @@ SystematicRoutines::SystematicRoutines(int argc, char *argv[]) {
   // Finish configuration XML
   configuration.FinaliseSettings(fCompKey.GetS("outputfile") + ".xml");
 
+  if (resume) {
+    Config::SetPar("checkpoint_resume", true);
+  }
+
   // Add Error Verbo Lines
   verbocount += Config::GetParI("VERBOSITY");
   errorcount += Config::GetParI("ERROR");
@@ -889,8 +895,8 @@ void SystematicRoutines::GenerateErrorBands() {
 void SystematicRoutines::GenerateThrows() {
   //*************************************
 
-  TFile *tempfile =
-      new TFile((fOutputFile + ".throws.root").c_str(), "RECREATE");
+  // A resumed job carries on with the throws it already made
+  TFile *tempfile = CheckpointUtils::OpenOutput(fOutputFile + ".throws.root");
   tempfile->cd();
 
   // For generating throws we check with the config
@@ -905,15 +911,10 @@ void SystematicRoutines::GenerateThrows() {
   if (endthrows < 0)
     endthrows = startthrows + nthrows;
 
-  // Setting Seed
-  // Matteo Mazzanti's Fix
-  struct timeval mytime;
-  gettimeofday(&mytime, NULL);
-  Double_t seed = time(NULL) + int(getpid()) + (mytime.tv_sec * 1000.) +
-                  (mytime.tv_usec / 1000.);
-  gRandom->SetSeed(seed);
+  // Each throw is seeded from the master seed and its index, so any subset
+  // of throws can be regenerated exactly, on any number of workers.
+  ULong_t masterseed = ThrowUtils::GetFileMasterSeed(tempfile);
 
-  NUIS_LOG(FIT, "Using Seed : " << seed);
   NUIS_LOG(FIT, "nthrows = " << nthrows);
   NUIS_LOG(FIT, "startthrows = " << startthrows);
   NUIS_LOG(FIT, "endthrows = " << endthrows);
@@ -922,9 +923,11 @@ void SystematicRoutines::GenerateThrows() {
   fSampleFCN->ReconfigureAllEvents();
 
   // Make the nominal
-  if (startthrows == 0) {
+  if (startthrows == 0 && !tempfile->GetDirectory("postfit")) {
     NUIS_LOG(FIT, "Making nominal ");
-    TDirectory *nominal = (TDirectory *)tempfile->mkdir("nominal");
+    TDirectory *nominal = tempfile->GetDirectory("nominal");
+    if (!nominal)
+      nominal = (TDirectory *)tempfile->mkdir("nominal");
     nominal->cd();
     fSampleFCN->Write();
 
@@ -937,24 +940,85 @@ void SystematicRoutines::GenerateThrows() {
     fSampleFCN->Write();
   }
 
-  fSampleFCN->CreateIterationTree("error_iterations", FitBase::GetRW());
-
   // Would anybody actually want to do uniform throws of any parameter??
   bool uniformly = FitPar::Config().GetParB("error_uniform");
 
-  // Run Throws and save
-  for (Int_t i = 0; i < endthrows + 1; i++) {
+  // Throw 0 is the nominal
+  int firstthrow = (startthrows > 0) ? startthrows : 1;
+  int nworkers = ThrowUtils::GetNWorkers();
 
-    if (i < startthrows) continue;
-    if (i == 0) continue;
-    NUIS_LOG(FIT, "Throw " << i << "/" << endthrows
-                       << " ================================");
+  if (nworkers < 2) {
+    RunThrowRange(firstthrow, endthrows, masterseed, uniformly, tempfile);
+    CheckpointUtils::Remove(ThrowUtils::GetThrowCheckpoint(tempfile));
+    tempfile->Close();
+    return;
+  }
 
-    TDirectory *throwfolder =
-        (TDirectory *)tempfile->mkdir(Form("throw_%i", i));
-    throwfolder->cd();
+  // Run contiguous blocks of throws on forked workers, which share the loaded
+  // events with this process, then copy them back in throw order.
+  std::string throwsfile = fOutputFile + ".throws.root";
+  tempfile->Close();
+
+  std::vector<std::pair<int, int> > ranges =
+      ThrowUtils::SplitThrows(firstthrow, endthrows, nworkers);
+  std::vector<std::string> workerfiles = ThrowUtils::RunForkedThrows(
+      throwsfile, ranges, [&](int first, int last, TFile *workerfile) {
+        RunThrowRange(first, last, masterseed, uniformly, workerfile);
+      });
+
+  // Combine the workers' accumulators, which are disjoint in throw index
+  std::map<std::string, ThrowAccumulator *> accums;
+  for (size_t i = 0; i < workerfiles.size(); i++) {
+    TFile *workerfile = new TFile(workerfiles[i].c_str(), "READ");
+    TDirectory *accdir = workerfile->GetDirectory("throw_accumulators");
+    if (accdir)
+      ThrowAccumulator::ReadAll(accdir, accums);
+    workerfile->Close();
+    delete workerfile;
+  }
+
+  tempfile = new TFile(throwsfile.c_str(), "UPDATE");
+  std::vector<std::string> trees(1, "error_iterations");
+  std::vector<std::string> skipdirs(1, "throw_accumulators");
+  ThrowUtils::MergeWorkerFiles(tempfile, workerfiles, trees, skipdirs);
+
+  ThrowAccumulator::WriteAll(accums, tempfile->mkdir("throw_accumulators"));
+  ClearThrowAccumulators(accums);
+  tempfile->Close();
+
+  for (size_t i = 0; i < ranges.size(); i++) {
+    CheckpointUtils::Remove(CheckpointUtils::GetCheckpointFile(
+        ThrowUtils::GetWorkerFile(throwsfile, i)));
+  }
+}
+
+//*************************************
+void SystematicRoutines::RunThrowRange(int first, int last, ULong_t masterseed,
+                                       bool uniformly, TFile *outfile) {
+  //*************************************
+
+  fSampleFCN->CreateIterationTree("error_iterations", FitBase::GetRW());
+
+  // Raw throws are only needed to rebuild bands MergeThrows can't get from the
+  // accumulators, e.g. per-throw plots or non-MC histograms.
+  bool savethrows = FitPar::Config().GetParB("error_save_throws");
+  ClearThrowAccumulators(fThrowAccumulators);
+
+  std::string checkpoint = ThrowUtils::GetThrowCheckpoint(outfile);
+  CheckpointUtils::Timer timer;
+  timer.Start();
+  if (CheckpointUtils::IsResuming()) {
+    first = ReadThrowCheckpoint(checkpoint, first, last, outfile);
+  }
+
+  // Run Throws and save
+  for (Int_t i = first; i < last + 1; i++) {
+
+    NUIS_LOG(FIT, "Throw " << i << "/" << last
+                           << " ================================");
 
     // Generate Random Parameter Throw
+    ThrowUtils::SeedThrow(masterseed, i);
     ThrowCovariance(uniformly);
 
     // Run Eval
@@ -962,13 +1026,113 @@ void SystematicRoutines::GenerateThrows() {
     fSampleFCN->DoEval(vals);
     delete[] vals;
 
+    FillThrowAccumulators(i);
+
     // Save the FCN
-    fSampleFCN->Write();
+    if (savethrows) {
+      TDirectory *throwfolder =
+          (TDirectory *)outfile->mkdir(Form("throw_%i", i));
+      throwfolder->cd();
+      fSampleFCN->Write();
+      throwfolder->SaveSelf(kTRUE);
+    }
+
+    if (timer.IsDue()) {
+      WriteThrowCheckpoint(checkpoint, first, last, i, outfile);
+      timer.Reset();
+    }
   }
 
-  tempfile->cd();
+  // Kept until the caller has finished with outfile, in case it is killed
+  // before then
+  if (timer.IsEnabled()) {
+    WriteThrowCheckpoint(checkpoint, first, last, last, outfile);
+  }
+
+  outfile->cd();
   fSampleFCN->WriteIterationTree();
-  tempfile->Close();
+
+  TDirectory *accdir = outfile->GetDirectory("throw_accumulators");
+  if (!accdir)
+    accdir = outfile->mkdir("throw_accumulators");
+  ThrowAccumulator::WriteAll(fThrowAccumulators, accdir);
+  ClearThrowAccumulators(fThrowAccumulators);
+  outfile->cd();
+}
+
+//*************************************
+void SystematicRoutines::WriteThrowCheckpoint(std::string const &checkpoint,
+                                              int first, int last,
+                                              int lastdone, TFile *outfile) {
+  //*************************************
+
+  // Make the throw folders written so far readable if the job is killed
+  outfile->SaveSelf(kTRUE);
+  outfile->Flush();
+
+  TFile *file = CheckpointUtils::OpenWrite(checkpoint);
+  if (!file)
+    return;
+
+  ThrowUtils::WriteThrowRange(file, first, last, lastdone);
+
+  std::vector<int> const &counts = fSampleFCN->GetIterationCounts();
+  std::vector<std::vector<double> > const &itervals =
+      fSampleFCN->GetIterationValues();
+  std::vector<std::vector<double> > rows(itervals.size());
+  for (size_t i = 0; i < itervals.size(); i++) {
+    rows[i].push_back(counts[i]);
+    rows[i].insert(rows[i].end(), itervals[i].begin(), itervals[i].end());
+  }
+  CheckpointUtils::WriteRows(file, "iterations", rows);
+
+  ThrowAccumulator::WriteAll(fThrowAccumulators,
+                             file->mkdir("throw_accumulators"));
+  CheckpointUtils::Commit(file, checkpoint);
+}
+
+//*************************************
+int SystematicRoutines::ReadThrowCheckpoint(std::string const &checkpoint,
+                                            int first, int last,
+                                            TFile *outfile) {
+  //*************************************
+
+  TFile *file = CheckpointUtils::OpenRead(checkpoint);
+  int lastdone = ThrowUtils::ReadThrowRange(file, first, last);
+
+  std::vector<std::vector<double> > rows;
+  if (lastdone >= first && CheckpointUtils::ReadRows(file, "iterations", rows)) {
+    std::vector<int> counts(rows.size());
+    std::vector<std::vector<double> > itervals(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+      counts[i] = rows[i][0];
+      itervals[i].assign(rows[i].begin() + 1, rows[i].end());
+    }
+    fSampleFCN->RestoreIterations(counts, itervals);
+
+    TDirectory *accdir = file->GetDirectory("throw_accumulators");
+    if (accdir)
+      ThrowAccumulator::ReadAll(accdir, fThrowAccumulators);
+  } else {
+    lastdone = first - 1;
+  }
+
+  if (file) {
+    file->Close();
+    delete file;
+  }
+
+  // Throws after the checkpoint are made again
+  for (int i = lastdone + 1; i <= last; i++) {
+    if (outfile->GetDirectory(Form("throw_%i", i)))
+      outfile->Delete(Form("throw_%i;*", i));
+  }
+
+  if (lastdone >= first) {
+    NUIS_LOG(FIT, "Resuming throws " << first << "-" << last << " after throw "
+                                     << lastdone);
+  }
+  return lastdone + 1;
 }
 
 // Merge throws together into one summary
@@ -1070,6 +1234,29 @@ void SystematicRoutines::MergeThrows() {
     sleep(5);
   }
 
+  // Throw files with accumulated throws can be merged without reading back
+  // each throw. Only used if every good file has them.
+  std::map<std::string, ThrowAccumulator *> accums;
+  bool useaccums = true;
+  for (uint i = 0; i < fThrowList.size() and useaccums; i++) {
+    if (fThrowList[i].empty())
+      continue;
+    TFile *throwfile = new TFile(fThrowList[i].c_str(), "READ");
+    TDirectory *accdir = throwfile->GetDirectory("throw_accumulators");
+    if (accdir) {
+      ThrowAccumulator::ReadAll(accdir, accums);
+    } else {
+      useaccums = false;
+    }
+    throwfile->Close();
+    delete throwfile;
+  }
+  if (!useaccums) {
+    ClearThrowAccumulators(accums);
+  } else {
+    NUIS_LOG(FIT, "Using accumulated throws for the error bands.");
+  }
+
   // Now go through the keys in the temporary file and look for TH1D, and TH2D
   // plots
   TIter next(nominal->GetListOfKeys());
@@ -1095,6 +1282,13 @@ void SystematicRoutines::MergeThrows() {
     else
       nbins = ((TH1D *)baseplot)->GetNbinsX() * ((TH1D *)baseplot)->GetNbinsY();
 
+    if (accums.count(plotname)) {
+      WriteAccumulatedErrors(accums[plotname], baseplot, errorDIR, outnominal,
+                             uniformly);
+      delete baseplot;
+      continue;
+    }
+
     // Setup TProfile with RMS option
     TProfile *tprof =
         new TProfile((plotname + "_prof").c_str(), (plotname + "_prof").c_str(),
@@ -1125,9 +1319,13 @@ void SystematicRoutines::MergeThrows() {
     // Make new throw plot
     TH1 *newplot;
 
-    // Run Throw Merging.
+    // Run Throw Merging. Throws are seeded by index, so the same index in
+    // two files is the same throw and is only counted once.
+    std::set<int> mergedthrows;
     for (UInt_t i = 0; i < fThrowList.size(); i++) {
 
+      if (fThrowList[i].empty())
+        continue;
       TFile *throwfile = new TFile(fThrowList[i].c_str(), "READ");
 
       // Loop over all throws in a folder
@@ -1136,12 +1334,15 @@ void SystematicRoutines::MergeThrows() {
       while ((throwkey = (TKey *)nextthrow())) {
 
         // Skip non throw folders
-        if (std::string(throwkey->GetName()).find("throw_") ==
-            std::string::npos)
+        int throwindex = ThrowUtils::GetThrowIndex(throwkey->GetName());
+        if (throwindex < 0)
+          continue;
+        if (!mergedthrows.insert(throwindex).second)
           continue;
 
         // Get Throw DIR
-        TDirectory *throwdir = (TDirectory *)throwkey->ReadObj();
+        TDirectory *throwdir =
+            (TDirectory *)throwfile->Get(throwkey->GetName());
 
         // Get Plot From Throw
         newplot = (TH1 *)throwdir->Get(plotname.c_str());
@@ -1162,6 +1363,14 @@ void SystematicRoutines::MergeThrows() {
       delete throwfile;
     }
 
+    NUIS_LOG(FIT, "Merged " << mergedthrows.size() << " throws for "
+                            << plotname);
+    if (mergedthrows.empty()) {
+      delete baseplot;
+      delete tprof;
+      delete bintree;
+      continue;
+    }
     errorDIR->cd();
 
     if (uniformly) {
@@ -1199,10 +1408,115 @@ void SystematicRoutines::MergeThrows() {
     delete tprof;
     delete bintree;
   }
+  ClearThrowAccumulators(accums);
   fOutputRootFile->Write();
   fOutputRootFile->Close();
 };
 
+//*************************************
+void SystematicRoutines::FillThrowAccumulators(int throwindex) {
+  //*************************************
+
+  std::list<MeasurementBase *> samples = fSampleFCN->GetSampleList();
+  for (std::list<MeasurementBase *>::iterator iter = samples.begin();
+       iter != samples.end(); iter++) {
+    std::vector<TH1 *> mclist = (*iter)->GetMCList();
+
+    for (size_t i = 0; i < mclist.size(); i++) {
+      TH1 *mc = mclist[i];
+      if (!mc)
+        continue;
+
+      std::string name = mc->GetName();
+      std::map<std::string, ThrowAccumulator *>::iterator acc =
+          fThrowAccumulators.find(name);
+      if (acc == fThrowAccumulators.end()) {
+        std::vector<double> quantiles;
+        std::string quantilestr = FitPar::Config().GetParS("error_quantiles");
+        if (!quantilestr.empty())
+          quantiles = GeneralUtils::ParseToDbl(quantilestr, ",");
+        int sketchsize = FitPar::Config().GetParI("error_quantile_sketch_size");
+        int maxcovbins = FitPar::Config().GetParI("error_covar_maxbins");
+
+        int nbins = mc->GetNbinsX();
+        if (mc->InheritsFrom("TH2D"))
+          nbins *= mc->GetNbinsY();
+        acc = fThrowAccumulators
+                  .insert(std::make_pair(
+                      name, new ThrowAccumulator(name, nbins, quantiles,
+                                                 sketchsize, maxcovbins)))
+                  .first;
+      }
+      acc->second->Fill(mc, throwindex);
+    }
+  }
+}
+
+//*************************************
+void SystematicRoutines::ClearThrowAccumulators(
+    std::map<std::string, ThrowAccumulator *> &accums) {
+  //*************************************
+  for (std::map<std::string, ThrowAccumulator *>::iterator iter =
+           accums.begin();
+       iter != accums.end(); iter++) {
+    delete iter->second;
+  }
+  accums.clear();
+}
+
+//*************************************
+void SystematicRoutines::WriteAccumulatedErrors(ThrowAccumulator *acc,
+                                                TH1 *baseplot,
+                                                TDirectory *errorDIR,
+                                                TDirectory *outnominal,
+                                                bool uniformly) {
+  //*************************************
+
+  std::string plotname = baseplot->GetName();
+  NUIS_LOG(FIT, "Merged " << acc->GetN() << " accumulated throws for "
+                          << plotname);
+
+  TH1 *statplot = (TH1 *)baseplot->Clone();
+  for (Int_t j = 0; j < acc->GetNBins(); j++) {
+    if (!uniformly) {
+      baseplot->SetBinContent(j + 1, acc->GetMean(j));
+      baseplot->SetBinError(j + 1, acc->GetSpread(j));
+    } else {
+      baseplot->SetBinContent(j + 1, 0.0);
+      baseplot->SetBinError(j + 1, 0.0);
+    }
+  }
+
+  baseplot->SetTitle("Profiled throws");
+  errorDIR->cd();
+  baseplot->Write();
+
+  TMatrixDSym *covar = acc->GetCovariance();
+  if (covar) {
+    TH2D *covarplot = new TH2D(*covar);
+    covarplot->SetNameTitle((plotname + "_covar").c_str(),
+                            (plotname + " covariance of throws").c_str());
+    covarplot->Write();
+    delete covarplot;
+    delete covar;
+  }
+
+  for (size_t i = 0; i < acc->GetQuantiles().size(); i++) {
+    TH1 *quantplot = acc->GetQuantileBand(statplot, acc->GetQuantiles()[i]);
+    quantplot->Write();
+    delete quantplot;
+  }
+
+  outnominal->cd();
+  for (int i = 0; i < acc->GetNBins(); i++) {
+    baseplot->SetBinError(i + 1, sqrt(pow(statplot->GetBinError(i + 1), 2) +
+                                      pow(baseplot->GetBinError(i + 1), 2)));
+  }
+  baseplot->Write();
+
+  delete statplot;
+}
+
 void SystematicRoutines::EigenErrors() {
 
   fOutputRootFile = new TFile(fCompKey.GetS("outputfile").c_str(), "RECREATE");
@@ -39,9 +39,15 @@
 #include <iostream>
 #include <sstream>
 #include <cstring>
+#include <list>
+#include <map>
+#include <set>
 
 #include "FitEvent.h"
 #include "JointFCN.h"
+#include "ThrowAccumulator.h"
+#include "ThrowUtils.h"
+#include "CheckpointUtils.h"
 #include "TMatrixDSymEigen.h"
 #include "ParserUtils.h"
 
@@ -165,8 +171,41 @@ void SetupSystematicsFromXML();
   //! Currently only supports TH1D plots.
   void GenerateErrorBands();
   
+  //! Generate throws into <output>.throws.root. Throws are seeded from
+  //! "error_seed" and the throw index, and are run on "error_throw_workers"
+  //! forked processes if more than one.
   void GenerateThrows();
+
+  //! Run throws [first, last] into outfile, one throw_%i folder per throw.
+  //! Checkpoints every "checkpoint_interval" seconds and carries on from the
+  //! last checkpoint with --resume.
+  void RunThrowRange(int first, int last, ULong_t masterseed, bool uniformly,
+                     TFile *outfile);
+
+  //! Save the throws done so far in [first, last], their iterations and
+  //! accumulators.
+  void WriteThrowCheckpoint(std::string const &checkpoint, int first, int last,
+                            int lastdone, TFile *outfile);
+
+  //! Restore a WriteThrowCheckpoint, returning the first throw left to do.
+  int ReadThrowCheckpoint(std::string const &checkpoint, int first, int last,
+                          TFile *outfile);
+
+  //! Build error bands from any set of throw files. Each throw index is used
+  //! at most once. Uses the throw accumulators if all files have them.
   void MergeThrows();
+
+  //! Add the current MC of every sample to fThrowAccumulators.
+  void FillThrowAccumulators(int throwindex);
+
+  //! Delete and clear a set of accumulators.
+  void ClearThrowAccumulators(std::map<std::string, ThrowAccumulator *> &accums);
+
+  //! Write the error band, covariance and quantile plots for one histogram
+  //! from its accumulated throws.
+  void WriteAccumulatedErrors(ThrowAccumulator *acc, TH1 *baseplot,
+                              TDirectory *errorDIR, TDirectory *outnominal,
+                              bool uniformly);
   //! Step through each parameter one by one and create folders containing the MC predictions at each step.
   //! Doesn't handle correlated parameters well
   void PlotLimits();
@@ -259,6 +298,10 @@ protected:
   std::vector<std::string> fThrowList;
   std::string fThrowString;
 
+  //! Online mean, covariance and quantiles of each MC histogram over the
+  //! throws run by this process, keyed by histogram name.
+  std::map<std::string, ThrowAccumulator *> fThrowAccumulators;
+
   int fNThrows;
   int fStartThrows;
 
@@ -0,0 +1,369 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#include "ThrowUtils.h"
+
+#include "CheckpointUtils.h"
+#include "FitLogger.h"
+#include "ForkUtils.h"
+#include "NuisConfig.h"
+
+#include "TClass.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "TRandom.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <set>
+
+namespace {
+/// Copy all objects except trees in treenames and directories in skipdirs
+/// from one directory to another, keeping only the highest cycle of each key.
+void CopyDirectory(TDirectory *from, TDirectory *to,
+                   std::set<std::string> const &treenames,
+                   std::set<std::string> const &skipdirs) {
+  std::set<std::string> copied;
+  TIter next(from->GetListOfKeys());
+  TKey *key;
+  while ((key = (TKey *)next())) {
+    std::string name = key->GetName();
+    if (!copied.insert(name).second)
+      continue;
+    if (skipdirs.count(name))
+      continue;
+
+    TClass *cl = gROOT->GetClass(key->GetClassName());
+    if (!cl)
+      continue;
+
+    if (cl->InheritsFrom("TDirectory")) {
+      TDirectory *subfrom = (TDirectory *)from->Get(name.c_str());
+      TDirectory *subto = to->GetDirectory(name.c_str());
+      if (!subto)
+        subto = to->mkdir(name.c_str());
+      CopyDirectory(subfrom, subto, treenames, std::set<std::string>());
+      continue;
+    }
+
+    if (cl->InheritsFrom("TTree") and treenames.count(name))
+      continue;
+
+    TObject *obj = from->Get(name.c_str());
+    to->cd();
+    if (cl->InheritsFrom("TTree")) {
+      TTree *copy = ((TTree *)obj)->CloneTree(-1, "fast");
+      copy->Write(name.c_str());
+      delete copy;
+    } else {
+      obj->Write(name.c_str());
+      delete obj;
+    }
+  }
+}
+} // namespace
+
+namespace ThrowUtils {
+
+//*************************************
+ULong_t GetMasterSeed(std::string const &key) {
+  //*************************************
+
+  ULong_t seed = Config::GetParI(key);
+  if (seed) {
+    NUIS_LOG(FIT, "Using master seed : " << seed);
+    return seed;
+  }
+
+  // Matteo Mazzanti's Fix, kept to 31 bits so it can be passed back in
+  // through error_seed.
+  struct timeval mytime;
+  gettimeofday(&mytime, NULL);
+  Double_t timeseed = time(NULL) + int(getpid()) + (mytime.tv_sec * 1000.) +
+                      (mytime.tv_usec / 1000.);
+  seed = ULong_t(timeseed) & 0x7FFFFFFF;
+  if (!seed)
+    seed = 1;
+
+  NUIS_LOG(FIT, "Using master seed : " << seed);
+  NUIS_LOG(FIT, "Set " << key << "=" << seed << " to reproduce this run.");
+  return seed;
+}
+
+//*************************************
+ULong_t GetThrowSeed(ULong_t masterseed, int index) {
+  //*************************************
+
+  // SplitMix64 finaliser over (master, index) so that neighbouring throws get
+  // uncorrelated TRandom3 states.
+  ULong64_t z = ULong64_t(masterseed) * 0x9E3779B97F4A7C15ULL +
+                ULong64_t(index) + 0x632BE59BD9B4E019ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+
+  // TRandom3 treats 0 as "seed from the clock"
+  ULong_t seed = ULong_t(z & 0xFFFFFFFF);
+  return seed ? seed : 1;
+}
+
+//*************************************
+void SeedThrow(ULong_t masterseed, int index) {
+  //*************************************
+  gRandom->SetSeed(GetThrowSeed(masterseed, index));
+}
+
+//*************************************
+int GetNWorkers() {
+  //*************************************
+  int nworkers = Config::GetParI("error_throw_workers");
+  return nworkers > 1 ? nworkers : 1;
+}
+
+//*************************************
+std::vector<std::pair<int, int> > SplitThrows(int first, int last,
+                                             int nworkers) {
+  //*************************************
+
+  std::vector<std::pair<int, int> > ranges;
+  int nthrows = last - first + 1;
+  if (nthrows < 1)
+    return ranges;
+  if (nworkers > nthrows)
+    nworkers = nthrows;
+  if (nworkers < 1)
+    nworkers = 1;
+
+  int start = first;
+  for (int i = 0; i < nworkers; i++) {
+    int count = nthrows / nworkers + (i < (nthrows % nworkers) ? 1 : 0);
+    ranges.push_back(std::make_pair(start, start + count - 1));
+    start += count;
+  }
+  return ranges;
+}
+
+//*************************************
+std::string GetWorkerFile(std::string const &throwsfile, int worker) {
+  //*************************************
+  return throwsfile + Form(".worker%i.root", worker);
+}
+
+//*************************************
+std::vector<std::string>
+RunForkedThrows(std::string const &throwsfile,
+                std::vector<std::pair<int, int> > const &ranges,
+                std::function<void(int, int, TFile *)> run) {
+  //*************************************
+
+  // Anything buffered here would otherwise be flushed once per worker
+  std::cout << std::flush;
+  std::cerr << std::flush;
+  std::fflush(stdout);
+  std::fflush(stderr);
+
+  // Workers read events from the parent's open inputs
+  std::vector<ForkUtils::InputFile> inputs = ForkUtils::SnapshotInputFiles();
+
+  std::vector<pid_t> pids(ranges.size(), -1);
+  for (size_t i = 0; i < ranges.size(); i++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      NUIS_ERR(WRN, "Failed to fork throw worker " << i
+                                                   << ", throws "
+                                                   << ranges[i].first << "-"
+                                                   << ranges[i].second
+                                                   << " will be missing.");
+      continue;
+    }
+
+    if (pid == 0) {
+      int status = 0;
+      try {
+        ForkUtils::ReopenInputFiles(inputs);
+        // A resumed worker carries on with the file it left behind
+        TFile *workerfile =
+            CheckpointUtils::OpenOutput(GetWorkerFile(throwsfile, i));
+        workerfile->cd();
+        run(ranges[i].first, ranges[i].second, workerfile);
+        workerfile->Close();
+      } catch (...) {
+        status = 1;
+      }
+      std::cout << std::flush;
+      std::cerr << std::flush;
+      std::fflush(stdout);
+      std::fflush(stderr);
+      // Skip the parent's atexit/static teardown, it owns those resources
+      _exit(status);
+    }
+
+    NUIS_LOG(FIT, "Started throw worker " << i << " (pid " << pid
+                                           << ") for throws "
+                                           << ranges[i].first << "-"
+                                           << ranges[i].second);
+    pids[i] = pid;
+  }
+
+  std::vector<std::string> completed;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    if (pids[i] < 0)
+      continue;
+
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+    if (!WIFEXITED(status) or WEXITSTATUS(status) != 0) {
+      NUIS_ERR(WRN, "Throw worker " << i << " for throws " << ranges[i].first
+                                    << "-" << ranges[i].second
+                                    << " failed, its throws will be missing.");
+      gSystem->Unlink(GetWorkerFile(throwsfile, i).c_str());
+      continue;
+    }
+    completed.push_back(GetWorkerFile(throwsfile, i));
+  }
+
+  return completed;
+}
+
+//*************************************
+void MergeWorkerFiles(TFile *target, std::vector<std::string> const &files,
+                      std::vector<std::string> const &treenames,
+                      std::vector<std::string> const &skipdirs) {
+  //*************************************
+
+  std::set<std::string> treeset(treenames.begin(), treenames.end());
+  std::set<std::string> skipset(skipdirs.begin(), skipdirs.end());
+  std::vector<TList *> trees(treenames.size());
+  for (size_t i = 0; i < trees.size(); i++) {
+    trees[i] = new TList();
+  }
+
+  std::vector<TFile *> opened;
+  for (size_t i = 0; i < files.size(); i++) {
+    TFile *workerfile = new TFile(files[i].c_str(), "READ");
+    if (!workerfile or workerfile->IsZombie()) {
+      NUIS_ERR(WRN, "Could not read throw worker file " << files[i]);
+      delete workerfile;
+      continue;
+    }
+    opened.push_back(workerfile);
+
+    NUIS_LOG(FIT, "Merging throws from " << files[i]);
+    CopyDirectory(workerfile, target, treeset, skipset);
+
+    for (size_t j = 0; j < treenames.size(); j++) {
+      TTree *tree = (TTree *)workerfile->Get(treenames[j].c_str());
+      if (tree)
+        trees[j]->Add(tree);
+    }
+  }
+
+  target->cd();
+  for (size_t i = 0; i < trees.size(); i++) {
+    if (trees[i]->GetSize()) {
+      TTree *merged = TTree::MergeTrees(trees[i]);
+      merged->SetName(treenames[i].c_str());
+      merged->SetDirectory(target);
+      merged->Write();
+      delete merged;
+    }
+    delete trees[i];
+  }
+
+  for (size_t i = 0; i < opened.size(); i++) {
+    opened[i]->Close();
+    delete opened[i];
+  }
+  for (size_t i = 0; i < files.size(); i++) {
+    gSystem->Unlink(files[i].c_str());
+  }
+  target->cd();
+}
+
+//*************************************
+int GetThrowIndex(std::string const &dirname) {
+  //*************************************
+  int index = -1;
+  char trailing;
+  if (std::sscanf(dirname.c_str(), "throw_%d%c", &index, &trailing) != 1)
+    return -1;
+  return index;
+}
+
+//*************************************
+ULong_t GetFileMasterSeed(TFile *throwsfile) {
+  //*************************************
+
+  if (CheckpointUtils::IsResuming()) {
+    double seed = CheckpointUtils::ReadValue(throwsfile, "master_seed", 0);
+    if (seed > 0) {
+      NUIS_LOG(FIT, "Using master seed : " << ULong_t(seed)
+                                           << " from the resumed throws.");
+      return ULong_t(seed);
+    }
+  }
+
+  ULong_t seed = GetMasterSeed();
+  CheckpointUtils::WriteValue(throwsfile, "master_seed", seed);
+  return seed;
+}
+
+//*************************************
+std::string GetThrowCheckpoint(TFile *outfile) {
+  //*************************************
+  return CheckpointUtils::GetCheckpointFile(outfile->GetName());
+}
+
+//*************************************
+void WriteThrowRange(TDirectory *checkpoint, int first, int last,
+                     int lastdone) {
+  //*************************************
+  std::vector<double> range;
+  range.push_back(first);
+  range.push_back(last);
+  range.push_back(lastdone);
+  CheckpointUtils::WriteVector(checkpoint, "throw_range", range);
+}
+
+//*************************************
+int ReadThrowRange(TDirectory *checkpoint, int first, int last) {
+  //*************************************
+  std::vector<double> range;
+  if (!checkpoint ||
+      !CheckpointUtils::ReadVector(checkpoint, "throw_range", range) ||
+      range.size() != 3)
+    return first - 1;
+
+  if (int(range[0]) != first || int(range[1]) != last) {
+    NUIS_ERR(WRN, "Checkpoint is for throws " << range[0] << "-" << range[1]
+                                              << ", not " << first << "-"
+                                              << last << ", ignoring it.");
+    return first - 1;
+  }
+  return int(range[2]);
+}
+} // namespace ThrowUtils
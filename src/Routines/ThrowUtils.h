@@ -0,0 +1,102 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#ifndef THROW_UTILS_H
+#define THROW_UTILS_H
+
+/*!
+ *  \addtogroup Minimizer
+ *  @{
+ */
+
+#include "TFile.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+//! Scheduling and seeding of covariance throws shared by the throw routines.
+namespace ThrowUtils {
+
+//! Master seed for a set of throws or chains, read from the config key
+//! (default "error_seed"). If 0 a seed is derived from the time and PID and
+//! logged so that the run can be reproduced by setting it explicitly.
+ULong_t GetMasterSeed(std::string const &key = "error_seed");
+
+//! Seed for a single throw. Only depends on the master seed and the throw
+//! index, so a throw is identical whichever worker runs it and in whatever
+//! order.
+ULong_t GetThrowSeed(ULong_t masterseed, int index);
+
+//! Reseed gRandom for the given throw.
+void SeedThrow(ULong_t masterseed, int index);
+
+//! Number of worker processes to run throws on, from the config
+//! "error_throw_workers".
+int GetNWorkers();
+
+//! Split the inclusive throw range [first, last] into at most nworkers
+//! contiguous, ordered, inclusive ranges.
+std::vector<std::pair<int, int> > SplitThrows(int first, int last,
+                                             int nworkers);
+
+//! Worker output file for a given worker of a throws file.
+std::string GetWorkerFile(std::string const &throwsfile, int worker);
+
+//! Run one forked worker process per range. Each worker calls
+//! run(first, last, file) with file opened at GetWorkerFile(throwsfile, i).
+//! Workers share the already loaded events with the parent copy-on-write.
+//! Inputs still read from disk are reopened in each worker, see ForkUtils.
+//! Returns the worker files that completed, in range order.
+std::vector<std::string>
+RunForkedThrows(std::string const &throwsfile,
+                std::vector<std::pair<int, int> > const &ranges,
+                std::function<void(int, int, TFile *)> run);
+
+//! Copy everything in the worker files into target in the order given,
+//! merging the trees named in treenames into a single tree of the same name.
+//! Top level directories in skipdirs are left for the caller to combine.
+//! Worker files are removed afterwards.
+void MergeWorkerFiles(
+    TFile *target, std::vector<std::string> const &files,
+    std::vector<std::string> const &treenames,
+    std::vector<std::string> const &skipdirs = std::vector<std::string>());
+
+//! Returns the index of a "throw_%i" directory name, or -1.
+int GetThrowIndex(std::string const &dirname);
+
+//! Master seed of a throws file. When resuming a file that already has one
+//! it is reused, otherwise GetMasterSeed() is stored in the file.
+ULong_t GetFileMasterSeed(TFile *throwsfile);
+
+//! Checkpoint belonging to the file a range of throws is written to.
+std::string GetThrowCheckpoint(TFile *outfile);
+
+//! Record that throws [first, lastdone] of [first, last] are done.
+void WriteThrowRange(TDirectory *checkpoint, int first, int last,
+                     int lastdone);
+
+//! Last throw already done in [first, last] according to the checkpoint, or
+//! first - 1 if the checkpoint is missing or for a different range.
+int ReadThrowRange(TDirectory *checkpoint, int first, int last);
+} // namespace ThrowUtils
+
+/*! @} */
+#endif
@@ -0,0 +1,63 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "CounterRandom.h"
+
+namespace {
+/// SplitMix64 finaliser
+inline ULong64_t Mix(ULong64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+ULong64_t const kGolden = 0x9E3779B97F4A7C15ULL;
+} // namespace
+
+CounterRandom::CounterRandom(ULong64_t seed) : TRandom(), fCounter(0) {
+  SetSeed(seed);
+}
+
+void CounterRandom::SetSeed(ULong_t seed) {
+  fSeed = seed;
+  fKey = Mix(ULong64_t(seed) * kGolden + 0x632BE59BD9B4E019ULL);
+  SetStream(0);
+}
+
+void CounterRandom::SetStream(ULong64_t stream) {
+  fStreamKey = Mix(fKey ^ Mix((stream + 1) * kGolden));
+  fCounter = 0;
+}
+
+Double_t CounterRandom::Rndm() {
+  ULong64_t bits = Mix(fStreamKey + (++fCounter) * kGolden);
+  // Top 53 bits, offset by half a step so that 0 is never returned
+  return (double(bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+void CounterRandom::RndmArray(Int_t n, Float_t *array) {
+  for (Int_t i = 0; i < n; ++i) {
+    array[i] = Float_t(Rndm());
+  }
+}
+
+void CounterRandom::RndmArray(Int_t n, Double_t *array) {
+  for (Int_t i = 0; i < n; ++i) {
+    array[i] = Rndm();
+  }
+}
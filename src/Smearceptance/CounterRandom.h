@@ -0,0 +1,45 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#ifndef COUNTERRANDOM_HXX_SEEN
+#define COUNTERRANDOM_HXX_SEEN
+
+#include "TRandom.h"
+
+/// Counter-based generator. Each draw is a pure function of (seed, stream,
+/// draw number), so giving every event its own stream makes its throws
+/// independent of event order and of which thread smears it.
+class CounterRandom : public TRandom {
+  ULong64_t fKey;
+  ULong64_t fStreamKey;
+  ULong64_t fCounter;
+
+ public:
+  CounterRandom(ULong64_t seed = 0);
+
+  /// Restart at the first draw of the given stream, e.g. an event index.
+  void SetStream(ULong64_t stream);
+
+  virtual void SetSeed(ULong_t seed = 0);
+  virtual Double_t Rndm();
+  virtual void RndmArray(Int_t n, Float_t *array);
+  virtual void RndmArray(Int_t n, Double_t *array);
+};
+
+#endif
@@ -84,6 +84,7 @@ TH1 *GetEffHist(TFile *inputFile, std::string const &HistName) {
 void EfficiencyApplicator::SpecifcSetup(nuiskey &nk) {
   rand.~TRandom3();
   new (&rand) TRandom3();
+  SetRandom(&rand);
 
   std::vector<nuiskey> effDescriptors =
       nk.GetListOfChildNodes("EfficiencyCurve");
@@ -138,7 +139,8 @@ void EfficiencyApplicator::SpecifcSetup(nuiskey &nk) {
     std::string pdgs_s = effDescriptors[t_it].GetS("PDG");
     std::vector<int> pdgs_i = GeneralUtils::ParseToInt(pdgs_s, ",");
     for (size_t pdg_it = 0; pdg_it < pdgs_i.size(); ++pdg_it) {
-      if (Efficiencies.count(pdgs_i[pdg_it])) {
+      int slot = EfficiencySlots.Find(pdgs_i[pdg_it]);
+      if (slot != -1) {
         NUIS_ERR(WRN, "Smearceptor " << ElementName << ":" << InstanceName
                                   << " already has a efficiency for PDG: "
                                   << pdgs_i[pdg_it]);
@@ -157,7 +159,12 @@ void EfficiencyApplicator::SpecifcSetup(nuiskey &nk) {
       em.AxisScales[1] = YAxisScale;
       em.AxisScales[2] = ZAxisScale;
 
-      Efficiencies[pdgs_i[pdg_it]] = em;
+      if (slot == -1) {
+        EfficiencySlots.Set(pdgs_i[pdg_it], Efficiencies.size());
+        Efficiencies.push_back(em);
+      } else {
+        Efficiencies[slot] = em;
+      }
 
       NUIS_LOG(FIT,
            "Added reconstruction efficiency curve for PDG: " << pdgs_i[pdg_it]);
@@ -168,7 +175,7 @@ void EfficiencyApplicator::SpecifcSetup(nuiskey &nk) {
 }
 
 RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+  RecoInfo *ri = GetRecoInfoBuffer();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
@@ -186,7 +193,8 @@ RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
       continue;
     }
 
-    if (!Efficiencies.count(fp->PDG())) {
+    int slot = EfficiencySlots.Find(fp->PDG());
+    if (slot == -1) {
       SlaveTA.SmearceptOneParticle(ri, fp
 #ifdef DEBUG_THRESACCEPT
                                    ,
@@ -196,7 +204,7 @@ RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
       continue;
     }
 
-    EffMap &em = Efficiencies[fp->PDG()];
+    EffMap &em = Efficiencies[slot];
 
     double kineProps[3];
     for (Int_t dim_it = 0; dim_it < em.NDims; ++dim_it) {
@@ -352,7 +360,7 @@ RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
       }
     }
 
-    bool accepted = (rand.Uniform() < effProb);
+    bool accepted = (GetRandom()->Uniform() < effProb);
 
     if (accepted) {
 #ifdef DEBUG_EFFAPP
@@ -40,7 +40,8 @@ private:
     EfficiencyApplicator::DependVar DependVars[3];
     double AxisScales[3];
   };
-  std::map<int, EffMap> Efficiencies;
+  std::vector<EffMap> Efficiencies;
+  PDGSlotTable EfficiencySlots;
 
   void SpecifcSetup(nuiskey &);
 
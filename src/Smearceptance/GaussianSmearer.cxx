@@ -19,7 +19,20 @@
 
 #include "GaussianSmearer.h"
 
+#include "RVersion.h"
+
 namespace {
+/// TF1::GetRandom only takes a generator from ROOT 6.24, before that
+/// Function smears are thrown with gRandom.
+double ThrowFunction(TF1 *func, TRandom *rand) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 24, 0)
+  return func->GetRandom(rand);
+#else
+  (void)rand;
+  return func->GetRandom();
+#endif
+}
+
 GaussianSmearer::GSmearType GetVarType(std::string const &type) {
   if (type == "Absolute") {
     return GaussianSmearer::kAbsolute;
@@ -87,6 +100,7 @@ std::string GetKineTypeName(GaussianSmearer::DependVar dv) {
 void GaussianSmearer::SpecifcSetup(nuiskey &nk) {
   rand.~TRandom3();
   new (&rand) TRandom3();
+  SetRandom(&rand);
 
   std::vector<nuiskey> smearDescriptors = nk.GetListOfChildNodes("Smear");
 
@@ -156,7 +170,7 @@ void GaussianSmearer::SpecifcSetup(nuiskey &nk) {
     }
 
     for (size_t pdg_it = 0; pdg_it < pdgs_i.size(); ++pdg_it) {
-      if (IsVisSmear && VisGausSmears.count(pdgs_i[pdg_it])) {
+      if (IsVisSmear && VisSlots.Has(pdgs_i[pdg_it])) {
         NUIS_ERR(WRN,
               "Smearceptor "
                   << ElementName << ":" << InstanceName
@@ -178,9 +192,21 @@ void GaussianSmearer::SpecifcSetup(nuiskey &nk) {
       }
 
       if (IsVisSmear) {
-        VisGausSmears[pdgs_i[pdg_it]] = gs;
+        int slot = VisSlots.Find(pdgs_i[pdg_it]);
+        if (slot == -1) {
+          VisSlots.Set(pdgs_i[pdg_it], VisGausSmears.size());
+          VisGausSmears.push_back(gs);
+        } else {
+          VisGausSmears[slot] = gs;
+        }
       } else {
-        TrackedGausSmears[pdgs_i[pdg_it]].push_back(gs);
+        int slot = TrackedSlots.Find(pdgs_i[pdg_it]);
+        if (slot == -1) {
+          slot = TrackedGausSmears.size();
+          TrackedSlots.Set(pdgs_i[pdg_it], slot);
+          TrackedGausSmears.push_back(std::vector<GSmear>());
+        }
+        TrackedGausSmears[slot].push_back(gs);
       }
 
       NUIS_LOG(SAM, "Added gaussian "
@@ -211,19 +237,20 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
     return;
   }
 
-  if ((TrackedGausSmears.count(fp->PDG()) + VisGausSmears.count(fp->PDG())) ==
-      0) {
+  int trackedslot = TrackedSlots.Find(fp->PDG());
+  int visslot = VisSlots.Find(fp->PDG());
+  if ((trackedslot == -1) && (visslot == -1)) {
 #ifdef DEBUG_GAUSSSMEAR
     std::cout << " -- Undetectable." << std::flush;
 #endif
     return;
   }
 
-  if (TrackedGausSmears.count(fp->PDG())) {
+  if (trackedslot != -1) {
     TVector3 ThreeMom = fp->P3();
-    for (size_t sm_it = 0; sm_it < TrackedGausSmears[fp->PDG()].size();
-         ++sm_it) {
-      GSmear &sm = TrackedGausSmears[fp->PDG()][sm_it];
+    std::vector<GSmear> &smears = TrackedGausSmears[trackedslot];
+    for (size_t sm_it = 0; sm_it < smears.size(); ++sm_it) {
+      GSmear &sm = smears[sm_it];
 
       double kineProp = 0;
 
@@ -253,9 +280,9 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
       while (!ok) {
         if (sm.type == GaussianSmearer::kFunction) {
           sm.func->SetParameter(0, kineProp);
-          Smeared = sm.func->GetRandom();
+          Smeared = ThrowFunction(sm.func, GetRandom());
         } else {
-          double sThrow = rand.Gaus(
+          double sThrow = GetRandom()->Gaus(
               0, sm.width *
                      ((sm.type == GaussianSmearer::kAbsolute) ? 1 : kineProp));
           Smeared = kineProp + sThrow;
@@ -319,7 +346,7 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
     ri->RecObjClass.push_back(fp->PDG());
   } else {  // Smear to EVis
 
-    GSmear &sm = VisGausSmears[fp->PDG()];
+    GSmear &sm = VisGausSmears[visslot];
 
     double kineProp = 0;
 
@@ -338,9 +365,9 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
     double Smeared;
     if (sm.type == GaussianSmearer::kFunction) {
       sm.func->SetParameter(0, kineProp);
-      Smeared = sm.func->GetRandom();
+      Smeared = ThrowFunction(sm.func, GetRandom());
     } else {
-      double sThrow = rand.Gaus(
+      double sThrow = GetRandom()->Gaus(
           0, sm.width *
                  ((sm.type == GaussianSmearer::kAbsolute) ? 1.0 : kineProp));
       Smeared = kineProp + sThrow;
@@ -359,8 +386,29 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
 #endif
 }
 
+bool GaussianSmearer::IsThreadSafe() {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 24, 0)
+  return true;
+#else
+  // Function smears are thrown with gRandom, see ThrowFunction
+  for (size_t t_it = 0; t_it < TrackedGausSmears.size(); ++t_it) {
+    for (size_t sm_it = 0; sm_it < TrackedGausSmears[t_it].size(); ++sm_it) {
+      if (TrackedGausSmears[t_it][sm_it].type == kFunction) {
+        return false;
+      }
+    }
+  }
+  for (size_t sm_it = 0; sm_it < VisGausSmears.size(); ++sm_it) {
+    if (VisGausSmears[sm_it].type == kFunction) {
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
 RecoInfo *GaussianSmearer::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+  RecoInfo *ri = GetRecoInfoBuffer();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
@@ -377,14 +425,15 @@ RecoInfo *GaussianSmearer::Smearcept(FitEvent *fe) {
 
 void GaussianSmearer::SmearceptOneParticle(TVector3 &RecObjMom,
                                            int RecObjClass) {
-  if (!TrackedGausSmears.count(RecObjClass)) {
+  int slot = TrackedSlots.Find(RecObjClass);
+  if (slot == -1) {
     return;
   }
   TVector3 ThreeMom = RecObjMom;
   TVector3 OriginalKP = ThreeMom;
-  for (size_t sm_it = 0; sm_it < TrackedGausSmears[RecObjClass].size();
-       ++sm_it) {
-    GSmear &sm = TrackedGausSmears[RecObjClass][sm_it];
+  std::vector<GSmear> &smears = TrackedGausSmears[slot];
+  for (size_t sm_it = 0; sm_it < smears.size(); ++sm_it) {
+    GSmear &sm = smears[sm_it];
 
     double kineProp = 0;
 
@@ -415,9 +464,9 @@ void GaussianSmearer::SmearceptOneParticle(TVector3 &RecObjMom,
     while (!ok) {
       if (sm.type == GaussianSmearer::kFunction) {
         sm.func->SetParameter(0, kineProp);
-        Smeared = sm.func->GetRandom();
+        Smeared = ThrowFunction(sm.func, GetRandom());
       } else {
-        double sThrow = rand.Gaus(
+        double sThrow = GetRandom()->Gaus(
             0, sm.width *
                    ((sm.type == GaussianSmearer::kAbsolute) ? 1.0 : kineProp));
         Smeared = kineProp + sThrow;
@@ -487,18 +536,19 @@ void GaussianSmearer::SmearceptOneParticle(TVector3 &RecObjMom,
 
 void GaussianSmearer::SmearceptOneParticle(double &RecVisibleEnergy,
                                            int TrueContribPDG) {
-  if (!VisGausSmears.count(TrueContribPDG)) {
+  int slot = VisSlots.Find(TrueContribPDG);
+  if (slot == -1) {
     return;
   }
-  GSmear &sm = VisGausSmears[TrueContribPDG];
+  GSmear &sm = VisGausSmears[slot];
   double kineProp = RecVisibleEnergy;
 
   double Smeared;
   if (sm.type == GaussianSmearer::kFunction) {
     sm.func->SetParameter(0, kineProp);
-    Smeared = sm.func->GetRandom();
+    Smeared = ThrowFunction(sm.func, GetRandom());
   } else {
-    double sThrow = rand.Gaus(
+    double sThrow = GetRandom()->Gaus(
         0,
         sm.width * ((sm.type == GaussianSmearer::kAbsolute) ? 1.0 : kineProp));
     Smeared = kineProp + sThrow;
@@ -39,8 +39,10 @@ class GaussianSmearer : public ISmearcepter {
     TF1 *func;
   };
 
-  std::map<int, std::vector<GSmear> > TrackedGausSmears;
-  std::map<int, GSmear> VisGausSmears;
+  std::vector<std::vector<GSmear> > TrackedGausSmears;
+  PDGSlotTable TrackedSlots;
+  std::vector<GSmear> VisGausSmears;
+  PDGSlotTable VisSlots;
 
   TRandom3 rand;
 
@@ -48,6 +50,7 @@ class GaussianSmearer : public ISmearcepter {
 
  public:
   RecoInfo *Smearcept(FitEvent *);
+  bool IsThreadSafe();
 
   void SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
 #ifdef DEBUG_GAUSSSMEAR
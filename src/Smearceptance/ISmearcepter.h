@@ -23,8 +23,10 @@
 #include "FitEvent.h"
 #include "NuisKey.h"
 
+#include "TRandom.h"
 #include "TVector3.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -50,6 +52,47 @@ struct RecoInfo {
   std::vector<int> TrueContribPDGs;
 
   double Weight;
+
+  /// Empty the reconstructed objects but keep the allocated storage, so one
+  /// RecoInfo can be reused from event to event.
+  void Reset() {
+    RecObjMom.clear();
+    RecObjClass.clear();
+    RecVisibleEnergy.clear();
+    TrueContribPDGs.clear();
+    Weight = 1;
+  }
+};
+
+/// Lookup from PDG code to a slot in a smearcepter's per-particle tables.
+/// Codes with |PDG| < kDenseRange are a single array access, larger ones
+/// (nuclei) fall back to a std::map.
+class PDGSlotTable {
+ public:
+  PDGSlotTable() : Dense(2 * kDenseRange + 1, -1) {}
+
+  /// Slot for the PDG code, or -1 if it has none.
+  int Find(int pdg) const {
+    if ((pdg > -kDenseRange) && (pdg < kDenseRange)) {
+      return Dense[pdg + kDenseRange];
+    }
+    std::map<int, int>::const_iterator it = Sparse.find(pdg);
+    return (it == Sparse.end()) ? -1 : it->second;
+  }
+  bool Has(int pdg) const { return Find(pdg) != -1; }
+
+  void Set(int pdg, int slot) {
+    if ((pdg > -kDenseRange) && (pdg < kDenseRange)) {
+      Dense[pdg + kDenseRange] = slot;
+    } else {
+      Sparse[pdg] = slot;
+    }
+  }
+
+ private:
+  static const int kDenseRange = 4096;
+  std::vector<int> Dense;
+  std::map<int, int> Sparse;
 };
 
 class ISmearcepter {
@@ -57,13 +100,40 @@ class ISmearcepter {
   std::string ElementName;
   std::string InstanceName;
 
+  /// Reset and return this smearcepter's reusable RecoInfo.
+  RecoInfo *GetRecoInfoBuffer() {
+    RecoBuffer.Reset();
+    return &RecoBuffer;
+  }
+
+  /// Generator that all throws should be drawn from, gRandom unless one has
+  /// been set with SetRandom.
+  TRandom *GetRandom() { return Rand ? Rand : gRandom; }
+
+ private:
+  RecoInfo RecoBuffer;
+  TRandom *Rand;
+
  public:
+  ISmearcepter() : Rand(NULL) {}
+  virtual ~ISmearcepter() {}
+
   void Setup(nuiskey &);
   virtual void SpecifcSetup(nuiskey &) = 0;
 
   std::string GetName() { return InstanceName; }
   std::string GetElementName() { return ElementName; }
 
+  /// Draw all throws from rand rather than gRandom. The generator is not
+  /// owned, smearcepters that wrap others should pass it on.
+  virtual void SetRandom(TRandom *rand) { Rand = rand; }
+
+  /// False if separate instances can't smear at the same time, e.g. because
+  /// some throws still go through gRandom.
+  virtual bool IsThreadSafe() { return true; }
+
+  /// The returned RecoInfo is owned by the smearcepter and is overwritten by
+  /// the next call, callers should not delete it.
   virtual RecoInfo *Smearcept(FitEvent *) = 0;
   /// Helper method for using this class as a component in a more complex
   /// smearer
@@ -58,10 +58,26 @@ void MetaSimpleSmearcepter::SpecifcSetup(nuiskey &nk) {
   }
   NSmearcepters = Smearcepters.size();
 }
+void MetaSimpleSmearcepter::SetRandom(TRandom *rand) {
+  ISmearcepter::SetRandom(rand);
+  for (size_t sm_it = 0; sm_it < NSmearcepters; ++sm_it) {
+    Smearcepters[sm_it]->SetRandom(rand);
+  }
+}
+bool MetaSimpleSmearcepter::IsThreadSafe() {
+  for (size_t sm_it = 0; sm_it < NSmearcepters; ++sm_it) {
+    if (!Smearcepters[sm_it]->IsThreadSafe()) {
+      return false;
+    }
+  }
+  return true;
+}
 RecoInfo *MetaSimpleSmearcepter::Smearcept(FitEvent *fe) {
   if (ES) {
     ES->DoTheShuffle(fe);
   }
+  // The first smearcepter's buffer is smeared in place by the rest of the
+  // chain, so nothing is allocated per event.
   RecoInfo *ri = NULL;
   for (size_t sm_it = 0; sm_it < NSmearcepters; ++sm_it) {
     if (!sm_it) {
@@ -37,7 +37,10 @@ class MetaSimpleSmearcepter : public ISmearcepter {
   void SpecifcSetup(nuiskey &);
 
  public:
+  MetaSimpleSmearcepter() : NSmearcepters(0), ES(NULL) {}
   RecoInfo *Smearcept(FitEvent *);
+  void SetRandom(TRandom *);
+  bool IsThreadSafe();
 };
 
 #endif
@@ -0,0 +1,105 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SmearDriver.h"
+
+#include "Smearcepterton.h"
+
+#include "TDirectory.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+SmearDriver::SmearDriver(std::string const &smearcepter, int nthreads,
+                         ULong64_t seed) {
+  if (nthreads < 1) {
+    nthreads = 1;
+  }
+
+  Smearcepters.push_back(
+      &Smearcepterton::Get().GetSmearcepter(smearcepter));
+  if (nthreads > 1 && !Smearcepters[0]->IsThreadSafe()) {
+    NUIS_ERR(WRN, "Smearcepter " << smearcepter
+                                 << " isn't thread safe (Function smears "
+                                    "need ROOT 6.24), smearing on 1 thread.");
+    nthreads = 1;
+  }
+  if (nthreads > 1) {
+    ROOT::EnableThreadSafety();
+  }
+  for (int t = 1; t < nthreads; ++t) {
+    Smearcepters.push_back(
+        Smearcepterton::Get().CreateSmearcepter(smearcepter));
+  }
+  for (int t = 0; t < nthreads; ++t) {
+    Randoms.push_back(new CounterRandom(seed));
+    Smearcepters[t]->SetRandom(Randoms[t]);
+  }
+
+  NUIS_LOG(SAM, "Smearing with " << smearcepter << " on " << nthreads
+                                 << " thread(s), seed " << seed);
+}
+
+SmearDriver::~SmearDriver() {
+  // Leave the shared instance as it was found
+  Smearcepters[0]->SetRandom(NULL);
+  for (size_t t = 0; t < Smearcepters.size(); ++t) {
+    if (t) {
+      delete Smearcepters[t];
+    }
+    delete Randoms[t];
+  }
+}
+
+RecoInfo *SmearDriver::Smearcept(FitEvent *ev, ULong64_t index) {
+  Randoms[0]->SetStream(index);
+  return Smearcepters[0]->Smearcept(ev);
+}
+
+void SmearDriver::SmearBatch(std::vector<FitEvent *> const &events,
+                             size_t nevents, ULong64_t firstindex) {
+  if (Results.size() < nevents) {
+    Results.resize(nevents);
+  }
+
+  size_t nthreads = std::min(Smearcepters.size(), nevents);
+  if (nthreads < 2) {
+    for (size_t j = 0; j < nevents; ++j) {
+      Results[j] = *Smearcept(events[j], firstindex + j);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < nthreads; ++t) {
+    workers.push_back(std::thread([&, t]() {
+      TDirectory::TContext context(NULL);
+      for (size_t j = next++; j < nevents; j = next++) {
+        Randoms[t]->SetStream(firstindex + j);
+        Results[j] = *Smearcepters[t]->Smearcept(events[j]);
+      }
+    }));
+  }
+  for (size_t t = 0; t < workers.size(); ++t) {
+    workers[t].join();
+  }
+}
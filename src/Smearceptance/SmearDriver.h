@@ -0,0 +1,57 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#ifndef SMEARDRIVER_HXX_SEEN
+#define SMEARDRIVER_HXX_SEEN
+
+#include "CounterRandom.h"
+#include "ISmearcepter.h"
+
+#include <string>
+#include <vector>
+
+/// Runs a named smearcepter over events on one or more threads. Every event
+/// is smeared with its own CounterRandom stream keyed by (seed, event index),
+/// so the smeared output does not depend on the number of threads or on which
+/// thread handles an event.
+class SmearDriver {
+  /// One smearcepter and generator per thread. The first smearcepter is the
+  /// shared Smearcepterton instance, the rest are owned.
+  std::vector<ISmearcepter *> Smearcepters;
+  std::vector<CounterRandom *> Randoms;
+  std::vector<RecoInfo> Results;
+
+ public:
+  SmearDriver(std::string const &smearcepter, int nthreads, ULong64_t seed);
+  ~SmearDriver();
+
+  int GetNThreads() const { return int(Smearcepters.size()); }
+
+  /// Smear one event on the calling thread. The result is owned by the
+  /// smearcepter, as for ISmearcepter::Smearcept.
+  RecoInfo *Smearcept(FitEvent *, ULong64_t index);
+
+  /// Smear events[i] with the stream for event firstindex + i, sharing the
+  /// events out between the threads. Results are kept until the next batch.
+  void SmearBatch(std::vector<FitEvent *> const &events, size_t nevents,
+                  ULong64_t firstindex);
+  RecoInfo const &GetResult(size_t i) const { return Results[i]; }
+};
+
+#endif
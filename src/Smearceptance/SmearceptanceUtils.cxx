@@ -20,9 +20,90 @@
 #include "SmearceptanceUtils.h"
 
 #include "TDecompSVD.h"
+#include "TMatrixDUtils.h"
 
 #include "FitLogger.h"
 
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+/// Inverses already computed, keyed on a hash of the matrix contents and the
+/// truncation. Matrices are compared in full on lookup so a hash collision
+/// can only cost a recomputation.
+struct CachedInverse {
+  TMatrixD Mapping;
+  int NToTruncate;
+  std::shared_ptr<const TMatrixD> Inverse;
+};
+std::multimap<ULong64_t, CachedInverse> InverseCache;
+std::mutex InverseCacheMutex;
+size_t const kMaxCachedInverses = 64;
+
+ULong64_t HashMatrix(TMatrixD const &mat, int NToTruncate) {
+  ULong64_t h = 0xCBF29CE484222325ULL;
+  h = (h ^ ULong64_t(mat.GetNrows())) * 0x100000001B3ULL;
+  h = (h ^ ULong64_t(mat.GetNcols())) * 0x100000001B3ULL;
+  h = (h ^ ULong64_t(NToTruncate)) * 0x100000001B3ULL;
+  Double_t const *el = mat.GetMatrixArray();
+  for (Int_t i = 0; i < mat.GetNoElements(); ++i) {
+    ULong64_t bits;
+    std::memcpy(&bits, &el[i], sizeof(bits));
+    h = (h ^ bits) * 0x100000001B3ULL;
+  }
+  return h;
+}
+
+bool SameMatrix(TMatrixD const &a, TMatrixD const &b) {
+  return (a.GetNrows() == b.GetNrows()) && (a.GetNcols() == b.GetNcols()) &&
+         !std::memcmp(a.GetMatrixArray(), b.GetMatrixArray(),
+                      a.GetNoElements() * sizeof(Double_t));
+}
+
+TMatrixD ComputeSVDInverse(TMatrixD const &mat, int NToTruncate) {
+  if (mat.GetNcols() > mat.GetNrows()) {
+    NUIS_ABORT("Trying to invert a " << mat.GetNrows() << "x" << mat.GetNcols()
+                                << " matrix.");
+  }
+
+  TDecompSVD svd(mat);
+  svd.Decompose();
+
+  if (NToTruncate) {
+    TVectorD Sig(svd.GetSig());
+    TMatrixD U(svd.GetU());
+    TMatrixD V(svd.GetV());
+    if (svd.GetV().TestBit(TMatrixD::kTransposed)) {
+      NUIS_ABORT("ARGHH");
+    }
+    TMatrixD V_T = V.Transpose(V);
+
+    TMatrixD Sig_TruncM(U.GetNrows(), V.GetNrows());
+    for (Int_t i = 0; i < U.GetNrows(); ++i) {
+      for (Int_t j = 0; j < V.GetNrows(); ++j) {
+        Sig_TruncM[i][j] =
+            ((i != j) || (i >= (Sig.GetNrows() - NToTruncate))) ? 0 : Sig[i];
+      }
+    }
+
+    TMatrixD Trunc = U * Sig_TruncM * V_T;
+
+    svd.~TDecompSVD();
+    new (&svd) TDecompSVD(Trunc);
+  }
+
+  TMatrixD inv = svd.Invert();
+  Int_t mid = mat.GetNcols() / 2;
+  if (fabs(inv[mid][mid] - mat[mid][mid]) <
+      std::numeric_limits<double>::epsilon()) {
+    NUIS_ABORT("Failed to SVD invert matrix.");
+  }
+  return inv;
+}
+} // namespace
+
 namespace SmearceptanceUtils {
 
 double Smear1DProp(TH2D *mapping, double TrueProp, TRandom3 *rnjesus) {
@@ -68,59 +149,57 @@ TVectorD SVDInverseSolve(TH1D *inp, TH2D *mapping) {
 }
 
 TH2D *SVDGetInverse(TH2D *mapping, int NToTruncate) {
-  TMatrixD mat = GetMatrix(mapping);
-
-  if (mat.GetNcols() > mat.GetNrows()) {
-    NUIS_ABORT("Trying to invert a " << mat.GetNrows() << "x" << mat.GetNcols()
-                                << " matrix.");
-  }
+  std::shared_ptr<const TMatrixD> inv =
+      SVDGetInverseMatrix(mapping, NToTruncate);
 
   TH2D *inverse = dynamic_cast<TH2D *>(mapping->Clone());
   inverse->SetName("inverse");
   inverse->Reset();
 
-  TDecompSVD svd(mat);
-  svd.Decompose();
-
-  if (NToTruncate) {
-    TVectorD Sig(svd.GetSig());
-    TMatrixD U(svd.GetU());
-    TMatrixD V(svd.GetV());
-    if (svd.GetV().TestBit(TMatrixD::kTransposed)) {
-      NUIS_ABORT("ARGHH");
+  for (Int_t xb_it = 0; xb_it < inverse->GetXaxis()->GetNbins(); ++xb_it) {
+    for (Int_t yb_it = 0; yb_it < inverse->GetYaxis()->GetNbins(); ++yb_it) {
+      inverse->SetBinContent(xb_it + 1, yb_it + 1, (*inv)[yb_it][xb_it]);
     }
-    TMatrixD V_T = V.Transpose(V);
+  }
 
-    TMatrixD Sig_TruncM(U.GetNrows(), V.GetNrows());
-    for (Int_t i = 0; i < U.GetNrows(); ++i) {
-      for (Int_t j = 0; j < V.GetNrows(); ++j) {
-        Sig_TruncM[i][j] =
-            ((i != j) || (i >= (Sig.GetNrows() - NToTruncate))) ? 0 : Sig[i];
-      }
-    }
+  return inverse;
+}
 
-    TMatrixD Trunc = U * Sig_TruncM * V_T;
+std::shared_ptr<const TMatrixD> SVDGetInverseMatrix(TH2D *mapping,
+                                                    int NToTruncate) {
+  TMatrixD mat = GetMatrix(mapping);
+  ULong64_t key = HashMatrix(mat, NToTruncate);
 
-    svd.~TDecompSVD();
-    new (&svd) TDecompSVD(Trunc);
-  }
+  std::lock_guard<std::mutex> lock(InverseCacheMutex);
 
-  TMatrixD inv = svd.Invert();
-  if (fabs(inv[mapping->GetXaxis()->GetNbins() / 2]
-              [mapping->GetXaxis()->GetNbins() / 2] -
-           mat[mapping->GetXaxis()->GetNbins() / 2]
-              [mapping->GetXaxis()->GetNbins() / 2]) <
-      std::numeric_limits<double>::epsilon()) {
-    NUIS_ABORT("Failed to SVD invert matrix.");
+  typedef std::multimap<ULong64_t, CachedInverse>::iterator CacheIt;
+  std::pair<CacheIt, CacheIt> range = InverseCache.equal_range(key);
+  for (CacheIt it = range.first; it != range.second; ++it) {
+    if ((it->second.NToTruncate == NToTruncate) &&
+        SameMatrix(it->second.Mapping, mat)) {
+      return it->second.Inverse;
+    }
   }
 
-  for (Int_t xb_it = 0; xb_it < inverse->GetXaxis()->GetNbins(); ++xb_it) {
-    for (Int_t yb_it = 0; yb_it < inverse->GetYaxis()->GetNbins(); ++yb_it) {
-      inverse->SetBinContent(xb_it + 1, yb_it + 1, inv[yb_it][xb_it]);
-    }
+  if (InverseCache.size() >= kMaxCachedInverses) {
+    NUIS_LOG(SAM, "Clearing " << InverseCache.size()
+                              << " cached SVD inverses.");
+    InverseCache.clear();
   }
 
-  return inverse;
+  CachedInverse &entry =
+      InverseCache.insert(std::make_pair(key, CachedInverse()))->second;
+  entry.NToTruncate = NToTruncate;
+  entry.Mapping.ResizeTo(mat);
+  entry.Mapping = mat;
+  entry.Inverse =
+      std::make_shared<const TMatrixD>(ComputeSVDInverse(mat, NToTruncate));
+  return entry.Inverse;
+}
+
+void ClearSVDInverseCache() {
+  std::lock_guard<std::mutex> lock(InverseCacheMutex);
+  InverseCache.clear();
 }
 
 void GetSVDDecomp(TH2D *mapping, TVectorD &Sig, TMatrixD &U, TMatrixD &V) {
@@ -228,30 +307,32 @@ void PushTH1ThroughMatrixWithErrors(TH1D *inp, TH1D *oup, TMatrixD &response,
 
   oup->Reset();
 
-  TVectorD Mean(oup->GetXaxis()->GetNbins());
-  TVectorD RMS(oup->GetXaxis()->GetNbins());
-  std::vector<TVectorD> Toys;
-  Toys.reserve(NToys);
+  Int_t NBins = oup->GetXaxis()->GetNbins();
+  TVectorD Mean(NBins);
+  TVectorD RMS(NBins);
   double NToysFact = 1.0 / double(NToys);
 
+  // One toy per column, thrown in the same order as before so that the
+  // random sequence is unchanged.
+  TMatrixD Toys(inp->GetXaxis()->GetNbins(), NToys);
   for (size_t t_it = 0; t_it < NToys; ++t_it) {
-    TVectorD Toy = ThrowVectFromHist(inp, &rnjesus, allowNeg);
-    TVectorD UnfoldToy = response * Toy;
-
-    for (Int_t bi_it = 0; bi_it < oup->GetXaxis()->GetNbins(); ++bi_it) {
-      Mean[bi_it] += UnfoldToy[bi_it] * NToysFact;
-    }
-    Toys.push_back(UnfoldToy);
+    TMatrixDColumn(Toys, t_it) = ThrowVectFromHist(inp, &rnjesus, allowNeg);
   }
 
-  for (size_t t_it = 0; t_it < NToys; ++t_it) {
-    for (Int_t bi_it = 0; bi_it < oup->GetXaxis()->GetNbins(); ++bi_it) {
-      RMS[bi_it] += (Mean[bi_it] - Toys[t_it][bi_it]) *
-                    (Mean[bi_it] - Toys[t_it][bi_it]) * NToysFact;
+  TMatrixD UnfoldToys(response, TMatrixD::kMult, Toys);
+
+  for (Int_t bi_it = 0; bi_it < NBins; ++bi_it) {
+    TMatrixDRow_const UnfoldBin(UnfoldToys, bi_it);
+    for (size_t t_it = 0; t_it < NToys; ++t_it) {
+      Mean[bi_it] += UnfoldBin[t_it] * NToysFact;
+    }
+    for (size_t t_it = 0; t_it < NToys; ++t_it) {
+      RMS[bi_it] += (Mean[bi_it] - UnfoldBin[t_it]) *
+                    (Mean[bi_it] - UnfoldBin[t_it]) * NToysFact;
     }
   }
 
-  for (Int_t bi_it = 0; bi_it < oup->GetXaxis()->GetNbins(); ++bi_it) {
+  for (Int_t bi_it = 0; bi_it < NBins; ++bi_it) {
     oup->SetBinContent(bi_it + 1, Mean[bi_it]);
     oup->SetBinError(bi_it + 1, sqrt(RMS[bi_it]));
   }
@@ -22,6 +22,8 @@
 #include "TRandom3.h"
 #include "TVectorD.h"
 
+#include <memory>
+
 namespace SmearceptanceUtils {
 
 double Smear1DProp(TH2D *, double TrueProp, TRandom3 *rand = NULL);
@@ -30,6 +32,15 @@ TVectorD SVDInverseSolve(TVectorD *inp, TMatrixD *mapping);
 TVectorD SVDInverseSolve(TH1D *inp, TMatrixD *mapping);
 TVectorD SVDInverseSolve(TH1D *inp, TH2D *mapping);
 TH2D *SVDGetInverse(TH2D *mapping, int NToTruncate=0);
+/// Inverse of GetMatrix(mapping) with the NToTruncate smallest singular values
+/// removed, the same matrix as GetMatrix(SVDGetInverse(mapping, NToTruncate)).
+/// Inverses are cached on the mapping contents and truncation, so repeated
+/// unfoldings with the same response are only decomposed once. The shared
+/// pointer keeps the inverse alive if the cache is cleared.
+std::shared_ptr<const TMatrixD> SVDGetInverseMatrix(TH2D *mapping,
+                                                    int NToTruncate = 0);
+/// Drop all cached inverses.
+void ClearSVDInverseCache();
 void GetSVDDecomp(TH2D *mapping, TVectorD &Sig, TMatrixD &U, TMatrixD &V);
 
 TVectorD GetVector(TH1D *inp);
@@ -39,6 +50,8 @@ TH1D *GetTH1FromVector(TVectorD const &inp, TH1D *templ = NULL);
 TH2D *GetTH2FromMatrix(TMatrixD const &inp, TH2D *templ = NULL);
 
 TVectorD ThrowVectFromHist(TH1D *inp, TRandom3 *rnjesus, bool allowNeg);
+/// Mean and RMS of response * toy over NToys throws of inp. The toys are
+/// pushed through the response as one matrix-matrix product.
 void PushTH1ThroughMatrixWithErrors(TH1D *inp, TH1D *oup, TMatrixD &response,
                                     size_t NToys, bool allowNeg);
 
@@ -292,15 +292,13 @@ Smearcepterton::Smearcepterton() { InitialiserSmearcepters(); }
 void Smearcepterton::InitialiserSmearcepters() {
   // hard coded list of tag name -> smearcepter factories, add here to add your
   // own.
-  std::map<std::string, SmearceptionFactory_fcn> factories;
-
-  factories["ThresholdAccepter"] = &BuildSmearcepter<ThresholdAccepter>;
-  factories["EfficiencyApplicator"] = &BuildSmearcepter<EfficiencyApplicator>;
-  factories["GaussianSmearer"] = &BuildSmearcepter<GaussianSmearer>;
-  factories["TrackedMomentumMatrixSmearer"] =
+  Factories["ThresholdAccepter"] = &BuildSmearcepter<ThresholdAccepter>;
+  Factories["EfficiencyApplicator"] = &BuildSmearcepter<EfficiencyApplicator>;
+  Factories["GaussianSmearer"] = &BuildSmearcepter<GaussianSmearer>;
+  Factories["TrackedMomentumMatrixSmearer"] =
       &BuildSmearcepter<TrackedMomentumMatrixSmearer>;
-  factories["VisECoalescer"] = &BuildSmearcepter<VisECoalescer>;
-  factories["MetaSimpleSmearcepter"] = &BuildSmearcepter<MetaSimpleSmearcepter>;
+  Factories["VisECoalescer"] = &BuildSmearcepter<VisECoalescer>;
+  Factories["MetaSimpleSmearcepter"] = &BuildSmearcepter<MetaSimpleSmearcepter>;
 
   Config::Get().PrintXML(NULL);
 
@@ -316,30 +314,13 @@ void Smearcepterton::InitialiserSmearcepters() {
     std::vector<nuiskey> smearcepters =
         smearcepterBlocks[smearB_it].GetListOfChildNodes();
     for (size_t smear_it = 0; smear_it < smearcepters.size(); ++smear_it) {
-      std::string const &smearType = smearcepters[smear_it].GetElementName();
-
-      ISmearcepter *smearer = NULL;
-      if (DynamicSmearceptorFactory::Get().HasSmearceptor(smearType)) {
-        smearer = DynamicSmearceptorFactory::Get().CreateSmearceptor(
-            smearcepters[smear_it]);
-      } else {
-        if (!factories.count(smearType)) {
-          NUIS_ERR(WRN, "No known smearer accepts elements named: \""
-                            << smearType << "\"");
-          continue;
-        }
-        smearer = factories[smearType](smearcepters[smear_it]);
-      }
-
+      ISmearcepter *smearer = BuildFromKey(smearcepters[smear_it]);
       if (!smearer) {
-        NUIS_ABORT("Failed to load smearceptor.");
-      }
-      if (!smearer->GetName().length()) {
-        NUIS_ABORT("Smearcepter type " << smearer->GetElementName()
-                                       << " had no instance name.");
+        continue;
       }
 
       Smearcepters[smearer->GetName()] = smearer;
+      SmearcepterKeys[smearer->GetName()] = smearcepters[smear_it];
 
       NUIS_LOG(FIT, "Configured smearer named: " << smearer->GetName()
                                                  << " of type: "
@@ -347,3 +328,34 @@ void Smearcepterton::InitialiserSmearcepters() {
     }
   }
 }
+
+ISmearcepter *Smearcepterton::BuildFromKey(nuiskey &nk) {
+  std::string const &smearType = nk.GetElementName();
+
+  ISmearcepter *smearer = NULL;
+  if (DynamicSmearceptorFactory::Get().HasSmearceptor(smearType)) {
+    smearer = DynamicSmearceptorFactory::Get().CreateSmearceptor(nk);
+  } else {
+    if (!Factories.count(smearType)) {
+      NUIS_ERR(WRN, "No known smearer accepts elements named: \""
+                        << smearType << "\"");
+      return NULL;
+    }
+    smearer = Factories[smearType](nk);
+  }
+
+  if (!smearer) {
+    NUIS_ABORT("Failed to load smearceptor.");
+  }
+  if (!smearer->GetName().length()) {
+    NUIS_ABORT("Smearcepter type " << smearer->GetElementName()
+                                   << " had no instance name.");
+  }
+  return smearer;
+}
+
+ISmearcepter *Smearcepterton::CreateSmearcepter(std::string const &name) {
+  // Aborts with the list of known smearcepters if name is unknown
+  GetSmearcepter(name);
+  return BuildFromKey(SmearcepterKeys[name]);
+}
@@ -83,10 +83,14 @@ class Smearcepterton {
   Smearcepterton();
 
   void InitialiserSmearcepters();
+  ISmearcepter *BuildFromKey(nuiskey &);
 
   static Smearcepterton *_inst;
 
+  std::map<std::string, SmearceptionFactory_fcn> Factories;
   std::map<std::string, ISmearcepter *> Smearcepters;
+  /// Configuration each named smearcepter was built from.
+  std::map<std::string, nuiskey> SmearcepterKeys;
 
  public:
   static Smearcepterton &Get();
@@ -103,6 +107,10 @@ class Smearcepterton {
     }
     return *Smearcepters[name];
   }
+
+  /// Builds a new, independent instance of a named smearcepter from the same
+  /// configuration, e.g. for each smearing thread. The caller owns it.
+  ISmearcepter *CreateSmearcepter(std::string const &name);
 };
 
 #endif
@@ -77,7 +77,7 @@ double GetKineThreshold(nuiskey &nk, ThresholdAccepter::KineVar kv) {
   }
 }
 
-double GetKineVal(FitParticle *fp, ThresholdAccepter::Thresh &rt) {
+double GetKineVal(FitParticle *fp, ThresholdAccepter::Thresh const &rt) {
   switch (rt.ThresholdType) {
     case ThresholdAccepter::kMomentum:
       return fp->P3().Mag();
@@ -96,7 +96,7 @@ double GetKineVal(FitParticle *fp, ThresholdAccepter::Thresh &rt) {
   }
 }
 
-bool PassesThreshold(FitParticle *fp, ThresholdAccepter::Thresh &rt) {
+bool PassesThreshold(FitParticle *fp, ThresholdAccepter::Thresh const &rt) {
   switch (rt.ThresholdType) {
     case ThresholdAccepter::kMomentum:
       return (fp->P3().Mag() > rt.ThresholdVal);
@@ -140,13 +140,18 @@ void ThresholdAccepter::SpecifcSetup(nuiskey &nk) {
       t.ThresholdVal =
           GetKineThreshold(recoThresholdDescriptors[t_it], t.ThresholdType);
 
-      ReconThresholds[pdgs_i[pdg_it]].push_back(t);
+      int slot = ReconSlots.Find(pdgs_i[pdg_it]);
+      if (slot == -1) {
+        slot = ReconThresholds.size();
+        ReconThresholds.push_back(std::vector<Thresh>());
+        ReconSlots.Set(pdgs_i[pdg_it], slot);
+      }
+      ReconThresholds[slot].push_back(t);
 
       NUIS_LOG(FIT, "Added reconstruction threshold of type: "
-                    << ReconThresholds[pdgs_i[pdg_it]].back().ThresholdVal
-                    << " "
+                    << ReconThresholds[slot].back().ThresholdVal << " "
                     << GetKineTypeName(
-                           ReconThresholds[pdgs_i[pdg_it]].back().ThresholdType)
+                           ReconThresholds[slot].back().ThresholdType)
                     << ", for PDG: " << pdgs_i[pdg_it]);
     }
   }
@@ -159,7 +164,7 @@ void ThresholdAccepter::SpecifcSetup(nuiskey &nk) {
     std::vector<int> pdgs_i = GeneralUtils::ParseToInt(pdgs_s, ",");
 
     for (size_t pdg_it = 0; pdg_it < pdgs_i.size(); ++pdg_it) {
-      if (VisThresholds.count(pdgs_i[pdg_it])) {
+      if (VisSlots.Has(pdgs_i[pdg_it])) {
         NUIS_ERR(WRN, "Smearceptor " << ElementName << ":" << InstanceName
                                   << " already has a threshold for PDG: "
                                   << pdgs_i[pdg_it]);
@@ -189,15 +194,22 @@ void ThresholdAccepter::SpecifcSetup(nuiskey &nk) {
         continue;
       }
 
-      VisThresholds[pdgs_i[pdg_it]] = vt;
+      int slot = VisSlots.Find(pdgs_i[pdg_it]);
+      if (slot == -1) {
+        slot = VisThresholds.size();
+        VisThresholds.push_back(vt);
+        VisSlots.Set(pdgs_i[pdg_it], slot);
+      } else {
+        VisThresholds[slot] = vt;
+      }
 
       NUIS_LOG(FIT,
            "Added visibility threshold of MeV "
-               << VisThresholds[pdgs_i[pdg_it]].ThresholdVal << " "
-               << GetKineTypeName(VisThresholds[pdgs_i[pdg_it]].ThresholdType)
+               << VisThresholds[slot].ThresholdVal << " "
+               << GetKineTypeName(VisThresholds[slot].ThresholdType)
                << ", for PDG: " << pdgs_i[pdg_it]
                << ". If visible, particle deposits: "
-               << (VisThresholds[pdgs_i[pdg_it]].UseKE ? "KE" : "TE"));
+               << (VisThresholds[slot].UseKE ? "KE" : "TE"));
     }
   }
 }
@@ -222,8 +234,9 @@ void ThresholdAccepter::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
     return;
   }
 
-  if ((ReconThresholds.count(fp->PDG()) + VisThresholds.count(fp->PDG())) ==
-      0) {
+  int reconslot = ReconSlots.Find(fp->PDG());
+  int visslot = VisSlots.Find(fp->PDG());
+  if ((reconslot == -1) && (visslot == -1)) {
 #ifdef DEBUG_THRESACCEPT
     std::cout << " -- Undetectable." << std::flush;
 #endif
@@ -231,35 +244,31 @@ void ThresholdAccepter::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
   }
 
   // If no reco thresholds it should fall through to EVis
-  bool Passes = ReconThresholds[fp->PDG()].size();
-  bool FailEnergyThresh = !ReconThresholds[fp->PDG()].size();
-  for (size_t rt_it = 0; rt_it < ReconThresholds[fp->PDG()].size(); ++rt_it) {
-    bool Passed = PassesThreshold(fp, ReconThresholds[fp->PDG()][rt_it]);
+  static std::vector<Thresh> const NoThresholds;
+  std::vector<Thresh> const &thresholds =
+      (reconslot == -1) ? NoThresholds : ReconThresholds[reconslot];
+
+  bool Passes = thresholds.size();
+  bool FailEnergyThresh = !thresholds.size();
+  for (size_t rt_it = 0; rt_it < thresholds.size(); ++rt_it) {
+    bool Passed = PassesThreshold(fp, thresholds[rt_it]);
     if (!Passed) {
 #ifdef DEBUG_THRESACCEPT
       std::cout << "\n\t -- Rejected. ("
-                << GetKineTypeName(
-                       ReconThresholds[fp->PDG()][rt_it].ThresholdType)
-                << " Threshold: "
-                << ReconThresholds[fp->PDG()][rt_it].ThresholdVal << " | "
-                << GetKineVal(fp, ReconThresholds[fp->PDG()][rt_it]) << ")"
-                << std::flush;
+                << GetKineTypeName(thresholds[rt_it].ThresholdType)
+                << " Threshold: " << thresholds[rt_it].ThresholdVal << " | "
+                << GetKineVal(fp, thresholds[rt_it]) << ")" << std::flush;
 #endif
-      if ((ReconThresholds[fp->PDG()][rt_it].ThresholdType ==
-           ThresholdAccepter::kMomentum) ||
-          (ReconThresholds[fp->PDG()][rt_it].ThresholdType ==
-           ThresholdAccepter::kKE)) {
+      if ((thresholds[rt_it].ThresholdType == ThresholdAccepter::kMomentum) ||
+          (thresholds[rt_it].ThresholdType == ThresholdAccepter::kKE)) {
         FailEnergyThresh = true;
       }
     } else {
 #ifdef DEBUG_THRESACCEPT
       std::cout << "\n\t -- Accepted. ("
-                << GetKineTypeName(
-                       ReconThresholds[fp->PDG()][rt_it].ThresholdType)
-                << " Threshold: "
-                << ReconThresholds[fp->PDG()][rt_it].ThresholdVal << " | "
-                << GetKineVal(fp, ReconThresholds[fp->PDG()][rt_it]) << ")"
-                << std::flush;
+                << GetKineTypeName(thresholds[rt_it].ThresholdType)
+                << " Threshold: " << thresholds[rt_it].ThresholdVal << " | "
+                << GetKineVal(fp, thresholds[rt_it]) << ")" << std::flush;
 #endif
     }
     Passes = Passes && Passed;
@@ -277,42 +286,43 @@ void ThresholdAccepter::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
 #ifdef DEBUG_THRESACCEPT
     std::cout << " -- Failed non-Energy threshold, no chance for EVis."
               << std::flush;
+#endif
+    return;
+  } else if (visslot == -1) {
+#ifdef DEBUG_THRESACCEPT
+    std::cout << " -- Rejected, no visible energy threshold." << std::flush;
 #endif
     return;
   }
 
-  if (((VisThresholds[fp->PDG()].ThresholdType == ThresholdAccepter::kKE) &&
-       (VisThresholds[fp->PDG()].ThresholdVal <
-        fp->KE()))  // Above KE-style threshold
-      || ((VisThresholds[fp->PDG()].ThresholdType ==
-           ThresholdAccepter::kMomentum) &&
-          (VisThresholds[fp->PDG()].ThresholdVal <
-           fp->P3().Mag()))  // Above mom-style threshold
+  VisThresh const &vt = VisThresholds[visslot];
+  if (((vt.ThresholdType == ThresholdAccepter::kKE) &&
+       (vt.ThresholdVal < fp->KE()))  // Above KE-style threshold
+      || ((vt.ThresholdType == ThresholdAccepter::kMomentum) &&
+          (vt.ThresholdVal < fp->P3().Mag()))  // Above mom-style threshold
       ) {
 #ifdef DEBUG_THRESACCEPT
     std::cout << " -- Contributed to VisE. ("
-              << GetKineTypeName(VisThresholds[fp->PDG()].ThresholdType) << ": "
-              << VisThresholds[fp->PDG()].ThresholdVal << ")" << std::flush;
+              << GetKineTypeName(vt.ThresholdType) << ": " << vt.ThresholdVal
+              << ")" << std::flush;
 #endif
 
-    ri->RecVisibleEnergy.push_back(
-        VisThresholds[fp->PDG()].Fraction *
-        (VisThresholds[fp->PDG()].UseKE ? fp->KE() : fp->E()));
+    ri->RecVisibleEnergy.push_back(vt.Fraction *
+                                   (vt.UseKE ? fp->KE() : fp->E()));
     ri->TrueContribPDGs.push_back(fp->PDG());
 
     return;
   } else {
 #ifdef DEBUG_THRESACCEPT
     std::cout << " -- Rejected. "
-              << " Vis: ("
-              << GetKineTypeName(VisThresholds[fp->PDG()].ThresholdType) << ": "
-              << VisThresholds[fp->PDG()].ThresholdVal << ")" << std::flush;
+              << " Vis: (" << GetKineTypeName(vt.ThresholdType) << ": "
+              << vt.ThresholdVal << ")" << std::flush;
 #endif
   }
 }
 
 RecoInfo *ThresholdAccepter::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+  RecoInfo *ri = GetRecoInfoBuffer();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
@@ -49,8 +49,10 @@ class ThresholdAccepter : public ISmearcepter {
   };
 
  private:
-  std::map<int, std::vector<Thresh> > ReconThresholds;
-  std::map<int, VisThresh> VisThresholds;
+  std::vector<std::vector<Thresh> > ReconThresholds;
+  PDGSlotTable ReconSlots;
+  std::vector<VisThresh> VisThresholds;
+  PDGSlotTable VisSlots;
 
   void SpecifcSetup(nuiskey &);
 
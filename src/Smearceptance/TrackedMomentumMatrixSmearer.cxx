@@ -19,6 +19,10 @@
 
 #include "TrackedMomentumMatrixSmearer.h"
 
+#include "TRandom.h"
+
+#include <algorithm>
+
 namespace {
 TrackedMomentumMatrixSmearer::DependVar GetVarType(std::string const &axisvar) {
   if (axisvar == "Momentum") {
@@ -32,39 +36,60 @@ TrackedMomentumMatrixSmearer::DependVar GetVarType(std::string const &axisvar) {
 }
 }
 
-TH1D const *TrackedMomentumMatrixSmearer::SmearMap::GetRecoSlice(double val) {
-  if ((val < RecoSlices.front().first.first) ||
-      (val > RecoSlices.back().first.second)) {
-    NUIS_ERR(WRN,
-          "Kinematic property: " << val << ", not within smearable range: ["
-                                 << RecoSlices.front().first.first << " -- "
-                                 << RecoSlices.back().first.second << "].");
-    return NULL;
+void TrackedMomentumMatrixSmearer::RecoSlice::SetFromHist(TH1D *hist) {
+  Hist = hist;
+
+  int NBins = hist->GetXaxis()->GetNbins();
+  Edges.resize(NBins + 1);
+  CDF.resize(NBins + 1);
+
+  CDF[0] = 0;
+  for (int bi_it = 0; bi_it < NBins; ++bi_it) {
+    Edges[bi_it] = hist->GetXaxis()->GetBinLowEdge(bi_it + 1);
+    CDF[bi_it + 1] = CDF[bi_it] + hist->GetBinContent(bi_it + 1);
   }
+  Edges[NBins] = hist->GetXaxis()->GetBinUpEdge(NBins);
 
-  int L = 0, U = RecoSlices.size();
+  Empty = (CDF[NBins] == 0);
+  if (Empty) {
+    return;
+  }
+  for (int bi_it = 1; bi_it <= NBins; ++bi_it) {
+    CDF[bi_it] /= CDF[NBins];
+  }
+}
 
-  while (true) {
-    if (U == L) {
-      return RecoSlices[L].second;
-    }
-    int R = (U - L);
-    int m = L + (R / 2);
+double TrackedMomentumMatrixSmearer::RecoSlice::Throw(TRandom *rand) const {
+  double r1 = rand->Rndm();
 
-    if (val <= RecoSlices[m].first.first) {
-      U = m - 1;
-      continue;
-    }
-    if (val > RecoSlices[m].first.second) {
-      L = m + 1;
-      continue;
-    }
-    if ((val > RecoSlices[m].first.first) &&
-        (val <= RecoSlices[m].first.second)) {
-      return RecoSlices[m].second;
-    }
-    NUIS_ABORT("Binary smearing search failed. Check logic.");
+  size_t NBins = Edges.size() - 1;
+  size_t bin =
+      (std::upper_bound(CDF.begin(), CDF.begin() + NBins, r1) - CDF.begin()) -
+      1;
+
+  double x = Edges[bin];
+  if (r1 > CDF[bin]) {
+    x += (Edges[bin + 1] - Edges[bin]) * (r1 - CDF[bin]) /
+         (CDF[bin + 1] - CDF[bin]);
   }
+  return x;
+}
+
+TrackedMomentumMatrixSmearer::RecoSlice const *
+TrackedMomentumMatrixSmearer::SmearMap::GetRecoSlice(double val) const {
+  if ((val < TrueEdges.front()) || (val > TrueEdges.back())) {
+    NUIS_ERR(WRN,
+          "Kinematic property: " << val << ", not within smearable range: ["
+                                 << TrueEdges.front() << " -- "
+                                 << TrueEdges.back() << "].");
+    return NULL;
+  }
+
+  // Slices cover (low, up], the first also includes its lower edge.
+  size_t slice =
+      std::lower_bound(TrueEdges.begin() + 1, TrueEdges.end(), val) -
+      (TrueEdges.begin() + 1);
+  return &RecoSlices[slice];
 }
 
 TH1D *GetMapSlice(TH2D *mp, int SliceBin, bool AlongX) {
@@ -133,18 +158,16 @@ TH1D *GetMapSlice(TH2D *mp, int SliceBin, bool AlongX) {
 
 void TrackedMomentumMatrixSmearer::SmearMap::SetSlicesFromMap(TH2D *map,
                                                               bool TruthIsY) {
-  int NSlices = (TruthIsY ? map->GetYaxis() : map->GetXaxis())->GetNbins();
+  TAxis *TrueAxis = TruthIsY ? map->GetYaxis() : map->GetXaxis();
+  int NSlices = TrueAxis->GetNbins();
 
+  TrueEdges.resize(NSlices + 1);
+  RecoSlices.resize(NSlices);
+  TrueEdges[0] = TrueAxis->GetBinLowEdge(1);
   for (Int_t TrueSlice_it = 0; TrueSlice_it < NSlices; ++TrueSlice_it) {
-    std::pair<double, double> BinEdges;
-    BinEdges.first = (TruthIsY ? map->GetYaxis() : map->GetXaxis())
-                         ->GetBinLowEdge(TrueSlice_it + 1);
-    BinEdges.second = (TruthIsY ? map->GetYaxis() : map->GetXaxis())
-                          ->GetBinUpEdge(TrueSlice_it + 1);
-
-    TH1D *slice = GetMapSlice(map, TrueSlice_it, TruthIsY);
-
-    RecoSlices.push_back(std::make_pair(BinEdges, slice));
+    TrueEdges[TrueSlice_it + 1] = TrueAxis->GetBinUpEdge(TrueSlice_it + 1);
+    RecoSlices[TrueSlice_it].SetFromHist(
+        GetMapSlice(map, TrueSlice_it, TruthIsY));
   }
   NUIS_LOG(FIT, "\tAdded " << RecoSlices.size() << " reco slices.");
 }
@@ -185,21 +208,22 @@ void TrackedMomentumMatrixSmearer::SpecifcSetup(nuiskey &nk) {
     TrackedMomentumMatrixSmearer::DependVar var =
         GetVarType(effDescriptors[t_it].GetS("Kinematics"));
 
+    // All PDGs listed share the one set of slices
+    int slot = SmearMaps.size();
+    SmearMaps.push_back(SmearMap());
+    SmearMaps.back().SetSlicesFromMap(inpHist, YIsTrue);
+    SmearMaps.back().SmearVar = var;
+    SmearMaps.back().UnitsScale = UnitsScale;
+
     std::string pdgs_s = effDescriptors[t_it].GetS("PDG");
     std::vector<int> pdgs_i = GeneralUtils::ParseToInt(pdgs_s, ",");
     for (size_t pdg_it = 0; pdg_it < pdgs_i.size(); ++pdg_it) {
-      if (ParticleMappings.count(pdgs_i[pdg_it])) {
+      if (ParticleSlots.Has(pdgs_i[pdg_it])) {
         NUIS_ERR(WRN, "Smearceptor " << ElementName << ":" << InstanceName
                                   << " already has a smearing for PDG: "
                                   << pdgs_i[pdg_it]);
       }
-
-      SmearMap sm;
-      sm.SetSlicesFromMap(inpHist, YIsTrue);
-      sm.SmearVar = var;
-      sm.UnitsScale = UnitsScale;
-
-      ParticleMappings[pdgs_i[pdg_it]] = sm;
+      ParticleSlots.Set(pdgs_i[pdg_it], slot);
 
       NUIS_LOG(FIT, "Added smearing map for PDG: " << pdgs_i[pdg_it]);
     }
@@ -207,8 +231,13 @@ void TrackedMomentumMatrixSmearer::SpecifcSetup(nuiskey &nk) {
   SlaveGS.Setup(nk);
 }
 
+void TrackedMomentumMatrixSmearer::SetRandom(TRandom *rand) {
+  ISmearcepter::SetRandom(rand);
+  SlaveGS.SetRandom(rand);
+}
+
 RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+  RecoInfo *ri = GetRecoInfoBuffer();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
@@ -226,7 +255,8 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
       continue;
     }
 
-    if (!ParticleMappings.count(fp->PDG())) {
+    int slot = ParticleSlots.Find(fp->PDG());
+    if (slot == -1) {
       SlaveGS.SmearceptOneParticle(ri, fp
 #ifdef DEBUG_GAUSSSMEAR
                                    ,
@@ -236,7 +266,7 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
       continue;
     }
 
-    SmearMap &sm = ParticleMappings[fp->PDG()];
+    SmearMap const &sm = SmearMaps[slot];
     double kineProp = 0;
 
     switch (sm.SmearVar) {
@@ -255,15 +285,8 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
       default: { NUIS_ABORT("Trying to find particle value for a kNoAxis."); }
     }
 
-    TH1 const *recoDistrib = sm.GetRecoSlice(kineProp / sm.UnitsScale);
-
-#ifdef DEBUG_MATSMEAR
-    std::cout << " -- Got slice spanning ["
-              << recoDistrib->GetXaxis()->GetBinLowEdge(1) << " -- "
-              << recoDistrib->GetXaxis()->GetBinUpEdge(
-                     recoDistrib->GetXaxis()->GetNbins())
-              << "]" << std::endl;
-#endif
+    RecoSlice const *recoDistrib =
+        sm.GetRecoSlice(kineProp / sm.UnitsScale);
 
     if (!recoDistrib) {
 #ifdef DEBUG_MATSMEAR
@@ -272,16 +295,21 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
       continue;
     }
 
-    if (recoDistrib->Integral() == 0) {
+#ifdef DEBUG_MATSMEAR
+    std::cout << " -- Got slice spanning [" << recoDistrib->Edges.front()
+              << " -- " << recoDistrib->Edges.back() << "]" << std::endl;
+#endif
+
+    if (recoDistrib->Empty) {
       NUIS_ERR(WRN, "True slice has no reconstructed events. Not smearing.")
       continue;
     }
 
-    double Smeared = recoDistrib->GetRandom() * sm.UnitsScale;
+    double Smeared = recoDistrib->Throw(GetRandom()) * sm.UnitsScale;
 #ifdef DEBUG_MATSMEAR
     std::cout << "GotRandom: " << Smeared << ", MPV: "
-              << recoDistrib->GetXaxis()->GetBinCenter(
-                     recoDistrib->GetMaximumBin()) *
+              << recoDistrib->Hist->GetXaxis()->GetBinCenter(
+                     recoDistrib->Hist->GetMaximumBin()) *
                      sm.UnitsScale
               << std::endl;
 #endif
@@ -339,7 +367,7 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
 
 #include "TCanvas.h"
       TCanvas *Test = new TCanvas("c1", "");
-      static_cast<TH1 *>(recoDistrib->Clone())->Draw();
+      static_cast<TH1 *>(recoDistrib->Hist->Clone())->Draw();
       Test->SaveAs("Fail.png");
       delete Test;
       NUIS_ABORT("ARGH");
@@ -355,11 +383,12 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
 
 void TrackedMomentumMatrixSmearer::SmearRecoInfo(RecoInfo *ri) {
   for (size_t p_it = 0; p_it < ri->RecObjMom.size(); ++p_it) {
-    if (!ParticleMappings.count(ri->RecObjClass[p_it])) {
+    int slot = ParticleSlots.Find(ri->RecObjClass[p_it]);
+    if (slot == -1) {
       SlaveGS.SmearceptOneParticle(ri->RecObjMom[p_it], ri->RecObjClass[p_it]);
       continue;
     }
-    SmearMap &sm = ParticleMappings[ri->RecObjClass[p_it]];
+    SmearMap const &sm = SmearMaps[slot];
     double kineProp = 0;
 
     switch (sm.SmearVar) {
@@ -379,17 +408,18 @@ void TrackedMomentumMatrixSmearer::SmearRecoInfo(RecoInfo *ri) {
       }
       default: { NUIS_ABORT("Trying to find particle value for a kNoAxis."); }
     }
-    TH1 const *recoDistrib = sm.GetRecoSlice(kineProp / sm.UnitsScale);
+    RecoSlice const *recoDistrib =
+        sm.GetRecoSlice(kineProp / sm.UnitsScale);
     if (!recoDistrib) {
       continue;
     }
 
-    if (recoDistrib->Integral() == 0) {
+    if (recoDistrib->Empty) {
       NUIS_ERR(WRN, "True slice has no reconstructed events. Not smearing.")
       continue;
     }
 
-    double Smeared = recoDistrib->GetRandom() * sm.UnitsScale;
+    double Smeared = recoDistrib->Throw(GetRandom()) * sm.UnitsScale;
 
     switch (sm.SmearVar) {
       case kMomentum: {
@@ -38,12 +38,29 @@ class TrackedMomentumMatrixSmearer : public ISmearcepter {
   enum DependVar { kMomentum, kKE, kTE, kNoVar };
 
  private:
+  /// Reco distribution for one true slice, with its normalised cumulative
+  /// content precomputed so that throws do not go through TH1::GetRandom.
+  struct RecoSlice {
+    TH1D *Hist;
+    /// Reco bin edges
+    std::vector<double> Edges;
+    /// Normalised cumulative content at each reco bin edge
+    std::vector<double> CDF;
+    bool Empty;
+
+    void SetFromHist(TH1D *);
+    /// Inverse-CDF throw, reproduces TH1::GetRandom with the given generator.
+    double Throw(TRandom *) const;
+  };
+
   class SmearMap {
+    /// Bin edges of the true slices.
+    std::vector<double> TrueEdges;
     /// Input True -> Reco mapping.
-    std::vector<std::pair<std::pair<double, double>, TH1D *> > RecoSlices;
+    std::vector<RecoSlice> RecoSlices;
 
    public:
-    TH1D const *GetRecoSlice(double val);
+    RecoSlice const *GetRecoSlice(double val) const;
     void SetSlicesFromMap(TH2D *, bool TruthIsY);
     /// Particle variable to smear: Momentum/KE
     ///
@@ -54,7 +71,8 @@ class TrackedMomentumMatrixSmearer : public ISmearcepter {
 
     double UnitsScale;
   };
-  std::map<int, SmearMap> ParticleMappings;
+  std::vector<SmearMap> SmearMaps;
+  PDGSlotTable ParticleSlots;
 
   GaussianSmearer SlaveGS;
 
@@ -66,6 +84,8 @@ class TrackedMomentumMatrixSmearer : public ISmearcepter {
   /// Helper method for using this class as a component in a more complex
   /// smearer
   void SmearRecoInfo(RecoInfo *);
+  void SetRandom(TRandom *);
+  bool IsThreadSafe() { return SlaveGS.IsThreadSafe(); }
   ~TrackedMomentumMatrixSmearer();
 };
 
@@ -18,12 +18,77 @@
  *******************************************************************************/
 
 #include "StatUtils.h"
+#include "CacheUtils.h"
 #include "GeneralUtils.h"
 #include "NuisConfig.h"
 #include "TH1D.h"
 #include "TVector.h"
 #include <limits>
 
+namespace {
+bool ReadUseSVDInverse() {
+  bool use = FitPar::Config().GetParB("UseSVDInverse");
+  if (use) {
+    NUIS_ERR(WRN, "Allowing SVD inverse if matrices are singular, use with "
+                  "extreme caution!");
+  }
+  return use;
+}
+
+// Read once with a static initialiser, as the chi2 and inversion functions
+// are reached from the parallel sample loader threads.
+bool UseSVDInverse() {
+  static bool const use = ReadUseSVDInverse();
+  return use;
+}
+
+// Key a processed matrix on its dimensions, content and how it is processed
+std::string GetMatrixCacheKey(TMatrixDBase const &mat, std::string const &kind,
+                              std::string const &opts) {
+  int dims[2] = {mat.GetNrows(), mat.GetNcols()};
+  uint64_t hash = CacheUtils::Hash(opts);
+  hash = CacheUtils::Hash(dims, sizeof(dims), hash);
+  hash = CacheUtils::Hash(mat.GetMatrixArray(),
+                          mat.GetNoElements() * sizeof(double), hash);
+  return CacheUtils::MakeKey(kind, hash);
+}
+
+// Entries are stored as {nrows, ncols}, {elements}
+bool ReadCachedMatrix(std::string const &key, int &nrows, int &ncols,
+                      std::vector<double> &elements) {
+  std::vector<std::vector<double> > arrays;
+  if (!CacheUtils::Read(key, arrays) || (arrays.size() != 2) ||
+      (arrays[0].size() != 2)) {
+    return false;
+  }
+  nrows = arrays[0][0];
+  ncols = arrays[0][1];
+  if (arrays[1].size() != size_t(nrows * ncols)) {
+    return false;
+  }
+  elements.swap(arrays[1]);
+  return true;
+}
+
+void WriteCachedMatrix(std::string const &key, TMatrixDBase const &mat) {
+  std::vector<std::vector<double> > arrays(2);
+  arrays[0].push_back(mat.GetNrows());
+  arrays[0].push_back(mat.GetNcols());
+  arrays[1].assign(mat.GetMatrixArray(),
+                   mat.GetMatrixArray() + mat.GetNoElements());
+  CacheUtils::Write(key, arrays);
+}
+
+TMatrixDSym *ReadCachedMatrixSym(std::string const &key) {
+  int nrows, ncols;
+  std::vector<double> elements;
+  if (!ReadCachedMatrix(key, nrows, ncols, elements) || (nrows != ncols)) {
+    return NULL;
+  }
+  return new TMatrixDSym(nrows, &elements[0], "");
+}
+} // namespace
+
 //*******************************************************************
 Double_t StatUtils::GetChi2FromDiag(TH1D *data, TH1D *mc, TH1I *mask) {
   //*******************************************************************
@@ -112,12 +177,7 @@ Double_t StatUtils::GetChi2FromCov(TH1D *data, TH1D *mc, TMatrixDSym *invcov,
                                    double covar_scale, TH1D *outchi2perbin) {
   //*******************************************************************
 
-  static bool first = true;
-  static bool UseSVDDecomp = false;
-  if (first) {
-    UseSVDDecomp = FitPar::Config().GetParB("UseSVDInverse");
-    first = false;
-  }
+  bool const UseSVDDecomp = UseSVDInverse();
 
   Double_t Chi2 = 0.0;
   TMatrixDSym *calc_cov = (TMatrixDSym *)invcov->Clone("local_invcov");
@@ -267,6 +327,73 @@ Double_t StatUtils::GetChi2FromCov(TH1D *data, TH1D *mc, TMatrixDSym *invcov,
   return Chi2;
 }
 
+//*******************************************************************
+Double_t StatUtils::GetChi2FromCov(TH1D *data, TH1D *mc, TMatrixDSym *invcov,
+                                   CovarBlocks const &blocks, TH1I *mask,
+                                   double data_scale, double covar_scale,
+                                   TH1D *outchi2perbin) {
+  //*******************************************************************
+
+  // Masking and MC errors rebuild the matrix, so leave them to the dense
+  // calculation
+  if (mask || blocks.empty() ||
+      FitPar::Config().GetParB("statutils.addmcerror")) {
+    return GetChi2FromCov(data, mc, invcov, mask, data_scale, covar_scale,
+                          outchi2perbin);
+  }
+
+  bool const UseSVDDecomp = UseSVDInverse();
+
+  int nbins = data->GetNbinsX();
+  if (nbins != invcov->GetNcols()) {
+    NUIS_ERR(WRN, "Inconsistent matrix and data histogram passed to "
+                  "StatUtils::GetChi2FromCov!");
+    NUIS_ABORT("data_hist has " << nbins << " matrix has "
+                                << invcov->GetNcols() << " bins");
+  }
+
+  // Same terms as the dense calculation, only bins i with data and MC
+  // contribute
+  std::vector<double> diff(nbins);
+  std::vector<bool> used(nbins);
+  for (int i = 0; i < nbins; i++) {
+    double data_i = data->GetBinContent(i + 1) * data_scale;
+    double mc_i = mc->GetBinContent(i + 1) * data_scale;
+    diff[i] = data_i - mc_i;
+    used[i] = (data_i != 0) && (mc_i != 0);
+  }
+
+  const double *el = invcov->GetMatrixArray();
+  Double_t Chi2 = 0.0;
+  for (size_t b = 0; b < blocks.size(); b++) {
+    for (int i = blocks[b].first; i <= blocks[b].second; i++) {
+      double ibin_contrib = 0;
+      for (int j = blocks[b].first; used[i] && j <= blocks[b].second; j++) {
+        double cov_ij = el[i * nbins + j] * covar_scale;
+        if (cov_ij == 0) {
+          continue;
+        }
+
+        double bin_cont = diff[i] * cov_ij * diff[j];
+        if (!UseSVDDecomp && (i == j) && (cov_ij < 0)) {
+          NUIS_ABORT("Found negative diagonal covariance element: Covar("
+                     << i << ", " << j << ") = " << cov_ij
+                     << " would contribute: " << bin_cont
+                     << " on top of: " << Chi2);
+        }
+
+        Chi2 += bin_cont;
+        ibin_contrib += bin_cont;
+      }
+      if (outchi2perbin) {
+        outchi2perbin->SetBinContent(i + 1, ibin_contrib);
+      }
+    }
+  }
+
+  return Chi2;
+}
+
 //*******************************************************************
 Double_t StatUtils::GetChi2FromCov(TH2D *data, TH2D *mc, TMatrixDSym *invcov,
                                    TH2I *map, TH2I *mask, TH2D *outchi2perbin) {
@@ -753,6 +880,53 @@ TH1D *StatUtils::ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag,
   return calc_hist;
 };
 
+//*******************************************************************
+TH1D *StatUtils::ThrowHistogram(TH1D *hist, TMatrixDSym *cov,
+                                CovarBlocks const &blocks) {
+  //*******************************************************************
+
+  if (blocks.empty()) {
+    return ThrowHistogram(hist, cov);
+  }
+
+  TH1D *calc_hist =
+      (TH1D *)hist->Clone((std::string(hist->GetName()) + "_THROW").c_str());
+
+  // Drawn in the same order as the dense throw
+  std::vector<Double_t> rand_val;
+  for (int i = 0; i < hist->GetNbinsX(); i++) {
+    rand_val.push_back(gRandom->Gaus(0.0, 1.0));
+  }
+
+  // The decomposition of a block diagonal matrix is the decomposition of each
+  // block
+  for (size_t b = 0; b < blocks.size(); b++) {
+    int first = blocks[b].first;
+    int nblock = blocks[b].second - first + 1;
+
+    TMatrixDSym block_cov(nblock);
+    for (int i = 0; i < nblock; i++) {
+      for (int j = 0; j < nblock; j++) {
+        block_cov(i, j) = (*cov)(first + i, first + j);
+      }
+    }
+    TMatrixDSym *decomp_cov = StatUtils::GetDecomp(&block_cov);
+
+    for (int i = 0; i < nblock; i++) {
+      Double_t correl_val = 0.0;
+      for (int j = 0; j < nblock; j++) {
+        correl_val += rand_val[first + j] * (*decomp_cov)(j, i);
+      }
+      calc_hist->SetBinContent(first + i + 1,
+                               (calc_hist->GetBinContent(first + i + 1) +
+                                correl_val * 1E-38));
+    }
+    delete decomp_cov;
+  }
+
+  return calc_hist;
+}
+
 //*******************************************************************
 TH2D *StatUtils::ThrowHistogram(TH2D *hist, TMatrixDSym *cov, TH2I *map,
                                 bool throwdiag, TH2I *mask) {
@@ -992,14 +1166,19 @@ TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale) {
     return new_mat;
   }
 
-  static bool first = true;
-  static bool UseSVDDecomp = false;
-  if (first) {
-    UseSVDDecomp = FitPar::Config().GetParB("UseSVDInverse");
-    first = false;
-    if (UseSVDDecomp) {
-      NUIS_ERR(WRN, "Allowing SVD inverse if matrices are singular, use with "
-                    "extreme caution!");
+  bool const UseSVDDecomp = UseSVDInverse();
+
+  // Inversions of large covariances dominate startup, so reuse any previous
+  // result for a matrix with identical content.
+  std::string cachekey = "";
+  if (CacheUtils::IsEnabled()) {
+    cachekey = GetMatrixCacheKey(*new_mat, "invert",
+                                 std::string(rescale ? "rescale" : "") +
+                                     (UseSVDDecomp ? "svd" : ""));
+    TMatrixDSym *cached = ReadCachedMatrixSym(cachekey);
+    if (cached) {
+      delete new_mat;
+      return cached;
     }
   }
 
@@ -1057,9 +1236,50 @@ TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale) {
     new_mat = new TMatrixDSym(nrows, mat_decomp.Invert().GetMatrixArray(), "");
   }
 
+  if (!cachekey.empty()) {
+    WriteCachedMatrix(cachekey, *new_mat);
+  }
+
   return new_mat;
 }
 
+//*******************************************************************
+StatUtils::CovarBlocks StatUtils::GetCovarBlocks(TMatrixDSym *mat) {
+  //*******************************************************************
+
+  CovarBlocks blocks;
+  if (!mat) {
+    return blocks;
+  }
+
+  int nrows = mat->GetNrows();
+  const double *el = mat->GetMatrixArray();
+
+  // A block closes at row i once nothing in the rows since it opened reaches
+  // a column past i. Both triangles are checked, inverses aren't always
+  // exactly symmetric.
+  int first = 0;
+  int reach = -1;
+  for (int i = 0; i < nrows; i++) {
+    int last = i;
+    for (int j = nrows - 1; j > i; j--) {
+      if (el[i * nrows + j] != 0 || el[j * nrows + i] != 0) {
+        last = j;
+        break;
+      }
+    }
+    if (last > reach) {
+      reach = last;
+    }
+    if (reach == i) {
+      blocks.push_back(std::make_pair(first, i));
+      first = i + 1;
+    }
+  }
+
+  return blocks;
+}
+
 //*******************************************************************
 TMatrixDSym *StatUtils::GetDecomp(TMatrixDSym *mat) {
   //*******************************************************************
@@ -1092,6 +1312,16 @@ TMatrixDSym *StatUtils::GetDecomp(TMatrixDSym *mat) {
     return new_mat;
   }
 
+  std::string cachekey = "";
+  if (CacheUtils::IsEnabled()) {
+    cachekey = GetMatrixCacheKey(*new_mat, "decomp", "");
+    TMatrixDSym *cached = ReadCachedMatrixSym(cachekey);
+    if (cached) {
+      delete new_mat;
+      return cached;
+    }
+  }
+
   // Test if we can decompose the matrix before trying
   bool isWellBehaved = StatUtils::IsMatrixWellBehaved(new_mat);
 
@@ -1121,6 +1351,10 @@ TMatrixDSym *StatUtils::GetDecomp(TMatrixDSym *mat) {
 
   TMatrixDSym *dec_mat = new TMatrixDSym(nrows, LU.GetU().GetMatrixArray(), "");
 
+  if (!cachekey.empty()) {
+    WriteCachedMatrix(cachekey, *dec_mat);
+  }
+
   return dec_mat;
 }
 
@@ -1360,6 +1594,16 @@ TMatrixDSym *StatUtils::ExtractShapeOnlyCovar(TMatrixDSym *full_covar,
 
   NUIS_LOG(DEB, "Norm error = " << sqrt(total_covar) / total_data);
 
+  // Column and row sums only depend on one index, so get them once up front
+  std::vector<double> col_sums(nbins, 0);
+  std::vector<double> row_sums(nbins, 0);
+  for (int i = 0; i < nbins; ++i) {
+    for (int k = 0; k < nbins; ++k) {
+      col_sums[i] += (*full_covar)(k, i);
+      row_sums[i] += (*full_covar)(i, k);
+    }
+  }
+
   // Now loop over and calculate the shape-only matrix
   for (int i = 0; i < nbins; ++i) {
     double data_i = data_hist->GetBinContent(i + 1) * data_scale;
@@ -1369,13 +1613,8 @@ TMatrixDSym *StatUtils::ExtractShapeOnlyCovar(TMatrixDSym *full_covar,
 
       double norm_term =
           data_i * data_j * total_covar / total_data / total_data;
-      double mix_sum1 = 0;
-      double mix_sum2 = 0;
-
-      for (int k = 0; k < nbins; ++k) {
-        mix_sum1 += (*full_covar)(k, j);
-        mix_sum2 += (*full_covar)(i, k);
-      }
+      double mix_sum1 = col_sums[j];
+      double mix_sum2 = row_sums[i];
 
       double mix_term1 =
           data_i * (mix_sum1 / total_data -
@@ -1684,6 +1923,22 @@ TMatrixD *StatUtils::GetMatrixFromTextFile(std::string covfile, int dimx,
                                            int dimy) {
   //*******************************************************************
 
+  // Parsing large text matrices is slow, check for a cached copy keyed on the
+  // file content and requested dimensions.
+  std::string cachekey = "";
+  uint64_t filehash;
+  if (CacheUtils::IsEnabled() && CacheUtils::HashFile(covfile, filehash)) {
+    int dims[2] = {dimx, dimy};
+    cachekey = CacheUtils::MakeKey(
+        "textmatrix", CacheUtils::Hash(dims, sizeof(dims), filehash));
+
+    int nrows, ncols;
+    std::vector<double> elements;
+    if (ReadCachedMatrix(cachekey, nrows, ncols, elements)) {
+      return new TMatrixD(nrows, ncols, &elements[0]);
+    }
+  }
+
   // Determine dim
   if (dimx == -1 and dimy == -1) {
     std::string line;
@@ -1749,6 +2004,10 @@ TMatrixD *StatUtils::GetMatrixFromTextFile(std::string covfile, int dimx,
     row++;
   }
 
+  if (!cachekey.empty()) {
+    WriteCachedMatrix(cachekey, *mat);
+  }
+
   return mat;
 }
 
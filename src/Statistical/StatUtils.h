@@ -30,6 +30,8 @@
 #include <sstream>
 #include <stdlib.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 // Root Includes
 #include "TDecompChol.h"
@@ -55,6 +57,9 @@
 //! Functions for handling statistics calculations
 namespace StatUtils {
 
+//! Inclusive [first, last] bin ranges of the diagonal blocks of a covariance
+typedef std::vector<std::pair<int, int> > CovarBlocks;
+
 /*
   Chi2 Functions
 */
@@ -73,6 +78,15 @@ Double_t GetChi2FromCov(TH1D *data, TH1D *mc, TMatrixDSym *invcov,
                         TH1I *mask = NULL, double data_scale = 1,
                         double covar_scale = 1E76, TH1D *outchi2perbin = NULL);
 
+//! Get Chi2 using an inverted covariance for the data made up of the given
+//! diagonal blocks (see GetCovarBlocks). Only elements inside a block are
+//! visited. Masked calculations and statutils.addmcerror use the dense
+//! version.
+Double_t GetChi2FromCov(TH1D *data, TH1D *mc, TMatrixDSym *invcov,
+                        CovarBlocks const &blocks, TH1I *mask = NULL,
+                        double data_scale = 1, double covar_scale = 1E76,
+                        TH1D *outchi2perbin = NULL);
+
 //! Get Chi2 using an inverted covariance for the data
 //! Plots converted to 1D histograms before using 1D calculation.
 Double_t GetChi2FromCov(TH2D *data, TH2D *mc, TMatrixDSym *invcov,
@@ -147,6 +161,10 @@ Int_t GetNDOF(TH2D *hist, TH2I *map = NULL, TH2I *mask = NULL);
 TH1D *ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag = true,
                      TH1I *mask = NULL);
 
+//! Throw a 1D data set from a full covariance made up of the given diagonal
+//! blocks, decomposing each block on its own.
+TH1D *ThrowHistogram(TH1D *hist, TMatrixDSym *cov, CovarBlocks const &blocks);
+
 //! Given a full covariance for a 2D data set throw the decomposition to
 //! generate fake data. Plots are converted to 1D histograms and the 1D
 //! ThrowHistogram is used, before being converted back to 2D histograms.
@@ -196,6 +214,10 @@ bool IsMatrixWellBehaved(TMatrixDSym* mat);
 //! Return inverted matrix of TMatrixDSym
 TMatrixDSym *GetInvert(TMatrixDSym *mat, bool rescale = false);
 
+//! Split a covariance (or its inverse) into the smallest contiguous diagonal
+//! blocks with only zeros between them. A dense matrix is a single block.
+CovarBlocks GetCovarBlocks(TMatrixDSym *mat);
+
 //! Return Cholesky Decomposed matrix of TMatrixDSym
 TMatrixDSym *GetDecomp(TMatrixDSym *mat);
 
@@ -0,0 +1,495 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#include "ThrowAccumulator.h"
+
+#include "FitLogger.h"
+
+#include "TClass.h"
+#include "TKey.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+//*************************************
+QuantileSketch::QuantileSketch(int k) {
+  //*************************************
+  fK = (k < 8) ? 8 : k;
+  fN = 0;
+  fLevels.resize(1);
+}
+
+//*************************************
+void QuantileSketch::Fill(double val) {
+  //*************************************
+  fN++;
+  fLevels[0].push_back(val);
+  if (fLevels[0].size() >= size_t(fK))
+    Compact(0);
+}
+
+//*************************************
+void QuantileSketch::Compact(size_t level) {
+  //*************************************
+
+  if (fLevels.size() < level + 2)
+    fLevels.resize(level + 2);
+
+  std::vector<double> &items = fLevels[level];
+  std::sort(items.begin(), items.end());
+
+  // Alternate which half survives so the estimate is not biased, derived
+  // from the state so that the same fills always give the same sketch.
+  size_t offset = size_t(fN + level) % 2;
+  for (size_t i = offset; i < items.size(); i += 2) {
+    fLevels[level + 1].push_back(items[i]);
+  }
+  items.clear();
+
+  if (fLevels[level + 1].size() >= size_t(fK))
+    Compact(level + 1);
+}
+
+//*************************************
+void QuantileSketch::Merge(QuantileSketch const &other) {
+  //*************************************
+
+  fN += other.fN;
+  if (fLevels.size() < other.fLevels.size())
+    fLevels.resize(other.fLevels.size());
+
+  for (size_t l = 0; l < other.fLevels.size(); l++) {
+    fLevels[l].insert(fLevels[l].end(), other.fLevels[l].begin(),
+                      other.fLevels[l].end());
+  }
+  for (size_t l = 0; l < fLevels.size(); l++) {
+    if (fLevels[l].size() >= size_t(fK))
+      Compact(l);
+  }
+}
+
+//*************************************
+double QuantileSketch::GetQuantile(double q) const {
+  //*************************************
+
+  std::vector<std::pair<double, double> > items;
+  double totweight = 0.0;
+  for (size_t l = 0; l < fLevels.size(); l++) {
+    double weight = std::ldexp(1.0, int(l));
+    for (size_t i = 0; i < fLevels[l].size(); i++) {
+      items.push_back(std::make_pair(fLevels[l][i], weight));
+      totweight += weight;
+    }
+  }
+  if (items.empty())
+    return 0.0;
+
+  std::sort(items.begin(), items.end());
+  double target = q * totweight;
+  double cumulative = 0.0;
+  for (size_t i = 0; i < items.size(); i++) {
+    cumulative += items[i].second;
+    if (cumulative >= target)
+      return items[i].first;
+  }
+  return items.back().first;
+}
+
+//*************************************
+void QuantileSketch::GetItems(std::vector<double> &vals,
+                              std::vector<double> &levels) const {
+  //*************************************
+  for (size_t l = 0; l < fLevels.size(); l++) {
+    for (size_t i = 0; i < fLevels[l].size(); i++) {
+      vals.push_back(fLevels[l][i]);
+      levels.push_back(l);
+    }
+  }
+}
+
+//*************************************
+void QuantileSketch::SetItems(Long64_t n, std::vector<double> const &vals,
+                              std::vector<double> const &levels) {
+  //*************************************
+  fN = n;
+  fLevels.clear();
+  fLevels.resize(1);
+  for (size_t i = 0; i < vals.size(); i++) {
+    size_t l = size_t(levels[i]);
+    if (fLevels.size() < l + 1)
+      fLevels.resize(l + 1);
+    fLevels[l].push_back(vals[i]);
+  }
+}
+
+//*************************************
+ThrowAccumulator::ThrowAccumulator(std::string const &name, int nbins,
+                                   std::vector<double> const &quantiles,
+                                   int sketchsize, int maxcovbins) {
+  //*************************************
+  fName = name;
+  fNBins = nbins;
+  fFullCovar = (nbins <= maxcovbins);
+  fN = 0;
+
+  fMean.resize(nbins, 0.0);
+  fM2.resize(fFullCovar ? nbins * nbins : nbins, 0.0);
+  fDelta.resize(nbins, 0.0);
+
+  fQuantiles = quantiles;
+  if (!fQuantiles.empty())
+    fSketches.resize(nbins, QuantileSketch(sketchsize));
+}
+
+//*************************************
+void ThrowAccumulator::Fill(TH1 const *hist, int throwindex) {
+  //*************************************
+
+  fN++;
+  fThrows.push_back(throwindex);
+
+  for (int i = 0; i < fNBins; i++) {
+    double val = hist->GetBinContent(i + 1);
+    fDelta[i] = val - fMean[i];
+    fMean[i] += fDelta[i] / double(fN);
+
+    if (!fSketches.empty())
+      fSketches[i].Fill(val);
+  }
+
+  // (x - mean_old)(x - mean_new)^T = delta delta^T (N-1)/N
+  double scale = double(fN - 1) / double(fN);
+  if (fFullCovar) {
+    for (int i = 0; i < fNBins; i++) {
+      double di = fDelta[i] * scale;
+      double *row = &fM2[i * fNBins];
+      for (int j = 0; j < fNBins; j++) {
+        row[j] += di * fDelta[j];
+      }
+    }
+  } else {
+    for (int i = 0; i < fNBins; i++) {
+      fM2[i] += fDelta[i] * fDelta[i] * scale;
+    }
+  }
+}
+
+//*************************************
+bool ThrowAccumulator::Merge(ThrowAccumulator const &other) {
+  //*************************************
+
+  if (other.fNBins != fNBins) {
+    NUIS_ERR(WRN, "Cannot merge throw accumulators for "
+                      << fName << " with " << fNBins << " and "
+                      << other.fNBins << " bins.");
+    return false;
+  }
+
+  std::set<int> throws(fThrows.begin(), fThrows.end());
+  for (size_t i = 0; i < other.fThrows.size(); i++) {
+    if (throws.count(other.fThrows[i]))
+      return false;
+  }
+  if (!other.fN)
+    return true;
+
+  // Keep the cheaper of the two covariance forms
+  if (fFullCovar and !other.fFullCovar) {
+    std::vector<double> diag(fNBins);
+    for (int i = 0; i < fNBins; i++) {
+      diag[i] = fM2[i * fNBins + i];
+    }
+    fM2 = diag;
+    fFullCovar = false;
+  }
+
+  double na = fN;
+  double nb = other.fN;
+  double n = na + nb;
+  for (int i = 0; i < fNBins; i++) {
+    fDelta[i] = other.fMean[i] - fMean[i];
+    fMean[i] += fDelta[i] * nb / n;
+  }
+
+  double scale = na * nb / n;
+  if (fFullCovar) {
+    for (int i = 0; i < fNBins; i++) {
+      for (int j = 0; j < fNBins; j++) {
+        fM2[i * fNBins + j] += other.fM2[i * fNBins + j] +
+                               fDelta[i] * fDelta[j] * scale;
+      }
+    }
+  } else {
+    for (int i = 0; i < fNBins; i++) {
+      double otherm2 =
+          other.fFullCovar ? other.fM2[i * fNBins + i] : other.fM2[i];
+      fM2[i] += otherm2 + fDelta[i] * fDelta[i] * scale;
+    }
+  }
+
+  if (fQuantiles == other.fQuantiles and
+      fSketches.size() == other.fSketches.size()) {
+    for (size_t i = 0; i < fSketches.size(); i++) {
+      fSketches[i].Merge(other.fSketches[i]);
+    }
+  } else if (!fSketches.empty()) {
+    NUIS_ERR(WRN, "Throw quantiles for " << fName
+                                         << " differ between inputs, dropping"
+                                            " quantile bands.");
+    fSketches.clear();
+    fQuantiles.clear();
+  }
+
+  fN += other.fN;
+  fThrows.insert(fThrows.end(), other.fThrows.begin(), other.fThrows.end());
+  return true;
+}
+
+//*************************************
+double ThrowAccumulator::GetSpread(int bin) const {
+  //*************************************
+  if (!fN)
+    return 0.0;
+  double m2 = fFullCovar ? fM2[bin * fNBins + bin] : fM2[bin];
+  return sqrt(m2 / double(fN));
+}
+
+//*************************************
+double ThrowAccumulator::GetQuantile(int bin, double q) const {
+  //*************************************
+  if (fSketches.empty())
+    return 0.0;
+  return fSketches[bin].GetQuantile(q);
+}
+
+//*************************************
+TMatrixDSym *ThrowAccumulator::GetCovariance() const {
+  //*************************************
+  if (!fFullCovar or fN < 2)
+    return NULL;
+
+  TMatrixDSym *covar = new TMatrixDSym(fNBins);
+  for (int i = 0; i < fNBins; i++) {
+    for (int j = 0; j < fNBins; j++) {
+      (*covar)(i, j) = fM2[i * fNBins + j] / double(fN - 1);
+    }
+  }
+  return covar;
+}
+
+//*************************************
+TH1 *ThrowAccumulator::GetErrorBand(TH1 const *nominal) const {
+  //*************************************
+  TH1 *band = (TH1 *)nominal->Clone();
+  for (int i = 0; i < fNBins; i++) {
+    band->SetBinContent(i + 1, GetMean(i));
+    band->SetBinError(i + 1, GetSpread(i));
+  }
+  return band;
+}
+
+//*************************************
+TH1 *ThrowAccumulator::GetQuantileBand(TH1 const *nominal, double q) const {
+  //*************************************
+  TH1 *band = (TH1 *)nominal->Clone(
+      Form("%s_quantile_%g", nominal->GetName(), q * 100.0));
+  band->SetTitle(Form("%g%% quantile of throws", q * 100.0));
+  for (int i = 0; i < fNBins; i++) {
+    band->SetBinContent(i + 1, GetQuantile(i, q));
+    band->SetBinError(i + 1, 0.0);
+  }
+  return band;
+}
+
+namespace {
+TVectorD ToVector(std::vector<double> const &vals) {
+  TVectorD vect(vals.size());
+  for (size_t i = 0; i < vals.size(); i++) {
+    vect(i) = vals[i];
+  }
+  return vect;
+}
+
+std::vector<double> FromVector(TVectorD const *vect) {
+  std::vector<double> vals;
+  if (!vect)
+    return vals;
+  for (int i = 0; i < vect->GetNrows(); i++) {
+    vals.push_back((*vect)(i));
+  }
+  return vals;
+}
+} // namespace
+
+//*************************************
+void ThrowAccumulator::Write(TDirectory *dir) const {
+  //*************************************
+
+  TDirectory *accdir = dir->mkdir(fName.c_str());
+  accdir->cd();
+
+  TVectorD info(4);
+  info(0) = fN;
+  info(1) = fNBins;
+  info(2) = fFullCovar;
+  info(3) = fSketches.empty() ? 0 : fSketches[0].GetK();
+  info.Write("info");
+
+  std::vector<double> throws(fThrows.begin(), fThrows.end());
+  ToVector(throws).Write("throws");
+  ToVector(fMean).Write("mean");
+  ToVector(fM2).Write("m2");
+
+  if (!fSketches.empty()) {
+    ToVector(fQuantiles).Write("quantiles");
+
+    std::vector<double> counts, offsets, vals, levels;
+    for (size_t i = 0; i < fSketches.size(); i++) {
+      counts.push_back(fSketches[i].GetN());
+      offsets.push_back(vals.size());
+      fSketches[i].GetItems(vals, levels);
+    }
+    offsets.push_back(vals.size());
+
+    ToVector(counts).Write("sketch_n");
+    ToVector(offsets).Write("sketch_offsets");
+    ToVector(vals).Write("sketch_vals");
+    ToVector(levels).Write("sketch_levels");
+  }
+
+  dir->cd();
+}
+
+//*************************************
+ThrowAccumulator *ThrowAccumulator::Read(TDirectory *dir,
+                                         std::string const &name) {
+  //*************************************
+
+  TDirectory *accdir = dir->GetDirectory(name.c_str());
+  if (!accdir)
+    return NULL;
+
+  TVectorD *info = (TVectorD *)accdir->Get("info");
+  if (!info or info->GetNrows() < 3)
+    return NULL;
+
+  ThrowAccumulator *acc = new ThrowAccumulator();
+  acc->fName = name;
+  acc->fN = Long64_t((*info)(0));
+  acc->fNBins = int((*info)(1));
+  acc->fFullCovar = ((*info)(2) != 0);
+
+  std::vector<double> throws = FromVector((TVectorD *)accdir->Get("throws"));
+  acc->fThrows.assign(throws.begin(), throws.end());
+  acc->fMean = FromVector((TVectorD *)accdir->Get("mean"));
+  acc->fM2 = FromVector((TVectorD *)accdir->Get("m2"));
+  acc->fDelta.resize(acc->fNBins, 0.0);
+
+  size_t m2size = acc->fFullCovar ? acc->fNBins * acc->fNBins : acc->fNBins;
+  if (acc->fMean.size() != size_t(acc->fNBins) or acc->fM2.size() != m2size) {
+    NUIS_ERR(WRN, "Throw accumulator " << name << " is malformed, skipping.");
+    delete acc;
+    return NULL;
+  }
+
+  acc->fQuantiles = FromVector((TVectorD *)accdir->Get("quantiles"));
+  if (!acc->fQuantiles.empty()) {
+    std::vector<double> counts =
+        FromVector((TVectorD *)accdir->Get("sketch_n"));
+    std::vector<double> offsets =
+        FromVector((TVectorD *)accdir->Get("sketch_offsets"));
+    std::vector<double> vals =
+        FromVector((TVectorD *)accdir->Get("sketch_vals"));
+    std::vector<double> levels =
+        FromVector((TVectorD *)accdir->Get("sketch_levels"));
+
+    if (counts.size() != size_t(acc->fNBins) or
+        offsets.size() != size_t(acc->fNBins + 1) or
+        vals.size() != levels.size()) {
+      NUIS_ERR(WRN, "Throw quantiles for " << name
+                                           << " are malformed, dropping them.");
+      acc->fQuantiles.clear();
+    } else {
+      // Sketches must keep the size they were filled with to merge correctly
+      int k = (info->GetNrows() > 3) ? int((*info)(3)) : 0;
+      acc->fSketches.assign(acc->fNBins,
+                            k > 0 ? QuantileSketch(k) : QuantileSketch());
+      for (int i = 0; i < acc->fNBins; i++) {
+        size_t first = size_t(offsets[i]);
+        size_t last = size_t(offsets[i + 1]);
+        acc->fSketches[i].SetItems(
+            Long64_t(counts[i]),
+            std::vector<double>(vals.begin() + first, vals.begin() + last),
+            std::vector<double>(levels.begin() + first,
+                                levels.begin() + last));
+      }
+    }
+  }
+
+  return acc;
+}
+
+//*************************************
+void ThrowAccumulator::WriteAll(
+    std::map<std::string, ThrowAccumulator *> const &accums, TDirectory *dir) {
+  //*************************************
+  for (std::map<std::string, ThrowAccumulator *>::const_iterator iter =
+           accums.begin();
+       iter != accums.end(); iter++) {
+    iter->second->Write(dir);
+  }
+  dir->cd();
+}
+
+//*************************************
+void ThrowAccumulator::ReadAll(
+    TDirectory *dir, std::map<std::string, ThrowAccumulator *> &accums) {
+  //*************************************
+
+  std::set<std::string> seen;
+  TIter next(dir->GetListOfKeys());
+  TKey *key;
+  while ((key = (TKey *)next())) {
+    std::string name = key->GetName();
+    if (!seen.insert(name).second)
+      continue;
+
+    TClass *cl = gROOT->GetClass(key->GetClassName());
+    if (!cl or !cl->InheritsFrom("TDirectory"))
+      continue;
+
+    ThrowAccumulator *acc = Read(dir, name);
+    if (!acc)
+      continue;
+
+    if (!accums.count(name)) {
+      accums[name] = acc;
+      continue;
+    }
+
+    if (!accums[name]->Merge(*acc)) {
+      NUIS_ERR(WRN, "Skipping accumulated throws for "
+                        << name << " in " << dir->GetName()
+                        << ", they repeat throws that were already merged.");
+    }
+    delete acc;
+  }
+}
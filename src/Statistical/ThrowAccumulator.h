@@ -0,0 +1,138 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+
+#ifndef THROWACCUMULATOR_H
+#define THROWACCUMULATOR_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "TDirectory.h"
+#include "TH1.h"
+#include "TH2D.h"
+#include "TMatrixDSym.h"
+#include "TVectorD.h"
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+//! Deterministic, mergeable streaming quantile estimate for a single value.
+//! Values are kept in levels of at most k entries, a full level is sorted and
+//! every other entry is promoted to the next level with twice the weight.
+class QuantileSketch {
+public:
+  QuantileSketch(int k = 128);
+
+  void Fill(double val);
+  void Merge(QuantileSketch const &other);
+  double GetQuantile(double q) const;
+  Long64_t GetN() const { return fN; }
+  int GetK() const { return fK; }
+
+  //! Flatten into values and their levels for writing.
+  void GetItems(std::vector<double> &vals, std::vector<double> &levels) const;
+  //! Rebuild from GetItems output.
+  void SetItems(Long64_t n, std::vector<double> const &vals,
+                std::vector<double> const &levels);
+
+private:
+  void Compact(size_t level);
+
+  int fK;
+  Long64_t fN;
+  std::vector<std::vector<double> > fLevels;
+};
+
+//! Online per-bin mean, covariance and quantiles of a histogram over a set of
+//! throws, so error bands can be built without keeping every throw.
+//! Bins are counted as in SystematicRoutines::MergeThrows, i.e. GetBinContent(
+//! i + 1) for i < nbinsx * nbinsy.
+class ThrowAccumulator {
+public:
+  //! maxcovbins limits the full covariance to histograms with at most that
+  //! many bins, larger histograms only keep the variance.
+  ThrowAccumulator(std::string const &name, int nbins,
+                   std::vector<double> const &quantiles, int sketchsize,
+                   int maxcovbins);
+
+  //! Welford update from one throw of the histogram.
+  void Fill(TH1 const *hist, int throwindex);
+
+  //! Combine with accumulated throws from another process or file. Returns
+  //! false, leaving this unchanged, if any throw index was already included.
+  bool Merge(ThrowAccumulator const &other);
+
+  std::string const &GetName() const { return fName; }
+  Long64_t GetN() const { return fN; }
+  int GetNBins() const { return fNBins; }
+  std::vector<int> const &GetThrows() const { return fThrows; }
+  std::vector<double> const &GetQuantiles() const { return fQuantiles; }
+  bool HasCovariance() const { return fFullCovar; }
+
+  double GetMean(int bin) const { return fMean[bin]; }
+  //! Spread of the throws, sqrt(sum (x - mean)^2 / N) as in a TProfile with
+  //! the "S" option.
+  double GetSpread(int bin) const;
+  double GetQuantile(int bin, double q) const;
+
+  //! Unbiased (N-1) covariance, NULL if only the variance is kept.
+  TMatrixDSym *GetCovariance() const;
+
+  //! Clone of nominal with contents and errors set to the mean and spread.
+  TH1 *GetErrorBand(TH1 const *nominal) const;
+  //! Clone of nominal with contents set to the q quantile of the throws.
+  TH1 *GetQuantileBand(TH1 const *nominal, double q) const;
+
+  //! Write into a subdirectory of dir named after the accumulator.
+  void Write(TDirectory *dir) const;
+  //! Read back from a subdirectory written with Write. NULL if missing.
+  static ThrowAccumulator *Read(TDirectory *dir, std::string const &name);
+
+  //! Write/read a whole set of accumulators, keyed by histogram name.
+  static void WriteAll(std::map<std::string, ThrowAccumulator *> const &accums,
+                       TDirectory *dir);
+  //! Merge everything in dir into accums. Accumulators that overlap in throw
+  //! index with ones already in accums are skipped with a warning.
+  static void ReadAll(TDirectory *dir,
+                      std::map<std::string, ThrowAccumulator *> &accums);
+
+private:
+  ThrowAccumulator() {}
+
+  std::string fName;
+  int fNBins;
+  bool fFullCovar;
+  Long64_t fN;
+  std::vector<int> fThrows;
+
+  std::vector<double> fMean;
+  //! Sum of (x - mean)(x - mean)^T, full or diagonal only.
+  std::vector<double> fM2;
+
+  std::vector<double> fQuantiles;
+  std::vector<QuantileSketch> fSketches;
+
+  std::vector<double> fDelta;
+};
+
+/*! @} */
+#endif
@@ -0,0 +1,168 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "SampleFactoryRegistry.h"
+
+// T2K CC0pi 2016
+#include "T2K_CC0pi_XSec_2DPcos_nu_I.h"
+#include "T2K_CC0pi_XSec_2DPcos_nu_II.h"
+
+// T2K CC0pi 2020 arXiv:1908.10249
+#include "T2K_CC0pi_XSec_H2O_2DPcos_anu.h"
+
+// T2K CC0pi 2020 arXiv:2004.05434
+#include "T2K_NuMu_CC0pi_OC_XSec_2DPcos.h"
+#include "T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint.h"
+
+// T2K CC0pi 2020 arXiv:2002.09323
+#include "T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos.h"
+#include "T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint.h"
+
+// T2K CC-inclusive with full acceptance 2018
+#include "T2K_CCinc_XSec_2DPcos_nu_nonuniform.h"
+
+// T2K nue CC-inclusive 2019
+#include "T2K_nueCCinc_XSec_1Dpe.h"
+#include "T2K_nueCCinc_XSec_1Dpe_joint.h"
+#include "T2K_nueCCinc_XSec_1Dthe.h"
+#include "T2K_nueCCinc_XSec_1Dthe_joint.h"
+#include "T2K_nueCCinc_XSec_joint.h"
+
+// T2K STV CC0pi 2018
+#include "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np.h"
+#include "T2K_CC0pinp_STV_XSec_1Ddat_nu.h"
+#include "T2K_CC0pinp_STV_XSec_1Ddphit_nu.h"
+#include "T2K_CC0pinp_STV_XSec_1Ddpt_nu.h"
+#include "T2K_CC0pinp_ifk_XSec_3Dinfa_nu.h"
+#include "T2K_CC0pinp_ifk_XSec_3Dinfip_nu.h"
+#include "T2K_CC0pinp_ifk_XSec_3Dinfp_nu.h"
+
+// T2K CC1pi+ on CH
+#include "T2K_CC1pip_CH_XSec_1DAdlerPhi_nu.h"
+#include "T2K_CC1pip_CH_XSec_1DCosThAdler_nu.h"
+#include "T2K_CC1pip_CH_XSec_1DQ2_nu.h"
+#include "T2K_CC1pip_CH_XSec_1Dppi_nu.h"
+#include "T2K_CC1pip_CH_XSec_1Dthmupi_nu.h"
+#include "T2K_CC1pip_CH_XSec_1Dthpi_nu.h"
+#include "T2K_CC1pip_CH_XSec_2Dpmucosmu_nu.h"
+
+// T2K CCCOH (single bin)
+#include "T2K_CCCOH_C12_XSec_1DEnu_nu.h"
+
+// T2K CC1pi+ on H2O
+#include "T2K_CC1pip_H2O_XSec_1DEnuDelta_nu.h"
+#include "T2K_CC1pip_H2O_XSec_1DEnuMB_nu.h"
+#include "T2K_CC1pip_H2O_XSec_1Dcosmu_nu.h"
+#include "T2K_CC1pip_H2O_XSec_1Dcosmupi_nu.h"
+#include "T2K_CC1pip_H2O_XSec_1Dcospi_nu.h"
+#include "T2K_CC1pip_H2O_XSec_1Dpmu_nu.h"
+#include "T2K_CC1pip_H2O_XSec_1Dppi_nu.h"
+
+// add header here
+
+void SampleUtils::RegisterT2KSamples(SampleFactoryMap &factories) {
+  RegisterSample<T2K_CC0pi_XSec_2DPcos_nu_I>(factories,
+                                             "T2K_CC0pi_XSec_2DPcos_nu_I");
+  RegisterSample<T2K_CC0pi_XSec_2DPcos_nu_II>(factories,
+                                              "T2K_CC0pi_XSec_2DPcos_nu_II");
+  RegisterSample<T2K_CCinc_XSec_2DPcos_nu_nonuniform>(
+      factories, "T2K_CCinc_XSec_2DPcos_nu_nonuniform");
+  RegisterSample<T2K_CC0pi_XSec_H2O_2DPcos_anu>(
+      factories, "T2K_CC0pi_XSec_H2O_2DPcos_anu");
+  RegisterSample<T2K_NuMu_CC0pi_OC_XSec_2DPcos>(factories,
+                                                "T2K_NuMu_CC0pi_O_XSec_2DPcos");
+  RegisterSample<T2K_NuMu_CC0pi_OC_XSec_2DPcos>(factories,
+                                                "T2K_NuMu_CC0pi_C_XSec_2DPcos");
+  RegisterSample<T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint>(
+      factories, "T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint", false);
+  RegisterSample<T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos>(
+      factories, "T2K_NuMu_CC0pi_CH_XSec_2DPcos");
+  RegisterSample<T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos>(
+      factories, "T2K_AntiNuMu_CC0pi_CH_XSec_2DPcos");
+  RegisterSample<T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint>(
+      factories, "T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint", false);
+  RegisterSample<T2K_nueCCinc_XSec_1Dpe>(factories,
+                                         "T2K_nueCCinc_XSec_1Dpe_FHC");
+  RegisterSample<T2K_nueCCinc_XSec_1Dpe>(factories,
+                                         "T2K_nueCCinc_XSec_1Dpe_RHC");
+  RegisterSample<T2K_nueCCinc_XSec_1Dpe>(factories,
+                                         "T2K_nuebarCCinc_XSec_1Dpe_RHC");
+  RegisterSample<T2K_nueCCinc_XSec_1Dthe>(factories,
+                                          "T2K_nueCCinc_XSec_1Dthe_FHC");
+  RegisterSample<T2K_nueCCinc_XSec_1Dthe>(factories,
+                                          "T2K_nueCCinc_XSec_1Dthe_RHC");
+  RegisterSample<T2K_nueCCinc_XSec_1Dthe>(factories,
+                                          "T2K_nuebarCCinc_XSec_1Dthe_RHC");
+  RegisterSample<T2K_nueCCinc_XSec_1Dpe_joint>(
+      factories, "T2K_nueCCinc_XSec_1Dpe_joint", false);
+  RegisterSample<T2K_nueCCinc_XSec_1Dthe_joint>(
+      factories, "T2K_nueCCinc_XSec_1Dthe_joint", false);
+  RegisterSample<T2K_nueCCinc_XSec_joint>(factories,
+                                          "T2K_nueCCinc_XSec_joint", false);
+  RegisterSample<T2K_CC1pip_CH_XSec_2Dpmucosmu_nu>(
+      factories, "T2K_CC1pip_CH_XSec_2Dpmucosmu_nu");
+  RegisterSample<T2K_CC1pip_CH_XSec_1Dppi_nu>(factories,
+                                              "T2K_CC1pip_CH_XSec_1Dppi_nu");
+  RegisterSample<T2K_CC1pip_CH_XSec_1Dthpi_nu>(factories,
+                                               "T2K_CC1pip_CH_XSec_1Dthpi_nu");
+  RegisterSample<T2K_CC1pip_CH_XSec_1Dthmupi_nu>(
+      factories, "T2K_CC1pip_CH_XSec_1Dthmupi_nu");
+  RegisterSample<T2K_CC1pip_CH_XSec_1DQ2_nu>(factories,
+                                             "T2K_CC1pip_CH_XSec_1DQ2_nu");
+  RegisterSample<T2K_CC1pip_CH_XSec_1DAdlerPhi_nu>(
+      factories, "T2K_CC1pip_CH_XSec_1DAdlerPhi_nu");
+  RegisterSample<T2K_CC1pip_CH_XSec_1DCosThAdler_nu>(
+      factories, "T2K_CC1pip_CH_XSec_1DCosThAdler_nu");
+  RegisterSample<T2K_CCCOH_C12_XSec_1DEnu_nu>(factories,
+                                              "T2K_CCCOH_C12_XSec_1DEnu_nu");
+  RegisterSample<T2K_CC1pip_H2O_XSec_1DEnuDelta_nu>(
+      factories, "T2K_CC1pip_H2O_XSec_1DEnuDelta_nu");
+  RegisterSample<T2K_CC1pip_H2O_XSec_1DEnuMB_nu>(
+      factories, "T2K_CC1pip_H2O_XSec_1DEnuMB_nu");
+  RegisterSample<T2K_CC1pip_H2O_XSec_1Dcosmu_nu>(
+      factories, "T2K_CC1pip_H2O_XSec_1Dcosmu_nu");
+  RegisterSample<T2K_CC1pip_H2O_XSec_1Dcosmupi_nu>(
+      factories, "T2K_CC1pip_H2O_XSec_1Dcosmupi_nu");
+  RegisterSample<T2K_CC1pip_H2O_XSec_1Dcospi_nu>(
+      factories, "T2K_CC1pip_H2O_XSec_1Dcospi_nu");
+  RegisterSample<T2K_CC1pip_H2O_XSec_1Dpmu_nu>(factories,
+                                               "T2K_CC1pip_H2O_XSec_1Dpmu_nu");
+  RegisterSample<T2K_CC1pip_H2O_XSec_1Dppi_nu>(factories,
+                                               "T2K_CC1pip_H2O_XSec_1Dppi_nu");
+  RegisterSample<T2K_CC0pinp_STV_XSec_1Ddpt_nu>(
+      factories, "T2K_CC0pinp_STV_XSec_1Ddpt_nu");
+  RegisterSample<T2K_CC0pinp_STV_XSec_1Ddphit_nu>(
+      factories, "T2K_CC0pinp_STV_XSec_1Ddphit_nu");
+  RegisterSample<T2K_CC0pinp_STV_XSec_1Ddat_nu>(
+      factories, "T2K_CC0pinp_STV_XSec_1Ddat_nu");
+  RegisterSample<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      factories, "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np");
+  RegisterSample<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      factories, "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p");
+  RegisterSample<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      factories, "T2K_CC0piWithProtons_XSec_2018_multidif_0p");
+  RegisterSample<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      factories, "T2K_CC0piWithProtons_XSec_2018_multidif_1p");
+  RegisterSample<T2K_CC0pinp_ifk_XSec_3Dinfp_nu>(
+      factories, "T2K_CC0pinp_ifk_XSec_3Dinfp_nu");
+  RegisterSample<T2K_CC0pinp_ifk_XSec_3Dinfa_nu>(
+      factories, "T2K_CC0pinp_ifk_XSec_3Dinfa_nu");
+  RegisterSample<T2K_CC0pinp_ifk_XSec_3Dinfip_nu>(
+      factories, "T2K_CC0pinp_ifk_XSec_3Dinfip_nu");
+}
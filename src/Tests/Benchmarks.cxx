@@ -0,0 +1,531 @@
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "ConstructibleFitEvent.h"
+#include "FitEvent.h"
+#include "GenericFlux_Vectors.h"
+#include "JointFCN.h"
+#include "ParserUtils.h"
+#include "ProfileUtils.h"
+#include "SignalDef.h"
+#include "SplineReader.h"
+#include "StatUtils.h"
+
+#include "TFile.h"
+#include "TH1D.h"
+#include "TMatrixDSym.h"
+#include "TRandom3.h"
+#include "TTree.h"
+
+/// Throughput benchmarks of the event loop and statistics hot paths, run on
+/// reproducible synthetic events so that no generator is needed.
+///
+/// Results are printed one benchmark per line as
+///   name calls best_s mean_s calls_per_s checksum
+/// in a fixed order. The checksum only depends on the seed and event options,
+/// so a change in it flags a change in behaviour rather than speed.
+
+namespace {
+
+struct BenchmarkOptions {
+  int nevents;
+  int repeats;
+  int seed;
+  int maxnucleons;
+  int maxpions;
+  std::vector<int> modes;
+  std::vector<std::string> samples;
+  std::string eventfile;
+  std::string outputfile;
+};
+
+struct BenchmarkResult {
+  std::string name;
+  long long calls;
+  double best;
+  double mean;
+  double checksum;
+};
+
+std::vector<BenchmarkResult> gResults;
+
+/// Run bench repeats times. bench does calls units of work and returns a
+/// checksum, which must be the same every repeat.
+template <typename F>
+void RunBenchmark(std::string const &name, long long calls, int repeats,
+                  F bench) {
+  BenchmarkResult result;
+  result.name = name;
+  result.calls = calls;
+  result.best = -1;
+  result.mean = 0;
+  result.checksum = 0;
+
+  for (int r = 0; r < repeats; ++r) {
+    long long start = ProfileUtils::Now();
+    double checksum = bench();
+    double seconds = (ProfileUtils::Now() - start) * 1E-9;
+
+    if (r && checksum != result.checksum) {
+      NUIS_ERR(WRN, name << " gave checksum " << checksum << " on repeat " << r
+                         << ", expected " << result.checksum);
+    }
+    result.checksum = checksum;
+    result.mean += seconds / repeats;
+    if (result.best < 0 || seconds < result.best) {
+      result.best = seconds;
+    }
+  }
+
+  NUIS_LOG(FIT, std::left << std::setw(40) << name << " : " << result.best
+                          << " s");
+  gResults.push_back(result);
+}
+
+double SyntheticMass(int pdg) {
+  switch (abs(pdg)) {
+  case 11:
+    return 0.511;
+  case 13:
+    return 105.658;
+  case 111:
+    return 134.977;
+  case 211:
+    return 139.570;
+  case 2112:
+    return 939.565;
+  case 2212:
+    return 938.272;
+  default:
+    return 0.0;
+  }
+}
+
+void AddSyntheticParticle(ConstructibleFitEvent &fe, TRandom3 &rnd, int pdg,
+                          double pmag, double costheta) {
+  TVector3 mom;
+  mom.SetMagThetaPhi(pmag, acos(costheta), 2 * M_PI * rnd.Uniform());
+  double E = sqrt(pmag * pmag + SyntheticMass(pdg) * SyntheticMass(pdg));
+  double p4[4] = {mom.X(), mom.Y(), mom.Z(), E};
+  fe.AddPart(p4, kFinalState, pdg);
+}
+
+void AddSyntheticHadron(ConstructibleFitEvent &fe, TRandom3 &rnd, int pdg) {
+  AddSyntheticParticle(fe, rnd, pdg, fabs(rnd.Gaus(300, 150)),
+                       rnd.Uniform(-1, 1));
+}
+
+/// Fill fe with a numu interaction of the given NEUT-like mode. Modes below
+/// 30 are CC, the rest NC. Extra nucleons and pions are drawn up to the
+/// configured multiplicities.
+void MakeSyntheticEvent(ConstructibleFitEvent &fe, TRandom3 &rnd, int mode,
+                        BenchmarkOptions const &opts) {
+  fe.ResetEvent();
+  fe.fNParticles = 0;
+
+  double enu = rnd.Uniform(300, 3000);
+  double nu[4] = {0, 0, enu, enu};
+  fe.AddPart(nu, kInitialState, 14);
+
+  bool cc = abs(mode) < 30;
+  AddSyntheticParticle(fe, rnd, cc ? 13 : 14, enu * rnd.Uniform(0.2, 0.9),
+                       rnd.Uniform(-0.2, 1));
+
+  int npions = 0;
+  int pionpdg = 211;
+  switch (abs(mode)) {
+  case 11:
+  case 13:
+  case 16:
+  case 34:
+    npions = 1;
+    break;
+  case 12:
+  case 31:
+  case 32:
+    npions = 1;
+    pionpdg = 111;
+    break;
+  case 33:
+    npions = 1;
+    pionpdg = -211;
+    break;
+  case 21:
+  case 26:
+  case 41:
+  case 46:
+    npions = 2 + rnd.Integer(std::max(opts.maxpions - 1, 1));
+    pionpdg = 0;
+    break;
+  }
+
+  int nnucleons = (abs(mode) == 16 || abs(mode) == 36) ? 0 : 1;
+  if (abs(mode) == 2) {
+    nnucleons = 2;
+  }
+  if (nnucleons) {
+    nnucleons += rnd.Integer(opts.maxnucleons + 1);
+  }
+
+  for (int i = 0; i < nnucleons; ++i) {
+    AddSyntheticHadron(fe, rnd, rnd.Uniform() < 0.5 ? 2212 : 2112);
+  }
+  for (int i = 0; i < npions; ++i) {
+    int pdg = pionpdg;
+    if (!pdg) {
+      int const charges[3] = {211, 111, -211};
+      pdg = charges[rnd.Integer(3)];
+    }
+    AddSyntheticHadron(fe, rnd, pdg);
+  }
+
+  fe.SetMode(mode);
+  fe.InputWeight = 1.0;
+  fe.OrderStack();
+}
+
+/// Write the synthetic events as a NUISANCE FitEvent input, flat in Enu.
+void WriteSyntheticEvents(BenchmarkOptions const &opts,
+                          std::vector<ConstructibleFitEvent *> &pool,
+                          size_t poolsize) {
+  TFile *outfile = new TFile(opts.eventfile.c_str(), "RECREATE");
+
+  TH1D *fluxhist =
+      new TH1D("nuisance_fluxhist", "nuisance_fluxhist", 100, 0, 5);
+  for (int i = 1; i <= fluxhist->GetNbinsX(); ++i) {
+    double center = fluxhist->GetXaxis()->GetBinCenter(i);
+    fluxhist->SetBinContent(i, (center > 0.3 && center < 3.0) ? 1.0 : 0.0);
+  }
+  TH1D *eventhist = (TH1D *)fluxhist->Clone("nuisance_eventhist");
+  eventhist->SetTitle("nuisance_eventhist");
+
+  TRandom3 rnd(opts.seed);
+  ConstructibleFitEvent fe;
+  TTree *eventtree = new TTree("nuisance_events", "nuisance_events");
+  fe.AddBranchesToTree(eventtree);
+
+  for (int i = 0; i < opts.nevents; ++i) {
+    int mode = opts.modes[rnd.Integer(opts.modes.size())];
+    MakeSyntheticEvent(fe, rnd, mode, opts);
+    fe.RWWeight = 1.0;
+    eventtree->Fill();
+
+    if (pool.size() < poolsize) {
+      pool.push_back(new ConstructibleFitEvent());
+      pool.back()->CopyEventFrom(fe);
+    }
+  }
+
+  outfile->cd();
+  fluxhist->Write();
+  eventhist->Write();
+  eventtree->Write();
+  outfile->Close();
+  delete outfile;
+}
+
+void BenchmarkSignalDef(BenchmarkOptions const &opts,
+                        std::vector<ConstructibleFitEvent *> const &pool) {
+  long long ncalls = opts.nevents;
+
+#define SIGNALDEF_BENCHMARK(name, call)                                        \
+  RunBenchmark("signaldef/" name, ncalls, opts.repeats, [&]() {               \
+    double npass = 0;                                                          \
+    for (long long i = 0; i < ncalls; ++i) {                                   \
+      FitEvent *event = pool[i % pool.size()];                                 \
+      npass += (call);                                                         \
+    }                                                                          \
+    return npass;                                                              \
+  })
+
+  SIGNALDEF_BENCHMARK("isCCINC", SignalDef::isCCINC(event, 14));
+  SIGNALDEF_BENCHMARK("isNCINC", SignalDef::isNCINC(event, 14));
+  SIGNALDEF_BENCHMARK("isCC0pi", SignalDef::isCC0pi(event, 14));
+  SIGNALDEF_BENCHMARK("isCCQELike", SignalDef::isCCQELike(event, 14));
+  SIGNALDEF_BENCHMARK("isCC1pi", SignalDef::isCC1pi(event, 14, 211));
+  SIGNALDEF_BENCHMARK("isNC1pi", SignalDef::isNC1pi(event, 14, 111));
+  SIGNALDEF_BENCHMARK("isCCCOH", SignalDef::isCCCOH(event, 14, 211));
+  SIGNALDEF_BENCHMARK("HasProtonKEAboveThreshold",
+                      SignalDef::HasProtonKEAboveThreshold(event, 110));
+
+#undef SIGNALDEF_BENCHMARK
+}
+
+void BenchmarkStatUtils(BenchmarkOptions const &opts) {
+  TRandom3 rnd(opts.seed);
+  int const nbins = 50;
+  TH1D data("bench_data", "", nbins, 0, 1);
+  TH1D mc("bench_mc", "", nbins, 0, 1);
+  for (int i = 1; i <= nbins; ++i) {
+    double val = 100 + 50 * rnd.Uniform();
+    data.SetBinContent(i, val);
+    data.SetBinError(i, sqrt(val));
+    mc.SetBinContent(i, val * rnd.Gaus(1, 0.05));
+  }
+
+  // Smooth positive definite covariance with neighbouring bin correlations
+  TMatrixDSym cov(nbins);
+  for (int i = 0; i < nbins; ++i) {
+    for (int j = 0; j < nbins; ++j) {
+      cov(i, j) = data.GetBinError(i + 1) * data.GetBinError(j + 1) *
+                  exp(-fabs(i - j) / 3.0);
+    }
+  }
+  TMatrixDSym *invcov = StatUtils::GetInvert(&cov);
+
+  long long ncalls = std::max(opts.nevents / 100, 1);
+
+  RunBenchmark("statutils/GetChi2FromDiag", ncalls, opts.repeats, [&]() {
+    double sum = 0;
+    for (long long i = 0; i < ncalls; ++i) {
+      sum += StatUtils::GetChi2FromDiag(&data, &mc);
+    }
+    return sum / ncalls;
+  });
+  RunBenchmark("statutils/GetChi2FromCov", ncalls, opts.repeats, [&]() {
+    double sum = 0;
+    for (long long i = 0; i < ncalls; ++i) {
+      sum += StatUtils::GetChi2FromCov(&data, &mc, invcov, NULL, 1, 1);
+    }
+    return sum / ncalls;
+  });
+
+  // Same covariance split into five uncorrelated sub-samples
+  TMatrixDSym blockcov(cov);
+  for (int i = 0; i < nbins; ++i) {
+    for (int j = 0; j < nbins; ++j) {
+      if (i / 10 != j / 10) {
+        blockcov(i, j) = 0;
+      }
+    }
+  }
+  TMatrixDSym *blockinvcov = StatUtils::GetInvert(&blockcov);
+  StatUtils::CovarBlocks blocks = StatUtils::GetCovarBlocks(blockinvcov);
+
+  RunBenchmark("statutils/GetChi2FromCov_dense_blockdiag", ncalls,
+               opts.repeats, [&]() {
+                 double sum = 0;
+                 for (long long i = 0; i < ncalls; ++i) {
+                   sum += StatUtils::GetChi2FromCov(&data, &mc, blockinvcov,
+                                                    NULL, 1, 1);
+                 }
+                 return sum / ncalls;
+               });
+  RunBenchmark("statutils/GetChi2FromCov_blocks", ncalls, opts.repeats,
+               [&]() {
+                 double sum = 0;
+                 for (long long i = 0; i < ncalls; ++i) {
+                   sum += StatUtils::GetChi2FromCov(&data, &mc, blockinvcov,
+                                                    blocks, NULL, 1, 1);
+                 }
+                 return sum / ncalls;
+               });
+  delete blockinvcov;
+
+  RunBenchmark("statutils/GetChi2FromSVD", ncalls, opts.repeats, [&]() {
+    double sum = 0;
+    for (long long i = 0; i < ncalls; ++i) {
+      sum += StatUtils::GetChi2FromSVD(&data, &mc, &cov);
+    }
+    return sum / ncalls;
+  });
+  RunBenchmark("statutils/GetChi2FromEventRate", ncalls, opts.repeats, [&]() {
+    double sum = 0;
+    for (long long i = 0; i < ncalls; ++i) {
+      sum += StatUtils::GetChi2FromEventRate(&data, &mc);
+    }
+    return sum / ncalls;
+  });
+
+  delete invcov;
+}
+
+void BenchmarkSplineReader(BenchmarkOptions const &opts) {
+  SplineReader reader;
+  char const *forms[3][3] = {{"MaCCQE", "1DPol3", "-3,-2,-1,0,1,2,3"},
+                             {"MaRES", "1DPol6", "-3,-2,-1,0,1,2,3"},
+                             {"CA5", "1DTSpline3", "-3,-2,-1,0,1,2,3"}};
+  for (int i = 0; i < 3; ++i) {
+    nuiskey splkey = Config::CreateKey("spline");
+    splkey.Set("name", forms[i][0]);
+    splkey.Set("type", "benchmark");
+    splkey.Set("form", forms[i][1]);
+    splkey.Set("points", forms[i][2]);
+    reader.AddSpline(splkey);
+  }
+
+  std::map<std::string, double> vals;
+  vals["MaCCQE"] = 0.5;
+  vals["MaRES"] = -0.7;
+  vals["CA5"] = 1.3;
+  reader.Reconfigure(vals);
+
+  // Small coefficients keep the polynomial weights close to one
+  TRandom3 rnd(opts.seed);
+  int npar = reader.GetNPar();
+  size_t nsets = std::min(opts.nevents, 10000);
+  std::vector<float> coeffs(nsets * npar);
+  for (size_t i = 0; i < coeffs.size(); ++i) {
+    coeffs[i] = rnd.Gaus(0, 0.1);
+  }
+
+  long long ncalls = opts.nevents;
+  RunBenchmark("splines/SplineReader::CalcWeight", ncalls, opts.repeats,
+               [&]() {
+                 double sum = 0;
+                 for (long long i = 0; i < ncalls; ++i) {
+                   sum += reader.CalcWeight(&coeffs[(i % nsets) * npar]);
+                 }
+                 return sum;
+               });
+}
+
+void BenchmarkFlattening(BenchmarkOptions const &opts) {
+  GenericFlux_Vectors *vectors =
+      new GenericFlux_Vectors("GenericVectors_Benchmark",
+                              "FEVENT:" + opts.eventfile, FitBase::GetRW(),
+                              "", "");
+
+  RunBenchmark("flat/GenericFlux_Vectors::Reconfigure", opts.nevents,
+               opts.repeats, [&]() {
+                 vectors->Reconfigure();
+                 return double(vectors->GetInput()->GetNEvents());
+               });
+  delete vectors;
+}
+
+void BenchmarkJointFCN(BenchmarkOptions const &opts, TFile *outfile) {
+  std::vector<nuiskey> samplekeys;
+  for (size_t i = 0; i < opts.samples.size(); ++i) {
+    nuiskey samplekey = Config::CreateKey("sample");
+    samplekey.Set("name", opts.samples[i]);
+    samplekey.Set("input", "FEVENT:" + opts.eventfile);
+    samplekeys.push_back(samplekey);
+  }
+
+  JointFCN *fcn = new JointFCN(samplekeys, outfile);
+
+  RunBenchmark("fcn/ReconfigureAllEvents", opts.nevents, opts.repeats, [&]() {
+    fcn->ReconfigureAllEvents();
+    return fcn->GetLikelihood();
+  });
+  RunBenchmark("fcn/ReconfigureSignal", opts.nevents, opts.repeats, [&]() {
+    fcn->ReconfigureSignal();
+    return fcn->GetLikelihood();
+  });
+  RunBenchmark("fcn/GetLikelihood", opts.samples.size(), opts.repeats,
+               [&]() { return fcn->GetLikelihood(); });
+
+  delete fcn;
+}
+
+void PrintResults(BenchmarkOptions const &opts, std::ostream &os) {
+  os << "# nevents=" << opts.nevents << " repeats=" << opts.repeats
+     << " seed=" << opts.seed << " maxnucleons=" << opts.maxnucleons
+     << " maxpions=" << opts.maxpions << std::endl;
+  os << "# name calls best_s mean_s calls_per_s checksum" << std::endl;
+  for (size_t i = 0; i < gResults.size(); ++i) {
+    BenchmarkResult const &res = gResults[i];
+    os << res.name << " " << res.calls << " " << std::setprecision(6)
+       << res.best << " " << res.mean << " "
+       << (res.best > 0 ? res.calls / res.best : 0) << " "
+       << std::setprecision(12) << res.checksum << std::endl;
+  }
+}
+
+void PrintUsage() {
+  std::cout
+      << "Benchmarks [-n nevents] [-r repeats] [-s seed] [-m modes]\n"
+      << "           [-N maxnucleons] [-P maxpions] [-S samples] [-f eventfile]\n"
+      << "           [-o results.txt]\n\n"
+      << "  -m : comma separated NEUT modes to draw events from.\n"
+      << "  -S : comma separated samples for the JointFCN benchmarks, NONE "
+         "skips them.\n"
+      << "  -f : where to write the synthetic events, removed afterwards.\n"
+      << std::endl;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  SETVERBOSITY(FIT);
+
+  BenchmarkOptions opts;
+  opts.nevents = 100000;
+  opts.repeats = 5;
+  opts.seed = 1;
+  opts.maxnucleons = 3;
+  opts.maxpions = 3;
+  opts.eventfile = "nuisance_benchmark_events.root";
+
+  std::string modes = "1,2,11,12,13,16,21,26,31,32,51,52";
+  std::string samples = "MiniBooNE_CCQE_XSec_1DQ2_nu,ANL_CCQE_XSec_1DEnu_nu,"
+                        "MINERvA_CC1pip_XSec_1DTpi_nu,"
+                        "T2K_CC0pi_XSec_2DPcos_nu_I";
+
+  std::vector<std::string> args = GeneralUtils::LoadCharToVectStr(argc, argv);
+  bool help = false;
+  ParserUtils::ParseFlag(args, "-h", help);
+  if (help) {
+    PrintUsage();
+    return 0;
+  }
+  ParserUtils::ParseArgument(args, "-n", opts.nevents, false, false);
+  ParserUtils::ParseArgument(args, "-r", opts.repeats, false, false);
+  ParserUtils::ParseArgument(args, "-s", opts.seed, false, false);
+  ParserUtils::ParseArgument(args, "-N", opts.maxnucleons, false, false);
+  ParserUtils::ParseArgument(args, "-P", opts.maxpions, false, false);
+  ParserUtils::ParseArgument(args, "-m", modes, false, false);
+  ParserUtils::ParseArgument(args, "-S", samples, false, false);
+  ParserUtils::ParseArgument(args, "-f", opts.eventfile, false, false);
+  ParserUtils::ParseArgument(args, "-o", opts.outputfile, false, false);
+  ParserUtils::CheckBadArguments(args);
+
+  opts.modes = GeneralUtils::ParseToInt(modes, ",");
+  if (samples != "NONE") {
+    opts.samples = GeneralUtils::ParseToStr(samples, ",");
+  }
+  if (opts.nevents < 1 || opts.repeats < 1 || opts.modes.empty()) {
+    PrintUsage();
+    NUIS_ABORT("Benchmarks need at least one event, repeat and mode.");
+  }
+
+  NUIS_LOG(FIT, "*            Running Benchmarks");
+  NUIS_LOG(FIT, "***************************************************");
+
+  Config::SetPar("EventManager", true);
+  Config::SetPar("SignalReconfigures", true);
+
+  std::vector<ConstructibleFitEvent *> pool;
+  WriteSyntheticEvents(opts, pool, 1000);
+
+  std::string outname = opts.eventfile + ".out.root";
+  TFile *outfile = new TFile(outname.c_str(), "RECREATE");
+  Config::Get().out = outfile;
+
+  BenchmarkSignalDef(opts, pool);
+  BenchmarkStatUtils(opts);
+  BenchmarkSplineReader(opts);
+  BenchmarkFlattening(opts);
+  if (!opts.samples.empty()) {
+    BenchmarkJointFCN(opts, outfile);
+  }
+
+  PrintResults(opts, std::cout);
+  if (!opts.outputfile.empty()) {
+    std::ofstream ofs(opts.outputfile.c_str());
+    PrintResults(opts, ofs);
+  }
+
+  outfile->Close();
+  delete outfile;
+  std::remove(outname.c_str());
+  std::remove(opts.eventfile.c_str());
+
+  for (size_t i = 0; i < pool.size(); ++i) {
+    delete pool[i];
+  }
+  return 0;
+}
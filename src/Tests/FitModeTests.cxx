@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "ConstructibleFitEvent.h"
+#include "ConstructibleInputHandler.h"
+#include "Measurement1D.h"
+#include "Measurement2D.h"
+#include "StatUtils.h"
+
+#include "TRandom.h"
+
+/// Minimal 1D sample with fine and true mode histograms enabled, used to check
+/// that a fit mode reconfigure followed by a full pass writes the same
+/// histograms as a normal reconfigure.
+struct FitModeTestSample : public Measurement1D {
+
+  std::vector<ConstructibleFitEvent *> FitEvents;
+  FitModeTestSample(std::string const &name, int nbins = 3) {
+    ConstructibleInputHandler *cih = new ConstructibleInputHandler(name);
+    fInput = cih;
+
+    nuiskey samplekey = Config::CreateKey("sample");
+    samplekey.Set("name", name);
+    samplekey.Set("type", "DIAG");
+
+    fSettings = SampleSettings(samplekey);
+    fSettings.SetTitle(name);
+    FinaliseSampleSettings();
+
+    fDataHist = new TH1D((name + "_data").c_str(), "", nbins, 0, nbins);
+    fScaleFactor = 1;
+
+    int IS[] = {14};
+    int FS[] = {13, 2212};
+    int Modes[] = {1, 2, 11, 12};
+    for (int i = 0; i < 12; ++i) {
+      FitEvents.push_back(
+          new ConstructibleFitEvent(MakePDGStackEvent(IS, FS, Modes[i % 4])));
+      FitEvents.back()->InputWeight = 0.5 + 0.25 * i;
+      cih->AddFitEvent(FitEvents.back());
+    }
+    for (int i = 0; i < nbins; ++i) {
+      fDataHist->SetBinContent(i + 1, 1.0 + 0.5 * i);
+      fDataHist->SetBinError(i + 1, 0.1);
+    }
+
+    FinaliseMeasurement();
+  }
+
+  void FillEventVariables(FitEvent *nvect) {
+    // Spread events across the fine binning as well as the coarse binning
+    fXVar = 0.1 + 0.2 * (nvect->InputWeight * 4 - 2);
+  }
+
+  bool isSignal(FitEvent *nvect) { return true; }
+
+  TrueModeStack *GetModeStack() { return fMCHist_Modes; }
+  TrueModeStack *GetFineModeStack() { return fMCFine_Modes; }
+
+  virtual ~FitModeTestSample() {
+    for (size_t fe_it = 0; fe_it < FitEvents.size(); ++fe_it) {
+      delete FitEvents[fe_it];
+    }
+  }
+};
+
+/// Sample that builds fMCHist from auto-processed slice histograms in
+/// ConvertEventRates, as several T2K multi-differential samples do.
+struct FitModeSliceTestSample : public FitModeTestSample {
+
+  std::vector<TH1D *> fMCHist_Slices;
+  FitModeSliceTestSample(std::string const &name)
+      : FitModeTestSample(name, 4) {
+    for (int i = 0; i < 2; ++i) {
+      fMCHist_Slices.push_back(new TH1D(
+          Form("%s_MC_Slice%i", name.c_str(), i), "", 2, 0, 2.4));
+      SetAutoProcessTH1(fMCHist_Slices[i]);
+    }
+  }
+
+  void FillEventVariables(FitEvent *nvect) {
+    FitModeTestSample::FillEventVariables(nvect);
+    fYVar = nvect->Mode;
+  }
+
+  void FillHistograms() {
+    Measurement1D::FillHistograms();
+    if (Signal) {
+      fMCHist_Slices[(fYVar < 10) ? 0 : 1]->Fill(fXVar, Weight);
+    }
+  }
+
+  void ConvertEventRates() {
+    Measurement1D::ConvertEventRates();
+
+    fMCHist->Reset();
+    for (int i = 0; i < 2; ++i) {
+      for (int j = 0; j < 2; ++j) {
+        fMCHist->SetBinContent(2 * i + j + 1,
+                               fMCHist_Slices[i]->GetBinContent(j + 1));
+      }
+    }
+  }
+};
+
+bool Close(double a, double b) {
+  return fabs(a - b) <= 1E-9 * std::max(fabs(a), fabs(b));
+}
+
+/// Small 2D sample with a correlated covariance, used to check the n-1 chi2
+/// plot against a masked chi2 for each bin.
+struct Chi2LessBinTestSample : public Measurement2D {
+
+  Chi2LessBinTestSample(std::string const &name) {
+    fInput = new ConstructibleInputHandler(name);
+
+    nuiskey samplekey = Config::CreateKey("sample");
+    samplekey.Set("name", name);
+    samplekey.Set("type", "FULL");
+
+    fSettings = SampleSettings(samplekey);
+    fSettings.SetTitle(name);
+    FinaliseSampleSettings();
+
+    fDataHist = new TH2D((name + "_data").c_str(), "", 3, 0, 3, 2, 0, 2);
+    fFullCovar = new TMatrixDSym(6);
+    for (int i = 0; i < 6; ++i) {
+      for (int j = 0; j < 6; ++j) {
+        (*fFullCovar)(i, j) =
+            (i == j) ? 0.04 + 0.01 * i : 0.01 / (1 + abs(i - j));
+      }
+    }
+    fScaleFactor = 1;
+
+    FinaliseMeasurement();
+
+    for (int xi = 0; xi < 3; ++xi) {
+      for (int yi = 0; yi < 2; ++yi) {
+        int i = 2 * xi + yi;
+        fDataHist->SetBinContent(xi + 1, yi + 1, (1.0 + 0.2 * i) * 1E-38);
+        fMCHist->SetBinContent(xi + 1, yi + 1, (1.1 + 0.15 * i) * 1E-38);
+      }
+    }
+  }
+
+  void FillEventVariables(FitEvent *nvect) {}
+
+  bool isSignal(FitEvent *nvect) { return false; }
+
+  /// Mask a bin through SetBinMask, as a mask file would
+  void MaskBin(int xi, int yi) {
+    std::string maskfile = fName + ".mask";
+    std::ofstream ofs(maskfile.c_str());
+    ofs << xi + 1 << " " << yi + 1 << " 1" << std::endl;
+    ofs.close();
+    fIsMask = true;
+    SetBinMask(maskfile);
+    std::remove(maskfile.c_str());
+  }
+
+  /// Compare the likelihood and each bin of the n-1 plot with the dense
+  /// masked chi2
+  bool CheckChi2LessBin(std::string const &what) {
+    delete fChi2LessBinHist;
+    fChi2LessBinHist =
+        (TH2D *)fMCHist->Clone((fName + "_Chi2NMinusOne").c_str());
+    fChi2LessBinHist->Reset();
+
+    fIsWriting = true;
+    double chi2 = GetLikelihood();
+    fIsWriting = false;
+
+    bool pass = true;
+    double densechi2 = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar,
+                                                 fMapHist, fMaskHist);
+    if (!Close(chi2, densechi2)) {
+      NUIS_ERR(FTL, what << " chi2 " << chi2 << " differs from dense chi2 "
+                         << densechi2);
+      pass = false;
+    }
+
+    for (int xi = 0; xi < 3; ++xi) {
+      for (int yi = 0; yi < 2; ++yi) {
+        TH2I *binmask = fMaskHist
+                            ? static_cast<TH2I *>(fMaskHist->Clone("mask"))
+                            : new TH2I("mask", "", 3, 0, 3, 2, 0, 2);
+        binmask->SetDirectory(NULL);
+        binmask->SetBinContent(xi + 1, yi + 1, 1);
+        double lessbin = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar,
+                                                   fMapHist, binmask);
+        delete binmask;
+
+        if (!Close(fChi2LessBinHist->GetBinContent(xi + 1, yi + 1),
+                   lessbin)) {
+          NUIS_ERR(FTL, what << " n-1 chi2 without bin " << xi + 1 << ","
+                             << yi + 1 << " = "
+                             << fChi2LessBinHist->GetBinContent(xi + 1, yi + 1)
+                             << ", masked chi2 = " << lessbin);
+          pass = false;
+        }
+      }
+    }
+    if (pass) {
+      NUIS_LOG(SAM, what << " n-1 chi2 matches masked chi2s.");
+    }
+    return pass;
+  }
+};
+
+bool SameHist(TH1 *a, TH1 *b, std::string const &what) {
+  bool same = (a->GetNcells() == b->GetNcells());
+  for (int i = 0; same && i < a->GetNcells(); ++i) {
+    same = (a->GetBinContent(i) == b->GetBinContent(i)) &&
+           (a->GetBinError(i) == b->GetBinError(i));
+  }
+  if (!same) {
+    NUIS_ERR(FTL, what << " differs between fit mode and a full reconfigure.");
+  } else {
+    NUIS_LOG(SAM, what << " identical.");
+  }
+  return same;
+}
+
+bool SameStack(StackBase *a, StackBase *b, std::string const &what) {
+  bool same = (a->fAllHists.size() == b->fAllHists.size());
+  for (size_t i = 0; same && i < a->fAllHists.size(); ++i) {
+    same = SameHist(a->fAllHists[i], b->fAllHists[i],
+                    what + " " + a->fAllLabels[i]);
+  }
+  return same;
+}
+
+bool SameBlocks(StatUtils::CovarBlocks const &blocks,
+                StatUtils::CovarBlocks const &expected,
+                std::string const &what) {
+  if (blocks != expected) {
+    NUIS_ERR(FTL, what << " split into " << blocks.size()
+                       << " blocks, expected " << expected.size() << ".");
+    return false;
+  }
+  NUIS_LOG(SAM, what << " blocks as expected.");
+  return true;
+}
+
+/// Build a covariance from diagonal blocks of the given sizes and check that
+/// the block layout is found, survives inversion, and that the block chi2
+/// and throw match the dense calculations.
+bool CheckBlockCovar(std::vector<int> const &sizes, std::string const &what) {
+  StatUtils::CovarBlocks expected;
+  int nbins = 0;
+  for (size_t b = 0; b < sizes.size(); ++b) {
+    expected.push_back(std::make_pair(nbins, nbins + sizes[b] - 1));
+    nbins += sizes[b];
+  }
+
+  // Diagonally dominant, so positive definite
+  TMatrixDSym cov(nbins);
+  for (size_t b = 0; b < expected.size(); ++b) {
+    for (int i = expected[b].first; i <= expected[b].second; ++i) {
+      for (int j = expected[b].first; j <= expected[b].second; ++j) {
+        cov(i, j) = (i == j) ? 2.0 + 0.1 * i : 0.5 / (1 + abs(i - j));
+      }
+    }
+  }
+
+  bool pass = SameBlocks(StatUtils::GetCovarBlocks(&cov), expected, what);
+
+  TMatrixDSym *inv = StatUtils::GetInvert(&cov);
+  pass = SameBlocks(StatUtils::GetCovarBlocks(inv), expected,
+                    what + " inverse") &&
+         pass;
+  TMatrixD unit(*inv, TMatrixD::kMult, cov);
+  for (int i = 0; i < nbins; ++i) {
+    for (int j = 0; j < nbins; ++j) {
+      if (fabs(unit(i, j) - (i == j)) > 1E-9) {
+        NUIS_ERR(FTL, what << " inverse times covariance (" << i << ", " << j
+                           << ") = " << unit(i, j));
+        pass = false;
+      }
+    }
+  }
+
+  TH1D data((what + "_data").c_str(), "", nbins, 0, nbins);
+  TH1D mc((what + "_mc").c_str(), "", nbins, 0, nbins);
+  TH1D zero((what + "_zero").c_str(), "", nbins, 0, nbins);
+  for (int i = 0; i < nbins; ++i) {
+    data.SetBinContent(i + 1, 1.0 + 0.5 * i);
+    mc.SetBinContent(i + 1, 1.2 + 0.3 * i);
+  }
+
+  double densechi2 = StatUtils::GetChi2FromCov(&data, &mc, inv, NULL, 1, 1);
+  double blockchi2 =
+      StatUtils::GetChi2FromCov(&data, &mc, inv, expected, NULL, 1, 1);
+  if (!Close(densechi2, blockchi2)) {
+    NUIS_ERR(FTL, what << " block chi2 " << blockchi2
+                       << " differs from dense chi2 " << densechi2);
+    pass = false;
+  }
+
+  // Same random numbers, so the block throw matches the dense throw
+  gRandom->SetSeed(1234);
+  TH1D *densethrow = StatUtils::ThrowHistogram(&zero, &cov);
+  gRandom->SetSeed(1234);
+  TH1D *blockthrow = StatUtils::ThrowHistogram(&zero, &cov, expected);
+  for (int i = 0; i < nbins; ++i) {
+    if (!Close(densethrow->GetBinContent(i + 1),
+               blockthrow->GetBinContent(i + 1))) {
+      NUIS_ERR(FTL, what << " block throw differs from dense throw in bin "
+                         << i + 1);
+      pass = false;
+    }
+  }
+
+  delete densethrow;
+  delete blockthrow;
+  delete inv;
+  return pass;
+}
+
+int main(int argc, char const *argv[]) {
+  bool FailOnFail = (argc > 1);
+  SETVERBOSITY(SAM);
+
+  NUIS_LOG(FIT, "*            Running FitMode Tests");
+  NUIS_LOG(FIT, "***************************************************");
+
+  Config::SetPar("drawopts", "DATA/MC/MODES/FINE");
+
+  // Reference: a normal full reconfigure
+  FitModeTestSample full("FitModeTest_Full");
+  full.Reconfigure();
+
+  // Several fit mode reconfigures, as the minimiser would do
+  FitModeTestSample lean("FitModeTest_Lean");
+  lean.SetFitMode(true);
+  for (int i = 0; i < 3; ++i) {
+    lean.Reconfigure();
+  }
+
+  bool pass = true;
+
+  NUIS_LOG(FIT, "*            Testing: fit mode likelihood");
+  pass = SameHist(full.GetMCList()[0], lean.GetMCList()[0], "MC") && pass;
+  if (full.GetLikelihood() != lean.GetLikelihood()) {
+    NUIS_ERR(FTL, "Likelihood differs in fit mode: "
+                      << lean.GetLikelihood() << " vs "
+                      << full.GetLikelihood());
+    pass = false;
+  }
+  if (!lean.HasStaleOutputs()) {
+    NUIS_ERR(FTL, "Fit mode reconfigure did not flag stale outputs.");
+    pass = false;
+  }
+
+  NUIS_LOG(FIT, "*            Testing: fit mode with slice-built MC");
+  FitModeSliceTestSample slicefull("FitModeTest_SliceFull");
+  slicefull.Reconfigure();
+  FitModeSliceTestSample slicelean("FitModeTest_SliceLean");
+  slicelean.SetFitMode(true);
+  for (int i = 0; i < 3; ++i) {
+    slicelean.Reconfigure();
+  }
+  pass = SameHist(slicefull.GetMCList()[0], slicelean.GetMCList()[0],
+                  "Slice-built MC") &&
+         pass;
+  if (slicefull.GetLikelihood() != slicelean.GetLikelihood()) {
+    NUIS_ERR(FTL, "Slice-built likelihood differs in fit mode: "
+                      << slicelean.GetLikelihood() << " vs "
+                      << slicefull.GetLikelihood());
+    pass = false;
+  }
+
+  NUIS_LOG(FIT, "*            Testing: final full pass");
+  lean.SetFitMode(false);
+  lean.Reconfigure();
+  if (lean.HasStaleOutputs()) {
+    NUIS_ERR(FTL, "Full reconfigure left outputs flagged as stale.");
+    pass = false;
+  }
+  pass = SameHist(full.GetMCList()[0], lean.GetMCList()[0], "MC") && pass;
+  pass = SameHist(full.GetFineList()[0], lean.GetFineList()[0], "MC fine") &&
+         pass;
+  pass = SameStack(full.GetModeStack(), lean.GetModeStack(), "MC modes") &&
+         pass;
+  pass = SameStack(full.GetFineModeStack(), lean.GetFineModeStack(),
+                   "MC fine modes") &&
+         pass;
+
+  NUIS_LOG(FIT, "*            Testing: block diagonal covariances");
+  pass = CheckBlockCovar(std::vector<int>(1, 5), "DenseCovar") && pass;
+  pass = CheckBlockCovar(std::vector<int>(4, 1), "DiagCovar") && pass;
+  std::vector<int> twoblocks;
+  twoblocks.push_back(2);
+  twoblocks.push_back(3);
+  pass = CheckBlockCovar(twoblocks, "TwoBlockCovar") && pass;
+
+  NUIS_LOG(FIT, "*            Testing: 2D n-1 chi2");
+  Chi2LessBinTestSample lessbin("Chi2LessBinTest");
+  pass = lessbin.CheckChi2LessBin("Unmasked") && pass;
+  // The flat inverse has to be rebuilt once a mask is set
+  lessbin.MaskBin(1, 0);
+  pass = lessbin.CheckChi2LessBin("Masked") && pass;
+
+  if (FailOnFail) {
+    assert(pass);
+  }
+  return pass ? 0 : 1;
+}
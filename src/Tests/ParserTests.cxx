@@ -5,6 +5,7 @@
 #include "GeneralUtils.h"
 #include "InputUtils.h"
 #include "NuisConfig.h"
+#include "ParserUtils.h"
 #include "StatUtils.h"
 
 int main(int argc, char const *argv[]) {
@@ -96,4 +97,39 @@ int main(int argc, char const *argv[]) {
 
   NUIS_LOG(FIT, "*            Passed InputUtils Tests");
   NUIS_LOG(FIT, "***************************************************");
+
+  NUIS_LOG(FIT, "*            Running ParserUtils Tests");
+  NUIS_LOG(FIT, "***************************************************");
+
+  std::vector<std::string> args;
+  args.push_back("-c");
+  args.push_back("card.xml");
+  args.push_back("--resume");
+  args.push_back("-o");
+  args.push_back("out.root");
+
+  bool resume = false;
+  bool missing = false;
+  ParserUtils::ParseFlag(args, "--resume", resume);
+  ParserUtils::ParseFlag(args, "--missing", missing);
+  std::string card = "";
+  std::string output = "";
+  ParserUtils::ParseArgument(args, "-c", card, true);
+  ParserUtils::ParseArgument(args, "-o", output, true);
+
+  NUIS_LOG(FIT, "    *        Test flag parse");
+  if (!resume || missing) {
+    NUIS_ERR(FTL, "--resume parsed as " << resume << ", --missing as "
+                                        << missing);
+  }
+  assert(resume && !missing);
+  NUIS_LOG(FIT, "    *        Test arguments after a flag");
+  if (card != "card.xml" || output != "out.root" || !args.empty()) {
+    NUIS_ERR(FTL, "Parsed -c " << card << " -o " << output << " with "
+                               << args.size() << " arguments left");
+  }
+  assert(card == "card.xml" && output == "out.root" && args.empty());
+
+  NUIS_LOG(FIT, "*            Passed ParserUtils Tests");
+  NUIS_LOG(FIT, "***************************************************");
 }
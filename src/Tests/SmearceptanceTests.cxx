@@ -3,6 +3,7 @@
 #include "FitLogger.h"
 
 #include "TDecompSVD.h"
+#include "TH2D.h"
 
 #include <cassert>
 #include <limits>
@@ -70,4 +71,32 @@ int main(int argc, char const *argv[]) {
   }
 
   assert(similar);
+
+  // Cached inverse of the same mapping as a histogram, GetMatrix(hist) == M
+  TH2D MHist("MHist", "", 2, 0, 2, 2, 0, 2);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      MHist.SetBinContent(j + 1, i + 1, M[i][j]);
+    }
+  }
+
+  std::shared_ptr<const TMatrixD> cachedInv =
+      SmearceptanceUtils::SVDGetInverseMatrix(&MHist);
+  assert(cachedInv == SmearceptanceUtils::SVDGetInverseMatrix(&MHist));
+  // Still owned by the caller once the cache has been dropped
+  SmearceptanceUtils::ClearSVDInverseCache();
+
+  similar = true;
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      if (fabs((*cachedInv)[i][j] - inv[i][j]) > numerTol) {
+        NUIS_ERR(FTL, "Cached inverse element " << i << "," << j << ": "
+                                                << (*cachedInv)[i][j]
+                                                << " != " << inv[i][j]);
+        similar = false;
+      }
+    }
+  }
+
+  assert(similar);
 }
@@ -0,0 +1,166 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "CacheUtils.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+// Bump if the entry layout changes
+const char kCacheMagic[8] = {'N', 'U', 'I', 'S', 'C', 'A', 'C', '1'};
+
+std::string OpenCacheDir() {
+  std::string dir = FitPar::Config().GetParS("InputCacheDir");
+  if (!dir.empty()) {
+    mkdir(dir.c_str(), 0755);
+    NUIS_LOG(SAM, "Using processed input cache in " << dir);
+  }
+  return dir;
+}
+
+// Samples are loaded on several threads, the static initialiser makes sure
+// the directory is only looked up and created once.
+std::string const &GetCacheDir() {
+  static std::string const dir = OpenCacheDir();
+  return dir;
+}
+} // namespace
+
+bool CacheUtils::IsEnabled() { return !GetCacheDir().empty(); }
+
+uint64_t CacheUtils::Hash(void const *data, size_t nbytes, uint64_t seed) {
+  unsigned char const *bytes = static_cast<unsigned char const *>(data);
+  uint64_t hash = seed;
+  for (size_t i = 0; i < nbytes; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+uint64_t CacheUtils::Hash(std::string const &str, uint64_t seed) {
+  return Hash(str.data(), str.size(), seed);
+}
+
+bool CacheUtils::HashFile(std::string const &filename, uint64_t &hash) {
+  std::ifstream ifs(filename.c_str(), std::ios::binary);
+  if (!ifs.good()) {
+    return false;
+  }
+
+  hash = 14695981039346656037ULL;
+  char buffer[65536];
+  while (ifs) {
+    ifs.read(buffer, sizeof(buffer));
+    hash = Hash(buffer, ifs.gcount(), hash);
+  }
+  return true;
+}
+
+std::string CacheUtils::MakeKey(std::string const &kind, uint64_t hash) {
+  std::stringstream ss;
+  ss << kind << "_" << std::hex << hash;
+  return ss.str();
+}
+
+bool CacheUtils::Read(std::string const &key,
+                      std::vector<std::vector<double> > &arrays) {
+  if (!IsEnabled()) {
+    return false;
+  }
+
+  std::string filename = GetCacheDir() + "/" + key + ".bin";
+  std::ifstream ifs(filename.c_str(), std::ios::binary);
+  if (!ifs.good()) {
+    return false;
+  }
+
+  char magic[8];
+  uint64_t narrays = 0;
+  ifs.read(magic, sizeof(magic));
+  ifs.read(reinterpret_cast<char *>(&narrays), sizeof(narrays));
+  if (!ifs.good() || memcmp(magic, kCacheMagic, sizeof(magic))) {
+    return false;
+  }
+
+  arrays.assign(narrays, std::vector<double>());
+  for (uint64_t i = 0; i < narrays; ++i) {
+    uint64_t size = 0;
+    ifs.read(reinterpret_cast<char *>(&size), sizeof(size));
+    if (!ifs.good()) {
+      return false;
+    }
+    arrays[i].resize(size);
+    if (size) {
+      ifs.read(reinterpret_cast<char *>(&arrays[i][0]), size * sizeof(double));
+    }
+  }
+
+  if (!ifs.good()) {
+    return false;
+  }
+
+  NUIS_LOG(DEB, "Read " << key << " from input cache.");
+  return true;
+}
+
+void CacheUtils::Write(std::string const &key,
+                       std::vector<std::vector<double> > const &arrays) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  std::string filename = GetCacheDir() + "/" + key + ".bin";
+  std::stringstream tmpname;
+  tmpname << filename << ".tmp." << getpid();
+
+  std::ofstream ofs(tmpname.str().c_str(), std::ios::binary);
+  if (!ofs.good()) {
+    NUIS_ERR(WRN, "Cannot write input cache entry " << filename);
+    return;
+  }
+
+  uint64_t narrays = arrays.size();
+  ofs.write(kCacheMagic, sizeof(kCacheMagic));
+  ofs.write(reinterpret_cast<char const *>(&narrays), sizeof(narrays));
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    uint64_t size = arrays[i].size();
+    ofs.write(reinterpret_cast<char const *>(&size), sizeof(size));
+    if (size) {
+      ofs.write(reinterpret_cast<char const *>(&arrays[i][0]),
+                size * sizeof(double));
+    }
+  }
+  ofs.close();
+
+  // rename is atomic, so other jobs only ever see complete entries
+  if (ofs.fail() || std::rename(tmpname.str().c_str(), filename.c_str())) {
+    NUIS_ERR(WRN, "Failed to write input cache entry " << filename);
+    std::remove(tmpname.str().c_str());
+  }
+}
@@ -0,0 +1,64 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef CACHEUTILS_H_SEEN
+#define CACHEUTILS_H_SEEN
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Content-hashed on-disk cache for expensive processed inputs (parsed data
+/// and covariance text files, covariance inverses and decompositions).
+///
+/// Entries are stored as a list of double arrays in <InputCacheDir>/<key>.bin
+/// and are written to a temporary file then renamed, so concurrent jobs can
+/// share one cache directory. Caching is disabled if InputCacheDir is empty.
+namespace CacheUtils {
+
+/// Returns true if InputCacheDir is set
+bool IsEnabled();
+
+/// 64-bit FNV-1a hash of a block of memory, chained from seed
+uint64_t Hash(void const *data, size_t nbytes,
+              uint64_t seed = 14695981039346656037ULL);
+
+/// Hash of a string, chained from seed
+uint64_t Hash(std::string const &str, uint64_t seed = 14695981039346656037ULL);
+
+/// Hash of the full contents of a file. Returns false if it can't be read.
+bool HashFile(std::string const &filename, uint64_t &hash);
+
+/// Build a cache key from a kind tag and a hash
+std::string MakeKey(std::string const &kind, uint64_t hash);
+
+/// Read a cache entry, returns false on a miss or a corrupt entry
+bool Read(std::string const &key, std::vector<std::vector<double> > &arrays);
+
+/// Write a cache entry. Failures are reported but never fatal.
+void Write(std::string const &key,
+           std::vector<std::vector<double> > const &arrays);
+} // namespace CacheUtils
+
+/*! @} */
+#endif
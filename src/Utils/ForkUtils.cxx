@@ -0,0 +1,112 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "ForkUtils.h"
+
+#include "FitLogger.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>
+
+namespace {
+bool GetFdPath(int fd, std::string &path) {
+#ifdef F_GETPATH
+  char buf[PATH_MAX];
+  if (fcntl(fd, F_GETPATH, buf) == -1) {
+    return false;
+  }
+  path = buf;
+  return true;
+#else
+  char buf[PATH_MAX];
+  std::string link = "/proc/self/fd/" + std::to_string(fd);
+  ssize_t len = readlink(link.c_str(), buf, sizeof(buf) - 1);
+  if (len <= 0) {
+    return false;
+  }
+  buf[len] = '\0';
+  path = buf;
+  return true;
+#endif
+}
+} // namespace
+
+namespace ForkUtils {
+
+std::vector<InputFile> SnapshotInputFiles() {
+  std::vector<InputFile> files;
+
+  long maxfd = sysconf(_SC_OPEN_MAX);
+  if ((maxfd < 0) || (maxfd > 65536)) {
+    maxfd = 65536;
+  }
+
+  // 0-2 are the standard streams, which are meant to be shared
+  for (int fd = 3; fd < maxfd; ++fd) {
+    struct stat st;
+    if (fstat(fd, &st) || !S_ISREG(st.st_mode)) {
+      continue;
+    }
+    int flags = fcntl(fd, F_GETFL);
+    if ((flags == -1) || ((flags & O_ACCMODE) != O_RDONLY)) {
+      continue;
+    }
+
+    InputFile file;
+    file.fd = fd;
+    file.flags = flags;
+    file.offset = lseek(fd, 0, SEEK_CUR);
+    if ((file.offset < 0) || !GetFdPath(fd, file.path)) {
+      continue;
+    }
+    files.push_back(file);
+  }
+  return files;
+}
+
+void ReopenInputFiles(std::vector<InputFile> const &files) {
+  for (size_t i = 0; i < files.size(); ++i) {
+    InputFile const &file = files[i];
+
+    // e.g. a file that has since been deleted, it can't be an input that is
+    // still being read
+    int newfd = open(file.path.c_str(), file.flags & ~(O_CREAT | O_TRUNC));
+    if (newfd < 0) {
+      NUIS_ERR(WRN, "Couldn't reopen " << file.path
+                                       << " in a forked worker, it will "
+                                          "share its read offset.");
+      continue;
+    }
+    int fdflags = fcntl(file.fd, F_GETFD);
+    if ((lseek(newfd, file.offset, SEEK_SET) != file.offset) ||
+        (dup2(newfd, file.fd) < 0)) {
+      close(newfd);
+      NUIS_ABORT("Failed to reopen input " << file.path
+                                           << " in a forked worker.");
+    }
+    if (fdflags != -1) {
+      fcntl(file.fd, F_SETFD, fdflags);
+    }
+    close(newfd);
+  }
+}
+} // namespace ForkUtils
@@ -0,0 +1,60 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef FORKUTILS_H_SEEN
+#define FORKUTILS_H_SEEN
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Helpers for routines that fork worker processes which keep reading the
+/// parent's inputs.
+///
+/// A forked child shares each open file's offset with its parent and its
+/// siblings, and ROOT and HepMC3 read with a seek followed by a read, so
+/// workers reading the same input at once silently get each other's bytes.
+/// Children therefore replace every read-only file descriptor with a fresh
+/// one on the same file, at the offset it had when the snapshot was taken.
+namespace ForkUtils {
+
+/// A read-only regular file open in this process
+struct InputFile {
+  int fd;
+  int flags;
+  off_t offset;
+  std::string path;
+};
+
+/// Every read-only regular file open in this process. Take this in the
+/// parent before forking, siblings may already be reading once a child runs.
+std::vector<InputFile> SnapshotInputFiles();
+
+/// Reopen the snapshotted files in a forked child, so that its reads no
+/// longer move the offsets seen by the parent and other children.
+void ReopenInputFiles(std::vector<InputFile> const &files);
+} // namespace ForkUtils
+
+/*! @} */
+#endif
@@ -187,4 +187,16 @@ void ParserUtils::ParseCounter(std::vector<std::string>& args, std::string opt,
 	}
 }
 
+void ParserUtils::ParseFlag(std::vector<std::string>& args, std::string opt, bool& found) {
+
+	for (size_t i = 0; i < args.size();) {
+		if (!(args[i]).compare(opt)) {
+			found = true;
+			args.erase(args.begin() + i);
+		} else {
+			i++;
+		}
+	}
+}
+
 
@@ -43,6 +43,9 @@ void ParseSplitArgument(std::vector<std::string>& args, std::string opt,
 /// Parse arguments looking for '+/-opt' and add/subtract from counter when it occurs
 void ParseCounter(std::vector<std::string>& args, std::string opt, int& count);
 
+/// Parses the arguments looking for a flag that takes no value, e.g. --resume
+void ParseFlag(std::vector<std::string>& args, std::string opt, bool& found);
+
 /// In the case where duplicates can be given, parses all cases into the val vector
 void ParseArgument(std::vector<std::string>& args, std::string opt,
                    std::vector<std::string>& val, bool required = false, bool duplicates = true);
@@ -18,6 +18,7 @@
  *******************************************************************************/
 
 #include "PlotUtils.h"
+#include "CacheUtils.h"
 #include "FitEvent.h"
 #include "StatUtils.h"
 
@@ -580,18 +581,40 @@ TH1D *PlotUtils::GetTH1DFromFile(std::string dataFile, std::string title,
 
     // Else its a space separated txt file
   } else {
-    // Make a TGraph Errors
-    TGraphErrors *gr = new TGraphErrors(dataFile.c_str(), "%lg %lg %lg");
-    if (gr->IsZombie()) {
-      NUIS_ABORT(
-          dataFile
-          << " is a zombie and could not be read. Are you sure it exists?"
-          << std::endl);
+    // Cached {bins, values, errors} keyed on the file content
+    std::vector<std::vector<double> > columns;
+    std::string cachekey = "";
+    uint64_t filehash;
+    if (CacheUtils::IsEnabled() && CacheUtils::HashFile(dataFile, filehash)) {
+      cachekey = CacheUtils::MakeKey("th1d", filehash);
     }
-    double *bins = gr->GetX();
-    double *values = gr->GetY();
-    double *errors = gr->GetEY();
-    int npoints = gr->GetN();
+
+    if (cachekey.empty() || !CacheUtils::Read(cachekey, columns) ||
+        (columns.size() != 3)) {
+      // Make a TGraph Errors
+      TGraphErrors *gr = new TGraphErrors(dataFile.c_str(), "%lg %lg %lg");
+      if (gr->IsZombie()) {
+        NUIS_ABORT(
+            dataFile
+            << " is a zombie and could not be read. Are you sure it exists?"
+            << std::endl);
+      }
+      int npoints = gr->GetN();
+      columns.resize(3);
+      columns[0].assign(gr->GetX(), gr->GetX() + npoints);
+      columns[1].assign(gr->GetY(), gr->GetY() + npoints);
+      columns[2].assign(gr->GetEY(), gr->GetEY() + npoints);
+      delete gr;
+
+      if (!cachekey.empty()) {
+        CacheUtils::Write(cachekey, columns);
+      }
+    }
+
+    double *bins = &columns[0][0];
+    double *values = &columns[1][0];
+    double *errors = &columns[2][0];
+    int npoints = columns[0].size();
 
     // Fill the histogram from it
     tempPlot = new TH1D(title.c_str(), title.c_str(), npoints - 1, bins);
@@ -608,8 +631,6 @@ TH1D *PlotUtils::GetTH1DFromFile(std::string dataFile, std::string title,
         tempPlot->SetBinError(i + 1, errors[i]);
       }
     }
-
-    delete gr;
   }
 
   // Allow alternate naming for root files
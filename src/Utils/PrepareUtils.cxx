@@ -0,0 +1,303 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "PrepareUtils.h"
+
+#include "CacheUtils.h"
+#include "FitLogger.h"
+#include "GeneralUtils.h"
+
+#include "TFile.h"
+#include "TNamed.h"
+#include "TSystem.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <sstream>
+
+namespace {
+// Size and modification time, cached inputs are refilled if either changes.
+// Empty if the input can't be stat'd, which turns caching off for it.
+std::string GetInputStat(std::string const &input) {
+  FileStat_t stat;
+  if (gSystem->GetPathInfo(input.c_str(), stat)) {
+    return "";
+  }
+  std::stringstream ss;
+  ss << stat.fSize << ":" << stat.fMtime;
+  return ss.str();
+}
+
+std::string GetCacheDirName(std::string const &input) {
+  return CacheUtils::MakeKey("input", CacheUtils::Hash(input));
+}
+
+std::string GetWorkerFile(int worker) {
+  return Form("%s/nuisprepare_%i_worker%i.root", gSystem->TempDirectory(),
+              int(getpid()), worker);
+}
+
+void FlushOutput() {
+  std::cout << std::flush;
+  std::cerr << std::flush;
+  std::fflush(stdout);
+  std::fflush(stderr);
+}
+} // namespace
+
+namespace PrepareUtils {
+
+bool HistSet::Has(std::string const &name) const {
+  return fHists.count(name);
+}
+
+TH1D *HistSet::Get(std::string const &name) const {
+  std::map<std::string, TH1D *>::const_iterator it = fHists.find(name);
+  return (it == fHists.end()) ? NULL : it->second;
+}
+
+TH1D *HistSet::Get(std::string const &name, TH1D const *templ) {
+  TH1D *hist = Get(name);
+  if (!hist) {
+    hist = static_cast<TH1D *>(templ->Clone());
+    hist->SetDirectory(NULL);
+    hist->Reset();
+    fNames.push_back(name);
+    fHists[name] = hist;
+  }
+  return hist;
+}
+
+void HistSet::Add(HistSet const &other) {
+  for (size_t i = 0; i < other.fNames.size(); ++i) {
+    TH1D *from = other.Get(other.fNames[i]);
+    Get(other.fNames[i], from)->Add(from);
+  }
+}
+
+void HistSet::Clear() {
+  for (std::map<std::string, TH1D *>::iterator it = fHists.begin();
+       it != fHists.end(); ++it) {
+    delete it->second;
+  }
+  fHists.clear();
+  fNames.clear();
+}
+
+void HistSet::Write(TDirectory *dir) const {
+  // Names are kept separately as they can contain ';', which ROOT would read
+  // as a key cycle.
+  std::string names;
+  for (size_t i = 0; i < fNames.size(); ++i) {
+    names += fNames[i] + "\n";
+    dir->WriteTObject(Get(fNames[i]), Form("hist_%i", int(i)));
+  }
+  TNamed list("hist_names", names.c_str());
+  dir->WriteTObject(&list);
+}
+
+bool HistSet::Read(TDirectory *dir) {
+  Clear();
+  TNamed *list = dynamic_cast<TNamed *>(dir->Get("hist_names"));
+  if (!list) {
+    return false;
+  }
+
+  std::vector<std::string> names =
+      GeneralUtils::ParseToStr(list->GetTitle(), "\n");
+  delete list;
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (names[i].empty()) {
+      continue;
+    }
+    TH1D *hist = dynamic_cast<TH1D *>(dir->Get(Form("hist_%i", int(i))));
+    if (!hist) {
+      Clear();
+      return false;
+    }
+    hist->SetDirectory(NULL);
+    fNames.push_back(names[i]);
+    fHists[names[i]] = hist;
+  }
+  return true;
+}
+
+std::string GetCacheFile(std::string const &output) {
+  return output + ".prepcache.root";
+}
+
+std::string GetBinningKey(TH1 const *templ) {
+  TAxis const *axis = templ->GetXaxis();
+  std::stringstream ss;
+  ss.precision(17);
+  for (int i = 0; i <= axis->GetNbins(); ++i) {
+    ss << axis->GetBinUpEdge(i) << ",";
+  }
+  return CacheUtils::MakeKey("binning", CacheUtils::Hash(ss.str()));
+}
+
+void FillFromInputs(std::vector<std::string> const &inputs, InputFiller fill,
+                    HistSet &total, int nworkers,
+                    std::string const &cachefile,
+                    std::string const &fillkey) {
+
+  std::vector<HistSet *> filled(inputs.size(), (HistSet *)NULL);
+
+  // Reuse anything already filled from an unchanged input
+  if (cachefile.length() && !gSystem->AccessPathName(cachefile.c_str())) {
+    TFile cache(cachefile.c_str(), "READ");
+    for (size_t i = 0; i < inputs.size() && !cache.IsZombie(); ++i) {
+      std::string stat = GetInputStat(inputs[i]);
+      TDirectory *dir = cache.GetDirectory(GetCacheDirName(inputs[i]).c_str());
+      TNamed *cached =
+          dir ? dynamic_cast<TNamed *>(dir->Get("input_stat")) : NULL;
+      TNamed *cachedkey =
+          dir ? dynamic_cast<TNamed *>(dir->Get("fill_key")) : NULL;
+      bool unchanged = cached && !stat.empty() && stat == cached->GetTitle() &&
+                       cachedkey && fillkey == cachedkey->GetTitle();
+      delete cached;
+      delete cachedkey;
+      if (!unchanged) {
+        continue;
+      }
+      filled[i] = new HistSet();
+      if (!filled[i]->Read(dir)) {
+        delete filled[i];
+        filled[i] = NULL;
+      }
+    }
+    cache.Close();
+  }
+
+  std::vector<size_t> todo;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!filled[i]) {
+      todo.push_back(i);
+    }
+  }
+  if (todo.size() != inputs.size()) {
+    NUIS_LOG(FIT, "Reusing " << inputs.size() - todo.size() << " of "
+                             << inputs.size() << " inputs from "
+                             << cachefile);
+  }
+
+  if (nworkers > int(todo.size())) {
+    nworkers = todo.size();
+  }
+
+  if (nworkers <= 1) {
+    for (size_t t = 0; t < todo.size(); ++t) {
+      NUIS_LOG(FIT, "Reading input " << todo[t] << ": " << inputs[todo[t]]);
+      filled[todo[t]] = new HistSet();
+      fill(inputs[todo[t]], *filled[todo[t]]);
+    }
+  } else {
+    // Generator libraries hold global state, so inputs are filled in forked
+    // processes rather than threads, and passed back through a file each.
+    FlushOutput();
+    std::vector<pid_t> pids(nworkers, -1);
+    for (int w = 0; w < nworkers; ++w) {
+      pid_t pid = fork();
+      if (pid < 0) {
+        NUIS_ABORT("Failed to fork prepare worker " << w);
+      }
+
+      if (pid == 0) {
+        int status = 0;
+        try {
+          TFile workerfile(GetWorkerFile(w).c_str(), "RECREATE");
+          for (size_t t = w; t < todo.size(); t += nworkers) {
+            NUIS_LOG(FIT, "Worker " << w << " reading input " << todo[t]
+                                    << ": " << inputs[todo[t]]);
+            HistSet hists;
+            fill(inputs[todo[t]], hists);
+            hists.Write(workerfile.mkdir(Form("input_%i", int(todo[t]))));
+          }
+          workerfile.Close();
+        } catch (...) {
+          status = 1;
+        }
+        FlushOutput();
+        _exit(status);
+      }
+      pids[w] = pid;
+    }
+
+    bool failed = false;
+    for (int w = 0; w < nworkers; ++w) {
+      int status = 0;
+      waitpid(pids[w], &status, 0);
+      if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        NUIS_ERR(FTL, "Prepare worker " << w << " failed.");
+        failed = true;
+      }
+    }
+
+    for (int w = 0; w < nworkers && !failed; ++w) {
+      TFile workerfile(GetWorkerFile(w).c_str(), "READ");
+      for (size_t t = w; t < todo.size(); t += nworkers) {
+        TDirectory *dir =
+            workerfile.GetDirectory(Form("input_%i", int(todo[t])));
+        filled[todo[t]] = new HistSet();
+        if (!dir || !filled[todo[t]]->Read(dir)) {
+          NUIS_ERR(FTL, "Prepare worker " << w << " didn't write input "
+                                          << inputs[todo[t]]);
+          failed = true;
+        }
+      }
+      workerfile.Close();
+    }
+
+    for (int w = 0; w < nworkers; ++w) {
+      gSystem->Unlink(GetWorkerFile(w).c_str());
+    }
+    if (failed) {
+      NUIS_ABORT("Failed to prepare all inputs.");
+    }
+  }
+
+  if (cachefile.length() && todo.size()) {
+    TFile cache(cachefile.c_str(), "UPDATE");
+    if (cache.IsZombie()) {
+      NUIS_ERR(WRN, "Couldn't open prepare cache " << cachefile);
+    }
+    for (size_t t = 0; t < todo.size() && !cache.IsZombie(); ++t) {
+      std::string stat = GetInputStat(inputs[todo[t]]);
+      if (stat.empty()) {
+        continue;
+      }
+      std::string dirname = GetCacheDirName(inputs[todo[t]]);
+      cache.rmdir(dirname.c_str());
+      TDirectory *dir = cache.mkdir(dirname.c_str(), inputs[todo[t]].c_str());
+      filled[todo[t]]->Write(dir);
+      TNamed statobj("input_stat", stat.c_str());
+      dir->WriteTObject(&statobj);
+      TNamed keyobj("fill_key", fillkey.c_str());
+      dir->WriteTObject(&keyobj);
+    }
+    cache.Close();
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    total.Add(*filled[i]);
+    delete filled[i];
+  }
+}
+} // namespace PrepareUtils
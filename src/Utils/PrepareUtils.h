@@ -0,0 +1,96 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef PREPAREUTILS_H_SEEN
+#define PREPAREUTILS_H_SEEN
+
+#include "TDirectory.h"
+#include "TH1D.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Shared event loop for the Prepare* apps. Each input file is filled into
+/// its own set of histograms, optionally by several forked worker processes,
+/// and the per-file sets are summed in input order so the result does not
+/// depend on the number of workers. Per-file sets can be kept in a cache file
+/// so that re-preparing after adding inputs only reads the new files.
+namespace PrepareUtils {
+
+/// Named histograms, kept in the order they were first created so that
+/// summing sets reproduces the ordering of a single pass.
+class HistSet {
+public:
+  HistSet() {}
+  ~HistSet() { Clear(); }
+
+  bool Has(std::string const &name) const;
+  /// Returns the histogram, NULL if it doesn't exist
+  TH1D *Get(std::string const &name) const;
+  /// Returns the histogram, creating it as an empty copy of templ if needed
+  TH1D *Get(std::string const &name, TH1D const *templ);
+  std::vector<std::string> const &GetNames() const { return fNames; }
+
+  /// Add other into this, appending histograms this doesn't have yet
+  void Add(HistSet const &other);
+  void Clear();
+
+  void Write(TDirectory *dir) const;
+  /// Replace the contents with a set written by Write, false if there isn't one
+  bool Read(TDirectory *dir);
+
+private:
+  HistSet(HistSet const &);
+  HistSet &operator=(HistSet const &);
+
+  std::vector<std::string> fNames;
+  std::map<std::string, TH1D *> fHists;
+};
+
+/// Fills the histograms for one input file
+typedef std::function<void(std::string const &, HistSet &)> InputFiller;
+
+/// Default cache file for a prepared output
+std::string GetCacheFile(std::string const &output);
+
+/// Key describing a template histogram's binning, for use in a fill key
+std::string GetBinningKey(TH1 const *templ);
+
+
+/// Run fill over every input and sum the results into total in input order.
+/// Up to nworkers inputs are filled at once in forked worker processes. If
+/// cachefile is given, inputs that are unchanged since they were cached are
+/// not read again and newly filled inputs are added to the cache. fillkey
+/// should describe everything else that changes what fill produces (template
+/// binning, unit flags, ...), cached inputs filled with a different key are
+/// read again.
+void FillFromInputs(std::vector<std::string> const &inputs, InputFiller fill,
+                    HistSet &total, int nworkers = 1,
+                    std::string const &cachefile = "",
+                    std::string const &fillkey = "");
+} // namespace PrepareUtils
+
+/*! @} */
+#endif
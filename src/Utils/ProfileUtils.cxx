@@ -0,0 +1,215 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "ProfileUtils.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include "TDirectory.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace {
+struct StageRegistry {
+  std::mutex mutex;
+  std::vector<ProfileUtils::Stage *> stages;
+  std::map<std::string, ProfileUtils::Stage *> index;
+};
+
+StageRegistry &GetRegistry() {
+  static StageRegistry registry;
+  return registry;
+}
+
+// Wall clock reference for the run, set when profiling is first checked
+long long gProfileStart = 0;
+
+std::string EscapeJSON(std::string const &str) {
+  std::string out;
+  for (size_t i = 0; i < str.size(); ++i) {
+    if (str[i] == '"' || str[i] == '\\') {
+      out += '\\';
+    }
+    out += str[i];
+  }
+  return out;
+}
+
+bool ReadIsEnabled() {
+  bool enabled = FitPar::Config().GetParB("ProfileStages");
+  if (enabled) {
+    gProfileStart = ProfileUtils::Now();
+    NUIS_LOG(FIT, "Profiling event loop stages.");
+  }
+  return enabled;
+}
+} // namespace
+
+bool ProfileUtils::IsEnabled() {
+  static bool const enabled = ReadIsEnabled();
+  return enabled;
+}
+
+ProfileUtils::Stage *ProfileUtils::GetStage(std::string const &name) {
+  if (!IsEnabled()) {
+    return NULL;
+  }
+
+  StageRegistry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::map<std::string, Stage *>::iterator it = registry.index.find(name);
+  if (it != registry.index.end()) {
+    return it->second;
+  }
+
+  Stage *stage = new Stage(name);
+  registry.stages.push_back(stage);
+  registry.index[name] = stage;
+  return stage;
+}
+
+std::vector<ProfileUtils::Stage *> ProfileUtils::GetStages() {
+  StageRegistry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.stages;
+}
+
+void ProfileUtils::Print() {
+  std::vector<Stage *> stages = GetStages();
+  double wall = (Now() - gProfileStart) * 1E-9;
+
+  size_t namewidth = 5;
+  for (size_t i = 0; i < stages.size(); ++i) {
+    namewidth = std::max(namewidth, stages[i]->GetName().size());
+  }
+
+  NUIS_LOG(FIT, "Stage profile over " << std::fixed << std::setprecision(2)
+                                      << wall << " s wall time");
+  NUIS_LOG(FIT, std::left << std::setw(namewidth) << "Stage" << std::right
+                          << std::setw(12) << "Calls" << std::setw(10)
+                          << "Time(s)" << std::setw(8) << "Wall%"
+                          << std::setw(12) << "Calls/s" << std::setw(9)
+                          << "Signal%" << std::setw(10) << "Proc MB");
+  for (size_t i = 0; i < stages.size(); ++i) {
+    Stage const *stage = stages[i];
+    double seconds = stage->GetSeconds();
+    long long calls = stage->GetCalls();
+
+    std::stringstream signal;
+    if (stage->CountsSignal() && calls) {
+      signal << std::fixed << std::setprecision(1)
+             << 100. * stage->GetSignal() / calls;
+    } else {
+      signal << "-";
+    }
+
+    std::stringstream bytes;
+    if (stage->GetBytes()) {
+      bytes << std::fixed << std::setprecision(1)
+            << stage->GetBytes() / (1024. * 1024.);
+    } else {
+      bytes << "-";
+    }
+
+    NUIS_LOG(FIT, std::left << std::setw(namewidth) << stage->GetName()
+                            << std::right << std::setw(12) << calls
+                            << std::fixed << std::setprecision(3)
+                            << std::setw(10) << seconds << std::setprecision(1)
+                            << std::setw(8)
+                            << (wall > 0 ? 100. * seconds / wall : 0.)
+                            << std::setprecision(0) << std::setw(12)
+                            << (seconds > 0 ? calls / seconds : 0.)
+                            << std::setw(9) << signal.str() << std::setw(10)
+                            << bytes.str());
+  }
+  NUIS_LOG(FIT, "Proc MB counts every ROOT file read in the process while a "
+                "stage ran, including reads on other threads.");
+}
+
+void ProfileUtils::WriteJSON(std::string const &filename) {
+  std::ofstream ofs(filename.c_str());
+  if (!ofs.good()) {
+    NUIS_ERR(WRN, "Could not write stage profile to " << filename);
+    return;
+  }
+
+  std::vector<Stage *> stages = GetStages();
+  ofs << "{\n  \"wall_seconds\": " << (Now() - gProfileStart) * 1E-9
+      << ",\n  \"stages\": [";
+  for (size_t i = 0; i < stages.size(); ++i) {
+    Stage const *stage = stages[i];
+    ofs << (i ? ",\n" : "\n") << "    {\"name\": \""
+        << EscapeJSON(stage->GetName()) << "\", \"calls\": "
+        << stage->GetCalls() << ", \"seconds\": " << stage->GetSeconds()
+        << ", \"signal\": "
+        << (stage->CountsSignal() ? stage->GetSignal() : -1)
+        << ", \"process_bytes\": " << stage->GetBytes() << "}";
+  }
+  ofs << "\n  ]\n}\n";
+  NUIS_LOG(FIT, "Written stage profile to " << filename);
+}
+
+void ProfileUtils::WriteTree(TDirectory *dir) {
+  TDirectory *curdir = gDirectory;
+  dir->cd();
+
+  std::string name;
+  Long64_t calls, signal, bytes;
+  double seconds;
+  TTree *tree = new TTree("profile", "profile");
+  tree->Branch("name", &name);
+  tree->Branch("calls", &calls, "calls/L");
+  tree->Branch("seconds", &seconds, "seconds/D");
+  tree->Branch("signal", &signal, "signal/L");
+  tree->Branch("process_bytes", &bytes, "process_bytes/L");
+
+  std::vector<Stage *> stages = GetStages();
+  for (size_t i = 0; i < stages.size(); ++i) {
+    name = stages[i]->GetName();
+    calls = stages[i]->GetCalls();
+    seconds = stages[i]->GetSeconds();
+    signal = stages[i]->CountsSignal() ? stages[i]->GetSignal() : -1;
+    bytes = stages[i]->GetBytes();
+    tree->Fill();
+  }
+
+  tree->Write("profile", TObject::kOverwrite);
+  delete tree;
+  curdir->cd();
+}
+
+void ProfileUtils::Report(TDirectory *dir, std::string const &filename) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  Print();
+  if (dir) {
+    WriteTree(dir);
+  }
+  if (!filename.empty()) {
+    WriteJSON(filename);
+  }
+}
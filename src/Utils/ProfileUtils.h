@@ -0,0 +1,139 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef PROFILEUTILS_H_SEEN
+#define PROFILEUTILS_H_SEEN
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <time.h>
+
+class TDirectory;
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Built-in per-stage timers and counters, enabled with ProfileStages.
+///
+/// Stages are registered by name once and kept for the lifetime of the
+/// process. GetStage returns NULL when profiling is disabled, and every
+/// timer and counter is a no-op on a NULL stage, so instrumented code only
+/// pays for a pointer check. Counters are atomic as stages can be filled from
+/// the input read-ahead thread.
+namespace ProfileUtils {
+
+/// Totals for one named stage
+class Stage {
+public:
+  Stage(std::string const &name)
+      : fName(name), fCalls(0), fNanoseconds(0), fSignal(0), fBytes(0),
+        fCountsSignal(false){};
+
+  inline void AddCall(long long ns) {
+    fCalls.fetch_add(1, std::memory_order_relaxed);
+    fNanoseconds.fetch_add(ns, std::memory_order_relaxed);
+  };
+  inline void AddSignal(bool signal) {
+    fCountsSignal.store(true, std::memory_order_relaxed);
+    if (signal)
+      fSignal.fetch_add(1, std::memory_order_relaxed);
+  };
+  inline void AddBytes(long long n) {
+    fBytes.fetch_add(n, std::memory_order_relaxed);
+  };
+
+  std::string const &GetName() const { return fName; };
+  long long GetCalls() const { return fCalls.load(); };
+  double GetSeconds() const { return fNanoseconds.load() * 1E-9; };
+  long long GetSignal() const { return fSignal.load(); };
+  long long GetBytes() const { return fBytes.load(); };
+  bool CountsSignal() const { return fCountsSignal.load(); };
+
+private:
+  std::string fName;
+  std::atomic<long long> fCalls;
+  std::atomic<long long> fNanoseconds;
+  std::atomic<long long> fSignal;
+  std::atomic<long long> fBytes;
+  std::atomic<bool> fCountsSignal;
+};
+
+/// Returns true if ProfileStages is set
+bool IsEnabled();
+
+/// Get or register the stage with this name, NULL if profiling is disabled
+Stage *GetStage(std::string const &name);
+
+/// All registered stages in registration order
+std::vector<Stage *> GetStages();
+
+/// Monotonic clock in nanoseconds
+inline long long Now() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/// Adds one call and the time spent in its scope to a stage
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Stage *stage)
+      : fStage(stage), fStart(stage ? Now() : 0){};
+  ~ScopedTimer() {
+    if (fStage)
+      fStage->AddCall(Now() - fStart);
+  };
+
+private:
+  Stage *fStage;
+  long long fStart;
+};
+
+/// Count a selected or rejected event for a stage
+inline void CountSignal(Stage *stage, bool signal) {
+  if (stage)
+    stage->AddSignal(signal);
+}
+
+/// Count bytes read for a stage. Callers take these from the process-wide
+/// TFile::GetFileBytesRead(), so they also include reads made by other
+/// threads while the stage ran, and are reported as process bytes.
+inline void CountBytes(Stage *stage, long long bytes) {
+  if (stage && bytes > 0)
+    stage->AddBytes(bytes);
+}
+
+/// Print a table of all stages to the log
+void Print();
+
+/// Write all stages as a JSON list of objects
+void WriteJSON(std::string const &filename);
+
+/// Write all stages as a "profile" TTree with one entry per stage
+void WriteTree(TDirectory *dir);
+
+/// If enabled, print the stages and write them to dir and filename
+void Report(TDirectory *dir, std::string const &filename);
+} // namespace ProfileUtils
+
+/*! @} */
+#endif